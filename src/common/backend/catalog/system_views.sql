@@ -1398,6 +1398,7 @@ CREATE VIEW gs_wlm_workload_records AS
 CREATE VIEW gs_os_run_info AS SELECT * FROM pv_os_run_info();
 CREATE VIEW gs_thread_memory_detail AS SELECT * FROM pv_thread_memory_detail();
 CREATE VIEW gs_shared_memory_detail AS SELECT * FROM pg_shared_memory_detail();
+CREATE VIEW gs_card_feedback AS SELECT * FROM gs_get_card_feedback();
 CREATE VIEW gs_instance_time AS SELECT * FROM pv_instance_time();
 CREATE VIEW gs_session_time AS SELECT * FROM pv_session_time();
 CREATE VIEW gs_session_memory AS SELECT * FROM pv_session_memory();
@@ -88,6 +88,13 @@ void BuildStreamFlow(PlannedStmt* plan)
     DISTRIBUTED_FEATURE_NOT_SUPPORTED();
 }
 
+/*
+ * The single-node planner makes no Stream nodes, so row-store plans always
+ * run on the session thread.  Parallel row-store scans (heap scans split
+ * into heap_init_parallel_seqscan() block ranges, partial aggregation and a
+ * local gather) need local streams here, together with the worker set-up
+ * that StreamMain() does in the distributed build.
+ */
 StreamState* ExecInitStream(Stream* node, EState* estate, int eflags)
 {
     Assert(false);
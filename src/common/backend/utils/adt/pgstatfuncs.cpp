@@ -51,6 +51,8 @@
 #include "storage/proc.h"
 #include "storage/procarray.h"
 #include "storage/buf_internals.h"
+#include "storage/cucache_mgr.h"
+#include "storage/dfs/dfscache_mgr.h"
 #include "workload/cpwlm.h"
 #include "workload/workload.h"
 #include "pgxc/pgxcnode.h"
@@ -64,6 +66,7 @@
 #include "instruments/list.h"
 #include "access/redo_statistic.h"
 #include "replication/rto_statistic.h"
+#include "storage/mot/mot_fdw.h"
 
 #define UINT32_ACCESS_ONCE(var) ((uint32)(*((volatile uint32*)&(var))))
 
@@ -174,6 +177,7 @@ extern Datum pg_stat_get_bgwriter_stat_reset_time(PG_FUNCTION_ARGS);
 extern Datum pg_stat_get_buf_written_backend(PG_FUNCTION_ARGS);
 extern Datum pg_stat_get_buf_fsync_backend(PG_FUNCTION_ARGS);
 extern Datum pg_stat_get_buf_alloc(PG_FUNCTION_ARGS);
+extern Datum pg_stat_get_cache_hit_stats(PG_FUNCTION_ARGS);
 
 extern Datum pg_stat_get_xact_numscans(PG_FUNCTION_ARGS);
 extern Datum pg_stat_get_xact_tuples_returned(PG_FUNCTION_ARGS);
@@ -229,6 +233,7 @@ extern Datum pv_session_memctx_detail(PG_FUNCTION_ARGS);
 extern Datum pv_total_memory_detail(PG_FUNCTION_ARGS);
 extern Datum mot_global_memory_detail(PG_FUNCTION_ARGS);
 extern Datum mot_local_memory_detail(PG_FUNCTION_ARGS);
+extern Datum mot_redo_replay_progress(PG_FUNCTION_ARGS);
 extern Datum gs_total_nodegroup_memory_detail(PG_FUNCTION_ARGS);
 
 /* Global bgwriter statistics, from bgwriter.c */
@@ -6153,6 +6158,76 @@ Datum pg_stat_get_buf_alloc(PG_FUNCTION_ARGS)
     PG_RETURN_INT64(pgstat_fetch_global()->buf_alloc);
 }
 
+/*
+ * @Description: report the hits, reads, evictions and scan ring reuses of the
+ *     column data caches (CU, ORC and OBS) and of the ORC meta cache.
+ *     the counters are kept since the start of the instance.
+ * @Return: one row per cache type
+ */
+Datum pg_stat_get_cache_hit_stats(PG_FUNCTION_ARGS)
+{
+    FuncCallContext* func_ctx = NULL;
+    const int ATT_COUNT = 6;
+    static const int cacheTypes[] = {CACHE_COlUMN_DATA, CACHE_ORC_DATA, CACHE_OBS_DATA, CACHE_ORC_INDEX};
+    static const char* cacheNames[] = {"CU", "ORC", "OBS", "ORC index"};
+
+    if (SRF_IS_FIRSTCALL()) {
+        MemoryContext old_context;
+        TupleDesc tup_desc;
+
+        func_ctx = SRF_FIRSTCALL_INIT();
+
+        old_context = MemoryContextSwitchTo(func_ctx->multi_call_memory_ctx);
+
+        tup_desc = CreateTemplateTupleDesc(ATT_COUNT, false);
+        TupleDescInitEntry(tup_desc, (AttrNumber)1, "cache_type", TEXTOID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)2, "hits", INT8OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)3, "reads", INT8OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)4, "evictions", INT8OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)5, "ring_reuses", INT8OID, -1, 0);
+        TupleDescInitEntry(tup_desc, (AttrNumber)6, "hit_ratio", FLOAT8OID, -1, 0);
+
+        func_ctx->tuple_desc = BlessTupleDesc(tup_desc);
+        func_ctx->max_calls = lengthof(cacheTypes);
+
+        MemoryContextSwitchTo(old_context);
+    }
+
+    func_ctx = SRF_PERCALL_SETUP();
+    if (func_ctx->call_cntr < func_ctx->max_calls) {
+        Datum values[ATT_COUNT];
+        bool nulls[ATT_COUNT] = {false};
+        HeapTuple tuple = NULL;
+        uint64 hits = 0;
+        uint64 reads = 0;
+        uint64 evictions = 0;
+        uint64 ringReuses = 0;
+        int type = cacheTypes[func_ctx->call_cntr];
+
+        if (type == CACHE_ORC_INDEX) {
+            MetaCache->GetCacheTypeStats(&hits, &reads, &evictions, &ringReuses);
+        } else {
+            CUCache->GetCacheTypeStats(type, &hits, &reads, &evictions, &ringReuses);
+        }
+
+        values[0] = CStringGetTextDatum(cacheNames[func_ctx->call_cntr]);
+        values[1] = Int64GetDatum((int64)hits);
+        values[2] = Int64GetDatum((int64)reads);
+        values[3] = Int64GetDatum((int64)evictions);
+        values[4] = Int64GetDatum((int64)ringReuses);
+        if (hits + reads > 0) {
+            values[5] = Float8GetDatum((double)hits / (double)(hits + reads));
+        } else {
+            nulls[5] = true;
+        }
+
+        tuple = heap_form_tuple(func_ctx->tuple_desc, values, nulls);
+        SRF_RETURN_NEXT(func_ctx, HeapTupleGetDatum(tuple));
+    } else {
+        SRF_RETURN_DONE(func_ctx);
+    }
+}
+
 Datum pg_stat_get_xact_numscans(PG_FUNCTION_ARGS)
 {
     Oid rel_id = PG_GETARG_OID(0);
@@ -7010,6 +7085,55 @@ Datum mot_local_memory_detail(PG_FUNCTION_ARGS)
     }
 }
 
+/*
+ * mot_redo_replay_progress
+ *		Produce a view to show the MOT redo replay progress on node
+ *
+ */
+Datum mot_redo_replay_progress(PG_FUNCTION_ARGS)
+{
+    int i = 0;
+    errno_t rc = 0;
+    char lsnBuf[MAXFNAMELEN];
+    MotRedoReplayProgress progress;
+
+    TupleDesc tupdesc = CreateTemplateTupleDesc(7, false);
+    TupleDescInitEntry(tupdesc, (AttrNumber)++i, "workers", INT4OID, -1, 0);
+    TupleDescInitEntry(tupdesc, (AttrNumber)++i, "replayed_transactions", INT8OID, -1, 0);
+    TupleDescInitEntry(tupdesc, (AttrNumber)++i, "serial_transactions", INT8OID, -1, 0);
+    TupleDescInitEntry(tupdesc, (AttrNumber)++i, "pending_transactions", INT8OID, -1, 0);
+    TupleDescInitEntry(tupdesc, (AttrNumber)++i, "replayed_operations", INT8OID, -1, 0);
+    TupleDescInitEntry(tupdesc, (AttrNumber)++i, "last_replay_lsn", TEXTOID, -1, 0);
+    TupleDescInitEntry(tupdesc, (AttrNumber)++i, "max_recovered_csn", INT8OID, -1, 0);
+    tupdesc = BlessTupleDesc(tupdesc);
+
+    Datum values[7];
+    bool nulls[7] = {false};
+    HeapTuple tuple = NULL;
+
+    rc = memset_s(values, sizeof(values), 0, sizeof(values));
+    securec_check(rc, "\0", "\0");
+    rc = memset_s(nulls, sizeof(nulls), 0, sizeof(nulls));
+    securec_check(rc, "\0", "\0");
+
+    MOTGetRedoReplayProgress(&progress);
+    rc = snprintf_s(lsnBuf, sizeof(lsnBuf), sizeof(lsnBuf) - 1, "%X/%X",
+        (uint32)(progress.lastReplayLsn >> 32), (uint32)progress.lastReplayLsn);
+    securec_check_ss(rc, "\0", "\0");
+
+    i = 0;
+    values[i++] = Int32GetDatum(progress.workers);
+    values[i++] = Int64GetDatum(progress.replayedTxns);
+    values[i++] = Int64GetDatum(progress.serialTxns);
+    values[i++] = Int64GetDatum(progress.pendingTxns);
+    values[i++] = Int64GetDatum(progress.replayedOps);
+    values[i++] = CStringGetTextDatum(lsnBuf);
+    values[i++] = Int64GetDatum(progress.maxRecoveredCsn);
+    tuple = heap_form_tuple(tupdesc, values, nulls);
+
+    PG_RETURN_DATUM(HeapTupleGetDatum(tuple));
+}
+
 /*
  * @@GaussDB@@
  * Brief		: Collect each thread Memory Context status,
@@ -98,12 +98,31 @@ static void cat_cache_print_stats(int code, Datum arg);
 #endif
 static void cat_cache_remove_ctup(CatCache* cache, CatCTup* ct);
 static void cat_cache_remove_clist(CatCache* cache, CatCList* cl);
+static void cat_cache_prune(void);
 static void catalog_cache_initialize_cache(CatCache* cache);
 static CatCTup* catalog_cache_create_entry(CatCache* cache, HeapTuple ntp, Datum* arguments, uint32 hashValue,
     Index hashIndex, bool negative, bool isnailed = false);
 static void cat_cache_free_keys(TupleDesc tupdesc, int nkeys, const int* attnos, Datum* keys);
 static void cat_cache_copy_keys(TupleDesc tupdesc, int nkeys, const int* attnos, Datum* srckeys, Datum* dstkeys);
 
+/* bytes of a cache entry, the keys of a negative entry are not counted */
+static inline Size CatCTupSize(const CatCTup* ct)
+{
+    return ct->negative ? sizeof(CatCTup) : (sizeof(CatCTup) + MAXIMUM_ALIGNOF + ct->tuple.t_len);
+}
+
+/*
+ * Prune the caches when they exceed local_syscache_threshold, but not again
+ * before half of the entries could have been searched since the last time.
+ */
+static inline bool CatCacheNeedPrune(const CatCacheHeader* header)
+{
+    int64 threshold = (int64)u_sess->attr.attr_memory.local_syscache_threshold * 1024L;
+
+    return threshold > 0 && header->ch_size > threshold &&
+           header->ch_clock - header->ch_pruned > (uint64)(header->ch_ntup / 2);
+}
+
 /*
  *					internal support functions
  */
@@ -508,6 +527,8 @@ static void cat_cache_remove_ctup(CatCache* cache, CatCTup* ct)
     /* delink from linked list */
     DLRemove(&ct->cache_elem);
 
+    u_sess->cache_cxt.cache_header->ch_size -= CatCTupSize(ct);
+
     /*
      * Free keys when we're dealing with a negative entry, normal entries just
      * point into tuple, allocated together with the CatCTup.
@@ -560,6 +581,54 @@ static void cat_cache_remove_clist(CatCache* cache, CatCList* cl)
     pfree_ext(cl);
 }
 
+/*
+ *		cat_cache_prune
+ *
+ * Remove the entries of all caches which were not found by the latest
+ * ch_ntup / 2 searches, to keep the catalog cache of a session under
+ * local_syscache_threshold however many objects the database has.
+ *
+ * Each bucket is kept in LRU order, so we walk it from the tail and stop at
+ * the first recently used entry.  Referenced entries, nailed entries and
+ * members of CatCLists are left alone, removing a list member would remove
+ * the whole list.
+ *
+ * This only bounds the cache of one session.  Sessions do not share catalog
+ * cache entries, so a new session still warms its cache from the catalogs,
+ * and the relcache is not bounded.
+ */
+static void cat_cache_prune(void)
+{
+    CatCacheHeader* header = u_sess->cache_cxt.cache_header;
+    uint64 cutoff = header->ch_clock - (uint64)(header->ch_ntup / 2);
+    int nremoved = 0;
+
+    for (CatCache* ccp = header->ch_caches; ccp; ccp = ccp->cc_next) {
+        for (int i = 0; i < ccp->cc_nbuckets; i++) {
+            Dlelem* elt = NULL;
+            Dlelem* prevelt = NULL;
+
+            for (elt = DLGetTail(&ccp->cc_bucket[i]); elt; elt = prevelt) {
+                CatCTup* ct = (CatCTup*)DLE_VAL(elt);
+                prevelt = DLGetPred(elt);
+
+                if (ct->lastaccess >= cutoff) {
+                    break;
+                }
+                if (ct->refcount > 0 || ct->isnailed || ct->c_list != NULL) {
+                    continue;
+                }
+
+                cat_cache_remove_ctup(ccp, ct);
+                nremoved++;
+            }
+        }
+    }
+
+    header->ch_pruned = header->ch_clock;
+    ereport(DEBUG1, (errmsg("pruned %d catalog cache entries, %ld bytes left", nremoved, header->ch_size)));
+}
+
 /*
  *	CatalogCacheIdInvalidate
  *
@@ -880,6 +949,9 @@ CatCache* InitCatCache(int id, Oid reloid, Oid indexoid, int nkeys, const int* k
         u_sess->cache_cxt.cache_header = (CatCacheHeader*)palloc(sizeof(CatCacheHeader));
         u_sess->cache_cxt.cache_header->ch_caches = NULL;
         u_sess->cache_cxt.cache_header->ch_ntup = 0;
+        u_sess->cache_cxt.cache_header->ch_size = 0;
+        u_sess->cache_cxt.cache_header->ch_clock = 0;
+        u_sess->cache_cxt.cache_header->ch_pruned = 0;
 #ifdef CATCACHE_STATS
         /* set up to dump stats at backend exit */
         on_proc_exit(cat_cache_print_stats, 0);
@@ -1259,6 +1331,7 @@ HeapTuple SearchCatCacheInternal(CatCache* cache, int nkeys, Datum v1, Datum v2,
          * near the front of the hashbucket's list.)
          */
         DLMoveToFront(&ct->cache_elem);
+        ct->lastaccess = ++u_sess->cache_cxt.cache_header->ch_clock;
 
         /*
          * If it's a positive entry, bump its refcount and return it. If it's
@@ -1432,6 +1505,10 @@ static HeapTuple search_cat_cache_miss(
     cur_skey[2].sk_argument = v3;
     cur_skey[3].sk_argument = v4;
 
+    if (unlikely(CatCacheNeedPrune(u_sess->cache_cxt.cache_header))) {
+        cat_cache_prune();
+    }
+
     /* For search a function, we firstly try to search it in built-in function list */
     if (IsProcCache(cache) && u_sess->attr.attr_common.IsInplaceUpgrade == false) {
         CACHE2_elog(DEBUG2, "search_cat_cache_miss(%d): function not found in pg_proc", cache->id);
@@ -2510,11 +2587,13 @@ static CatCTup* catalog_cache_create_entry(
     ct->isnailed = isnailed;
     ct->negative = negative;
     ct->hash_value = hashValue;
+    ct->lastaccess = ++u_sess->cache_cxt.cache_header->ch_clock;
 
     DLAddHead(&cache->cc_bucket[hashIndex], &ct->cache_elem);
 
     cache->cc_ntup++;
     u_sess->cache_cxt.cache_header->ch_ntup++;
+    u_sess->cache_cxt.cache_header->ch_size += CatCTupSize(ct);
 
     return ct;
 }
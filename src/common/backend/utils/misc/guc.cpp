@@ -1657,6 +1657,34 @@ static void init_configure_names_bool()
             NULL,
             NULL
         },
+        {
+            {
+                "enable_adaptive_nestloop",
+                PGC_USERSET,
+                QUERY_TUNING_METHOD,
+                gettext_noop("Enables nested-loop joins to switch to hashing the inner side at runtime."),
+                NULL
+            },
+            &u_sess->attr.attr_sql.enable_adaptive_nestloop,
+            false,
+            NULL,
+            NULL,
+            NULL
+        },
+        {
+            {
+                "enable_card_feedback",
+                PGC_USERSET,
+                QUERY_TUNING_OTHER,
+                gettext_noop("Enables the planner to correct base relation estimates from executed scans."),
+                NULL
+            },
+            &u_sess->attr.attr_sql.enable_card_feedback,
+            false,
+            NULL,
+            NULL,
+            NULL
+        },
         {
             {
                 "enable_nodegroup_debug",
@@ -1974,6 +2002,21 @@ static void init_configure_names_bool()
             NULL,
             NULL
         },
+        {
+            {
+                "enable_dphyp",
+                PGC_USERSET,
+                QUERY_TUNING_GEQO,
+                gettext_noop("Enables dynamic-programming join enumeration over the join graph instead of GEQO."),
+                gettext_noop("Used for joins of at least geqo_threshold items. Falls back to greedy "
+                    "join ordering when dphyp_mem_limit is exceeded.")
+            },
+            &u_sess->attr.attr_sql.enable_dphyp,
+            false,
+            NULL,
+            NULL,
+            NULL
+        },
         { /* Not for general use --- used by SET SESSION AUTHORIZATION */
             {
                 "is_sysadmin",
@@ -2608,6 +2651,20 @@ static void init_configure_names_bool()
             NULL,
             NULL
         },
+        {
+            {
+                "autovacuum_merge_cstore_delta",
+                PGC_SIGHUP,
+                AUTOVACUUM,
+                gettext_noop("Lets autovacuum merge the delta tables of column tables into CUs."),
+                NULL
+            },
+            &u_sess->attr.attr_storage.autovacuum_merge_cstore_delta,
+            true,
+            NULL,
+            NULL,
+            NULL
+        },
         {
             {
                 "enable_analyze_check",
@@ -4733,6 +4790,23 @@ static void init_configure_names_int()
             NULL,
             NULL
         },
+        {
+            {
+                "adaptive_nestloop_threshold",
+                PGC_USERSET,
+                QUERY_TUNING_OTHER,
+                gettext_noop("Sets the number of outer rows after which an adaptive nested-loop join "
+                    "switches to a hash join."),
+                NULL
+            },
+            &u_sess->attr.attr_sql.adaptive_nestloop_threshold,
+            10000,
+            1,
+            INT_MAX,
+            NULL,
+            NULL,
+            NULL
+        },
         {
             {
                 "join_collapse_limit",
@@ -4768,6 +4842,23 @@ static void init_configure_names_int()
             NULL,
             NULL
         },
+        {
+            {
+                "dphyp_mem_limit",
+                PGC_USERSET,
+                QUERY_TUNING_GEQO,
+                gettext_noop("Sets the maximum memory used by the DPhyp join enumeration of one join problem."),
+                NULL,
+                GUC_UNIT_KB
+            },
+            &u_sess->attr.attr_sql.dphyp_mem_limit,
+            256 * 1024,
+            1024,
+            MAX_KILOBYTES,
+            NULL,
+            NULL,
+            NULL
+        },
         {
             {
                 "geqo_effort",
@@ -5812,6 +5903,24 @@ static void init_configure_names_int()
             NULL,
             NULL
         },
+        {
+            {
+                "local_syscache_threshold",
+                PGC_SIGHUP,
+                RESOURCES_MEM,
+                gettext_noop("Sets the maximum memory of the system catalog cache of a session."),
+                gettext_noop("Beyond it, the cache entries not searched for a while are removed. "
+                    "Zero disables the limit."),
+                GUC_UNIT_KB
+            },
+            &u_sess->attr.attr_memory.local_syscache_threshold,
+            32768,
+            0,
+            MAX_KILOBYTES,
+            NULL,
+            NULL,
+            NULL
+        },
         {
             {
                 "bulk_write_ring_size",
@@ -8496,6 +8605,25 @@ static void init_configure_names_int()
             NULL,
             NULL
         },
+        {
+            {
+                "opfusion_batch_insert_size",
+                PGC_USERSET,
+                QUERY_TUNING_METHOD,
+                gettext_noop("Sets the maximum number of rows of consecutive Bind/Execute messages "
+                    "that a bypass insert buffers into one multi-insert."),
+                gettext_noop("0 or 1 inserts every row when its Execute message arrives. Inside a "
+                    "transaction block the rows are kept across Sync until another statement runs. "
+                    "Tables with unique or exclusion indexes are always inserted row by row.")
+            },
+            &u_sess->attr.attr_sql.opfusion_batch_insert_size,
+            0,
+            0,
+            10000,
+            NULL,
+            NULL,
+            NULL
+        },
         {
             {
                 "transaction_sync_naptime",
@@ -9462,6 +9590,22 @@ static void init_configure_names_real()
             NULL,
             NULL
         },
+        {
+            {
+                "cstore_compaction_dead_ratio",
+                PGC_USERSET,
+                CLIENT_CONN_STATEMENT,
+                gettext_noop("Minimum fraction of deleted rows of a CU for VACUUM to compact it."),
+                gettext_noop("0, the default, disables the compaction of CUs.")
+            },
+            &u_sess->attr.attr_storage.cstore_compaction_dead_ratio,
+            0.0,
+            0.0,
+            1.0,
+            NULL,
+            NULL,
+            NULL
+        },
         {
             {
                 "autovacuum_analyze_scale_factor",
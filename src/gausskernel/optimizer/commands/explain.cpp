@@ -173,6 +173,7 @@ static void show_storage_filter_info(PlanState* planstate, ExplainState* es);
 static void show_llvm_info(const PlanState* planstate, ExplainState* es);
 static void show_modifytable_merge_info(const PlanState* planstate, ExplainState* es);
 static void show_recursive_info(RecursiveUnionState* rustate, ExplainState* es);
+static void show_nestloop_adaptive_info(NestLoopState* nlstate, ExplainState* es);
 static const char* explain_get_index_name(Oid indexId);
 static void ExplainIndexScanDetails(Oid indexid, ScanDirection indexorderdir, ExplainState* es);
 static void ExplainScanTarget(Scan* plan, ExplainState* es);
@@ -2481,6 +2482,8 @@ static void ExplainNode(
                 show_instrumentation_count("Rows Removed by Filter", 2, planstate, es);
             show_llvm_info(planstate, es);
             show_skew_optimization(planstate, es);
+            if (IsA(planstate, NestLoopState))
+                show_nestloop_adaptive_info((NestLoopState*)planstate, es);
         } break;
         case T_VecMergeJoin:
         case T_MergeJoin: {
@@ -4883,6 +4886,51 @@ static void show_vechash_info(VecHashJoinState* hashstate, ExplainState* es)
     }
 }
 
+/*
+ * @Description: show whether an adaptive nestloop switched to hashing its inner side
+ * @in nlstate: NestLoopState node.
+ * @in es: Explain state.
+ */
+static void show_nestloop_adaptive_info(NestLoopState* nlstate, ExplainState* es)
+{
+    const char* decision = NULL;
+
+    if (!es->analyze || nlstate->js.ps.instrument == NULL)
+        return;
+
+    switch (nlstate->nl_AdaptiveMode) {
+        case NL_ADAPTIVE_HASHED:
+            decision = "Hash";
+            break;
+        case NL_ADAPTIVE_ABANDONED:
+            decision = "Nested Loop (inner side exceeds work_mem)";
+            break;
+        case NL_ADAPTIVE_WATCHING:
+            decision = "Nested Loop";
+            break;
+        default:
+            return;
+    }
+
+    if (es->format == EXPLAIN_FORMAT_TEXT) {
+        appendStringInfoSpaces(es->str, es->indent * 2);
+        if (nlstate->nl_AdaptiveMode == NL_ADAPTIVE_HASHED)
+            appendStringInfo(es->str,
+                "Adaptive Join: %s (switched after %ld outer rows, %ld inner rows hashed)\n",
+                decision,
+                nlstate->nl_SwitchOuterRows,
+                nlstate->nl_HashInnerRows);
+        else
+            appendStringInfo(es->str, "Adaptive Join: %s\n", decision);
+    } else {
+        ExplainPropertyText("Adaptive Join", decision, es);
+        if (nlstate->nl_AdaptiveMode == NL_ADAPTIVE_HASHED) {
+            ExplainPropertyLong("Adaptive Switch Outer Rows", nlstate->nl_SwitchOuterRows, es);
+            ExplainPropertyLong("Adaptive Hashed Inner Rows", nlstate->nl_HashInnerRows, es);
+        }
+    }
+}
+
 static void show_recursive_info(RecursiveUnionState* rustate, ExplainState* es)
 {
     PlanState* planstate = (PlanState*)rustate;
@@ -734,6 +734,11 @@ Oid DefineIndex(Oid relationId, IndexStmt* stmt, Oid indexRelationId, bool is_al
 
     (void)index_reloptions(amoptions, reloptions, true);
 
+    /* hash_index chooses the MOT index implementation, any other index would ignore it */
+    if (!isMOTFromTblOid(relationId)) {
+        ForbidToSetOptionsForNotMOTIndex(stmt->options);
+    }
+
     /*
      * Prepare arguments for index_create, primarily an IndexInfo structure.
      * Note that ii_Predicate must be in implicit-AND format.
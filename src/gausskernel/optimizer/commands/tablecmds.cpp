@@ -12538,6 +12538,8 @@ static void ATExecSetRelOptions(Relation rel, List* defList, AlterTableType oper
         }
         case RELKIND_INDEX:
         case RELKIND_GLOBAL_INDEX:
+            /* hash_index is only read when the index is created */
+            ForbidUserToAlterIndexOptions(defList);
             (void)index_reloptions(rel->rd_am->amoptions, newOptions, true);
             break;
         default:
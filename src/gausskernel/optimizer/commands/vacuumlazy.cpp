@@ -41,6 +41,7 @@
 
 #include "access/cstore_am.h"
 #include "access/cstore_insert.h"
+#include "access/cstore_rewrite.h"
 #include "access/genam.h"
 #include "access/heapam.h"
 #include "access/transam.h"
@@ -226,6 +227,8 @@ void lazy_vacuum_rel(Relation onerel, VacuumStmt* vacstmt, BufferAccessStrategy
             bulkload_rows batchRow(tupDesc, RelationGetMaxBatchRows(onerel), true);
 
             while ((deltaTup = heap_getnext(deltaScanDesc, ForwardScanDirection)) != NULL) {
+                /* honor the vacuum cost delay, autovacuum merges the delta of busy tables online */
+                vacuum_delay_point();
                 heap_deform_tuple(deltaTup, tupDesc, val, null);
 
                 /* ignore returned value because only one tuple is appended into */
@@ -252,6 +255,22 @@ void lazy_vacuum_rel(Relation onerel, VacuumStmt* vacstmt, BufferAccessStrategy
             cstoreInsert.Destroy();
         }
 
+        /*
+         * compact the CUs with many deleted rows, but not for the tables with
+         * indexes, whose entries would still point to the old CUs.
+         */
+        bool compacted = false;
+        Relation parentRel = RelationIsPartition(onerel) ? vacstmt->onepartrel : onerel;
+        if (RelationIsCUFormat(onerel) && u_sess->attr.attr_storage.cstore_compaction_dead_ratio > 0 &&
+            !parentRel->rd_rel->relhasindex) {
+            int64 reclaimedRows = CStoreCompactCUs(onerel, u_sess->attr.attr_storage.cstore_compaction_dead_ratio);
+            ereport((vacstmt->options & VACOPT_VERBOSE) ? VERBOSEMESSAGE : DEBUG2,
+                (errmsg("\"%s\": compacted CUs, %ld deleted rows reclaimed",
+                    RelationGetRelationName(onerel),
+                    reclaimedRows)));
+            compacted = true;
+        }
+
         /* clean part info before vacuum delta and desc table */
         vacstmt->onepartrel = NULL;
         vacstmt->onepart = NULL;
@@ -281,7 +300,9 @@ void lazy_vacuum_rel(Relation onerel, VacuumStmt* vacstmt, BufferAccessStrategy
         }
         heap_close(descRel, RowExclusiveLock);
 
-        pgstat_report_vacuum(RelationGetRelid(onerel), onerel->parentId, onerel->rd_rel->relisshared, 0);
+        /* the dead tuples are counted again from zero after the CUs are compacted */
+        pgstat_report_vacuum(
+            RelationGetRelid(onerel), onerel->parentId, onerel->rd_rel->relisshared, compacted ? -1 : 0);
         gstrace_exit(GS_TRC_ID_lazy_vacuum_rel);
         return;
     }
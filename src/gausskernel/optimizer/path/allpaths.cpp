@@ -2050,14 +2050,16 @@ static RelOptInfo* make_rel_from_joinlist(PlannerInfo* root, List* joinlist)
     } else {
         /*
          * Consider the different orders in which we could join the rels,
-         * using a plugin, GEQO, or the regular join search code.
+         * using DPhyp, GEQO, or the regular join search code.
          *
          * We put the initial_rels list into a PlannerInfo field because
          * has_legal_joinclause() needs to look at it (ugly :-().
          */
         root->initial_rels = initial_rels;
 
-        if (u_sess->attr.attr_sql.enable_geqo && levels_needed >= u_sess->attr.attr_sql.geqo_threshold)
+        if (u_sess->attr.attr_sql.enable_dphyp && levels_needed >= u_sess->attr.attr_sql.geqo_threshold)
+            return dphyp_join_search(root, levels_needed, initial_rels);
+        else if (u_sess->attr.attr_sql.enable_geqo && levels_needed >= u_sess->attr.attr_sql.geqo_threshold)
             return geqo(root, levels_needed, initial_rels);
         else
             return standard_join_search(root, levels_needed, initial_rels);
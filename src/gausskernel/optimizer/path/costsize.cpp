@@ -77,6 +77,7 @@
 #include "miscadmin.h"
 #include "nodes/nodeFuncs.h"
 #include "optimizer/bucketpruning.h"
+#include "optimizer/cardfeedback.h"
 #include "optimizer/clauses.h"
 #include "optimizer/cost.h"
 #include "optimizer/optimizerdebug.h"
@@ -4912,12 +4913,30 @@ double approx_tuple_count(PlannerInfo* root, JoinPath* path, List* quals)
 void set_baserel_size_estimates(PlannerInfo* root, RelOptInfo* rel)
 {
     double nrows;
+    Selectivity selec = 0.0;
+    bool has_feedback = false;
 
     /* Should only be applied to base relations */
     AssertEreport(
         rel->relid > 0, MOD_OPT, "The relid is invalid when set the size estimates for the given base relation.");
 
-    nrows = rel->tuples * clauselist_selectivity(root, rel->baserestrictinfo, 0, JOIN_INNER, NULL);
+    /*
+     * Prefer the selectivity observed by earlier executions of the same
+     * restriction list over the statistics based estimate.
+     */
+    if (u_sess->attr.attr_sql.enable_card_feedback && rel->baserestrictinfo != NIL && rel->rtekind == RTE_RELATION) {
+        RangeTblEntry* rte = planner_rt_fetch(rel->relid, root);
+
+        if (!rte->ispartrel) {
+            has_feedback = CardFeedbackLookup(rte->relid, rel->baserestrictinfo, &selec);
+        }
+    }
+
+    if (!has_feedback) {
+        selec = clauselist_selectivity(root, rel->baserestrictinfo, 0, JOIN_INNER, NULL);
+    }
+
+    nrows = rel->tuples * selec;
 
     rel->rows = clamp_row_est(nrows);
 
@@ -968,3 +968,523 @@ static bool restriction_is_constant_false(List* restrictlist, bool only_pushed_d
     return false;
 }
 
+
+/*
+ * DPhyp join enumeration
+ *
+ * For join problems of geqo_threshold or more items, dphyp_join_search
+ * replaces GEQO with an exhaustive dynamic-programming search that is
+ * driven by the join graph: only connected subgraph / connected complement
+ * pairs (csg-cmp pairs, as in Moerkotte and Neumann's DPccp/DPhyp) are
+ * considered, so clauseless joins are never costed unless the graph is
+ * disconnected.  Each jointree item is a node of the graph; two nodes are
+ * adjacent if they share a join clause or a join order restriction.
+ *
+ * The search is bounded by dphyp_mem_limit, checked against the memory
+ * actually allocated in its context: when the pair array is grown while the
+ * csg-cmp pairs are enumerated, and after every join rel built from them.
+ * Dense graphs overflow while their pairs are still being enumerated, before
+ * any join rel is built.  When the search doesn't fit, the join order is
+ * chosen by greedy operator ordering (GOO) instead, which is still
+ * deterministic, unlike GEQO.
+ */
+
+/* jointree items are tracked as bits of a uint64 */
+#define DPHYP_MAX_RELS 64
+
+#define DPHYP_BIT(i) (((uint64)1) << (i))
+
+/* all nodes numbered up to and including i, well defined for i = 63 too */
+#define DPHYP_PREFIX(i) (DPHYP_BIT(i) * 2 - 1)
+
+/* iterate the non-empty subsets of set in increasing order */
+#define dphyp_foreach_subset(subset, set) \
+    for ((subset) = (0 - (set)) & (set); (subset) != 0; (subset) = ((subset) - (set)) & (set))
+
+typedef struct DPhypPair {
+    uint64 left;  /* connected subgraph */
+    uint64 right; /* connected complement, adjacent to left */
+} DPhypPair;
+
+typedef struct DPhypEntry {
+    uint64 items;     /* hash key: set of jointree items */
+    RelOptInfo* rel;  /* rel built for the set */
+    bool finished;    /* set_cheapest already applied */
+} DPhypEntry;
+
+typedef struct DPhypContext {
+    PlannerInfo* root;
+    int nitems;
+    RelOptInfo** items;   /* the initial rels, indexed by graph node */
+    uint64* neighbors;    /* adjacency of each node */
+    DPhypPair* pairs;     /* csg-cmp pairs found so far */
+    int npairs;
+    int maxpairs;         /* allocated length of pairs */
+    MemoryContext mcxt;   /* context everything is allocated in */
+    int64 memlimit;       /* dphyp_mem_limit in bytes */
+    bool overflow;        /* budget exceeded, give up */
+} DPhypContext;
+
+static inline int dphyp_popcount(uint64 set)
+{
+    int count = 0;
+
+    while (set != 0) {
+        set &= set - 1;
+        count++;
+    }
+    return count;
+}
+
+static inline int dphyp_lowest(uint64 set)
+{
+    int i = 0;
+
+    Assert(set != 0);
+    while ((set & DPHYP_BIT(i)) == 0) {
+        i++;
+    }
+    return i;
+}
+
+static uint64 dphyp_neighborhood(DPhypContext* cxt, uint64 set, uint64 excluded)
+{
+    uint64 result = 0;
+
+    for (int i = 0; i < cxt->nitems; i++) {
+        if (set & DPHYP_BIT(i)) {
+            result |= cxt->neighbors[i];
+        }
+    }
+    return result & ~set & ~excluded;
+}
+
+/* Would allocating 'extra' more bytes exceed dphyp_mem_limit? */
+static inline bool dphyp_over_budget(DPhypContext* cxt, Size extra)
+{
+    AllocSetContext* set = (AllocSetContext*)cxt->mcxt;
+
+    return (int64)(set->totalSpace + extra) > cxt->memlimit;
+}
+
+static void dphyp_emit_pair(DPhypContext* cxt, uint64 left, uint64 right)
+{
+    if (cxt->npairs >= cxt->maxpairs) {
+        if (dphyp_over_budget(cxt, cxt->maxpairs * 2 * sizeof(DPhypPair))) {
+            cxt->overflow = true;
+            return;
+        }
+        cxt->maxpairs *= 2;
+        cxt->pairs = (DPhypPair*)repalloc(cxt->pairs, cxt->maxpairs * sizeof(DPhypPair));
+    }
+    cxt->pairs[cxt->npairs].left = left;
+    cxt->pairs[cxt->npairs].right = right;
+    cxt->npairs++;
+}
+
+/*
+ * Grow the complement 'right' of 'left' through its neighborhood, never
+ * touching the nodes in 'excluded'.
+ */
+static void dphyp_enumerate_cmp_rec(DPhypContext* cxt, uint64 left, uint64 right, uint64 excluded)
+{
+    uint64 neighbors = dphyp_neighborhood(cxt, right, excluded);
+    uint64 subset;
+
+    if (neighbors == 0 || cxt->overflow) {
+        return;
+    }
+
+    CHECK_FOR_INTERRUPTS();
+
+    dphyp_foreach_subset(subset, neighbors) {
+        dphyp_emit_pair(cxt, left, right | subset);
+    }
+    dphyp_foreach_subset(subset, neighbors) {
+        if (cxt->overflow) {
+            break;
+        }
+        dphyp_enumerate_cmp_rec(cxt, left, right | subset, excluded | neighbors);
+    }
+}
+
+/* Emit every csg-cmp pair whose connected subgraph is 'left'. */
+static void dphyp_emit_csg(DPhypContext* cxt, uint64 left)
+{
+    uint64 excluded = left | DPHYP_PREFIX(dphyp_lowest(left));
+    uint64 neighbors = dphyp_neighborhood(cxt, left, excluded);
+
+    for (int i = cxt->nitems - 1; i >= 0 && !cxt->overflow; i--) {
+        if ((neighbors & DPHYP_BIT(i)) == 0) {
+            continue;
+        }
+        dphyp_emit_pair(cxt, left, DPHYP_BIT(i));
+        dphyp_enumerate_cmp_rec(cxt, left, DPHYP_BIT(i), excluded | (neighbors & DPHYP_PREFIX(i)));
+    }
+}
+
+/* Grow the connected subgraph 'set' through its neighborhood. */
+static void dphyp_enumerate_csg_rec(DPhypContext* cxt, uint64 set, uint64 excluded)
+{
+    uint64 neighbors = dphyp_neighborhood(cxt, set, excluded);
+    uint64 subset;
+
+    if (neighbors == 0 || cxt->overflow) {
+        return;
+    }
+
+    CHECK_FOR_INTERRUPTS();
+
+    dphyp_foreach_subset(subset, neighbors) {
+        if (cxt->overflow) {
+            break;
+        }
+        dphyp_emit_csg(cxt, set | subset);
+    }
+    dphyp_foreach_subset(subset, neighbors) {
+        if (cxt->overflow) {
+            break;
+        }
+        dphyp_enumerate_csg_rec(cxt, set | subset, excluded | neighbors);
+    }
+}
+
+/*
+ * Build the join graph.  Disconnected components are linked through their
+ * smallest items, so that the unavoidable cartesian products are made
+ * between small inputs.
+ */
+static void dphyp_build_graph(DPhypContext* cxt)
+{
+    uint64 reached = 0;
+    int* representative = (int*)palloc(cxt->nitems * sizeof(int));
+    int ncomponents = 0;
+
+    for (int i = 0; i < cxt->nitems; i++) {
+        for (int j = i + 1; j < cxt->nitems; j++) {
+            RelOptInfo* rel1 = cxt->items[i];
+            RelOptInfo* rel2 = cxt->items[j];
+
+            if (have_relevant_joinclause(cxt->root, rel1, rel2) || have_join_order_restriction(cxt->root, rel1, rel2)) {
+                cxt->neighbors[i] |= DPHYP_BIT(j);
+                cxt->neighbors[j] |= DPHYP_BIT(i);
+            }
+        }
+    }
+
+    for (int i = 0; i < cxt->nitems; i++) {
+        uint64 component = DPHYP_BIT(i);
+        uint64 frontier;
+        int smallest = i;
+
+        if (reached & DPHYP_BIT(i)) {
+            continue;
+        }
+
+        while ((frontier = dphyp_neighborhood(cxt, component, 0)) != 0) {
+            component |= frontier;
+        }
+        for (int j = 0; j < cxt->nitems; j++) {
+            if ((component & DPHYP_BIT(j)) && cxt->items[j]->rows < cxt->items[smallest]->rows) {
+                smallest = j;
+            }
+        }
+        reached |= component;
+        representative[ncomponents++] = smallest;
+    }
+
+    for (int i = 0; i < ncomponents; i++) {
+        for (int j = i + 1; j < ncomponents; j++) {
+            cxt->neighbors[representative[i]] |= DPHYP_BIT(representative[j]);
+            cxt->neighbors[representative[j]] |= DPHYP_BIT(representative[i]);
+        }
+    }
+
+    pfree_ext(representative);
+}
+
+/*
+ * Order the pairs so that every join rel is complete before it is used as
+ * an input: by the size of the result, then by the sets themselves to keep
+ * the order independent of the enumeration.
+ */
+static int dphyp_pair_cmp(const void* a, const void* b)
+{
+    const DPhypPair* pa = (const DPhypPair*)a;
+    const DPhypPair* pb = (const DPhypPair*)b;
+    uint64 ua = pa->left | pa->right;
+    uint64 ub = pb->left | pb->right;
+    int sizea = dphyp_popcount(ua);
+    int sizeb = dphyp_popcount(ub);
+
+    if (sizea != sizeb) {
+        return (sizea < sizeb) ? -1 : 1;
+    }
+    if (ua != ub) {
+        return (ua < ub) ? -1 : 1;
+    }
+    if (pa->left != pb->left) {
+        return (pa->left < pb->left) ? -1 : 1;
+    }
+    return 0;
+}
+
+static RelOptInfo* dphyp_get_input(DPhypContext* cxt, HTAB* dptable, uint64 items)
+{
+    DPhypEntry* entry = (DPhypEntry*)hash_search(dptable, &items, HASH_FIND, NULL);
+
+    if (entry == NULL) {
+        return NULL;
+    }
+    if (!entry->finished) {
+        set_cheapest(entry->rel, cxt->root);
+        entry->finished = true;
+    }
+    return entry->rel;
+}
+
+/*
+ * Run the enumeration in the current memory context.  Returns NULL if the
+ * budget was exceeded or no valid join tree was found.
+ */
+static RelOptInfo* dphyp_search(DPhypContext* cxt)
+{
+    HTAB* dptable = NULL;
+    HASHCTL ctl;
+    DPhypEntry* entry = NULL;
+    RelOptInfo* result = NULL;
+    uint64 all_items = DPHYP_PREFIX(cxt->nitems - 1);
+    bool found = false;
+    errno_t rc;
+
+    dphyp_build_graph(cxt);
+
+    /* Phase 1: find the csg-cmp pairs, giving up early on dense graphs */
+    for (int i = cxt->nitems - 1; i >= 0 && !cxt->overflow; i--) {
+        dphyp_emit_csg(cxt, DPHYP_BIT(i));
+        dphyp_enumerate_csg_rec(cxt, DPHYP_BIT(i), DPHYP_PREFIX(i));
+    }
+    if (cxt->overflow) {
+        return NULL;
+    }
+
+    qsort(cxt->pairs, cxt->npairs, sizeof(DPhypPair), dphyp_pair_cmp);
+
+    /* Phase 2: build the join rels bottom-up */
+    rc = memset_s(&ctl, sizeof(ctl), 0, sizeof(ctl));
+    securec_check(rc, "\0", "\0");
+    ctl.keysize = sizeof(uint64);
+    ctl.entrysize = sizeof(DPhypEntry);
+    ctl.hcxt = CurrentMemoryContext;
+    dptable = hash_create("DPhyp join rels", cxt->npairs + cxt->nitems, &ctl, HASH_ELEM | HASH_BLOBS | HASH_CONTEXT);
+
+    for (int i = 0; i < cxt->nitems; i++) {
+        uint64 items = DPHYP_BIT(i);
+
+        entry = (DPhypEntry*)hash_search(dptable, &items, HASH_ENTER, &found);
+        entry->rel = cxt->items[i];
+        entry->finished = true;
+    }
+
+    for (int i = 0; i < cxt->npairs; i++) {
+        DPhypPair* pair = &cxt->pairs[i];
+        uint64 items = pair->left | pair->right;
+        RelOptInfo* rel1 = dphyp_get_input(cxt, dptable, pair->left);
+        RelOptInfo* rel2 = dphyp_get_input(cxt, dptable, pair->right);
+        RelOptInfo* joinrel = NULL;
+
+        /* one side could not be built, e.g. because of outer join order */
+        if (rel1 == NULL || rel2 == NULL) {
+            continue;
+        }
+
+        joinrel = make_join_rel(cxt->root, rel1, rel2);
+        if (joinrel != NULL) {
+            entry = (DPhypEntry*)hash_search(dptable, &items, HASH_ENTER, &found);
+            if (!found) {
+                entry->rel = joinrel;
+                entry->finished = false;
+            }
+        }
+
+        if (dphyp_over_budget(cxt, 0)) {
+            cxt->overflow = true;
+            hash_destroy(dptable);
+            return NULL;
+        }
+    }
+
+    result = dphyp_get_input(cxt, dptable, all_items);
+    hash_destroy(dptable);
+
+    return result;
+}
+
+/*
+ * Try joining rel1 and rel2 in a scratch context, the way geqo_eval does,
+ * and report the estimated size of the result.  Returns false if the join
+ * is not legal.
+ */
+static bool goo_evaluate(PlannerInfo* root, RelOptInfo* rel1, RelOptInfo* rel2, double* rows)
+{
+    MemoryContext mycontext;
+    MemoryContext oldcxt;
+    RelOptInfo* joinrel = NULL;
+    int savelength;
+    struct HTAB* savehash;
+
+    mycontext = AllocSetContextCreate(
+        CurrentMemoryContext, "GOO", ALLOCSET_DEFAULT_MINSIZE, ALLOCSET_DEFAULT_INITSIZE, ALLOCSET_DEFAULT_MAXSIZE);
+    oldcxt = MemoryContextSwitchTo(mycontext);
+
+    savelength = list_length(root->join_rel_list);
+    savehash = root->join_rel_hash;
+    root->join_rel_hash = NULL;
+
+    joinrel = make_join_rel(root, rel1, rel2);
+    if (joinrel != NULL) {
+        *rows = joinrel->rows;
+    }
+
+    root->join_rel_list = list_truncate(root->join_rel_list, savelength);
+    root->join_rel_hash = savehash;
+
+    (void)MemoryContextSwitchTo(oldcxt);
+    MemoryContextDelete(mycontext);
+
+    return joinrel != NULL;
+}
+
+/*
+ * goo_join_search
+ *	  Greedy operator ordering: repeatedly perform the legal join with the
+ *	  smallest estimated result, preferring joins that have a join clause or
+ *	  a join order restriction over cartesian products.
+ */
+static RelOptInfo* goo_join_search(PlannerInfo* root, List* initial_rels)
+{
+    List* clumps = list_copy(initial_rels);
+
+    while (list_length(clumps) > 1) {
+        RelOptInfo* best_outer = NULL;
+        RelOptInfo* best_inner = NULL;
+        RelOptInfo* joinrel = NULL;
+        double best_rows = 0;
+
+        for (int pass = 0; pass < 2 && best_outer == NULL; pass++) {
+            ListCell* lc1 = NULL;
+
+            foreach (lc1, clumps) {
+                RelOptInfo* rel1 = (RelOptInfo*)lfirst(lc1);
+                ListCell* lc2 = NULL;
+
+                for_each_cell(lc2, lnext(lc1)) {
+                    RelOptInfo* rel2 = (RelOptInfo*)lfirst(lc2);
+                    double rows = 0;
+
+                    if (pass == 0 && !have_relevant_joinclause(root, rel1, rel2) &&
+                        !have_join_order_restriction(root, rel1, rel2)) {
+                        continue;
+                    }
+                    if (goo_evaluate(root, rel1, rel2, &rows) && (best_outer == NULL || rows < best_rows)) {
+                        best_outer = rel1;
+                        best_inner = rel2;
+                        best_rows = rows;
+                    }
+                }
+            }
+        }
+
+        if (best_outer == NULL) {
+            ereport(ERROR,
+                (errmodule(MOD_OPT_JOIN),
+                    errcode(ERRCODE_OPTIMIZER_INCONSISTENT_STATE),
+                    errmsg("failed to join all relations together")));
+        }
+
+        joinrel = make_join_rel(root, best_outer, best_inner);
+        AssertEreport(joinrel != NULL, MOD_OPT_JOIN, "greedy join became illegal");
+        set_cheapest(joinrel, root);
+
+        clumps = list_delete_ptr(clumps, best_outer);
+        clumps = list_delete_ptr(clumps, best_inner);
+        clumps = lappend(clumps, joinrel);
+    }
+
+    return (RelOptInfo*)linitial(clumps);
+}
+
+/*
+ * dphyp_join_search
+ *	  Find the join order of a large join problem, see the comment above.
+ *	  Same interface as standard_join_search.
+ */
+RelOptInfo* dphyp_join_search(PlannerInfo* root, int levels_needed, List* initial_rels)
+{
+    MemoryContext mycontext;
+    MemoryContext oldcxt;
+    DPhypContext cxt;
+    RelOptInfo* result = NULL;
+    ListCell* lc = NULL;
+    int savelength;
+    struct HTAB* savehash;
+    int i = 0;
+
+    AssertEreport(root->join_rel_level == NULL, MOD_OPT_JOIN, "join_rel_level is in use");
+
+    if (levels_needed > DPHYP_MAX_RELS) {
+        return goo_join_search(root, initial_rels);
+    }
+
+    /*
+     * Everything the enumeration builds lives in its own context, so that it
+     * can be released at once if the search gives up.  As in geqo_eval,
+     * join_rel_list is truncated back and the outer join_rel_hash restored in
+     * that case.
+     */
+    mycontext = AllocSetContextCreate(
+        CurrentMemoryContext, "DPhyp", ALLOCSET_DEFAULT_MINSIZE, ALLOCSET_DEFAULT_INITSIZE, ALLOCSET_DEFAULT_MAXSIZE);
+    oldcxt = MemoryContextSwitchTo(mycontext);
+
+    savelength = list_length(root->join_rel_list);
+    savehash = root->join_rel_hash;
+    root->join_rel_hash = NULL;
+
+    cxt.root = root;
+    cxt.nitems = levels_needed;
+    cxt.items = (RelOptInfo**)palloc(levels_needed * sizeof(RelOptInfo*));
+    cxt.neighbors = (uint64*)palloc0(levels_needed * sizeof(uint64));
+    cxt.maxpairs = 1024;
+    cxt.pairs = (DPhypPair*)palloc(cxt.maxpairs * sizeof(DPhypPair));
+    cxt.npairs = 0;
+    cxt.mcxt = mycontext;
+    cxt.memlimit = (int64)u_sess->attr.attr_sql.dphyp_mem_limit * 1024L;
+    cxt.overflow = false;
+    foreach (lc, initial_rels) {
+        cxt.items[i++] = (RelOptInfo*)lfirst(lc);
+    }
+
+    result = dphyp_search(&cxt);
+
+    (void)MemoryContextSwitchTo(oldcxt);
+
+    if (result == NULL) {
+        ereport(DEBUG1,
+            (errmodule(MOD_OPT_JOIN),
+                errmsg("DPhyp join search of %d items gave up after %d pairs, using greedy join order",
+                    levels_needed, cxt.npairs)));
+
+        root->join_rel_list = list_truncate(root->join_rel_list, savelength);
+        root->join_rel_hash = savehash;
+        MemoryContextDelete(mycontext);
+
+        return goo_join_search(root, initial_rels);
+    }
+
+    /* the join rels stay, only the enumeration state goes */
+    pfree_ext(cxt.pairs);
+    pfree_ext(cxt.neighbors);
+    pfree_ext(cxt.items);
+
+    return result;
+}
@@ -2051,12 +2051,20 @@ static void min_max_optimization(PlannerInfo* root, CStoreScan* scan_plan)
 
     jtnode = parse->jointree;
 
-    if (!parse->hasAggs || jtnode->quals || list_length(jtnode->fromlist) != 1) {
+    if (!parse->hasAggs || list_length(jtnode->fromlist) != 1) {
         return;
     }
 
-    /* If query include groupClause, or whereClause etc, it can not be optimize. */
-    if (parse->groupClause || parse->hasWindowFuncs || parse->groupingSets || parse->havingQual || jtnode->quals) {
+    /* If query include groupClause, or havingClause etc, it can not be optimize. */
+    if (parse->groupClause || parse->hasWindowFuncs || parse->groupingSets || parse->havingQual) {
+        return;
+    }
+
+    /*
+     * The quals must all be pushed down as scan keys, so that the scan can tell
+     * the CUs whose rows all pass them, see CStore::RoughCheckAllMatch().
+     */
+    if (list_length(scan_plan->cstorequal) != list_length(scan_plan->plan.qual)) {
         return;
     }
 
@@ -2145,9 +2153,7 @@ static CStoreScan* create_cstorescan_plan(PlannerInfo* root, Path* best_path, Li
     scan_plan = make_cstorescan(tlist, scan_clauses, scan_relid);
 
     rte = planner_rt_fetch(scan_relid, root);
-    if (rte->tablesample == NULL) {
-        min_max_optimization(root, scan_plan);
-    } else {
+    if (rte->tablesample != NULL) {
         Assert(rte->rtekind == RTE_RELATION);
         scan_plan->tablesample = rte->tablesample;
     }
@@ -2174,6 +2180,10 @@ static CStoreScan* create_cstorescan_plan(PlannerInfo* root, Path* best_path, Li
     else
         scan_plan->cstorequal = NIL;
 
+    if (rte->tablesample == NULL) {
+        min_max_optimization(root, scan_plan);
+    }
+
     return scan_plan;
 }
 
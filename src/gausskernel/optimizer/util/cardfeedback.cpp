@@ -0,0 +1,745 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * cardfeedback.cpp
+ *	  Cardinality feedback store.
+ *
+ * At ExecutorEnd the row counts observed by base relation scans are folded
+ * into a bounded shared hash table keyed by (database, relation, predicate
+ * hash).  When enable_card_feedback is on, set_baserel_size_estimates picks
+ * the observed selectivity up instead of the clauselist_selectivity()
+ * estimate for a restriction list it has seen executed before.  The store
+ * is written to disk at every checkpoint and reloaded at startup.
+ *
+ * The predicate hash ignores range table indexes and clause order, so the
+ * same WHERE clause on the same table maps to the same entry across
+ * queries, while different constants map to different entries.
+ *
+ * IDENTIFICATION
+ *	  src/gausskernel/optimizer/util/cardfeedback.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+#include "postgres.h"
+#include "knl/knl_variable.h"
+
+#include "access/hash.h"
+#include "access/transam.h"
+#include "executor/execdesc.h"
+#include "executor/instrument.h"
+#include "funcapi.h"
+#include "miscadmin.h"
+#include "nodes/nodeFuncs.h"
+#include "nodes/relation.h"
+#include "optimizer/cardfeedback.h"
+#include "storage/copydir.h"
+#include "storage/fd.h"
+#include "storage/lwlock.h"
+#include "utils/builtins.h"
+#include "utils/hsearch.h"
+#include "utils/memutils.h"
+#include "utils/rel.h"
+
+#define CARD_FEEDBACK_FORMAT_ID 0x01CF0001
+#define CARD_FEEDBACK_TMPFILE CARD_FEEDBACK_FILENAME ".tmp"
+
+/*
+ * An observation only moves the stored selectivity by 1/weight of the
+ * difference once an entry has seen this many executions, so a single
+ * atypical run cannot flip a plan that has been stable for a while.
+ */
+#define CARD_FEEDBACK_MAX_WEIGHT 8
+
+#define CARD_FEEDBACK_ATTRNUM 8
+
+/* one scan node observation, gathered before taking the lock */
+typedef struct CardFeedbackSample {
+    Oid relid;
+    uint32 predhash;
+    double selectivity;
+    double est_rows;
+    double actual_rows;
+} CardFeedbackSample;
+
+typedef struct CardFeedbackHashContext {
+    uint32 hash;
+    bool usable; /* false if the clause references executor-time params */
+} CardFeedbackHashContext;
+
+static inline void card_feedback_mix(CardFeedbackHashContext* context, uint32 value)
+{
+    context->hash = DatumGetUInt32(hash_uint32(context->hash ^ value)) + (context->hash << 5);
+}
+
+static void card_feedback_mix_const(CardFeedbackHashContext* context, Const* con)
+{
+    card_feedback_mix(context, con->consttype);
+    card_feedback_mix(context, (uint32)con->constisnull);
+    if (con->constisnull) {
+        return;
+    }
+
+    if (con->constbyval) {
+        card_feedback_mix(context, DatumGetUInt32(hash_any((unsigned char*)&con->constvalue, sizeof(Datum))));
+    } else if (con->constlen == -1) {
+        struct varlena* val = PG_DETOAST_DATUM_PACKED(con->constvalue);
+
+        card_feedback_mix(
+            context, DatumGetUInt32(hash_any((unsigned char*)VARDATA_ANY(val), VARSIZE_ANY_EXHDR(val))));
+        if ((Pointer)val != DatumGetPointer(con->constvalue)) {
+            pfree(val);
+        }
+    } else if (con->constlen == -2) {
+        char* str = DatumGetCString(con->constvalue);
+
+        card_feedback_mix(context, DatumGetUInt32(hash_any((unsigned char*)str, strlen(str))));
+    } else {
+        card_feedback_mix(
+            context, DatumGetUInt32(hash_any((unsigned char*)DatumGetPointer(con->constvalue), con->constlen)));
+    }
+}
+
+/*
+ * Hash one restriction clause.  Only what determines the selectivity goes
+ * into the hash: node tags, operators, functions, column numbers, and
+ * constant values.  varno is left out on purpose, the planner sees the
+ * clause with the relation's range table index while the executor may see
+ * it after setrefs.
+ */
+static bool card_feedback_hash_walker(Node* node, CardFeedbackHashContext* context)
+{
+    if (node == NULL) {
+        return false;
+    }
+
+    card_feedback_mix(context, (uint32)nodeTag(node));
+
+    switch (nodeTag(node)) {
+        case T_Var: {
+            Var* var = (Var*)node;
+
+            card_feedback_mix(context, (uint32)var->varattno);
+            card_feedback_mix(context, var->vartype);
+            card_feedback_mix(context, var->varlevelsup);
+            return false;
+        }
+        case T_Const:
+            card_feedback_mix_const(context, (Const*)node);
+            return false;
+        case T_Param: {
+            Param* param = (Param*)node;
+
+            /* PARAM_EXEC values come from an outer plan, not a fixed predicate */
+            if (param->paramkind == PARAM_EXEC) {
+                context->usable = false;
+                return true;
+            }
+            card_feedback_mix(context, (uint32)param->paramkind);
+            card_feedback_mix(context, (uint32)param->paramid);
+            card_feedback_mix(context, param->paramtype);
+            return false;
+        }
+        case T_OpExpr:
+        case T_DistinctExpr:
+        case T_NullIfExpr:
+            card_feedback_mix(context, ((OpExpr*)node)->opno);
+            break;
+        case T_ScalarArrayOpExpr:
+            card_feedback_mix(context, ((ScalarArrayOpExpr*)node)->opno);
+            card_feedback_mix(context, (uint32)((ScalarArrayOpExpr*)node)->useOr);
+            break;
+        case T_FuncExpr:
+            card_feedback_mix(context, ((FuncExpr*)node)->funcid);
+            break;
+        case T_BoolExpr:
+            card_feedback_mix(context, (uint32)((BoolExpr*)node)->boolop);
+            break;
+        case T_NullTest:
+            card_feedback_mix(context, (uint32)((NullTest*)node)->nulltesttype);
+            break;
+        case T_BooleanTest:
+            card_feedback_mix(context, (uint32)((BooleanTest*)node)->booltesttype);
+            break;
+        case T_RelabelType:
+            card_feedback_mix(context, ((RelabelType*)node)->resulttype);
+            break;
+        case T_CoerceViaIO:
+            card_feedback_mix(context, ((CoerceViaIO*)node)->resulttype);
+            break;
+        default:
+            break;
+    }
+
+    return expression_tree_walker(node, (bool (*)())card_feedback_hash_walker, (void*)context);
+}
+
+static int card_feedback_cmp_uint32(const void* a, const void* b)
+{
+    uint32 va = *(const uint32*)a;
+    uint32 vb = *(const uint32*)b;
+
+    return (va > vb) ? 1 : ((va < vb) ? -1 : 0);
+}
+
+/*
+ * Compute an order-insensitive hash of a list of clauses, either bare
+ * expressions (executor) or RestrictInfos (planner).  Returns false if the
+ * list cannot serve as a feedback key.
+ */
+static bool card_feedback_hash_clauses(List* clauses, uint32* predhash)
+{
+    ListCell* lc = NULL;
+    uint32* hashes = NULL;
+    int nhashes = 0;
+    uint32 result = 0;
+
+    if (clauses == NIL) {
+        return false;
+    }
+
+    hashes = (uint32*)palloc(sizeof(uint32) * list_length(clauses));
+    foreach (lc, clauses) {
+        Node* clause = (Node*)lfirst(lc);
+        CardFeedbackHashContext context;
+
+        if (IsA(clause, RestrictInfo)) {
+            RestrictInfo* rinfo = (RestrictInfo*)clause;
+
+            /* gating quals end up in a Result node above the scan */
+            if (rinfo->pseudoconstant) {
+                continue;
+            }
+            clause = (Node*)rinfo->clause;
+        }
+
+        context.hash = 0;
+        context.usable = true;
+        (void)card_feedback_hash_walker(clause, &context);
+        if (!context.usable) {
+            pfree(hashes);
+            return false;
+        }
+        hashes[nhashes++] = context.hash;
+    }
+
+    if (nhashes == 0) {
+        pfree(hashes);
+        return false;
+    }
+
+    qsort(hashes, nhashes, sizeof(uint32), card_feedback_cmp_uint32);
+    for (int i = 0; i < nhashes; i++) {
+        result = DatumGetUInt32(hash_uint32(result ^ hashes[i])) + (result << 5);
+    }
+    pfree(hashes);
+
+    *predhash = result;
+    return true;
+}
+
+/*
+ * Evict the entry that was refreshed least recently.  Caller holds
+ * CardFeedbackLock exclusively.
+ */
+static void card_feedback_evict_oldest(HTAB* htab)
+{
+    HASH_SEQ_STATUS status;
+    CardFeedbackEntry* entry = NULL;
+    CardFeedbackKey victim;
+    TimestampTz oldest = 0;
+    bool found = false;
+
+    hash_seq_init(&status, htab);
+    while ((entry = (CardFeedbackEntry*)hash_seq_search(&status)) != NULL) {
+        if (!found || entry->last_update < oldest) {
+            victim = entry->key;
+            oldest = entry->last_update;
+            found = true;
+        }
+    }
+
+    if (found) {
+        (void)hash_search(htab, &victim, HASH_REMOVE, NULL);
+    }
+}
+
+/* Insert or refresh an entry.  Caller holds CardFeedbackLock exclusively. */
+static void card_feedback_store(HTAB* htab, const CardFeedbackSample* sample, TimestampTz now)
+{
+    CardFeedbackKey key;
+    CardFeedbackEntry* entry = NULL;
+    bool found = false;
+
+    key.dbid = u_sess->proc_cxt.MyDatabaseId;
+    key.relid = sample->relid;
+    key.predhash = sample->predhash;
+
+    entry = (CardFeedbackEntry*)hash_search(htab, &key, HASH_FIND, NULL);
+    if (entry == NULL) {
+        if (hash_get_num_entries(htab) >= CARD_FEEDBACK_MAX_ENTRIES) {
+            card_feedback_evict_oldest(htab);
+        }
+        entry = (CardFeedbackEntry*)hash_search(htab, &key, HASH_ENTER_NULL, &found);
+        if (entry == NULL) {
+            return;
+        }
+        entry->selectivity = sample->selectivity;
+        entry->nsamples = 0;
+    } else {
+        int64 weight = Min(entry->nsamples + 1, CARD_FEEDBACK_MAX_WEIGHT);
+
+        entry->selectivity += (sample->selectivity - entry->selectivity) / weight;
+    }
+
+    entry->est_rows = sample->est_rows;
+    entry->actual_rows = sample->actual_rows;
+    entry->nsamples++;
+    entry->last_update = now;
+}
+
+/*
+ * Turn one executed scan node into a sample.  Only plain heap scans whose
+ * quals are known to the planner as baserestrictinfo are considered.
+ */
+static void card_feedback_sample_scan(PlanState* planstate, List** samples)
+{
+    Plan* plan = planstate->plan;
+    Scan* scan = (Scan*)plan;
+    Instrumentation* instr = planstate->instrument;
+    Relation rel = ((ScanState*)planstate)->ss_currentRelation;
+    List* quals = NIL;
+    double nloops;
+    double rows;
+    double selectivity;
+    uint32 predhash;
+    CardFeedbackSample* sample = NULL;
+
+    if (instr == NULL || rel == NULL || scan->isPartTbl) {
+        return;
+    }
+
+    switch (nodeTag(plan)) {
+        case T_SeqScan:
+            if (((SeqScan*)plan)->tablesample != NULL) {
+                return;
+            }
+            quals = plan->qual;
+            break;
+        case T_IndexScan:
+            if (((IndexScan*)plan)->usecstoreindex) {
+                return;
+            }
+            quals = list_concat(list_copy(((IndexScan*)plan)->indexqualorig), plan->qual);
+            break;
+        case T_BitmapHeapScan:
+            quals = list_concat(list_copy(((BitmapHeapScan*)plan)->bitmapqualorig), plan->qual);
+            break;
+        default:
+            return;
+    }
+
+    if (RelationGetRelid(rel) < FirstNormalObjectId || !card_feedback_hash_clauses(quals, &predhash)) {
+        return;
+    }
+
+    nloops = instr->nloops + (instr->running ? 1 : 0);
+    rows = instr->ntuples + instr->tuplecount;
+    if (nloops <= 0) {
+        return;
+    }
+
+    if (IsA(plan, SeqScan)) {
+        double scanned = rows + instr->nfiltered1;
+
+        if (scanned <= 0) {
+            return;
+        }
+        selectivity = rows / scanned;
+    } else {
+        double reltuples = rel->rd_rel->reltuples;
+
+        if (reltuples <= 0) {
+            return;
+        }
+        selectivity = rows / nloops / reltuples;
+    }
+
+    sample = (CardFeedbackSample*)palloc(sizeof(CardFeedbackSample));
+    sample->relid = RelationGetRelid(rel);
+    sample->predhash = predhash;
+    sample->selectivity = Min(selectivity, 1.0);
+    sample->est_rows = plan->plan_rows;
+    sample->actual_rows = rows / nloops;
+    *samples = lappend(*samples, sample);
+}
+
+/*
+ * Walk the executed plan state tree.  Scans below a Limit are skipped since
+ * they may have been stopped before seeing their whole input.
+ */
+static void card_feedback_walk(PlanState* planstate, bool under_limit, List** samples)
+{
+    ListCell* lc = NULL;
+
+    if (planstate == NULL) {
+        return;
+    }
+
+    if (IsA(planstate, LimitState)) {
+        under_limit = true;
+    }
+
+    if (!under_limit) {
+        card_feedback_sample_scan(planstate, samples);
+    }
+
+    foreach (lc, planstate->initPlan) {
+        card_feedback_walk(((SubPlanState*)lfirst(lc))->planstate, under_limit, samples);
+    }
+    foreach (lc, planstate->subPlan) {
+        card_feedback_walk(((SubPlanState*)lfirst(lc))->planstate, under_limit, samples);
+    }
+
+    switch (nodeTag(planstate)) {
+        case T_AppendState: {
+            AppendState* append = (AppendState*)planstate;
+
+            for (int i = 0; i < append->as_nplans; i++) {
+                card_feedback_walk(append->appendplans[i], under_limit, samples);
+            }
+        } break;
+        case T_MergeAppendState: {
+            MergeAppendState* ma = (MergeAppendState*)planstate;
+
+            for (int i = 0; i < ma->ms_nplans; i++) {
+                card_feedback_walk(ma->mergeplans[i], under_limit, samples);
+            }
+        } break;
+        case T_ModifyTableState: {
+            ModifyTableState* mt = (ModifyTableState*)planstate;
+
+            for (int i = 0; i < mt->mt_nplans; i++) {
+                card_feedback_walk(mt->mt_plans[i], under_limit, samples);
+            }
+        } break;
+        case T_SubqueryScanState:
+            card_feedback_walk(((SubqueryScanState*)planstate)->subplan, under_limit, samples);
+            break;
+        default:
+            break;
+    }
+
+    card_feedback_walk(planstate->lefttree, under_limit, samples);
+    card_feedback_walk(planstate->righttree, under_limit, samples);
+}
+
+/*
+ * CardFeedbackCollect
+ *	  Fold the row counts of a finished query into the feedback store.
+ *	  Called from standard_ExecutorEnd before the plan state is released.
+ */
+void CardFeedbackCollect(QueryDesc* queryDesc)
+{
+    EState* estate = queryDesc->estate;
+    HTAB* htab = g_instance.cost_cxt.card_feedback_hashtbl;
+    List* samples = NIL;
+    ListCell* lc = NULL;
+    TimestampTz now;
+
+    if (htab == NULL || queryDesc->planstate == NULL || !(estate->es_instrument & INSTRUMENT_ROWS) ||
+        (estate->es_top_eflags & EXEC_FLAG_EXPLAIN_ONLY) || !estate->es_finished) {
+        return;
+    }
+
+    card_feedback_walk(queryDesc->planstate, false, &samples);
+    if (samples == NIL) {
+        return;
+    }
+
+    now = GetCurrentTimestamp();
+    (void)LWLockAcquire(CardFeedbackLock, LW_EXCLUSIVE);
+    foreach (lc, samples) {
+        card_feedback_store(htab, (CardFeedbackSample*)lfirst(lc), now);
+    }
+    LWLockRelease(CardFeedbackLock);
+
+    list_free_deep(samples);
+}
+
+/*
+ * CardFeedbackLookup
+ *	  Look up the observed selectivity of a restriction list on relid.
+ *	  Returns false if the combination has never been executed.
+ */
+bool CardFeedbackLookup(Oid relid, List* restrictinfo, Selectivity* selec)
+{
+    HTAB* htab = g_instance.cost_cxt.card_feedback_hashtbl;
+    CardFeedbackKey key;
+    CardFeedbackEntry* entry = NULL;
+    bool found = false;
+
+    if (htab == NULL || relid < FirstNormalObjectId) {
+        return false;
+    }
+
+    key.dbid = u_sess->proc_cxt.MyDatabaseId;
+    key.relid = relid;
+    if (!card_feedback_hash_clauses(restrictinfo, &key.predhash)) {
+        return false;
+    }
+
+    (void)LWLockAcquire(CardFeedbackLock, LW_SHARED);
+    entry = (CardFeedbackEntry*)hash_search(htab, &key, HASH_FIND, NULL);
+    if (entry != NULL && entry->nsamples > 0) {
+        *selec = entry->selectivity;
+        found = true;
+    }
+    LWLockRelease(CardFeedbackLock);
+
+    return found;
+}
+
+/* Load the entries saved by the last checkpoint, if any. */
+static void card_feedback_load(HTAB* htab)
+{
+    FILE* fpin = NULL;
+    int32 format_id = 0;
+    CardFeedbackEntry buf;
+
+    if ((fpin = AllocateFile(CARD_FEEDBACK_FILENAME, PG_BINARY_R)) == NULL) {
+        if (errno != ENOENT) {
+            ereport(LOG, (errcode_for_file_access(),
+                errmsg("could not open cardinality feedback file \"%s\": %m", CARD_FEEDBACK_FILENAME)));
+        }
+        return;
+    }
+
+    if (fread(&format_id, sizeof(format_id), 1, fpin) != 1 || format_id != CARD_FEEDBACK_FORMAT_ID) {
+        ereport(LOG, (errmsg("corrupted cardinality feedback file \"%s\"", CARD_FEEDBACK_FILENAME)));
+        (void)FreeFile(fpin);
+        return;
+    }
+
+    while (fgetc(fpin) == 'F') {
+        CardFeedbackEntry* entry = NULL;
+        bool found = false;
+
+        if (fread(&buf, sizeof(CardFeedbackEntry), 1, fpin) != 1) {
+            ereport(LOG, (errmsg("corrupted cardinality feedback file \"%s\"", CARD_FEEDBACK_FILENAME)));
+            break;
+        }
+        if (hash_get_num_entries(htab) >= CARD_FEEDBACK_MAX_ENTRIES) {
+            break;
+        }
+        entry = (CardFeedbackEntry*)hash_search(htab, &buf.key, HASH_ENTER_NULL, &found);
+        if (entry == NULL) {
+            break;
+        }
+        *entry = buf;
+    }
+
+    (void)FreeFile(fpin);
+}
+
+/*
+ * InitCardFeedback
+ *	  Create the shared feedback store and load the saved entries.
+ *	  Called once by the postmaster.
+ */
+void InitCardFeedback(void)
+{
+    HASHCTL ctl;
+    errno_t rc;
+
+    g_instance.cost_cxt.card_feedback_context = AllocSetContextCreate(g_instance.instance_context,
+        "CardFeedbackContext",
+        ALLOCSET_DEFAULT_MINSIZE,
+        ALLOCSET_DEFAULT_INITSIZE,
+        ALLOCSET_DEFAULT_MAXSIZE,
+        SHARED_CONTEXT);
+
+    rc = memset_s(&ctl, sizeof(ctl), 0, sizeof(ctl));
+    securec_check_c(rc, "\0", "\0");
+
+    ctl.hcxt = g_instance.cost_cxt.card_feedback_context;
+    ctl.keysize = sizeof(CardFeedbackKey);
+    ctl.entrysize = sizeof(CardFeedbackEntry);
+    ctl.hash = tag_hash;
+
+    g_instance.cost_cxt.card_feedback_hashtbl = hash_create("cardinality feedback hash table",
+        CARD_FEEDBACK_MAX_ENTRIES,
+        &ctl,
+        HASH_ELEM | HASH_SHRCTX | HASH_FUNCTION | HASH_NOEXCEPT);
+
+    card_feedback_load(g_instance.cost_cxt.card_feedback_hashtbl);
+}
+
+/*
+ * CheckPointCardFeedback
+ *	  Write the feedback store to disk so it survives a restart.
+ */
+void CheckPointCardFeedback(void)
+{
+    HTAB* htab = g_instance.cost_cxt.card_feedback_hashtbl;
+    HASH_SEQ_STATUS status;
+    CardFeedbackEntry* entry = NULL;
+    CardFeedbackEntry* entries = NULL;
+    long nentries = 0;
+    FILE* fpout = NULL;
+    int32 format_id = CARD_FEEDBACK_FORMAT_ID;
+
+    if (htab == NULL) {
+        return;
+    }
+
+    /* copy the entries out so the lock is not held across file I/O */
+    (void)LWLockAcquire(CardFeedbackLock, LW_SHARED);
+    entries = (CardFeedbackEntry*)palloc(sizeof(CardFeedbackEntry) * (hash_get_num_entries(htab) + 1));
+    hash_seq_init(&status, htab);
+    while ((entry = (CardFeedbackEntry*)hash_seq_search(&status)) != NULL) {
+        entries[nentries++] = *entry;
+    }
+    LWLockRelease(CardFeedbackLock);
+
+    fpout = AllocateFile(CARD_FEEDBACK_TMPFILE, PG_BINARY_W);
+    if (fpout == NULL) {
+        ereport(LOG, (errcode_for_file_access(),
+            errmsg("could not open temporary cardinality feedback file \"%s\": %m", CARD_FEEDBACK_TMPFILE)));
+        pfree(entries);
+        return;
+    }
+
+    (void)fwrite(&format_id, sizeof(format_id), 1, fpout);
+    for (long i = 0; i < nentries; i++) {
+        fputc('F', fpout);
+        (void)fwrite(&entries[i], sizeof(CardFeedbackEntry), 1, fpout);
+    }
+    fputc('E', fpout);
+    pfree(entries);
+
+    if (ferror(fpout)) {
+        ereport(LOG, (errcode_for_file_access(),
+            errmsg("could not write temporary cardinality feedback file \"%s\": %m", CARD_FEEDBACK_TMPFILE)));
+        (void)FreeFile(fpout);
+        (void)unlink(CARD_FEEDBACK_TMPFILE);
+    } else if (FreeFile(fpout) < 0) {
+        ereport(LOG, (errcode_for_file_access(),
+            errmsg("could not close temporary cardinality feedback file \"%s\": %m", CARD_FEEDBACK_TMPFILE)));
+        (void)unlink(CARD_FEEDBACK_TMPFILE);
+    } else if (durable_rename(CARD_FEEDBACK_TMPFILE, CARD_FEEDBACK_FILENAME, LOG) != 0) {
+        (void)unlink(CARD_FEEDBACK_TMPFILE);
+    }
+}
+
+/*
+ * gs_get_card_feedback
+ *	  Return the content of the cardinality feedback store.
+ */
+Datum gs_get_card_feedback(PG_FUNCTION_ARGS)
+{
+    FuncCallContext* funcctx = NULL;
+    CardFeedbackEntry* entries = NULL;
+
+    if (SRF_IS_FIRSTCALL()) {
+        MemoryContext oldcontext;
+        TupleDesc tupdesc;
+        HTAB* htab = g_instance.cost_cxt.card_feedback_hashtbl;
+        long nentries = 0;
+
+        funcctx = SRF_FIRSTCALL_INIT();
+        oldcontext = MemoryContextSwitchTo(funcctx->multi_call_memory_ctx);
+
+        tupdesc = CreateTemplateTupleDesc(CARD_FEEDBACK_ATTRNUM, false);
+        TupleDescInitEntry(tupdesc, (AttrNumber)1, "dbid", OIDOID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber)2, "relid", OIDOID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber)3, "predicate_hash", INT8OID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber)4, "selectivity", FLOAT8OID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber)5, "est_rows", FLOAT8OID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber)6, "actual_rows", FLOAT8OID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber)7, "samples", INT8OID, -1, 0);
+        TupleDescInitEntry(tupdesc, (AttrNumber)8, "last_update", TIMESTAMPTZOID, -1, 0);
+        funcctx->tuple_desc = BlessTupleDesc(tupdesc);
+
+        if (htab != NULL) {
+            HASH_SEQ_STATUS status;
+            CardFeedbackEntry* entry = NULL;
+
+            (void)LWLockAcquire(CardFeedbackLock, LW_SHARED);
+            entries = (CardFeedbackEntry*)palloc(sizeof(CardFeedbackEntry) * (hash_get_num_entries(htab) + 1));
+            hash_seq_init(&status, htab);
+            while ((entry = (CardFeedbackEntry*)hash_seq_search(&status)) != NULL) {
+                entries[nentries++] = *entry;
+            }
+            LWLockRelease(CardFeedbackLock);
+        }
+
+        funcctx->user_fctx = entries;
+        funcctx->max_calls = nentries;
+        (void)MemoryContextSwitchTo(oldcontext);
+    }
+
+    funcctx = SRF_PERCALL_SETUP();
+    entries = (CardFeedbackEntry*)funcctx->user_fctx;
+
+    if (funcctx->call_cntr < funcctx->max_calls) {
+        CardFeedbackEntry* entry = &entries[funcctx->call_cntr];
+        Datum values[CARD_FEEDBACK_ATTRNUM];
+        bool nulls[CARD_FEEDBACK_ATTRNUM] = {false};
+        HeapTuple tuple;
+
+        values[0] = ObjectIdGetDatum(entry->key.dbid);
+        values[1] = ObjectIdGetDatum(entry->key.relid);
+        values[2] = Int64GetDatum((int64)entry->key.predhash);
+        values[3] = Float8GetDatum(entry->selectivity);
+        values[4] = Float8GetDatum(entry->est_rows);
+        values[5] = Float8GetDatum(entry->actual_rows);
+        values[6] = Int64GetDatum(entry->nsamples);
+        values[7] = TimestampTzGetDatum(entry->last_update);
+
+        tuple = heap_form_tuple(funcctx->tuple_desc, values, nulls);
+        SRF_RETURN_NEXT(funcctx, HeapTupleGetDatum(tuple));
+    }
+
+    SRF_RETURN_DONE(funcctx);
+}
+
+/*
+ * gs_reset_card_feedback
+ *	  Discard every entry of the cardinality feedback store.
+ */
+Datum gs_reset_card_feedback(PG_FUNCTION_ARGS)
+{
+    HTAB* htab = g_instance.cost_cxt.card_feedback_hashtbl;
+    HASH_SEQ_STATUS status;
+    CardFeedbackEntry* entry = NULL;
+
+    if (!superuser()) {
+        ereport(ERROR,
+            (errcode(ERRCODE_INSUFFICIENT_PRIVILEGE), (errmsg("only system admin can reset cardinality feedback"))));
+    }
+
+    if (htab == NULL) {
+        PG_RETURN_BOOL(false);
+    }
+
+    (void)LWLockAcquire(CardFeedbackLock, LW_EXCLUSIVE);
+    hash_seq_init(&status, htab);
+    while ((entry = (CardFeedbackEntry*)hash_seq_search(&status)) != NULL) {
+        (void)hash_search(htab, &entry->key, HASH_REMOVE, NULL);
+    }
+    LWLockRelease(CardFeedbackLock);
+
+    PG_RETURN_BOOL(true);
+}
@@ -1029,6 +1029,16 @@ OperatorPlanInfo* ExtractOperatorPlanInfo(PlanState* result_plan, PlannedStmt* p
     char* options = NULL;
     Plan* node = result_plan->plan;
     PHGetPlanNodeText(node, &operation, &isRow, &strategy, &options);
+
+    /*
+     * An adaptive nestloop that switched at runtime actually ran as a hash
+     * join, record the executed strategy so the model learns from it.
+     */
+    if (IsA(result_plan, NestLoopState) && ((NestLoopState*)result_plan)->nl_AdaptiveMode == NL_ADAPTIVE_HASHED) {
+        pfree_ext(strategy);
+        strategy = pstrdup(TEXT_STRATEGY_JOIN_HASH);
+    }
+
     if (isRow == false) {
         orientation = pstrdup("COL");
     } else {
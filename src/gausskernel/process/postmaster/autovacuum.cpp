@@ -293,6 +293,10 @@ static void relation_needs_vacanalyze(Oid relid, AutoVacOpts* relopts, Form_pg_c
     PgStat_StatTabEntry* tabentry, bool allowAnalyze, bool allowVacuum, bool is_recheck, bool* dovacuum,
     bool* doanalyze, bool* need_freeze);
 
+static bool cstore_delta_needs_merge(Oid deltaRelid, bytea* reloptions, const char* relname);
+static bool cstore_needs_compaction(bytea* reloptions, bool hasIndex, PgStat_StatTabEntry* tabentry,
+    int vac_base_thresh, float4 vac_scale_factor, const char* relname);
+
 static void autovacuum_do_vac_analyze(autovac_table* tab, BufferAccessStrategy bstrategy);
 static void autovacuum_local_vac_analyze(autovac_table* tab, BufferAccessStrategy bstrategy);
 
@@ -3193,6 +3197,24 @@ static void relation_needs_vacanalyze(Oid relid, AutoVacOpts* relopts, Form_pg_c
             *doanalyze = ((float4)anltuples > anlthresh);
     }
 
+    /*
+     * vacuum of a column table merges its delta table into CUs, and compacts the
+     * CUs with many deleted rows. do it as soon as the delta table can fill a whole
+     * CU, or enough rows are deleted. partitions are checked one by one.
+     */
+    if (!*dovacuum && OidIsValid(classForm->reldeltarelid) && !isPartitionedRelation(classForm)) {
+        bytea* reloptions = extractRelOptions(tuple, GetDefaultPgClassDesc(), InvalidOid);
+        *dovacuum = cstore_delta_needs_merge(classForm->reldeltarelid, reloptions, NameStr(classForm->relname)) ||
+                    cstore_needs_compaction(reloptions,
+                        classForm->relhasindex,
+                        tabentry,
+                        vac_base_thresh,
+                        vac_scale_factor,
+                        NameStr(classForm->relname));
+        if (reloptions != NULL)
+            pfree_ext(reloptions);
+    }
+
     if (*dovacuum || *doanalyze) {
         AUTOVAC_LOG(DEBUG2,
             "vac \"%s\": recheck = %s need_freeze = %s "
@@ -3210,6 +3232,75 @@ static void relation_needs_vacanalyze(Oid relid, AutoVacOpts* relopts, Form_pg_c
     }
 }
 
+/*
+ * cstore_delta_needs_merge
+ *
+ * Check whether the delta table of a column table (or partition) holds at least
+ * max_batch_rows live tuples, that is enough to form a full CU. Vacuum then moves
+ * them into CUs sorted by the partial cluster key, with the usual autovacuum cost
+ * delay, so a small-batch load workload doesn't leave the scans reading an ever
+ * growing row-store delta.
+ */
+static bool cstore_delta_needs_merge(Oid deltaRelid, bytea* reloptions, const char* relname)
+{
+    PgStat_StatTabKey tabkey;
+    PgStat_StatTabEntry* tabentry = NULL;
+    int maxBatchRows = RelDefaultFullCuSize;
+
+    if (!u_sess->attr.attr_storage.autovacuum_merge_cstore_delta || !DO_VACUUM)
+        return false;
+
+    /* only CU format tables, the delta of a HDFS table is merged by its own way */
+    if (reloptions == NULL || !StdRelOptIsColStore(reloptions))
+        return false;
+    maxBatchRows = RelRoundIntOption(((StdRdOptions*)reloptions)->max_batch_rows, BatchMaxSize);
+
+    tabkey.statFlag = InvalidOid;
+    tabkey.tableid = deltaRelid;
+    tabentry = pgstat_fetch_stat_tabentry(&tabkey);
+    if (tabentry == NULL || tabentry->n_live_tuples < maxBatchRows)
+        return false;
+
+    AUTOVAC_LOG(DEBUG2,
+        "vac \"%s\": merge delta table %u (live tuples %ld merge threshold %d)",
+        relname,
+        deltaRelid,
+        tabentry->n_live_tuples,
+        maxBatchRows);
+    return true;
+}
+
+/*
+ * cstore_needs_compaction
+ *
+ * Check whether enough rows of a column table (or partition) are deleted for
+ * vacuum to compact its CUs, using the usual vacuum threshold. The tables with
+ * indexes are never compacted, see lazy_vacuum_rel().
+ */
+static bool cstore_needs_compaction(bytea* reloptions, bool hasIndex, PgStat_StatTabEntry* tabentry,
+    int vac_base_thresh, float4 vac_scale_factor, const char* relname)
+{
+    float4 vacthresh;
+
+    if (u_sess->attr.attr_storage.cstore_compaction_dead_ratio <= 0 || !DO_VACUUM || hasIndex || tabentry == NULL)
+        return false;
+
+    if (reloptions == NULL || !StdRelOptIsColStore(reloptions))
+        return false;
+
+    /* reltuples is not kept for partitions, so use the live tuples for both */
+    vacthresh = (float4)vac_base_thresh + vac_scale_factor * tabentry->n_live_tuples;
+    if ((float4)tabentry->n_dead_tuples <= vacthresh)
+        return false;
+
+    AUTOVAC_LOG(DEBUG2,
+        "vac \"%s\": compact CUs (deleted tuples %ld compaction threshold %.0f)",
+        relname,
+        tabentry->n_dead_tuples,
+        vacthresh);
+    return true;
+}
+
 /*
  * fill_in_vac_stmt
  *
@@ -3537,8 +3628,10 @@ static void partition_needs_vacanalyze(Oid partid, AutoVacOpts* relopts, Form_pg
 
     bool isNull = false;
     TransactionId relfrozenxid = InvalidTransactionId;
+    bool relOptIsNull = false;
     Relation rel = heap_open(PartitionRelationId, AccessShareLock);
     Datum xid64datum = heap_getattr(partTuple, Anum_pg_partition_relfrozenxid64, RelationGetDescr(rel), &isNull);
+    Datum relOptDatum = heap_getattr(partTuple, Anum_pg_partition_reloptions, RelationGetDescr(rel), &relOptIsNull);
     heap_close(rel, AccessShareLock);
 
     if (isNull) {
@@ -3562,6 +3655,29 @@ static void partition_needs_vacanalyze(Oid partid, AutoVacOpts* relopts, Form_pg
         return;
     }
 
+    /* merge the delta table and compact the CUs of a column partition, see relation_needs_vacanalyze() */
+    if (!force_vacuum && OidIsValid(partForm->reldeltarelid) && !ap_entry->at_dovacuum) {
+        bytea* reloptions = relOptIsNull ? NULL : heap_reloptions(RELKIND_RELATION, relOptDatum, false);
+        bool hasIndex = false;
+        HeapTuple parentTup = SearchSysCache1(RELOID, ObjectIdGetDatum(partForm->parentid));
+        if (HeapTupleIsValid(parentTup)) {
+            hasIndex = ((Form_pg_class)GETSTRUCT(parentTup))->relhasindex;
+            ReleaseSysCache(parentTup);
+        }
+
+        *doanalyze = false;
+        *dovacuum = cstore_delta_needs_merge(partForm->reldeltarelid, reloptions, NameStr(partForm->relname)) ||
+                    cstore_needs_compaction(reloptions,
+                        hasIndex,
+                        tabentry,
+                        vac_base_thresh,
+                        vac_scale_factor,
+                        NameStr(partForm->relname));
+        if (reloptions != NULL)
+            pfree_ext(reloptions);
+        return;
+    }
+
     if (!force_vacuum && (!ap_entry->at_allowvacuum || ap_entry->at_dovacuum)) {
         *doanalyze = false;
         *dovacuum = false;
@@ -90,6 +90,7 @@
 #include "instruments/instr_user.h"
 #include "instruments/percentile.h"
 #include "opfusion/opfusion_util.h"
+#include "optimizer/cardfeedback.h"
 
 #include "lib/dllist.h"
 #include "libpq/auth.h"
@@ -2162,6 +2163,8 @@ int PostmasterMain(int argc, char* argv[])
         SHARED_CONTEXT);
     /* init unique sql */
     InitUniqueSQL();
+    /* init cardinality feedback store */
+    InitCardFeedback();
     /* init instr user */
     InitInstrUser();
     /* init Opfusion function id */
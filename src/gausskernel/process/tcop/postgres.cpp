@@ -3835,6 +3835,12 @@ void exec_bind_message(StringInfo input_message)
 
     Assert(NULL != psrc);
 
+    /* rows buffered by another bypass insert must be in the heap before this statement runs */
+    if (u_sess->exec_cxt.PendingBatchOpFusionObj != NULL &&
+        u_sess->exec_cxt.PendingBatchOpFusionObj != (OpFusion*)psrc->opFusionObj) {
+        OpFusion::flushPendingBatch();
+    }
+
     /*
      * Report query to various monitoring facilities.
      */
@@ -7509,6 +7515,7 @@ int PostgresMain(int argc, char* argv[], const char* dbname, const char* usernam
         }
 
         OpFusion::setCurrentOpFusionObj(NULL);
+        OpFusion::discardPendingBatch();
         /* init pbe execute status when long jump */
         u_sess->xact_cxt.pbe_execute_complete = true;
 
@@ -7906,6 +7913,16 @@ int PostgresMain(int argc, char* argv[], const char* dbname, const char* usernam
                 u_sess->proc_cxt.MyProcPort->gs_sock.sid,
                 firstchar);
 
+        /*
+         * A bypass insert buffers the rows of consecutive Bind/Execute messages,
+         * any other message sees them inserted.  Inside a transaction block a
+         * Sync commits nothing, so the rows may wait for the next statement.
+         */
+        if (u_sess->exec_cxt.PendingBatchOpFusionObj != NULL && firstchar != 'B' && firstchar != 'D' &&
+            firstchar != 'E' && !(firstchar == 'S' && IsTransactionBlock())) {
+            OpFusion::flushPendingBatch();
+        }
+
         switch (firstchar) {
 #ifdef ENABLE_MULTIPLE_NODES
             case 'Z':  // exeute plan directly.
@@ -8332,6 +8349,11 @@ int PostgresMain(int argc, char* argv[], const char* dbname, const char* usernam
                     break;
                 }
 
+                if (u_sess->exec_cxt.PendingBatchOpFusionObj != NULL &&
+                    u_sess->exec_cxt.PendingBatchOpFusionObj != u_sess->exec_cxt.CurrentOpFusionObj) {
+                    OpFusion::flushPendingBatch();
+                }
+
                 char* completionTag = (char*)palloc0(COMPLETION_TAG_BUFSIZE * sizeof(char));
                 if (u_sess->exec_cxt.CurrentOpFusionObj != NULL && IS_SINGLE_NODE) {
                     if (IS_UNIQUE_SQL_TRACK_TOP) {
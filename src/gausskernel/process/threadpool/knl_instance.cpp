@@ -58,6 +58,8 @@ static void knl_g_cost_init(knl_g_cost_context* cost_cxt)
     cost_cxt->receive_kdata_cost = DEFAULT_RECEIVE_KDATA_COST;
     cost_cxt->disable_cost = 1.0e10;
     cost_cxt->disable_cost_enlarge_factor = 10;
+    cost_cxt->card_feedback_context = NULL;
+    cost_cxt->card_feedback_hashtbl = NULL;
 }
 
 static void knl_g_quota_init(knl_g_quota_context* quota_cxt)
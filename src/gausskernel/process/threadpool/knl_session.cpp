@@ -105,6 +105,7 @@ static void knl_u_executor_init(knl_u_executor_context* exec_cxt)
 
     exec_cxt->HashScans = NULL;
     exec_cxt->executorStopFlag = false;
+    exec_cxt->PendingBatchOpFusionObj = NULL;
 
     exec_cxt->is_exec_trigger_func = false;
 }
@@ -1024,6 +1025,7 @@ static void knl_u_mot_init(knl_u_mot_context* mot_cxt)
     mot_cxt->jit_tvm_do_while_stack = NULL;
     mot_cxt->jit_context = NULL;
     mot_cxt->jit_txn = NULL;
+    mot_cxt->preferred_numa_node = -1;
 }
 
 void knl_session_init(knl_session_context* sess_cxt)
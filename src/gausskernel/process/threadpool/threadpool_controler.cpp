@@ -642,6 +642,29 @@ ThreadPoolGroup* ThreadPoolControler::FindThreadGroupWithLeastSession()
     return m_groups[idx];
 }
 
+/*
+ * Find the least loaded group bound to the given NUMA node,
+ * return NULL if no group is bound to it.
+ */
+ThreadPoolGroup* ThreadPoolControler::FindThreadGroupOnNumaNode(int numaId)
+{
+    ThreadPoolGroup* grp = NULL;
+    float4 least_session = 0.0;
+    float4 session_per_thread = 0.0;
+
+    for (int i = 0; i < m_groupNum; i++) {
+        if (m_groups[i]->GetNumaId() != numaId)
+            continue;
+        session_per_thread = m_groups[i]->GetSessionPerThread();
+        if (grp == NULL || session_per_thread < least_session) {
+            least_session = session_per_thread;
+            grp = m_groups[i];
+        }
+    }
+
+    return grp;
+}
+
 bool ThreadPoolControler::StayInAttachMode()
 {
     return m_sessCtrl->GetActiveSessionCount() < m_threadNum;
@@ -186,6 +186,23 @@ void ThreadPoolListener::AddNewSession(knl_session_context* session)
     (void)pg_atomic_fetch_add_u32((volatile uint32*)&m_group->m_sessionCount, 1);
 }
 
+/*
+ * Take over an idle session from the listener of another group. The caller
+ * has already removed the socket from the epoll of the other listener, so
+ * it is registered again here, and any pending input triggers an event.
+ */
+void ThreadPoolListener::AddMigratedSession(knl_session_context* session)
+{
+    struct epoll_event ev = {0};
+
+    m_idleSessionList->AddTail(&session->elem);
+
+    ev.events = EPOLLRDHUP | EPOLLIN | EPOLLET | EPOLLONESHOT;
+    ev.data.ptr = (void*)session;
+    epoll_ctl(m_epollFd, EPOLL_CTL_ADD, session->proc_cxt.MyProcPort->sock, &ev);
+    (void)pg_atomic_fetch_add_u32((volatile uint32*)&m_group->m_sessionCount, 1);
+}
+
 void ThreadPoolListener::SendShutDown()
 {
     m_reaperAllSession = true;
@@ -449,11 +449,32 @@ void ThreadPoolWorker::DetachSessionFromThread()
     m_currentSession->attachPid = (ThreadId)-1;
 
     /* should restore the data before return to listener. */
-    m_group->GetListener()->AddEpoll(m_currentSession);
+    ThreadPoolGroup* homeGroup = GetSessionHomeGroup();
+    if (homeGroup != m_group) {
+        m_group->GetListener()->DelSessionFromEpoll(m_currentSession);
+        homeGroup->GetListener()->AddMigratedSession(m_currentSession);
+    } else {
+        m_group->GetListener()->AddEpoll(m_currentSession);
+    }
     m_currentSession = NULL;
     u_sess = NULL;
 }
 
+/*
+ * Return the group the detached session should wait in. A session whose last
+ * transaction mostly accessed NUMA-partitioned MOT rows of another NUMA node
+ * moves to a group bound to that node, so its next statements run next to the data.
+ */
+ThreadPoolGroup* ThreadPoolWorker::GetSessionHomeGroup()
+{
+    int numaId = m_currentSession->mot_cxt.preferred_numa_node;
+    if (numaId < 0 || m_group->GetNumaId() < 0 || numaId == m_group->GetNumaId())
+        return m_group;
+
+    ThreadPoolGroup* grp = g_threadPoolControler->FindThreadGroupOnNumaNode(numaId);
+    return (grp != NULL) ? grp : m_group;
+}
+
 bool ThreadPoolWorker::AttachSessionToThread()
 {
     Assert(m_currentSession != NULL);
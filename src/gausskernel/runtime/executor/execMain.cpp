@@ -58,6 +58,7 @@
 #include "libpq/pqsignal.h"
 #include "mb/pg_wchar.h"
 #include "miscadmin.h"
+#include "optimizer/cardfeedback.h"
 #include "optimizer/clauses.h"
 #include "parser/parsetree.h"
 #include "pgstat.h"
@@ -351,6 +352,12 @@ void standard_ExecutorStart(QueryDesc *queryDesc, int eflags)
     estate->es_top_eflags = eflags;
     estate->es_instrument = queryDesc->instrument_options;
 
+    /* cardinality feedback needs the actual row counts of the scan nodes */
+    if (u_sess->attr.attr_sql.enable_card_feedback && estate->es_instrument == INSTRUMENT_NONE &&
+        u_sess->instr_cxt.global_instr == NULL && !(eflags & EXEC_FLAG_EXPLAIN_ONLY)) {
+        estate->es_instrument = INSTRUMENT_ROWS;
+    }
+
     /* Apply BloomFilter array space. */
     if (queryDesc->plannedstmt->MaxBloomFilterNum > 0) {
         int boom_size = queryDesc->plannedstmt->MaxBloomFilterNum;
@@ -716,6 +723,11 @@ void standard_ExecutorEnd(QueryDesc *queryDesc)
      * Switch into per-query memory context to run ExecEndPlan
      */
     old_context = MemoryContextSwitchTo(estate->es_query_cxt);
+
+    if (u_sess->attr.attr_sql.enable_card_feedback) {
+        CardFeedbackCollect(queryDesc);
+    }
+
     EARLY_FREE_LOG(elog(LOG, "Early Free: Start to end plan, memory used %d MB.", getSessionMemoryUsageMB()));
     ExecEndPlan(queryDesc->planstate, estate);
 
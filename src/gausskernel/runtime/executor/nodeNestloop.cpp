@@ -24,8 +24,28 @@
 #include "executor/execdebug.h"
 #include "executor/nodeNestloop.h"
 #include "executor/execStream.h"
+#include "nodes/nodeFuncs.h"
+#include "utils/lsyscache.h"
 #include "utils/memutils.h"
 
+/*
+ * Hash table entry for the adaptive nestloop.  The inner side may carry
+ * several tuples with the same key, so besides the representative tuple
+ * kept by the TupleHashTable we chain every inner tuple of the group.
+ */
+typedef struct NestLoopHashEntryData* NestLoopHashEntry;
+
+typedef struct NestLoopHashEntryData {
+    TupleHashEntryData shared; /* common header for hash table entries */
+    List* tuples;              /* all inner tuples with this key */
+} NestLoopHashEntryData;
+
+static void ExecNestLoopInitAdaptive(NestLoopState* nlstate, NestLoop* node, EState* estate);
+static bool ExecNestLoopBuildHashTable(NestLoopState* node);
+static void ExecNestLoopProbeHashTable(NestLoopState* node, TupleTableSlot* outer_tuple_slot);
+static TupleTableSlot* ExecNestLoopNextHashMatch(NestLoopState* node);
+static void ExecNestLoopResetAdaptive(NestLoopState* node);
+
 static void MaterialAll(PlanState* node)
 {
     if (IsA(node, MaterialState)) {
@@ -182,10 +202,28 @@ TupleTableSlot* ExecNestLoop(NestLoopState* node)
             }
 
             /*
-             * now rescan the inner plan
+             * Once enough outer rows have gone by, try to hash the inner
+             * side so that the remaining outer rows probe it instead of
+             * rescanning the inner plan.
              */
-            ENL1_printf("rescanning inner plan");
-            ExecReScan(inner_plan);
+            if (node->nl_AdaptiveMode == NL_ADAPTIVE_WATCHING &&
+                ++node->nl_OuterRows >= u_sess->attr.attr_sql.adaptive_nestloop_threshold) {
+                if (ExecNestLoopBuildHashTable(node))
+                    node->nl_AdaptiveMode = NL_ADAPTIVE_HASHED;
+                else
+                    node->nl_AdaptiveMode = NL_ADAPTIVE_ABANDONED;
+            }
+
+            if (node->nl_AdaptiveMode == NL_ADAPTIVE_HASHED) {
+                ENL1_printf("probing inner hash table");
+                ExecNestLoopProbeHashTable(node, outer_tuple_slot);
+            } else {
+                /*
+                 * now rescan the inner plan
+                 */
+                ENL1_printf("rescanning inner plan");
+                ExecReScan(inner_plan);
+            }
         }
 
         /*
@@ -198,13 +236,17 @@ TupleTableSlot* ExecNestLoop(NestLoopState* node)
          * but will early free the left and right tree's caching memory.
          * When rescan left tree, may fail.
          */
-        bool orig_value = inner_plan->state->es_skip_early_free;
-        if (!IsA(inner_plan, MaterialState))
-            inner_plan->state->es_skip_early_free = true;
+        if (node->nl_AdaptiveMode == NL_ADAPTIVE_HASHED) {
+            inner_tuple_slot = ExecNestLoopNextHashMatch(node);
+        } else {
+            bool orig_value = inner_plan->state->es_skip_early_free;
+            if (!IsA(inner_plan, MaterialState))
+                inner_plan->state->es_skip_early_free = true;
 
-        inner_tuple_slot = ExecProcNode(inner_plan);
+            inner_tuple_slot = ExecProcNode(inner_plan);
 
-        inner_plan->state->es_skip_early_free = orig_value;
+            inner_plan->state->es_skip_early_free = orig_value;
+        }
         econtext->ecxt_innertuple = inner_tuple_slot;
 
         if (TupIsNull(inner_tuple_slot)) {
@@ -391,6 +433,8 @@ NestLoopState* ExecInitNestLoop(NestLoop* node, EState* estate, int eflags)
     ExecAssignResultTypeFromTL(&nlstate->js.ps);
     ExecAssignProjectionInfo(&nlstate->js.ps, NULL);
 
+    ExecNestLoopInitAdaptive(nlstate, node, estate);
+
     /*
      * finally, wipe the current outer tuple clean.
      */
@@ -423,6 +467,16 @@ void ExecEndNestLoop(NestLoopState* node)
      */
     (void)ExecClearTuple(node->js.ps.ps_ResultTupleSlot);
 
+    /*
+     * release the adaptive hash table, if we built one
+     */
+    if (node->nl_HashTableContext != NULL) {
+        (void)ExecClearTuple(node->nl_HashInnerSlot);
+        MemoryContextDelete(node->nl_HashTableContext);
+        node->nl_HashTableContext = NULL;
+        node->nl_HashTable = NULL;
+    }
+
     /*
      * close down subplans
      */
@@ -456,8 +510,16 @@ void ExecReScanNestLoop(NestLoopState* node)
     if (IS_PGXC_DATANODE && EXEC_IN_RECURSIVE_MODE(ps.plan) && ((ps.state)->es_recursive_next_iteration)) {
         ExecReScan(inner_plan);
         node->nl_MaterialAll = ((NestLoop*)ps.plan)->materialAll;
+        ExecNestLoopResetAdaptive(node);
     }
 
+    /*
+     * A hashed inner side stays valid across rescans unless the inner plan
+     * depends on parameters that have changed.
+     */
+    if (inner_plan->chgParam != NULL)
+        ExecNestLoopResetAdaptive(node);
+
     /*
      * inner_plan is re-scanned for each new outer tuple and MUST NOT be
      * re-scanned from here or you'll get troubles from inner index scans when
@@ -466,4 +528,290 @@ void ExecReScanNestLoop(NestLoopState* node)
     node->js.ps.ps_TupFromTlist = false;
     node->nl_NeedNewOuter = true;
     node->nl_MatchedOuter = false;
-}
\ No newline at end of file
+}
+
+/*
+ * ExecNestLoopInitAdaptive
+ *
+ * Decide whether this nestloop may switch to hashing its inner side and, if
+ * so, collect the hash keys.  Only top-level join quals of the form
+ * "outer_var = inner_var" with a hashable, non cross-type equality operator
+ * are used; every inner tuple that can satisfy the join quals must agree on
+ * these keys, so the hash table hands back a superset of the matches and the
+ * full join quals still decide the result.
+ */
+static void ExecNestLoopInitAdaptive(NestLoopState* nlstate, NestLoop* node, EState* estate)
+{
+    List* outer_keys = NIL;
+    List* inner_keys = NIL;
+    List* eq_ops = NIL;
+    ListCell* lc = NULL;
+
+    nlstate->nl_AdaptiveMode = NL_ADAPTIVE_DISABLED;
+    nlstate->nl_OuterRows = 0;
+    nlstate->nl_SwitchOuterRows = 0;
+    nlstate->nl_HashInnerRows = 0;
+
+    if (!u_sess->attr.attr_sql.enable_adaptive_nestloop || node->nestParams != NIL || node->join.optimizable)
+        return;
+
+    /* recursive-stream plans rescan the inner side on their own schedule */
+    if (EXEC_IN_RECURSIVE_MODE((Plan*)node))
+        return;
+
+    foreach (lc, node->join.joinqual) {
+        Expr* clause = (Expr*)lfirst(lc);
+        OpExpr* opexpr = NULL;
+        Expr* larg = NULL;
+        Expr* rarg = NULL;
+        Oid lhs_hashfn = InvalidOid;
+        Oid rhs_hashfn = InvalidOid;
+
+        if (!IsA(clause, OpExpr) || list_length(((OpExpr*)clause)->args) != 2)
+            continue;
+
+        opexpr = (OpExpr*)clause;
+        larg = (Expr*)linitial(opexpr->args);
+        rarg = (Expr*)lsecond(opexpr->args);
+        while (IsA(larg, RelabelType))
+            larg = ((RelabelType*)larg)->arg;
+        while (IsA(rarg, RelabelType))
+            rarg = ((RelabelType*)rarg)->arg;
+
+        if (!IsA(larg, Var) || !IsA(rarg, Var))
+            continue;
+        if (((Var*)larg)->varattno <= 0 || ((Var*)rarg)->varattno <= 0)
+            continue;
+        if (!op_hashjoinable(opexpr->opno, exprType((Node*)linitial(opexpr->args))))
+            continue;
+        if (!get_op_hash_functions(opexpr->opno, &lhs_hashfn, &rhs_hashfn) || lhs_hashfn != rhs_hashfn)
+            continue;
+
+        if (((Var*)larg)->varno == OUTER_VAR && ((Var*)rarg)->varno == INNER_VAR) {
+            outer_keys = lappend_int(outer_keys, ((Var*)larg)->varattno);
+            inner_keys = lappend_int(inner_keys, ((Var*)rarg)->varattno);
+        } else if (((Var*)larg)->varno == INNER_VAR && ((Var*)rarg)->varno == OUTER_VAR) {
+            outer_keys = lappend_int(outer_keys, ((Var*)rarg)->varattno);
+            inner_keys = lappend_int(inner_keys, ((Var*)larg)->varattno);
+        } else {
+            continue;
+        }
+        eq_ops = lappend_oid(eq_ops, opexpr->opno);
+    }
+
+    if (eq_ops == NIL)
+        return;
+
+    int nkeys = list_length(eq_ops);
+    Oid* eq_oids = (Oid*)palloc(nkeys * sizeof(Oid));
+    ListCell* lc_outer = NULL;
+    ListCell* lc_inner = NULL;
+    int i = 0;
+
+    nlstate->nl_NumHashKeys = nkeys;
+    nlstate->nl_OuterKeyIdx = (AttrNumber*)palloc(nkeys * sizeof(AttrNumber));
+    nlstate->nl_InnerKeyIdx = (AttrNumber*)palloc(nkeys * sizeof(AttrNumber));
+    forthree(lc_outer, outer_keys, lc_inner, inner_keys, lc, eq_ops) {
+        nlstate->nl_OuterKeyIdx[i] = (AttrNumber)lfirst_int(lc_outer);
+        nlstate->nl_InnerKeyIdx[i] = (AttrNumber)lfirst_int(lc_inner);
+        eq_oids[i] = lfirst_oid(lc);
+        i++;
+    }
+    execTuplesHashPrepare(nkeys, eq_oids, &nlstate->nl_HashEqFuncs, &nlstate->nl_HashFuncs);
+    pfree(eq_oids);
+
+    /*
+     * The probe slot carries the outer key values at the inner key positions,
+     * so it is shaped like the inner result tuple.
+     */
+    TupleDesc inner_desc = ExecGetResultType(innerPlanState(nlstate));
+    nlstate->nl_HashProbeSlot = ExecInitExtraTupleSlot(estate);
+    ExecSetSlotDescriptor(nlstate->nl_HashProbeSlot, inner_desc);
+    nlstate->nl_HashInnerSlot = ExecInitExtraTupleSlot(estate);
+    ExecSetSlotDescriptor(nlstate->nl_HashInnerSlot, inner_desc);
+
+    nlstate->nl_AdaptiveMode = NL_ADAPTIVE_WATCHING;
+
+    list_free(outer_keys);
+    list_free(inner_keys);
+    list_free(eq_ops);
+}
+
+/*
+ * ExecNestLoopBuildHashTable
+ *
+ * Read the whole inner side into a hash table keyed on the inner hash keys.
+ * Returns false, leaving the node in plain nestloop mode, if the inner side
+ * does not fit in the operator's work memory.
+ */
+static bool ExecNestLoopBuildHashTable(NestLoopState* node)
+{
+    NestLoop* nl = (NestLoop*)node->js.ps.plan;
+    PlanState* inner_plan = innerPlanState(node);
+    ExprContext* econtext = node->js.ps.ps_ExprContext;
+    int64 work_mem = SET_NODEMEM(nl->join.plan.operatorMemKB[0], nl->join.plan.dop);
+    long nbuckets = (long)Max(nl->join.plan.righttree->plan_rows, 1024.0);
+    MemoryContext old_context;
+    bool fits = true;
+
+    if (node->nl_HashTableContext == NULL) {
+        node->nl_HashTableContext = AllocSetContextCreate(CurrentMemoryContext,
+            "NestLoop adaptive hash table",
+            ALLOCSET_DEFAULT_MINSIZE,
+            ALLOCSET_DEFAULT_INITSIZE,
+            ALLOCSET_DEFAULT_MAXSIZE);
+    }
+
+    node->nl_HashTable = BuildTupleHashTable(node->nl_NumHashKeys,
+        node->nl_InnerKeyIdx,
+        node->nl_HashEqFuncs,
+        node->nl_HashFuncs,
+        nbuckets,
+        sizeof(NestLoopHashEntryData),
+        node->nl_HashTableContext,
+        econtext->ecxt_per_tuple_memory,
+        work_mem);
+    node->nl_HashInnerRows = 0;
+
+    ExecReScan(inner_plan);
+
+    bool orig_value = inner_plan->state->es_skip_early_free;
+    if (!IsA(inner_plan, MaterialState))
+        inner_plan->state->es_skip_early_free = true;
+
+    for (;;) {
+        TupleTableSlot* slot = ExecProcNode(inner_plan);
+        bool has_null = false;
+        bool isnew = false;
+
+        if (TupIsNull(slot))
+            break;
+
+        /* equality join operators are strict, null keys never match */
+        for (int i = 0; i < node->nl_NumHashKeys; i++) {
+            if (slot_attisnull(slot, node->nl_InnerKeyIdx[i])) {
+                has_null = true;
+                break;
+            }
+        }
+        if (has_null)
+            continue;
+
+        NestLoopHashEntry entry = (NestLoopHashEntry)LookupTupleHashEntry(node->nl_HashTable, slot, &isnew);
+        old_context = MemoryContextSwitchTo(node->nl_HashTableContext);
+        if (isnew) {
+            entry->tuples = list_make1(entry->shared.firstTuple);
+        } else {
+            MinimalTuple tuple = ExecCopySlotMinimalTuple(slot);
+            node->nl_HashTable->width += tuple->t_len;
+            entry->tuples = lappend(entry->tuples, tuple);
+        }
+        (void)MemoryContextSwitchTo(old_context);
+        node->nl_HashInnerRows++;
+        ResetExprContext(econtext);
+
+        if (node->nl_HashTable->width / 1024L > work_mem) {
+            fits = false;
+            break;
+        }
+    }
+
+    inner_plan->state->es_skip_early_free = orig_value;
+
+    if (!fits) {
+        ereport(DEBUG1,
+            (errmodule(MOD_EXECUTOR),
+                errmsg("adaptive nestloop at node %d keeps looping: inner side exceeds %ld kB",
+                    nl->join.plan.plan_node_id,
+                    work_mem)));
+        MemoryContextReset(node->nl_HashTableContext);
+        node->nl_HashTable = NULL;
+        node->nl_HashInnerRows = 0;
+        ExecReScan(inner_plan);
+        return false;
+    }
+
+    node->nl_SwitchOuterRows = node->nl_OuterRows;
+    node->nl_HashMatch = NULL;
+
+    ereport(DEBUG1,
+        (errmodule(MOD_EXECUTOR),
+            errmsg("adaptive nestloop at node %d switched to hash after %ld outer rows, %ld inner rows hashed",
+                nl->join.plan.plan_node_id,
+                node->nl_SwitchOuterRows,
+                node->nl_HashInnerRows)));
+
+    return true;
+}
+
+/*
+ * ExecNestLoopProbeHashTable
+ *
+ * Look up the inner tuples matching the keys of a new outer tuple and
+ * position the match cursor on the first of them.
+ */
+static void ExecNestLoopProbeHashTable(NestLoopState* node, TupleTableSlot* outer_tuple_slot)
+{
+    TupleTableSlot* probe = node->nl_HashProbeSlot;
+    int natts = probe->tts_tupleDescriptor->natts;
+    NestLoopHashEntry entry = NULL;
+
+    node->nl_HashMatch = NULL;
+
+    (void)ExecClearTuple(probe);
+    for (int i = 0; i < natts; i++) {
+        probe->tts_values[i] = (Datum)0;
+        probe->tts_isnull[i] = true;
+    }
+    for (int i = 0; i < node->nl_NumHashKeys; i++) {
+        AttrNumber inner_attno = node->nl_InnerKeyIdx[i];
+        bool isnull = false;
+
+        probe->tts_values[inner_attno - 1] = slot_getattr(outer_tuple_slot, node->nl_OuterKeyIdx[i], &isnull);
+        if (isnull)
+            return;
+        probe->tts_isnull[inner_attno - 1] = false;
+    }
+    (void)ExecStoreVirtualTuple(probe);
+
+    entry = (NestLoopHashEntry)FindTupleHashEntry(node->nl_HashTable, probe, node->nl_HashEqFuncs, node->nl_HashFuncs);
+    if (entry != NULL)
+        node->nl_HashMatch = list_head(entry->tuples);
+}
+
+/*
+ * ExecNestLoopNextHashMatch
+ *
+ * Return the next inner tuple sharing the current outer tuple's hash keys,
+ * or NULL once they are exhausted.
+ */
+static TupleTableSlot* ExecNestLoopNextHashMatch(NestLoopState* node)
+{
+    if (node->nl_HashMatch == NULL)
+        return NULL;
+
+    MinimalTuple tuple = (MinimalTuple)lfirst(node->nl_HashMatch);
+    node->nl_HashMatch = lnext(node->nl_HashMatch);
+
+    return ExecStoreMinimalTuple(tuple, node->nl_HashInnerSlot, false);
+}
+
+/*
+ * ExecNestLoopResetAdaptive
+ *
+ * Throw away the inner hash table and start watching outer rows again.
+ */
+static void ExecNestLoopResetAdaptive(NestLoopState* node)
+{
+    if (node->nl_AdaptiveMode == NL_ADAPTIVE_DISABLED)
+        return;
+
+    if (node->nl_HashTableContext != NULL) {
+        (void)ExecClearTuple(node->nl_HashInnerSlot);
+        MemoryContextReset(node->nl_HashTableContext);
+    }
+    node->nl_HashTable = NULL;
+    node->nl_HashMatch = NULL;
+    node->nl_OuterRows = 0;
+    node->nl_AdaptiveMode = NL_ADAPTIVE_WATCHING;
+}
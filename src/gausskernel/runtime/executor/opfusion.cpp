@@ -26,8 +26,10 @@
 
 #include "opfusion/opfusion.h"
 
+#include "access/genam.h"
 #include "access/printtup.h"
 #include "access/transam.h"
+#include "access/xact.h"
 #include "catalog/pg_aggregate.h"
 #include "catalog/storage_gtt.h"
 #include "commands/copy.h"
@@ -709,6 +711,13 @@ void OpFusion::tearDown(OpFusion* opfusion)
     if (opfusion == NULL) {
         return;
     }
+    if (u_sess->exec_cxt.PendingBatchOpFusionObj == opfusion) {
+        if (IsTransactionState()) {
+            OpFusion::flushPendingBatch();
+        } else {
+            OpFusion::discardPendingBatch();
+        }
+    }
     if (opfusion->m_psrc != NULL) {
         opfusion->m_psrc->is_checked_opfusion = false;
         opfusion->m_psrc->opFusionObj = NULL;
@@ -758,6 +767,23 @@ void OpFusion::initParams(ParamListInfo params)
     }
 }
 
+void OpFusion::flushPendingBatch()
+{
+    InsertFusion* pending = (InsertFusion*)u_sess->exec_cxt.PendingBatchOpFusionObj;
+    if (pending != NULL) {
+        pending->flushBatch();
+    }
+}
+
+/* forget the buffered rows, their transaction is being aborted */
+void OpFusion::discardPendingBatch()
+{
+    InsertFusion* pending = (InsertFusion*)u_sess->exec_cxt.PendingBatchOpFusionObj;
+    if (pending != NULL) {
+        pending->discardBatch();
+    }
+}
+
 bool OpFusion::isQueryCompleted()
 {
     if (u_sess->exec_cxt.CurrentOpFusionObj != NULL)
@@ -1038,6 +1064,17 @@ InsertFusion::InsertFusion(MemoryContext context, CachedPlanSource* psrc, List*
     m_receiver = NULL;
     m_isInsideRec = true;
 
+    m_batchContext = AllocSetContextCreate(m_context,
+        "InsertFusionBatchContext",
+        ALLOCSET_DEFAULT_MINSIZE,
+        ALLOCSET_DEFAULT_INITSIZE,
+        ALLOCSET_DEFAULT_MAXSIZE);
+    m_batchTuples = NULL;
+    m_batchNum = 0;
+    m_batchSize = 0;
+    m_checkedIndexOids = NIL;
+    m_hasUniqueIndex = false;
+
     MemoryContextSwitchTo(old_context);
 }
 
@@ -1062,10 +1099,203 @@ void InsertFusion::refreshParameterIfNecessary()
     }
 }
 
+/*
+ * Only rows bound by the client through Bind messages are buffered, the
+ * 'U' batch message and simple queries keep inserting row by row.
+ */
+bool InsertFusion::useBatchInsert()
+{
+    return u_sess->attr.attr_sql.opfusion_batch_insert_size > 1 && !m_is_bucket_rel && m_outParams == NULL &&
+           u_sess->postgres_cxt.doing_extended_query_message;
+}
+
+/*
+ * Unique and exclusion checks run when the index entries are added, that is
+ * when the batch is flushed.  A conflict of a buffered row would then be
+ * reported by a later message than the Execute that sent the row, after its
+ * "INSERT 0 1" went out, so relations with such indexes are not buffered.
+ *
+ * This runs for every buffered row, so the answer is kept together with the
+ * index list it was computed from and the indexes are only opened again when
+ * that list changes, e.g. after a concurrent CREATE INDEX.
+ */
+bool InsertFusion::relHasUniqueIndex(Relation rel)
+{
+    if (!rel->rd_rel->relhasindex) {
+        return false;
+    }
+
+    List* index_list = RelationGetIndexList(rel);
+    if (m_checkedIndexOids != NIL && equal(index_list, m_checkedIndexOids)) {
+        list_free_ext(index_list);
+        return m_hasUniqueIndex;
+    }
+
+    bool result = false;
+    ListCell* lc = NULL;
+    foreach (lc, index_list) {
+        Relation index = index_open(lfirst_oid(lc), AccessShareLock);
+        result = index->rd_index->indisunique || index->rd_index->indisexclusion;
+        index_close(index, AccessShareLock);
+        if (result) {
+            break;
+        }
+    }
+
+    MemoryContext old_context = MemoryContextSwitchTo(m_context);
+    list_free_ext(m_checkedIndexOids);
+    m_checkedIndexOids = list_copy(index_list);
+    m_hasUniqueIndex = result;
+    MemoryContextSwitchTo(old_context);
+    list_free_ext(index_list);
+
+    return result;
+}
+
+/*
+ * Check and buffer the row of this Execute message.  The rows reach the heap
+ * in one heap_multi_insert when the buffer is full or when the client sends
+ * anything but another Bind/Describe/Execute or a Sync inside a transaction
+ * block, see PostgresMain.  Returns
+ * false without touching the row if the relation is inserted row by row.
+ */
+bool InsertFusion::executeBatch(char* completionTag)
+{
+    Assert(u_sess->exec_cxt.PendingBatchOpFusionObj == NULL || u_sess->exec_cxt.PendingBatchOpFusionObj == this);
+
+    Relation rel = heap_open(m_reloid, RowExclusiveLock);
+    if (relHasUniqueIndex(rel)) {
+        heap_close(rel, RowExclusiveLock);
+        /* the unique index was built concurrently, the earlier rows go first */
+        flushBatch();
+        return false;
+    }
+
+    ResultRelInfo* result_rel_info = makeNode(ResultRelInfo);
+    InitResultRelInfo(result_rel_info, rel, 1, 0);
+    m_estate->es_result_relation_info = result_rel_info;
+
+    refreshParameterIfNecessary();
+    init_gtt_storage(CMD_INSERT, result_rel_info);
+
+    MemoryContext old_context = MemoryContextSwitchTo(m_batchContext);
+    if (m_batchNum == 0) {
+        m_batchSize = u_sess->attr.attr_sql.opfusion_batch_insert_size;
+        m_batchTuples = (HeapTuple*)palloc(m_batchSize * sizeof(HeapTuple));
+    }
+    HeapTuple tuple = heap_form_tuple(m_tupDesc, m_values, m_isnull);
+    MemoryContextSwitchTo(old_context);
+
+    (void)ExecStoreTuple(tuple, m_reslot, InvalidBuffer, false);
+    if (rel->rd_att->constr) {
+        ExecConstraints(result_rel_info, m_reslot, m_estate);
+    }
+    (void)ExecClearTuple(m_reslot);
+
+    m_batchTuples[m_batchNum++] = tuple;
+    u_sess->exec_cxt.PendingBatchOpFusionObj = this;
+
+    heap_close(rel, RowExclusiveLock);
+
+    if (m_estate->esfRelations) {
+        FakeRelationCacheDestroy(m_estate->esfRelations);
+    }
+
+    if (m_batchNum >= m_batchSize) {
+        flushBatch();
+    }
+
+    m_isCompleted = true;
+
+    errno_t errorno = snprintf_s(completionTag, COMPLETION_TAG_BUFSIZE, COMPLETION_TAG_BUFSIZE - 1, "INSERT 0 1");
+    securec_check_ss(errorno, "\0", "\0");
+
+    return true;
+}
+
+/*
+ * Insert the buffered rows with one heap_multi_insert, which WAL-logs every
+ * filled page once instead of once per row, then add their index entries.
+ */
+void InsertFusion::flushBatch()
+{
+    if (m_batchNum == 0) {
+        discardBatch();
+        return;
+    }
+
+    bool snapshot_set = false;
+    if (!ActiveSnapshotSet()) {
+        PushActiveSnapshot(GetTransactionSnapshot());
+        snapshot_set = true;
+    }
+
+    Relation rel = heap_open(m_reloid, RowExclusiveLock);
+
+    ResultRelInfo* result_rel_info = makeNode(ResultRelInfo);
+    InitResultRelInfo(result_rel_info, rel, 1, 0);
+    m_estate->es_result_relation_info = result_rel_info;
+
+    if (result_rel_info->ri_RelationDesc->rd_rel->relhasindex) {
+        ExecOpenIndices(result_rel_info, false);
+    }
+
+    CommandId mycid = GetCurrentCommandId(true);
+
+    /*
+     * heap_multi_insert leaks memory, the batch context is reset below.  Page
+     * replication skips the heap WAL of index-less relations and relies on
+     * the caller to sync the relation at commit, as COPY does; these rows are
+     * WAL-logged like the single-row inserts they replace.
+     */
+    MemoryContext old_context = MemoryContextSwitchTo(m_batchContext);
+    HeapMultiInsertExtraArgs args = {NULL, 0, true};
+    (void)heap_multi_insert(rel, rel, m_batchTuples, m_batchNum, mycid, 0, NULL, &args);
+
+    if (result_rel_info->ri_NumIndices > 0) {
+        for (int i = 0; i < m_batchNum; i++) {
+            (void)ExecStoreTuple(m_batchTuples[i], m_reslot, InvalidBuffer, false);
+            List* recheck_indexes =
+                ExecInsertIndexTuples(m_reslot, &(m_batchTuples[i]->t_self), m_estate, NULL, NULL, InvalidBktId, NULL);
+            list_free_ext(recheck_indexes);
+        }
+        (void)ExecClearTuple(m_reslot);
+    }
+    MemoryContextSwitchTo(old_context);
+
+    ExecCloseIndices(result_rel_info);
+
+    heap_close(rel, RowExclusiveLock);
+
+    if (m_estate->esfRelations) {
+        FakeRelationCacheDestroy(m_estate->esfRelations);
+    }
+
+    if (snapshot_set) {
+        PopActiveSnapshot();
+    }
+
+    discardBatch();
+}
+
+void InsertFusion::discardBatch()
+{
+    if (u_sess->exec_cxt.PendingBatchOpFusionObj == this) {
+        u_sess->exec_cxt.PendingBatchOpFusionObj = NULL;
+    }
+    m_batchTuples = NULL;
+    m_batchNum = 0;
+    MemoryContextReset(m_batchContext);
+}
+
 bool InsertFusion::execute(long max_rows, char* completionTag)
 {
     bool success = false;
 
+    if (useBatchInsert() && executeBatch(completionTag)) {
+        return true;
+    }
+
     /*******************
      * step 1: prepare *
      *******************/
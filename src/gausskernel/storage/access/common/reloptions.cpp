@@ -85,6 +85,9 @@ static relopt_bool boolRelOpts[] = {
     {{"multi_zall", "segmente all word from long words in zhparser text search praser", RELOPT_KIND_ZHPARSER}, false},
     {{"ignore_enable_hadoop_env", "ignore enable_hadoop_env option", RELOPT_KIND_HEAP}, false},
     {{"hashbucket", "Enables hashbucket in this relation", RELOPT_KIND_HEAP}, false},
+    {{"hash_index", "Builds this MOT index as a lock-free hash index", RELOPT_KIND_BTREE}, false},
+    {{"bloom_filter", "Keeps a bloom filter of the values of each CU of this column relation", RELOPT_KIND_HEAP},
+        false},
     {{"on_commit_delete_rows", "global temp table on commit options", RELOPT_KIND_HEAP}, true},
     /* list terminator */
     {{NULL}}};
@@ -1359,7 +1362,8 @@ static void tsstore_tbl_check_compression_option(List* options)
 void ForbidToSetOptionsForRowTbl(List* options)
 {
     /* row relation's unsupported options */
-    static const char* unsupported[] = {"max_batchrow", "deltarow_threshold", "partial_cluster_rows", "compresslevel"};
+    static const char* unsupported[] = {
+        "max_batchrow", "deltarow_threshold", "partial_cluster_rows", "compresslevel", "bloom_filter"};
 
     /* check relation's options for row table */
     ForbidUserToSetUnsupportedOptions(options, unsupported, lengthof(unsupported), "row relation");
@@ -1408,7 +1412,8 @@ void forbid_to_set_options_for_timeseries_tbl(List* options)
 		"max_batchrow",
 		"deltarow_threshold",
 		"partial_cluster_rows",
-		"compresslevel"
+		"compresslevel",
+		"bloom_filter"
 	};
 
 	ForbidUserToSetUnsupportedOptions(options, unsupported, lengthof(unsupported), "timeseries relation");
@@ -1441,6 +1446,18 @@ void ForbidToSetOptionsForPSort(List* options)
     ForbidUserToSetUnsupportedOptions(options, unsupported, lengthof(unsupported), "psort index");
 }
 
+/*
+ * @Description: check index options for index not on MOT table
+ * @Param[IN] options: input user options
+ * @See also:
+ */
+void ForbidToSetOptionsForNotMOTIndex(List* options)
+{
+    static const char* unsupported[] = {"hash_index"};
+
+    ForbidUserToSetUnsupportedOptions(options, unsupported, lengthof(unsupported), "index not on MOT table");
+}
+
 /*
  * Option parser for anything that uses StdRdOptions (i.e. fillfactor and
  * autovacuum)
@@ -1501,6 +1518,8 @@ bytea* default_reloptions(Datum reloptions, bool validate, relopt_kind kind)
         {"end_ctid_internal", RELOPT_TYPE_STRING, offsetof(StdRdOptions, end_ctid_internal)},
         {"user_catalog_table", RELOPT_TYPE_BOOL, offsetof(StdRdOptions, user_catalog_table)},
         {"hashbucket", RELOPT_TYPE_BOOL, offsetof(StdRdOptions, hashbucket)},
+        {"hash_index", RELOPT_TYPE_BOOL, offsetof(StdRdOptions, hash_index)},
+        {"bloom_filter", RELOPT_TYPE_BOOL, offsetof(StdRdOptions, bloom_filter)},
         {"on_commit_delete_rows", RELOPT_TYPE_BOOL, offsetof(StdRdOptions, on_commit_delete_rows)},
         {"wait_clean_gpi", RELOPT_TYPE_STRING, offsetof(StdRdOptions, wait_clean_gpi)}};
 
@@ -1954,6 +1973,24 @@ void ForbidUserToSetDefinedOptions(List* options)
     }
 }
 
+/*
+ * @Description: forbid to change the index options only read when the index is created
+ * @Param[IN] options: input user options
+ * @See also:
+ */
+void ForbidUserToAlterIndexOptions(List* options)
+{
+    static const char* unchangedOpt[] = {"hash_index"};
+
+    int first_invalid_opt = -1;
+    if (FindInvalidOption(options, unchangedOpt, lengthof(unchangedOpt), &first_invalid_opt)) {
+        ereport(ERROR,
+            (errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+                (errmsg("Un-support feature"),
+                    errdetail("Option \"%s\" doesn't allow ALTER", unchangedOpt[first_invalid_opt]))));
+    }
+}
+
 /*
  * @Description: forbid to change inner option
  *   inner options only can be used by system itself.
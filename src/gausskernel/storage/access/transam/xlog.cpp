@@ -63,6 +63,7 @@
 #include "catalog/storage.h"
 #include "libpq/pqsignal.h"
 #include "miscadmin.h"
+#include "optimizer/cardfeedback.h"
 #ifdef PGXC
 #include "pgxc/barrier.h"
 #endif
@@ -10689,6 +10690,7 @@ static void CheckPointGuts(XLogRecPtr checkPointRedo, int flags, bool doFullChec
     CheckPointReplicationSlots();
     CheckPointSnapBuild();
     CheckPointLogicalRewriteHeap();
+    CheckPointCardFeedback();
     /*
      * If enable_incremental_checkpoint is on, there are two scenarios:
      * Incremental checkpoint, don't need flush any dirty page, and don't wait
@@ -47,27 +47,6 @@ struct CacheLookupEnt {
 // 2097152 = 2 * 1024 * 1024 = 2M
 #define MAX_CACHE_SLOT_COUNT 2097152
 
-#define CHECK_CACHE_SLOT_STATUS()                                                                                    \
-    {                                                                                                                \
-        if (m_csweep == start) {                                                                                     \
-            looped++;                                                                                                \
-            if (looped > MAX_LOOPS) {                                                                                 \
-                if (retryNum > MAX_RETRY_NUM) {                                                                        \
-                    ereport(ERROR,                                                                                   \
-                            (errcode(ERRCODE_OUT_OF_BUFFER), errmodule(MOD_CACHE),                                   \
-                             errmsg("No free Cache Blocks! cstore_buffers maybe too small, scanned=%d,"              \
-                                    " pinned=%d, unpinned=%d, invalid=%d, looped=%d, reserved=%d, freepinned = %d, " \
-                                    "start=%d, max=%d. RequestSize = %d, CurrentSize = %ld, BufferMaxSize = %ld.",   \
-                                    scanned, pinned, unpinned, invalid, looped, reserved, freepinned, start, max,    \
-                                    size, m_cstoreCurrentSize, m_cstoreMaxSize)));                                   \
-                } else {                                                                                             \
-                    UnlockSweep();                                                                                   \
-                    return CACHE_BLOCK_INVALID_IDX;                                                                  \
-                }                                                                                                    \
-            }                                                                                                        \
-        }                                                                                                            \
-    }
-
 /*
  * @Description: CacheMgrNumLocks
  * Returns the number of LW locks required by the CacheMgr instance.
@@ -80,8 +59,9 @@ struct CacheLookupEnt {
  */
 int CacheMgrNumLocks(int64 cache_size, uint32 each_block_size)
 {
-    /* One LW Lock for each cache block include IO lock and compress lock */
-    return (Min(cache_size / each_block_size, MAX_CACHE_SLOT_COUNT)) * 2;
+    /* One LW Lock for each cache block include IO lock and compress lock, and one for each sweep partition */
+    int64 total_slots = Min(cache_size / each_block_size, MAX_CACHE_SLOT_COUNT);
+    return total_slots * 2 + Min(total_slots, CACHE_SWEEP_PARTITIONS);
 }
 
 /*
@@ -159,8 +139,6 @@ void CacheMgr::Init(int64 cache_size, uint32 each_block_size, MgrCacheType type,
     SpinLockInit(&m_freeList_lock);
     SpinLockInit(&m_memsize_lock);
 
-    /* Clock Sweep Starting point  */
-    m_csweep = 0;
     m_csweep_lock = CStoreCUCacheSweepLock;
     m_partition_lock = FirstCacheSlotMappingLock;
     if (type == MGR_CACHE_TYPE_INDEX) {
@@ -168,6 +146,22 @@ void CacheMgr::Init(int64 cache_size, uint32 each_block_size, MgrCacheType type,
         m_partition_lock = FirstCacheSlotMappingLock + NUM_CACHE_BUFFER_PARTITIONS / 2;
     }
 
+    /* Clock Sweep Starting point of each partition */
+    m_sweep_parts = Min(total_slots, CACHE_SWEEP_PARTITIONS);
+    m_sweep_hands = (int *)palloc0(m_sweep_parts * sizeof(int));
+    m_sweep_locks = (LWLock **)palloc0(m_sweep_parts * sizeof(LWLock *));
+    for (i = 0; i < m_sweep_parts; ++i) {
+        m_sweep_locks[i] = LWLockAssign(trancheId);
+    }
+    pg_atomic_init_u32(&m_sweep_next, 0);
+
+    for (i = 0; i < CACHE_TYPE_NUM; ++i) {
+        pg_atomic_init_u64(&m_stats[i].hits, 0);
+        pg_atomic_init_u64(&m_stats[i].reads, 0);
+        pg_atomic_init_u64(&m_stats[i].evictions, 0);
+        pg_atomic_init_u64(&m_stats[i].ring_reuses, 0);
+    }
+
     HASHCTL info;
     errno_t rc = memset_s(&info, sizeof(info), 0, sizeof(info));
     securec_check(rc, "\0", "\0");
@@ -207,6 +201,8 @@ void CacheMgr::Destroy(void)
 
     pfree_ext(m_CacheSlots);
     pfree_ext(m_CacheDesc);
+    pfree_ext(m_sweep_hands);
+    pfree_ext(m_sweep_locks);
 }
 
 /*
@@ -267,6 +263,9 @@ CacheSlotId_t CacheMgr::FindCacheBlock(CacheTag *cacheTag, bool first_enter_bloc
             m_CacheDesc[slotId].m_usage_count += 1;
         }
         UnLockCacheDescHeader(slotId);
+        if (first_enter_block) {
+            (void)pg_atomic_fetch_add_u64(&m_stats[cacheTag->type].hits, 1);
+        }
 
         Assert(slotId >= 0 && slotId <= m_CaccheSlotMax && slotId < m_CacheSlotsNum);
         CacheDesc *cacheDesc = m_CacheDesc + slotId;
@@ -360,38 +359,29 @@ void CacheMgr::DeleteCacheBlock(CacheTag *cacheTag)
 }
 
 /*
- * @Description: use clock-swap algorithm to evict a block
- * @Return: slot id
+ * @Description: sweep one pass over the slots of a clock sweep partition
+ * @IN part: partition index
+ * @IN/OUT stats: sweep counters
+ * @Return: the evicted slot, Invalid and Pinned, or CACHE_BLOCK_INVALID_IDX if there is none
  * @See also:
  */
-CacheSlotId_t CacheMgr::EvictCacheBlock(int size, int retryNum)
+CacheSlotId_t CacheMgr::SweepPartition(int part, CacheSweepStats *stats)
 {
     CacheSlotId_t slotId = CACHE_BLOCK_INVALID_IDX;
 
-    /* If there is insufficient memory or no slots available
-     * we must evict one of the cache blocks using the clock sweep.
-     * Get the m_csweep_lock, only one sweeper searches the list. */
-    LockSweep();
+    /* Only one sweeper searches one partition */
+    (void)LWLockAcquire(m_sweep_locks[part], LW_EXCLUSIVE);
 
-    /* Initialize statistics for each new sweep */
-    int found = 0;
-    int start = m_csweep;
     int max = m_CaccheSlotMax;
-    int scanned = 0;
-    int pinned = 0;
-    int unpinned = 0;
-    int invalid = 0;
-    int looped = 0;
-    int reserved = 0;
-    int freepinned = 0;
-
-    while (1) {
-        /* Set the start slot to the current sweep position(m_csweep),
-        Then advance the current sweep position to the next */
-        slotId = m_csweep;
-        if (m_csweep++ >= m_CaccheSlotMax) {
-            m_csweep = 0;
+    int count = (max >= part) ? ((max - part) / m_sweep_parts + 1) : 0;
+    for (int n = 0; n < count; ++n) {
+        /* Get the slot at the partition sweep position, then advance the sweep position to the next */
+        int pos = m_sweep_hands[part];
+        if (pos >= count) {
+            pos = 0;
         }
+        m_sweep_hands[part] = pos + 1;
+        slotId = part + pos * m_sweep_parts;
         ereport(DEBUG2,
                 (errmodule(MOD_CACHE),
                  errmsg("try evict cache block, solt(%d), flag(%hhu), refcount(%u), usage_count(%hu), ring_count(%hu)",
@@ -399,19 +389,18 @@ CacheSlotId_t CacheMgr::EvictCacheBlock(int size, int retryNum)
                         m_CacheDesc[slotId].m_usage_count, m_CacheDesc[slotId].m_ring_count)));
 
         if (IsIOBusy(slotId)) {
-            CHECK_CACHE_SLOT_STATUS();
-            reserved++;
+            stats->reserved++;
             pg_usleep(2);
             continue;
         }
 
         LockCacheDescHeader(slotId);
-        scanned++;
+        stats->scanned++;
         /* skip invalid and error cache blocks */
         if ((m_CacheDesc[slotId].m_flag & CACHE_BLOCK_VALID) || (m_CacheDesc[slotId].m_flag & CACHE_BLOCK_ERROR)) {
             /* skip pinned cache blocks */
             if (m_CacheDesc[slotId].m_refcount == 0) {
-                unpinned++;
+                stats->unpinned++;
                 /* skip cache blocks with usage count > 0 */
                 if (m_CacheDesc[slotId].m_usage_count == 0) {
                     /* skip cache blocks that are in another ring , 1 in my ring,  0 no ring */
@@ -420,64 +409,139 @@ CacheSlotId_t CacheMgr::EvictCacheBlock(int size, int retryNum)
                                 (errmodule(MOD_CACHE), errmsg("evict cache block, solt(%d), flag(%d - %d)", slotId,
                                                               m_CacheDesc[slotId].m_flag, CACHE_BLOCK_INFREE)));
 
+                        int type = m_CacheDesc[slotId].m_cache_tag.type;
                         m_CacheDesc[slotId].m_flag = CACHE_BLOCK_INFREE;  // !Valid
                         PinCacheBlock_Locked(slotId);                     // Released header lock
-                        found++;
+                        LWLockRelease(m_sweep_locks[part]);
+                        (void)pg_atomic_fetch_add_u64(&m_stats[type].evictions, 1);
 
                         /* Found a slot to be reused with some buffer space,
                          * the space must be freed and reused.
                          * The slot is Invalid and Pinned!!! */
-                        break;
+                        return slotId;
                     }
-                    reserved++;
+                    stats->reserved++;
                 } else {
                     /* decrement the usage count to age the entry */
                     m_CacheDesc[slotId].m_usage_count--;
                 }
             } else {
-                pinned++;
+                stats->pinned++;
             }
         } else {
-            invalid++;
+            stats->invalid++;
             if ((m_CacheDesc[slotId].m_flag & CACHE_BLOCK_FREE) && (m_CacheDesc[slotId].m_refcount > 0)) {
-                freepinned++;
+                stats->freepinned++;
             }
         }
         UnLockCacheDescHeader(slotId);
+    }
+    LWLockRelease(m_sweep_locks[part]);
 
-        /* A full sweep should rarely happen
-         * Bail-out if we cannot find any unpinned blocks to
-         * avoid waiting forever.
-         *
-         * If the next sweep position is the same as
-         * the starting point, then we have gone
-         * an entire loop
-         *
-         * If there is not proper slot to replace, it will return CACHE_BLOCK_INVALID_IDX
-         * and unlock sweep lock in Macro CHECK_CACHE_SLOT_STATUS(). If this function
-         * returns CACHE_BLOCK_INVALID_IDX, it will retry to find freespace in GetFreeCacheBlock
-         * function.
-         */
-        CHECK_CACHE_SLOT_STATUS();
+    return CACHE_BLOCK_INVALID_IDX;
+}
+
+/*
+ * @Description: use clock-swap algorithm to evict a block. the slots are split into partitions
+ * swept under their own locks, and concurrent sweepers start from different partitions.
+ * @Return: slot id
+ * @See also:
+ */
+CacheSlotId_t CacheMgr::EvictCacheBlock(int size, int retryNum)
+{
+    CacheSlotId_t slotId = CACHE_BLOCK_INVALID_IDX;
+    CacheSweepStats stats = {0, 0, 0, 0, 0, 0};
+    int start = (int)(pg_atomic_fetch_add_u32(&m_sweep_next, 1) % (uint32)m_sweep_parts);
+    int part = start;
+
+    /* If there is insufficient memory or no slots available
+     * we must evict one of the cache blocks using the clock sweep. */
+    for (int looped = 0; looped <= MAX_LOOPS; ++looped) {
+        for (int i = 0; i < m_sweep_parts; ++i) {
+            slotId = SweepPartition(part, &stats);
+            if (IsValidCacheSlotID(slotId)) {
+                // purposely returning pinned Invalid slot !!!
+                return slotId;
+            }
+            part = (part + 1) % m_sweep_parts;
+        }
     }
-    UnlockSweep();
 
-    // purposely returning pinned Invalid slot !!!
-    return slotId;
+    /* A full sweep should rarely happen
+     * Bail-out if we cannot find any unpinned blocks to
+     * avoid waiting forever.
+     *
+     * If there is not proper slot to replace, it will return CACHE_BLOCK_INVALID_IDX,
+     * and GetFreeCacheBlock() retries to find freespace.
+     */
+    if (retryNum > MAX_RETRY_NUM) {
+        ereport(ERROR, (errcode(ERRCODE_OUT_OF_BUFFER), errmodule(MOD_CACHE),
+                        errmsg("No free Cache Blocks! cstore_buffers maybe too small, scanned=%d,"
+                               " pinned=%d, unpinned=%d, invalid=%d, looped=%d, reserved=%d, freepinned = %d, "
+                               "start=%d, max=%d. RequestSize = %d, CurrentSize = %ld, BufferMaxSize = %ld.",
+                               stats.scanned, stats.pinned, stats.unpinned, stats.invalid, MAX_LOOPS, stats.reserved,
+                               stats.freepinned, start, m_CaccheSlotMax, size, m_cstoreCurrentSize,
+                               m_cstoreMaxSize)));
+    }
+    return CACHE_BLOCK_INVALID_IDX;
+}
+
+/*
+ * @Description: reuse the next block of the ring of a large scan, if nobody else is using it
+ * @IN strategy: ring of the scan
+ * @Return: the slot Invalid and Pinned, or CACHE_BLOCK_INVALID_IDX if it cannot be reused
+ * @See also:
+ */
+CacheSlotId_t CacheMgr::GetRingCacheBlock(CacheAccessStrategy strategy)
+{
+    if (++strategy->current >= strategy->ring_size) {
+        strategy->current = 0;
+    }
+
+    CacheSlotId_t slotId = strategy->slots[strategy->current];
+    if (!IsValidCacheSlotID(slotId)) {
+        return CACHE_BLOCK_INVALID_IDX;
+    }
+
+    /*
+     * the block is reused only if it's still read by nobody but this scan, the same as
+     * what the clock sweep would evict. a block touched again has usage count above 1.
+     */
+    LockCacheDescHeader(slotId);
+    if ((m_CacheDesc[slotId].m_flag & CACHE_BLOCK_VALID) && !(m_CacheDesc[slotId].m_flag & CACHE_BLOCK_IOBUSY) &&
+        m_CacheDesc[slotId].m_refcount == 0 && m_CacheDesc[slotId].m_usage_count <= 1 &&
+        m_CacheDesc[slotId].m_ring_count == 0) {
+        int type = m_CacheDesc[slotId].m_cache_tag.type;
+        m_CacheDesc[slotId].m_flag = CACHE_BLOCK_INFREE;  // !Valid
+        PinCacheBlock_Locked(slotId);                     // Released header lock
+        (void)pg_atomic_fetch_add_u64(&m_stats[type].ring_reuses, 1);
+        return slotId;
+    }
+    UnLockCacheDescHeader(slotId);
+
+    return CACHE_BLOCK_INVALID_IDX;
 }
 
 /*
  * @Description:  get an Invalid cache block, first try get from free list cache, if without space,
  * second evict from used cache block, if all cache block are using, return error
  * @IN size: cache memory size needed
+ * @IN strategy: ring of a large scan, or NULL. the ring is tried first once it's in use.
  * @Return: return valid block index with pinned  or error return
  * @See also:
  */
-CacheSlotId_t CacheMgr::GetFreeCacheBlock(int size)
+CacheSlotId_t CacheMgr::GetFreeCacheBlock(int size, CacheAccessStrategy strategy)
 {
     CacheSlotId_t slotId = CACHE_BLOCK_INVALID_IDX;
     int retryNum = 0;
 
+    if (strategy != NULL && strategy->read_size >= strategy->ring_threshold) {
+        slotId = GetRingCacheBlock(strategy);
+        if (IsValidCacheSlotID(slotId)) {
+            return slotId;
+        }
+    }
+
 RETRY_FIND_FREESPACE:
 
     retryNum++;
@@ -519,6 +583,35 @@ RETRY_FIND_FREESPACE:
     return slotId;
 }
 
+/*
+ * @Description: create the ring of a large sequential scan in current memory context
+ * @IN ring_size: number of blocks in the ring
+ * @IN ring_threshold: the ring is used after the scan has read this many bytes into the cache
+ * @Return: the strategy
+ * @See also:
+ */
+CacheAccessStrategy GetCacheAccessStrategy(int ring_size, int64 ring_threshold)
+{
+    Assert(ring_size > 0);
+    CacheAccessStrategy strategy = (CacheAccessStrategy)palloc(
+        offsetof(CacheAccessStrategyData, slots) + ring_size * sizeof(CacheSlotId_t));
+    strategy->read_size = 0;
+    strategy->ring_threshold = ring_threshold;
+    strategy->ring_size = ring_size;
+    strategy->current = 0;
+    for (int i = 0; i < ring_size; ++i) {
+        strategy->slots[i] = CACHE_BLOCK_INVALID_IDX;
+    }
+    return strategy;
+}
+
+void FreeCacheAccessStrategy(CacheAccessStrategy strategy)
+{
+    if (strategy != NULL) {
+        pfree(strategy);
+    }
+}
+
 /*
  * @Description: generate hash value
  * @IN cacheTag: block unique identification
@@ -932,10 +1025,12 @@ void CacheMgr::AllocateBlockFromCacheWithSlotId(CacheSlotId_t slotId)
  * @Param[IN/OUT] hasFound: found in cache
  * @Param[IN] hashCode: hash code
  * @Param[IN] size: block size
+ * @Param[IN] strategy: ring of a large scan, or NULL
  * @Return: block index
  * @See also:
  */
-CacheSlotId_t CacheMgr::AllocateBlockFromCache(CacheTag *cacheTag, uint32 hashCode, int size, bool &hasFound)
+CacheSlotId_t CacheMgr::AllocateBlockFromCache(CacheTag *cacheTag, uint32 hashCode, int size, bool &hasFound,
+                                               CacheAccessStrategy strategy)
 {
     CacheLookupEnt *result = NULL;
     int old_size = 0;
@@ -945,7 +1040,7 @@ CacheSlotId_t CacheMgr::AllocateBlockFromCache(CacheTag *cacheTag, uint32 hashCo
 
     /* try allocate block from free list */
     while (1) {
-        slot = GetFreeCacheBlock(size);
+        slot = GetFreeCacheBlock(size, strategy);
         Assert(slot >= 0 && slot <= m_CaccheSlotMax && slot < m_CacheSlotsNum);
         Assert(m_CacheDesc[slot].m_refcount == 1);  // Only ours
 
@@ -1174,15 +1269,16 @@ bool CacheMgr::ReserveCstoreCacheBlockWithSlotId(CacheSlotId_t slotId)
  * @IN cacheTag: block unique identification
  * @OUT hasFound: found in cache
  * @IN size: cache block memory size
+ * @IN strategy: ring of a large scan, or NULL. a new block is put into the ring.
  * @Return:
  * @See also:
  */
-CacheSlotId_t CacheMgr::ReserveCacheBlock(CacheTag *cacheTag, int size, bool &hasFound)
+CacheSlotId_t CacheMgr::ReserveCacheBlock(CacheTag *cacheTag, int size, bool &hasFound, CacheAccessStrategy strategy)
 {
     int slot;
     uint32 hashCode = GetHashCode(cacheTag);
 
-    slot = AllocateBlockFromCache(cacheTag, hashCode, size, hasFound);
+    slot = AllocateBlockFromCache(cacheTag, hashCode, size, hasFound, strategy);
     Assert(slot >= 0 && slot <= m_CaccheSlotMax && slot < m_CacheSlotsNum);
     if (hasFound) {
         /* add m_usage_count here may not ok, so need think more about it */
@@ -1193,8 +1289,16 @@ CacheSlotId_t CacheMgr::ReserveCacheBlock(CacheTag *cacheTag, int size, bool &ha
         UnLockCacheDescHeader(slot);
         ereport(DEBUG2, (errmodule(MOD_CACHE), errmsg("Reuse cache block, slot(%d), type(%d)", slot, cacheTag->type)));
         Assert(m_CacheDesc[slot].m_refcount > 0);  // pinned
+        (void)pg_atomic_fetch_add_u64(&m_stats[cacheTag->type].hits, 1);
         return slot;
     }
+    (void)pg_atomic_fetch_add_u64(&m_stats[cacheTag->type].reads, 1);
+    if (strategy != NULL) {
+        if (strategy->read_size >= strategy->ring_threshold) {
+            strategy->slots[strategy->current] = slot;
+        }
+        strategy->read_size += size;
+    }
     ereport(DEBUG2, (errmodule(MOD_CACHE),
                      errmsg("Reserve cache block, add IOBUSY flag, slot(%d), type(%d)", slot, cacheTag->type)));
 
@@ -1249,6 +1353,24 @@ const CacheTag *CacheMgr::GetCacheBlockTag(CacheSlotId_t slotId, uint32 *refcoun
     return &(m_CacheDesc[slotId].m_cache_tag);
 }
 
+/*
+ * @Description: get the access counters of a cache type
+ * @IN type: cache type
+ * @OUT hits: blocks found in the cache at the first access
+ * @OUT reads: blocks read into the cache
+ * @OUT evictions: blocks evicted by the clock sweep
+ * @OUT ring_reuses: blocks replaced within the ring of a large scan
+ * @See also:
+ */
+void CacheMgr::GetCacheTypeStats(int type, uint64 *hits, uint64 *reads, uint64 *evictions, uint64 *ring_reuses)
+{
+    Assert(type > CACHE_TYPE_NONE && type < CACHE_TYPE_NUM);
+    *hits = pg_atomic_read_u64(&m_stats[type].hits);
+    *reads = pg_atomic_read_u64(&m_stats[type].reads);
+    *evictions = pg_atomic_read_u64(&m_stats[type].evictions);
+    *ring_reuses = pg_atomic_read_u64(&m_stats[type].ring_reuses);
+}
+
 /* copy cache block tag to out buffer safely */
 void CacheMgr::CopyCacheBlockTag(CacheSlotId_t slotId, CacheTag *outTag)
 {
@@ -1258,7 +1380,7 @@ void CacheMgr::CopyCacheBlockTag(CacheSlotId_t slotId, CacheTag *outTag)
 }
 
 /*
- * @Description: lock cache buffer before evict start
+ * @Description: lock before changing the used max slot id
  * @See also:
  */
 void CacheMgr::LockSweep()
@@ -1267,7 +1389,7 @@ void CacheMgr::LockSweep()
 }
 
 /*
- * @Description: unlock cache buffer after evict end
+ * @Description: unlock after changing the used max slot id
  * @See also:
  */
 void CacheMgr::UnlockSweep()
@@ -23,11 +23,17 @@
  */
 #include "access/hash.h"
 #include "storage/compress_kits.h"
+#include "storage/cstore_compress.h"
 #include "utils/memutils.h"
 #include "utils/memprot.h"
 #include "nodes/memnodes.h"
 #include "lz4.h"
 #include "lz4hc.h"
+#ifdef __aarch64__
+#include <arm_neon.h>
+#elif defined(__x86_64__)
+#include <immintrin.h>
+#endif
 
 /* The macro to validate if the return value is available */
 #define MEMPROT_ALLOC_VALID(buf, size)                                                                               \
@@ -926,6 +932,584 @@ int64 DeltaCoder::Decompress(
     return ret;
 }
 
+/*************************************************************************
+ *                   Frame-of-reference Bit Packing                       *
+ *************************************************************************/
+static inline int BitpackGetBitsNum(uint64 diff)
+{
+    return (diff == 0) ? 0 : (64 - __builtin_clzll(diff));
+}
+
+static inline int BitpackGetPackedSize(int nvals, int bits)
+{
+    return (int)(((uint64)nvals * bits + 7) >> 3);
+}
+
+// fetch the 64 bits starting at the byte holding the given bit, without reading beyond the input.
+static FORCE_INLINE uint64 BitpackLoadWord(const uint8* inbuf, int insize, uint64 bitpos)
+{
+    uint64 word = 0;
+    uint64 byte = bitpos >> 3;
+    if (byte + sizeof(uint64) <= (uint64)insize) {
+        word = *(const uint64*)(inbuf + byte);
+    } else if (byte < (uint64)insize) {
+        errno_t rc = memcpy_s(&word, sizeof(uint64), inbuf + byte, insize - byte);
+        securec_check(rc, "\0", "\0");
+    }
+    return word >> (bitpos & 7);
+}
+
+// the number of leading values whose 64-bit load stays inside the input.
+static inline int BitpackWideLoadCount(int insize, int nvals, int bits)
+{
+    if (bits == 0) {
+        return nvals;
+    }
+    if (insize < (int)sizeof(uint64)) {
+        return 0;
+    }
+    uint64 lastByte = (uint64)(insize - sizeof(uint64));
+    uint64 cnt = ((lastByte << 3) / bits) + 1;
+    return (cnt < (uint64)nvals) ? (int)cnt : nvals;
+}
+
+#if defined(__x86_64__) && defined(__GNUC__)
+static bool BitpackHasAvx2()
+{
+    static int hasAvx2 = -1;
+    if (hasAvx2 < 0) {
+        __builtin_cpu_init();
+        hasAvx2 = __builtin_cpu_supports("avx2") ? 1 : 0;
+    }
+    return (hasAvx2 == 1);
+}
+
+// unpack 4 values at a time: gather the 64-bit words holding them, shift and mask each lane.
+template <typename T>
+static __attribute__((target("avx2"))) int BitpackUnpackAvx2(
+    const uint8* inbuf, T* outbuf, int nvals, int bits, uint64 frame)
+{
+    const __m256i vbits = _mm256_set1_epi64x(bits);
+    const __m256i vseven = _mm256_set1_epi64x(7);
+    const __m256i vmask = _mm256_set1_epi64x((int64)((1ULL << bits) - 1));
+    const __m256i vframe = _mm256_set1_epi64x((int64)frame);
+    const __m256i vstep = _mm256_set1_epi64x(4);
+    const __m256i vnarrow = _mm256_setr_epi32(0, 2, 4, 6, 0, 0, 0, 0);
+    __m256i vidx = _mm256_setr_epi64x(0, 1, 2, 3);
+    int i = 0;
+
+    for (; i + 4 <= nvals; i += 4) {
+        __m256i bitpos = _mm256_mul_epu32(vidx, vbits);
+        __m256i word = _mm256_i64gather_epi64((const long long*)inbuf, _mm256_srli_epi64(bitpos, 3), 1);
+        word = _mm256_srlv_epi64(word, _mm256_and_si256(bitpos, vseven));
+        word = _mm256_add_epi64(_mm256_and_si256(word, vmask), vframe);
+        if (sizeof(T) == sizeof(int64)) {
+            _mm256_storeu_si256((__m256i*)(outbuf + i), word);
+        } else {
+            word = _mm256_permutevar8x32_epi32(word, vnarrow);
+            _mm_storeu_si128((__m128i*)(outbuf + i), _mm256_castsi256_si128(word));
+        }
+        vidx = _mm256_add_epi64(vidx, vstep);
+    }
+    return i;
+}
+#endif
+
+#ifdef __aarch64__
+// unpack 2 values at a time: shift each lane right by its own bit offset and mask.
+template <typename T>
+static int BitpackUnpackNeon(const uint8* inbuf, T* outbuf, int nvals, int bits, uint64 frame)
+{
+    const uint64x2_t vmask = vdupq_n_u64((1ULL << bits) - 1);
+    const uint64x2_t vframe = vdupq_n_u64(frame);
+    int i = 0;
+
+    for (; i + 2 <= nvals; i += 2) {
+        uint64 bitpos0 = (uint64)i * bits;
+        uint64 bitpos1 = bitpos0 + bits;
+        uint64x2_t word = vcombine_u64(vld1_u64((const uint64_t*)(inbuf + (bitpos0 >> 3))),
+            vld1_u64((const uint64_t*)(inbuf + (bitpos1 >> 3))));
+        int64x2_t shift = vcombine_s64(vcreate_s64(-(int64)(bitpos0 & 7)), vcreate_s64(-(int64)(bitpos1 & 7)));
+        word = vaddq_u64(vandq_u64(vshlq_u64(word, shift), vmask), vframe);
+        if (sizeof(T) == sizeof(int64)) {
+            vst1q_u64((uint64_t*)(outbuf + i), word);
+        } else {
+            vst1_u32((uint32_t*)(outbuf + i), vmovn_u64(word));
+        }
+    }
+    return i;
+}
+#endif
+
+template <typename T>
+void BitpackCoder::Unpack(const uint8* inbuf, int insize, T* outbuf, int nvals, int bits, uint64 frame)
+{
+    int i = 0;
+
+    if (bits == 0) {
+        for (; i < nvals; ++i) {
+            outbuf[i] = (T)frame;
+        }
+        return;
+    }
+
+    if (sizeof(T) == sizeof(int64) || sizeof(T) == sizeof(int32)) {
+        int nwide = BitpackWideLoadCount(insize, nvals, bits);
+#if defined(__x86_64__) && defined(__GNUC__)
+        if (BitpackHasAvx2()) {
+            i = BitpackUnpackAvx2<T>(inbuf, outbuf, nwide, bits, frame);
+        }
+#elif defined(__aarch64__)
+        i = BitpackUnpackNeon<T>(inbuf, outbuf, nwide, bits, frame);
+#endif
+    }
+
+    const uint64 mask = (1ULL << bits) - 1;
+    for (; i < nvals; ++i) {
+        outbuf[i] = (T)(frame + (BitpackLoadWord(inbuf, insize, (uint64)i * bits) & mask));
+    }
+}
+
+int BitpackCoder::Compress(char* inbuf, char* outbuf, int insize, int maxsize, int64 mindata, int64 maxdata)
+{
+    Assert(insize > 0 && (insize % m_eachValSize) == 0);
+    int nvals = insize / m_eachValSize;
+
+    // check whether the values are sorted, and find the widest step between neighbours
+    bool sorted = true;
+    uint64 maxStep = 0;
+    int64 prev = ConvertToInt64Data(inbuf, m_eachValSize);
+    for (int i = 1; i < nvals && sorted; ++i) {
+        int64 curr = ConvertToInt64Data(inbuf + i * m_eachValSize, m_eachValSize);
+        if (curr < prev) {
+            sorted = false;
+        } else {
+            uint64 step = (uint64)curr - (uint64)prev;
+            maxStep = (step > maxStep) ? step : maxStep;
+            prev = curr;
+        }
+    }
+
+    int bits = BitpackGetBitsNum((uint64)maxdata - (uint64)mindata);
+    uint8 format = BITPACK_FORMAT_FOR;
+    if (sorted && BitpackGetBitsNum(maxStep) < bits) {
+        bits = BitpackGetBitsNum(maxStep);
+        format = BITPACK_FORMAT_DELTA;
+    }
+    if (bits > BITPACK_MAX_BITS) {
+        return 0;
+    }
+
+    int cmprSize = (int)BITPACK_HEADER_SIZE + BitpackGetPackedSize(nvals, bits);
+    if (cmprSize >= maxsize) {
+        return 0;
+    }
+
+    // sorted data use the first value as the frame, so that its own step is 0
+    int64 frame = (format == BITPACK_FORMAT_DELTA) ? ConvertToInt64Data(inbuf, m_eachValSize) : mindata;
+    uint8* out = (uint8*)outbuf;
+    *out++ = format;
+    *out++ = (uint8)bits;
+    errno_t rc = memcpy_s(out, sizeof(int64), &frame, sizeof(int64));
+    securec_check(rc, "\0", "\0");
+    out += sizeof(int64);
+
+    uint64 acc = 0;
+    int accBits = 0;
+    uint64 base = (uint64)frame;
+    for (int i = 0; i < nvals; ++i) {
+        uint64 curr = (uint64)ConvertToInt64Data(inbuf + i * m_eachValSize, m_eachValSize);
+        acc |= (curr - base) << accBits;
+        accBits += bits;
+        while (accBits >= 8) {
+            *out++ = (uint8)acc;
+            acc >>= 8;
+            accBits -= 8;
+        }
+        if (format == BITPACK_FORMAT_DELTA) {
+            base = curr;
+        }
+    }
+    if (accBits > 0) {
+        *out++ = (uint8)acc;
+    }
+    Assert((char*)out - outbuf == cmprSize);
+    return cmprSize;
+}
+
+int BitpackCoder::Decompress(char* inbuf, char* outbuf, int insize, int outsize)
+{
+    Assert(insize >= (int)BITPACK_HEADER_SIZE && (outsize % m_eachValSize) == 0);
+    int nvals = outsize / m_eachValSize;
+    uint8 format = (uint8)inbuf[0];
+    int bits = (uint8)inbuf[1];
+    int64 frame = 0;
+    errno_t rc = memcpy_s(&frame, sizeof(int64), inbuf + 2, sizeof(int64));
+    securec_check(rc, "\0", "\0");
+    const uint8* packed = (const uint8*)inbuf + BITPACK_HEADER_SIZE;
+    int packedSize = insize - (int)BITPACK_HEADER_SIZE;
+    Assert(bits <= BITPACK_MAX_BITS && packedSize >= BitpackGetPackedSize(nvals, bits));
+
+    // steps are unpacked with a zero frame and accumulated afterwards
+    uint64 unpackFrame = (format == BITPACK_FORMAT_DELTA) ? 0 : (uint64)frame;
+    switch (m_eachValSize) {
+        case sizeof(int8):
+            Unpack<int8>(packed, packedSize, (int8*)outbuf, nvals, bits, unpackFrame);
+            break;
+        case sizeof(int16):
+            Unpack<int16>(packed, packedSize, (int16*)outbuf, nvals, bits, unpackFrame);
+            break;
+        case sizeof(int32):
+            Unpack<int32>(packed, packedSize, (int32*)outbuf, nvals, bits, unpackFrame);
+            break;
+        case sizeof(int64):
+            Unpack<int64>(packed, packedSize, (int64*)outbuf, nvals, bits, unpackFrame);
+            break;
+        default: {
+            // uncommon value sizes are restored one by one
+            const uint64 mask = (bits == 0) ? 0 : ((1ULL << bits) - 1);
+            for (int i = 0; i < nvals; ++i) {
+                uint64 val = unpackFrame + (BitpackLoadWord(packed, packedSize, (uint64)i * bits) & mask);
+                Int64DataConvertTo((int64)val, m_eachValSize, outbuf + i * m_eachValSize);
+            }
+            break;
+        }
+    }
+
+    if (format == BITPACK_FORMAT_DELTA) {
+        uint64 curr = (uint64)frame;
+        switch (m_eachValSize) {
+            case sizeof(int32): {
+                int32* vals = (int32*)outbuf;
+                for (int i = 0; i < nvals; ++i) {
+                    curr += (uint32)vals[i];
+                    vals[i] = (int32)curr;
+                }
+                break;
+            }
+            case sizeof(int64): {
+                int64* vals = (int64*)outbuf;
+                for (int i = 0; i < nvals; ++i) {
+                    curr += (uint64)vals[i];
+                    vals[i] = (int64)curr;
+                }
+                break;
+            }
+            default:
+                for (int i = 0; i < nvals; ++i) {
+                    char* ptr = outbuf + i * m_eachValSize;
+                    curr += (uint64)ConvertToInt64Data(ptr, m_eachValSize) & ((1ULL << (m_eachValSize * 8)) - 1);
+                    Int64DataConvertTo((int64)curr, m_eachValSize, ptr);
+                }
+                break;
+        }
+    }
+    return outsize;
+}
+
+/*************************************************************************
+ *                  FSST Static Symbol Table Compression                  *
+ *************************************************************************/
+// bytes of the sample the symbol table is trained on, and the number of training rounds.
+#define FSST_SAMPLE_SIZE (16 * 1024)
+#define FSST_TRAIN_ROUNDS 5
+// slots of the candidates hash table, which is twice more than candidates of one round
+#define FSST_CANDIDATE_SLOTS (4 * FSST_SAMPLE_SIZE)
+
+typedef struct FsstCandidate {
+    uint64 symbol;
+    uint32 gain;
+    uint8 len;
+} FsstCandidate;
+
+static FORCE_INLINE uint64 FsstLoadSymbol(const uint8* in, int len)
+{
+    uint64 symbol = 0;
+    if (len >= FSST_MAX_SYMBOL_LEN) {
+        symbol = *(const uint64*)in;
+    } else if (len > 0) {
+        errno_t rc = memcpy_s(&symbol, sizeof(uint64), in, len);
+        securec_check(rc, "\0", "\0");
+    }
+    return symbol;
+}
+
+static FORCE_INLINE uint64 FsstSymbolMask(int len)
+{
+    return (len >= FSST_MAX_SYMBOL_LEN) ? ~0ULL : ((1ULL << (len * 8)) - 1);
+}
+
+// accumulate the gain of one candidate symbol
+static void FsstAddCandidate(FsstCandidate* slots, uint64 symbol, int len, uint32 gain)
+{
+    uint32 pos = (uint32)((symbol * 0x9E3779B97F4A7C15ULL + len) >> 40) & (FSST_CANDIDATE_SLOTS - 1);
+    while (slots[pos].len != 0 && (slots[pos].symbol != symbol || slots[pos].len != len)) {
+        pos = (pos + 1) & (FSST_CANDIDATE_SLOTS - 1);
+    }
+    slots[pos].symbol = symbol;
+    slots[pos].len = (uint8)len;
+    slots[pos].gain += gain;
+}
+
+// the more bytes saved, the earlier. ties are broken by the symbol itself to stay deterministic.
+static int FsstCompareCandidates(const void* a, const void* b)
+{
+    const FsstCandidate* ca = (const FsstCandidate*)a;
+    const FsstCandidate* cb = (const FsstCandidate*)b;
+    if (ca->gain != cb->gain) {
+        return (ca->gain > cb->gain) ? -1 : 1;
+    }
+    if (ca->len != cb->len) {
+        return (ca->len > cb->len) ? -1 : 1;
+    }
+    if (ca->symbol != cb->symbol) {
+        return (ca->symbol < cb->symbol) ? -1 : 1;
+    }
+    return 0;
+}
+
+FsstCoder::FsstCoder() : m_symbolsNum(0), m_encodedSize(0), m_encoded(NULL)
+{
+    errno_t rc = memset_s(m_firstByteStart, sizeof(m_firstByteStart), 0, sizeof(m_firstByteStart));
+    securec_check(rc, "\0", "\0");
+}
+
+void FsstCoder::BuildLookupIndex(void)
+{
+    uint16 counts[256] = {0};
+    for (int i = 0; i < m_symbolsNum; ++i) {
+        ++counts[(uint8)m_symbols[i]];
+    }
+    m_firstByteStart[0] = 0;
+    for (int b = 0; b < 256; ++b) {
+        m_firstByteStart[b + 1] = m_firstByteStart[b] + counts[b];
+    }
+
+    // place symbols from the longest to the shortest, so that the first matched one is the longest
+    uint16 next[256];
+    errno_t rc = memcpy_s(next, sizeof(next), m_firstByteStart, sizeof(next));
+    securec_check(rc, "\0", "\0");
+    for (int len = FSST_MAX_SYMBOL_LEN; len > 0; --len) {
+        for (int i = 0; i < m_symbolsNum; ++i) {
+            if (m_symbolLens[i] == len) {
+                m_byFirstByte[next[(uint8)m_symbols[i]]++] = (uint8)i;
+            }
+        }
+    }
+}
+
+// return the code of the longest symbol <in> starts with, or -1 if there isn't any.
+int FsstCoder::FindLongestSymbol(const uint8* in, int len) const
+{
+    int start = m_firstByteStart[in[0]];
+    int end = m_firstByteStart[in[0] + 1];
+    if (start == end) {
+        return -1;
+    }
+
+    uint64 word = FsstLoadSymbol(in, (len < FSST_MAX_SYMBOL_LEN) ? len : FSST_MAX_SYMBOL_LEN);
+    for (int i = start; i < end; ++i) {
+        int code = m_byFirstByte[i];
+        int symLen = m_symbolLens[code];
+        if (symLen <= len && ((word ^ m_symbols[code]) & FsstSymbolMask(symLen)) == 0) {
+            return code;
+        }
+    }
+    return -1;
+}
+
+// train the symbol table. each round encodes the sample with the current table, and then keeps the
+// symbols and the concatenations of neighbouring symbols which save the most bytes.
+void FsstCoder::BuildSymbolTable(char* inbuf, int insize, int numVals)
+{
+    // take values evenly distributed over the input as the sample
+    int stride = (insize > FSST_SAMPLE_SIZE) ? (insize / FSST_SAMPLE_SIZE) : 1;
+    int* sampleOffs = (int*)palloc(sizeof(int) * numVals);
+    int* sampleLens = (int*)palloc(sizeof(int) * numVals);
+    int sampleNum = 0;
+    int sampleSize = 0;
+    int inpos = 0;
+    for (int i = 0; i < numVals && sampleSize < FSST_SAMPLE_SIZE; ++i) {
+        int len = VARSIZE_ANY(inbuf + inpos);
+        if ((i % stride) == 0) {
+            sampleOffs[sampleNum] = inpos;
+            sampleLens[sampleNum] = Min(len, FSST_SAMPLE_SIZE - sampleSize);
+            sampleSize += sampleLens[sampleNum];
+            ++sampleNum;
+        }
+        inpos += len;
+    }
+
+    FsstCandidate* slots = (FsstCandidate*)palloc(sizeof(FsstCandidate) * FSST_CANDIDATE_SLOTS);
+    m_symbolsNum = 0;
+    BuildLookupIndex();
+
+    for (int round = 0; round < FSST_TRAIN_ROUNDS; ++round) {
+        errno_t rc = memset_s(slots, sizeof(FsstCandidate) * FSST_CANDIDATE_SLOTS, 0,
+            sizeof(FsstCandidate) * FSST_CANDIDATE_SLOTS);
+        securec_check(rc, "\0", "\0");
+
+        for (int i = 0; i < sampleNum; ++i) {
+            const uint8* val = (const uint8*)inbuf + sampleOffs[i];
+            int len = sampleLens[i];
+            uint64 prev = 0;
+            int prevLen = 0;
+            int pos = 0;
+            while (pos < len) {
+                int code = FindLongestSymbol(val + pos, len - pos);
+                uint64 curr = (code >= 0) ? m_symbols[code] : val[pos];
+                int currLen = (code >= 0) ? m_symbolLens[code] : 1;
+
+                // an escaped byte takes 2 bytes, so a single byte symbol saves 1 byte too
+                FsstAddCandidate(slots, curr, currLen, (uint32)currLen);
+                if (prevLen > 0 && prevLen + currLen <= FSST_MAX_SYMBOL_LEN) {
+                    FsstAddCandidate(slots, prev | (curr << (prevLen * 8)), prevLen + currLen,
+                        (uint32)(prevLen + currLen));
+                }
+                prev = curr;
+                prevLen = currLen;
+                pos += currLen;
+            }
+        }
+
+        // compact the candidates, and keep the best ones
+        int candNum = 0;
+        for (int i = 0; i < FSST_CANDIDATE_SLOTS; ++i) {
+            if (slots[i].len != 0) {
+                slots[candNum++] = slots[i];
+            }
+        }
+        qsort(slots, candNum, sizeof(FsstCandidate), FsstCompareCandidates);
+
+        m_symbolsNum = Min(candNum, FSST_MAX_SYMBOLS);
+        for (int i = 0; i < m_symbolsNum; ++i) {
+            m_symbols[i] = slots[i].symbol;
+            m_symbolLens[i] = slots[i].len;
+        }
+        BuildLookupIndex();
+    }
+
+    pfree(slots);
+    pfree(sampleOffs);
+    pfree(sampleLens);
+}
+
+// return the encoded size, or -1 if <out> isn't big enough.
+int FsstCoder::EncodeBytes(const uint8* in, int len, uint8* out, const uint8* outEnd) const
+{
+    uint8* outStart = out;
+    int pos = 0;
+    while (pos < len) {
+        if (out + 2 > outEnd) {
+            return -1;
+        }
+        int code = FindLongestSymbol(in + pos, len - pos);
+        if (code >= 0) {
+            *out++ = (uint8)code;
+            pos += m_symbolLens[code];
+        } else {
+            *out++ = FSST_ESCAPE_CODE;
+            *out++ = in[pos++];
+        }
+    }
+    return (int)(out - outStart);
+}
+
+// return the decoded size, or -1 if <out> isn't big enough.
+int FsstCoder::DecodeBytes(const uint8* in, int len, char* out, const char* outEnd) const
+{
+    const uint8* inEnd = in + len;
+    char* outStart = out;
+    while (in < inEnd) {
+        uint8 code = *in++;
+        if (code == FSST_ESCAPE_CODE) {
+            if (in >= inEnd || out >= outEnd) {
+                return -1;
+            }
+            *out++ = (char)*in++;
+            continue;
+        }
+        if (code >= m_symbolsNum) {
+            return -1;
+        }
+        int symLen = m_symbolLens[code];
+        if (out + FSST_MAX_SYMBOL_LEN <= outEnd) {
+            // store all the 8 bytes, and the padding is overwritten by the following bytes
+            *(uint64*)out = m_symbols[code];
+        } else if (out + symLen <= outEnd) {
+            errno_t rc = memcpy_s(out, symLen, &m_symbols[code], symLen);
+            securec_check(rc, "\0", "\0");
+        } else {
+            return -1;
+        }
+        out += symLen;
+    }
+    return (int)(out - outStart);
+}
+
+int FsstCoder::Compress(char* inbuf, int insize, int numVals, char* outbuf, int maxsize)
+{
+    Assert(insize > 0 && numVals > 0);
+    BuildSymbolTable(inbuf, insize, numVals);
+
+    int symbolBytes = 0;
+    for (int i = 0; i < m_symbolsNum; ++i) {
+        symbolBytes += m_symbolLens[i];
+    }
+    int headerSize = 1 + m_symbolsNum + symbolBytes + (int)sizeof(uint32);
+    if (headerSize >= maxsize) {
+        return 0;
+    }
+
+    uint8* out = (uint8*)outbuf;
+    const uint8* outEnd = (const uint8*)outbuf + maxsize;
+    *out++ = (uint8)m_symbolsNum;
+    for (int i = 0; i < m_symbolsNum; ++i) {
+        *out++ = m_symbolLens[i];
+    }
+    for (int i = 0; i < m_symbolsNum; ++i) {
+        errno_t rc = memcpy_s(out, m_symbolLens[i], &m_symbols[i], m_symbolLens[i]);
+        securec_check(rc, "\0", "\0");
+        out += m_symbolLens[i];
+    }
+    uint32* encodedSize = (uint32*)out;
+    uint8* encoded = out + sizeof(uint32);
+
+    // the values are stored one after another, so they are encoded as a single byte stream
+    int size = EncodeBytes((const uint8*)inbuf, insize, encoded, outEnd);
+    if (size < 0) {
+        return 0;
+    }
+    *encodedSize = (uint32)size;
+
+    int cmprSize = (int)((encoded + size) - (uint8*)outbuf);
+    return (cmprSize < maxsize) ? cmprSize : 0;
+}
+
+void FsstCoder::Load(char* inbuf, int insize)
+{
+    const uint8* in = (const uint8*)inbuf;
+    m_symbolsNum = *in++;
+    const uint8* symbolBytes = in + m_symbolsNum;
+    for (int i = 0; i < m_symbolsNum; ++i) {
+        m_symbolLens[i] = in[i];
+        Assert(m_symbolLens[i] > 0 && m_symbolLens[i] <= FSST_MAX_SYMBOL_LEN);
+        m_symbols[i] = FsstLoadSymbol(symbolBytes, m_symbolLens[i]);
+        symbolBytes += m_symbolLens[i];
+    }
+    BuildLookupIndex();
+
+    m_encodedSize = (int)*(const uint32*)symbolBytes;
+    m_encoded = symbolBytes + sizeof(uint32);
+    Assert(m_encoded + m_encodedSize <= (const uint8*)inbuf + insize);
+}
+
+int FsstCoder::Decompress(char* outbuf, int outsize) const
+{
+    int size = DecodeBytes(m_encoded, m_encodedSize, outbuf, outbuf + outsize);
+    return (size == outsize) ? size : -1;
+}
+
 /*************************************************************************
  *                         Dictionary Compression                         *
  *************************************************************************/
@@ -297,7 +297,12 @@ static FORCE_INLINE void swapBuf(char *&buf1, char *&buf2, int &sz1, int &sz2)
 }
 
 IntegerCoder::IntegerCoder(short valSize)
-    : m_adopt_rle(true), m_minVal(0), m_maxVal(0), m_isValid(false), m_eachValSize(valSize)
+    : m_adopt_rle(true),
+      m_adopt_bitpack(true),
+      m_minVal(0),
+      m_maxVal(0),
+      m_isValid(false),
+      m_eachValSize(valSize)
 {}
 
 void IntegerCoder::SetMinMaxVal(int64 min, int64 max)
@@ -401,11 +406,29 @@ int IntegerCoder::CompressInner(const CompressionArg1& in, CompressionArg2& out)
         }
     }
 
+    // Step 2.5: if RLE doesn't help, try to pack the differences from the frame in the fewest bits.
+    // it replaces byte-aligned DELTA compression, and is decompressed in one pass.
+    if (this->m_adopt_bitpack && (out.modes & CU_RLECompressed) == 0) {
+        int currSize = (out.modes & CU_DeltaCompressed) ? (currInBufSize + this->m_eachValSize * 2) : currInBufSize;
+        BitpackCoder bitpack(this->m_eachValSize);
+        cmprSize = bitpack.Compress(in.buf, tempOutBuf.buf, in.sz, currSize, this->m_minVal, this->m_maxVal);
+        if (cmprSize > 0) {
+            Assert(cmprSize < currSize && (Size)cmprSize < tempOutBuf.bufSize);
+            rc = memcpy_s(out.buf, cmprSize, tempOutBuf.buf, cmprSize);
+            securec_check(rc, "", "");
+            out.sz = cmprSize;
+            out.modes = CU_BitpackCompressed;
+
+            currInBuf = out.buf;
+            currInBufSize = cmprSize;
+        }
+    }
+
     // Step3: try to apply LZ4 or Zlib according to CompressLevel
     // Apply different compression method for compressionLevel
-    // COMPRESS_LOW:    delta compression | RleCoder
-    // COMPRESS_MIDDLE: delta compression | RleCoder | LZ4
-    // COMPRESS_HIGH:   delta compression | RleCoder | Zlib
+    // COMPRESS_LOW:    delta compression | RleCoder | bit packing
+    // COMPRESS_MIDDLE: delta compression | RleCoder | bit packing | LZ4
+    // COMPRESS_HIGH:   delta compression | RleCoder | bit packing | Zlib
     // We can skip LZ4/Zlib compression when level is COMPRESS_MIDDLE or COMPRESS_HIGH
     if (compression == COMPRESS_LOW) {
         BufferHelperFree(&tempOutBuf);
@@ -559,6 +582,21 @@ int IntegerCoder::Decompress(_in_ const CompressionArg2& in, _out_ CompressionAr
         }
     }
 
+    if ((modes & CU_BitpackCompressed) != 0) {
+        // bit packing restores the raw values by itself, neither RLE nor DELTA is applied with it.
+        Assert((modes & (CU_RLECompressed | CU_DeltaCompressed)) == 0);
+
+        BitpackCoder bitpack(m_eachValSize);
+        nextOutSize = bitpack.Decompress(nextInBuf, nextOutBuf, nextInSize, out.sz);
+        Assert(nextOutSize == out.sz);
+
+        if (preparedOk) {
+            swapBuf(nextInBuf, nextOutBuf, nextInSize, nextOutSize);
+        } else {
+            prepareSwapBuf(nextInBuf, nextOutBuf, nextInSize, nextOutSize, tmpBuf.buf, out.sz, preparedOk);
+        }
+    }
+
     if ((modes & CU_RLECompressed) != 0) {
         // case 1: both delta and rle methods are applied to, the value size is inValSize,
         //         which is the size of DELTA value.
@@ -739,7 +777,21 @@ int StringCoder::CompressInner(CompressionArg1& in, CompressionArg2& out)
      * 2. caller give the hint which don't adopt dictionary compression.
      */
     cmprSize = this->CompressWithoutDict(in.buf, in.sz, in.mode, out.buf, out.sz, mode);
-    if (cmprSize > 0 && cmprSize < in.sz) {
+    if (cmprSize <= 0 || cmprSize >= in.sz) {
+        cmprSize = 0;
+        mode = 0;
+    }
+
+    /* a static symbol table decodes faster than lz4/zlib, so prefer it unless lz4/zlib is smaller */
+    if (in.useFsst && m_adopt_fsst && in.numVals > 0) {
+        int fsstSize = this->CompressWithFsst(in, cmprSize, out);
+        if (fsstSize > 0) {
+            out.modes |= CU_FSSTCompressed;
+            return fsstSize;
+        }
+    }
+
+    if (cmprSize > 0) {
         out.modes |= mode;
         return cmprSize;
     }
@@ -813,6 +865,22 @@ int StringCoder::CompressWithoutDict(_in_ char* inBuf, _in_ int inBufSize, _in_
     return outSize;
 }
 
+int StringCoder::CompressWithFsst(_in_ CompressionArg1& in, _in_ int cmprSize, _out_ CompressionArg2& out)
+{
+    int maxSize = (cmprSize > 0) ? (cmprSize + 1) : Min(in.sz, out.sz);
+    char* tmpOutBuf = (char*)palloc(maxSize);
+
+    FsstCoder fsst;
+    int outSize = fsst.Compress(in.buf, in.sz, in.numVals, tmpOutBuf, maxSize);
+    if (outSize > 0) {
+        Assert(outSize <= out.sz);
+        errno_t rc = memcpy_s(out.buf, outSize, tmpOutBuf, outSize);
+        securec_check(rc, "", "");
+    }
+    pfree(tmpOutBuf);
+    return outSize;
+}
+
 int StringCoder::DecompressWithoutDict(
     _in_ char* inBuf, _in_ int inBufSize, _in_ uint16 mode, _out_ char* outBuf, _out_ int outBufSize)
 {
@@ -844,6 +912,13 @@ int StringCoder::DecompressWithoutDict(
 
 int StringCoder::Decompress(_in_ const CompressionArg2& in, _out_ CompressionArg1& out)
 {
+    // case 0: values are compressed with a static symbol table
+    if (CU_IS_FSST_COMPRESSED(in.modes)) {
+        FsstCoder fsst;
+        fsst.Load(in.buf, in.sz);
+        return fsst.Decompress(out.buf, out.sz);
+    }
+
     // case 1: dictionary method is not applied to, so use lz4/zlib directly to decompress
     if ((in.modes & CU_DicEncode) == 0) {
         return DecompressWithoutDict(in.buf, in.sz, in.modes, out.buf, out.sz);
@@ -853,10 +928,11 @@ int StringCoder::Decompress(_in_ const CompressionArg2& in, _out_ CompressionArg
     DicCoder* dict = New(CurrentMemoryContext) DicCoder(in.buf);
     DictHeader* dictHeader = dict->GetHeader();
     DecompressNumbers(in.buf + dictHeader->m_totalSize, in.sz - dictHeader->m_totalSize, in.modes, out.buf, out.sz);
+    m_dicItemsNum = (int)dictHeader->m_itemsCount;
     int outSize = dict->Decompress((char*)m_dicCodes, m_dicCodesNum * sizeof(DicCodeType), out.buf, out.sz);
     delete dict;
 
-    if (m_dicCodes) {
+    if (m_dicCodes && !m_keep_dic_codes) {
         pfree(m_dicCodes);
         m_dicCodes = NULL;
     }
@@ -864,6 +940,18 @@ int StringCoder::Decompress(_in_ const CompressionArg2& in, _out_ CompressionArg
     return outSize;
 }
 
+DicCodeType* StringCoder::DetachDicCodes(_out_ int& codesNum, _out_ int& itemsNum)
+{
+    DicCodeType* codes = m_dicCodes;
+    codesNum = (codes != NULL) ? (int)m_dicCodesNum : 0;
+    itemsNum = (codes != NULL) ? m_dicItemsNum : 0;
+
+    m_dicCodes = NULL;
+    m_dicCodesNum = 0;
+    m_dicItemsNum = 0;
+    return codes;
+}
+
 ///
 /// DeltaPlusRLEv2 Implements
 ///
@@ -2870,6 +2958,8 @@ void compression_options::reset(void)
     m_adopt_numeric2int_int64_rle = true;
     m_adopt_dict = true;
     m_adopt_rle = true;
+    m_adopt_bitpack = true;
+    m_adopt_fsst = true;
 }
 
 /*
@@ -2891,8 +2981,11 @@ void compression_options::set_numeric_flags(uint16 modes)
  */
 void compression_options::set_common_flags(uint32 modes)
 {
-    m_adopt_dict = ((modes & CU_DicEncode) != 0);
+    m_adopt_fsst = CU_IS_FSST_COMPRESSED(modes);
+    m_adopt_dict = ((modes & CU_DicEncode) != 0) && !m_adopt_fsst;
     m_adopt_rle = ((modes & CU_RLECompressed) != 0);
+    /* values with a narrow range are either bit packed or RLE encoded after DELTA */
+    m_adopt_bitpack = ((modes & (CU_BitpackCompressed | CU_DeltaCompressed)) != 0);
 }
 
 #ifdef ENABLE_UT
@@ -37,6 +37,7 @@
 #include "pgstat.h"
 #include "catalog/pg_type.h"
 #include "access/cstore_am.h"
+#include "access/cstore_bloom.h"
 #include "storage/custorage.h"
 #include "storage/remote_read.h"
 #include "utils/builtins.h"
@@ -55,7 +56,11 @@
 #include "vecexecutor/vecnodes.h"
 #include "vecexecutor/vecnoderowtovector.h"
 #include "access/cstore_roughcheck_func.h"
+#include "access/tupmacs.h"
 #include "utils/snapmgr.h"
+#include "utils/array.h"
+#include "utils/lsyscache.h"
+#include "catalog/pg_proc.h"
 #include "catalog/storage.h"
 #include "miscadmin.h"
 #include "access/htup.h"
@@ -111,12 +116,22 @@ CStore::CStore()
       m_prefetch_quantity(0),
       m_prefetch_threshold(0),
       m_load_finish(false),
+      m_prefetchCursor(0),
+      m_prefetchLastCursor(-1),
+      m_cacheStrategy(NULL),
       m_scanPosInCU(NULL),
       m_RCFuncs(NULL),
+      m_cuPreds(NULL),
+      m_cuPredNum(0),
+      m_cuPredItemState(NULL),
+      m_cuPredCUId(InValidCUID),
+      m_cuBloomPreds(NULL),
+      m_cuBloomPredNum(0),
       m_fillVectorByTids(NULL),
       m_fillVectorLateRead(NULL),
       m_colFillFunArrary(NULL),
       m_fillMinMaxFunc(NULL),
+      m_RCNegFuncs(NULL),
       m_scanFunc(NULL),
       m_plan_node_id(-1),
       m_colNum(0),
@@ -156,7 +171,8 @@ void CStore::BindingFp(CStoreScanState* state)
     ProjectionInfo* proj = state->ps.ps_ProjInfo;
 
     if (proj->pi_maxOrmin) {
-        Assert(list_length(proj->pi_maxOrmin) == list_length(proj->pi_acessedVarNumbers));
+        /* the columns only referenced by quals follow the targetlist ones */
+        Assert(list_length(proj->pi_maxOrmin) <= list_length(proj->pi_acessedVarNumbers));
         m_scanFunc = &CStore::CStoreMinMaxScan;
         m_fillMinMaxFunc = (fillMinMaxFuncPtr*)palloc0(sizeof(fillMinMaxFuncPtr) * m_colNum);
 
@@ -178,6 +194,9 @@ void CStore::BindingFp(CStoreScanState* state)
                     break;
                 }
             }
+
+            /* min/max scan fills every column itself, there is no late read */
+            m_lateRead[i] = false;
         }
     }
 
@@ -312,6 +331,290 @@ void CStore::InitRoughCheckEnv(CStoreScanState* state)
             int colIdx = m_colId[scanKey[i].cs_attno];
             m_RCFuncs[i] = GetRoughCheckFunc(attrs[colIdx]->atttypid, scanKey[i].cs_strategy, scanKey[i].cs_collation);
         }
+
+        /*
+         * Min/max scan with quals: all the quals must be scan keys, so that a CU
+         * missing every negated key can be answered by its min/max.
+         * "col = c" is negated to "col < c" or "col > c".
+         */
+        if (m_scanFunc == &CStore::CStoreMinMaxScan && list_length(state->ps.plan->qual) == nkeys) {
+            m_RCNegFuncs = (RoughCheckFunc*)palloc0(sizeof(RoughCheckFunc) * nkeys * 2);
+            for (int i = 0; i < nkeys; i++) {
+                Oid typeOid = attrs[m_colId[scanKey[i].cs_attno]]->atttypid;
+                Oid collation = scanKey[i].cs_collation;
+                CStoreStrategyNumber negStrategy[2] = {InvalidCStoreStrategy, InvalidCStoreStrategy};
+
+                switch (scanKey[i].cs_strategy) {
+                    case CStoreLessStrategyNumber:
+                        negStrategy[0] = CStoreGreaterEqualStrategyNumber;
+                        break;
+                    case CStoreLessEqualStrategyNumber:
+                        negStrategy[0] = CStoreGreaterStrategyNumber;
+                        break;
+                    case CStoreEqualStrategyNumber:
+                        negStrategy[0] = CStoreLessStrategyNumber;
+                        negStrategy[1] = CStoreGreaterStrategyNumber;
+                        break;
+                    case CStoreGreaterEqualStrategyNumber:
+                        negStrategy[0] = CStoreLessStrategyNumber;
+                        break;
+                    case CStoreGreaterStrategyNumber:
+                        negStrategy[0] = CStoreLessEqualStrategyNumber;
+                        break;
+                    default:
+                        break;
+                }
+
+                /* an unknown strategy rough checks all through, so the CU never matches totally */
+                m_RCNegFuncs[2 * i] = GetRoughCheckFunc(typeOid, negStrategy[0], collation);
+                if (negStrategy[1] != InvalidCStoreStrategy) {
+                    m_RCNegFuncs[2 * i + 1] = GetRoughCheckFunc(typeOid, negStrategy[1], collation);
+                }
+            }
+        }
+    }
+}
+
+/*
+ * @Description: collect the quals which can be evaluated on dictionary or RLE encoded CUs.
+ *     only "column op const" and "column op ANY/ALL(const array)" with a strict and
+ *     non-volatile operator are supported, such as =, IN, LIKE and range predicates.
+ *     these quals are still evaluated by the executor later, so it's just a filter
+ *     skipping the rows which would fail them anyway.
+ * @Param[IN] state: cstore scan state
+ * @See also: ApplyCUPredicatesIfNeed()
+ */
+void CStore::InitCUPredicateEnv(CStoreScanState* state)
+{
+    Plan* plan = state->ps.plan;
+    if (m_colNum == 0 || plan == NULL || !IsA(plan, CStoreScan) || plan->qual == NIL || state->isSampleScan) {
+        return;
+    }
+
+    // the following spaces will live until deconstructor is called.
+    // so use m_scanMemContext which is not freed at all until the end.
+    AutoContextSwitch newMemCnxt(m_scanMemContext);
+
+    Form_pg_attribute* attrs = m_relation->rd_att->attrs;
+    ListCell* lc = NULL;
+
+    m_cuPreds = (CUPredicate*)palloc0(sizeof(CUPredicate) * list_length(plan->qual));
+    foreach (lc, plan->qual) {
+        Expr* clause = (Expr*)lfirst(lc);
+        Node* leftop = NULL;
+        Node* rightop = NULL;
+        Oid opfuncid = InvalidOid;
+        Oid collation = InvalidOid;
+        bool isArrayOp = false;
+        bool useOr = false;
+
+        if (IsA(clause, OpExpr) && list_length(((OpExpr*)clause)->args) == 2) {
+            OpExpr* op = (OpExpr*)clause;
+            opfuncid = op->opfuncid;
+            collation = op->inputcollid;
+            leftop = (Node*)linitial(op->args);
+            rightop = (Node*)lsecond(op->args);
+        } else if (IsA(clause, ScalarArrayOpExpr)) {
+            ScalarArrayOpExpr* saop = (ScalarArrayOpExpr*)clause;
+            opfuncid = saop->opfuncid;
+            collation = saop->inputcollid;
+            leftop = (Node*)linitial(saop->args);
+            rightop = (Node*)lsecond(saop->args);
+            isArrayOp = true;
+            useOr = saop->useOr;
+        } else {
+            continue;
+        }
+
+        if (leftop != NULL && IsA(leftop, RelabelType)) {
+            leftop = (Node*)((RelabelType*)leftop)->arg;
+        }
+        if (leftop == NULL || !IsA(leftop, Var) || rightop == NULL || !IsA(rightop, Const) ||
+            ((Const*)rightop)->constisnull) {
+            continue;
+        }
+
+        Var* var = (Var*)leftop;
+        if (var->varattno <= 0 || var->varlevelsup != 0 || !OidIsValid(opfuncid) || !func_strict(opfuncid) ||
+            func_volatile(opfuncid) == PROVOLATILE_VOLATILE) {
+            continue;
+        }
+
+        int seq = -1;
+        for (int i = 0; i < m_colNum; ++i) {
+            if (m_colId[i] == var->varattno - 1) {
+                seq = i;
+                break;
+            }
+        }
+
+        // only the dictionary of strings and the runs of integers are known
+        int attlen = (seq >= 0) ? attrs[m_colId[seq]]->attlen : 0;
+        if (attlen != -1 && attlen != sizeof(char) && attlen != sizeof(int16) && attlen != sizeof(int32) &&
+            attlen != sizeof(Datum)) {
+            continue;
+        }
+
+        CUPredicate* pred = m_cuPreds + m_cuPredNum;
+        Datum constVal = ((Const*)rightop)->constvalue;
+        if (!isArrayOp) {
+            pred->args = (Datum*)palloc(sizeof(Datum));
+            pred->args[0] = constVal;
+            pred->nargs = 1;
+        } else {
+            ArrayType* arr = DatumGetArrayTypeP(constVal);
+            int16 typlen;
+            bool typbyval = false;
+            char typalign;
+            Datum* elems = NULL;
+            bool* elemNulls = NULL;
+            int nelems = 0;
+
+            get_typlenbyvalalign(ARR_ELEMTYPE(arr), &typlen, &typbyval, &typalign);
+            deconstruct_array(arr, ARR_ELEMTYPE(arr), typlen, typbyval, typalign, &elems, &elemNulls, &nelems);
+
+            // ALL() is true for NULL rows if the array is empty, and never true if
+            // any element is NULL. leave these rare cases to the executor.
+            pred->args = (Datum*)palloc(sizeof(Datum) * Max(nelems, 1));
+            pred->nargs = 0;
+            bool skip = (!useOr && nelems == 0);
+            for (int i = 0; i < nelems && !skip; ++i) {
+                if (!elemNulls[i]) {
+                    pred->args[pred->nargs++] = elems[i];
+                } else if (!useOr) {
+                    skip = true;
+                }
+            }
+            if (skip) {
+                pfree_ext(pred->args);
+                continue;
+            }
+        }
+
+        pred->seq = seq;
+        pred->collation = collation;
+        pred->useOr = useOr;
+        fmgr_info(opfuncid, &pred->func);
+        ++m_cuPredNum;
+    }
+
+    if (m_cuPredNum > 0) {
+        m_cuPredItemState = (uint8*)palloc(sizeof(uint8) * (PG_UINT16_MAX + 1));
+    } else {
+        pfree_ext(m_cuPreds);
+    }
+}
+
+/*
+ * @Description: collect the "column = const" and "column = ANY(const array)" quals
+ *     which the per-CU bloom filters of a bloom_filter relation can answer, and hash
+ *     their consts once for the whole scan.
+ * @Param[IN] state: cstore scan state
+ * @See also: CUBloomExcludes(), RoughCheck()
+ */
+void CStore::InitCUBloomEnv(CStoreScanState* state)
+{
+    Plan* plan = state->ps.plan;
+    if (m_colNum == 0 || plan == NULL || !IsA(plan, CStoreScan) || plan->qual == NIL || state->isSampleScan ||
+        !RelationBloomFilterEnabled(m_relation)) {
+        return;
+    }
+
+    AutoContextSwitch newMemCnxt(m_scanMemContext);
+
+    Form_pg_attribute* attrs = m_relation->rd_att->attrs;
+    ListCell* lc = NULL;
+
+    m_cuBloomPreds = (CUBloomPredicate*)palloc0(sizeof(CUBloomPredicate) * list_length(plan->qual));
+    foreach (lc, plan->qual) {
+        Expr* clause = (Expr*)lfirst(lc);
+        Node* leftop = NULL;
+        Node* rightop = NULL;
+        Oid opno = InvalidOid;
+        bool isArrayOp = false;
+
+        if (IsA(clause, OpExpr) && list_length(((OpExpr*)clause)->args) == 2) {
+            OpExpr* op = (OpExpr*)clause;
+            opno = op->opno;
+            leftop = (Node*)linitial(op->args);
+            rightop = (Node*)lsecond(op->args);
+        } else if (IsA(clause, ScalarArrayOpExpr) && ((ScalarArrayOpExpr*)clause)->useOr) {
+            ScalarArrayOpExpr* saop = (ScalarArrayOpExpr*)clause;
+            opno = saop->opno;
+            leftop = (Node*)linitial(saop->args);
+            rightop = (Node*)lsecond(saop->args);
+            isArrayOp = true;
+        } else {
+            continue;
+        }
+
+        if (leftop != NULL && IsA(leftop, RelabelType)) {
+            leftop = (Node*)((RelabelType*)leftop)->arg;
+        }
+        if (leftop == NULL || !IsA(leftop, Var) || rightop == NULL || !IsA(rightop, Const) ||
+            ((Const*)rightop)->constisnull) {
+            continue;
+        }
+
+        Var* var = (Var*)leftop;
+        if (var->varattno <= 0 || var->varlevelsup != 0) {
+            continue;
+        }
+
+        int seq = -1;
+        for (int i = 0; i < m_colNum; ++i) {
+            if (m_colId[i] == var->varattno - 1) {
+                seq = i;
+                break;
+            }
+        }
+
+        Oid argType = InvalidOid;
+        if (seq < 0 || !CUBloomIsUsableOp(opno, attrs[m_colId[seq]]->atttypid, &argType)) {
+            continue;
+        }
+
+        CUBloomPredicate* pred = m_cuBloomPreds + m_cuBloomPredNum;
+        Datum constVal = ((Const*)rightop)->constvalue;
+        if (!isArrayOp) {
+            pred->hashes = (uint32*)palloc(sizeof(uint32));
+            pred->hashes[0] = CUBloomHashDatum(argType, constVal);
+            pred->nhashes = 1;
+        } else {
+            ArrayType* arr = DatumGetArrayTypeP(constVal);
+            int16 typlen;
+            bool typbyval = false;
+            char typalign;
+            Datum* elems = NULL;
+            bool* elemNulls = NULL;
+            int nelems = 0;
+
+            get_typlenbyvalalign(ARR_ELEMTYPE(arr), &typlen, &typbyval, &typalign);
+            deconstruct_array(arr, ARR_ELEMTYPE(arr), typlen, typbyval, typalign, &elems, &elemNulls, &nelems);
+
+            // NULL elements never match, an empty array is left to the executor
+            pred->hashes = (uint32*)palloc(sizeof(uint32) * Max(nelems, 1));
+            pred->nhashes = 0;
+            for (int i = 0; i < nelems; ++i) {
+                if (!elemNulls[i]) {
+                    pred->hashes[pred->nhashes++] = CUBloomHashDatum(argType, elems[i]);
+                }
+            }
+            if (pred->nhashes == 0) {
+                pfree_ext(pred->hashes);
+                continue;
+            }
+        }
+
+        pred->seq = seq;
+        if (m_CUDescInfo[seq]->bloomMiss == NULL) {
+            m_CUDescInfo[seq]->bloomMiss = (bool*)palloc0(sizeof(bool) * u_sess->attr.attr_storage.max_loaded_cudesc);
+        }
+        ++m_cuBloomPredNum;
+    }
+
+    if (m_cuBloomPredNum == 0) {
+        pfree_ext(m_cuBloomPreds);
     }
 }
 
@@ -374,6 +677,12 @@ void CStore::InitScan(CStoreScanState* state, Snapshot snapshot)
 
     InitRoughCheckEnv(state);
 
+    InitCUPredicateEnv(state);
+
+    InitCUBloomEnv(state);
+
+    InitCacheStrategy(state);
+
     /* remember node id of this plan */
     m_plan_node_id = state->ps.plan->plan_node_id;
 }
@@ -391,12 +700,38 @@ CStore::~CStore()
     m_CUDescInfo = NULL;
     m_perScanMemCnxt = NULL;
     m_RCFuncs = NULL;
+    m_RCNegFuncs = NULL;
+    m_cuPreds = NULL;
+    m_cuPredItemState = NULL;
+    m_cuBloomPreds = NULL;
     m_CUDescIdx = NULL;
     m_colFillFunArrary = NULL;
     m_cuStorage = NULL;
     m_relation = NULL;
     m_fillMinMaxFunc = NULL;
     m_sysColId = NULL;
+    m_cacheStrategy = NULL;
+}
+
+/*
+ * @Description: give a sequential scan a small ring of CU cache slots, so that a
+ *     table larger than the cache reuses its own slots once it has read a quarter of
+ *     the cache, instead of evicting the hot CUs of the other queries.
+ *     index scans and sample scans read few CUs and keep the plain replacement.
+ * @IN state: cstore scan state
+ * @See also: GetCacheAccessStrategy
+ */
+void CStore::InitCacheStrategy(CStoreScanState* state)
+{
+    Plan* plan = state->ps.plan;
+    if (plan == NULL || !IsA(plan, CStoreScan) || state->isSampleScan || OnlySysOrConstCol()) {
+        return;
+    }
+
+    // every batch keeps one CU of each column pinned, so the ring holds a few CUs per column
+    AutoContextSwitch newMemCnxt(m_scanMemContext);
+    int ringSize = Min(Max(m_colNum, 1) * CSTORE_RING_CU_PER_COLUMN, CSTORE_RING_MAX_SLOTS);
+    m_cacheStrategy = GetCacheAccessStrategy(ringSize, CUCache->m_cstoreMaxSize / 4);
 }
 
 void CStore::Destroy()
@@ -652,6 +987,56 @@ void CStore::CUListPrefetch()
     m_lastNumCUDescIdx = m_NumCUDescIdx;
 }
 
+/*
+ * @Description: read ahead for the scans without ADIO. hint the kernel to read
+ *     the CUs after the cursor which passed the rough check, until
+ *     cstore_prefetch_quantity bytes are hinted, so that the IO of the next CUs
+ *     overlaps with decompressing and consuming the current one. the late read
+ *     columns are skipped, since they are only read for the matched rows, and
+ *     so are the CUs already in the CU cache, which need no IO at all.
+ * @See also: CUListPrefetch
+ */
+void CStore::CUWindowPrefetch()
+{
+    /* virtual cu not need load, or nothing consumed since the last call */
+    if (OnlySysOrConstCol() || m_cursor == m_prefetchLastCursor) {
+        return;
+    }
+    m_prefetchLastCursor = m_cursor;
+    m_prefetchCursor = Max(m_prefetchCursor, m_cursor);
+
+    /* the hinted CUs not consumed yet */
+    int64 quantity = 0;
+    for (int pos = m_cursor; pos < m_prefetchCursor; ++pos) {
+        for (int col = 0; col < m_colNum; ++col) {
+            if (!IsLateRead(col)) {
+                quantity += m_CUDescInfo[col]->cuDescArray[m_CUDescIdx[pos]].cu_size;
+            }
+        }
+    }
+
+    while (m_prefetchCursor < m_NumLoadCUDesc && quantity < m_prefetch_threshold) {
+        for (int col = 0; col < m_colNum; ++col) {
+            CUDesc* cudesc = &(m_CUDescInfo[col]->cuDescArray[m_CUDescIdx[m_prefetchCursor]]);
+            if (IsLateRead(col) || cudesc->cu_size <= 0) {
+                continue;
+            }
+            quantity += cudesc->cu_size;
+
+            /* like CUPrefetch, do not count the lookup as an access of the CU */
+            DataSlotTag dataSlotTag = CUCache->InitCUSlotTag((RelFileNodeOld *)&m_relation->rd_node, m_colId[col],
+                                                             cudesc->cu_id, cudesc->cu_pointer);
+            CacheSlotId_t slotId = CUCache->FindDataBlock(&dataSlotTag, false);
+            if (IsValidCacheSlotID(slotId)) {
+                CUCache->UnPinDataBlock(slotId);
+                continue;
+            }
+            m_cuStorage[m_colId[col]]->Prefetch(cudesc->cu_pointer, cudesc->cu_size);
+        }
+        ++m_prefetchCursor;
+    }
+}
+
 /*
  * @Description: aio clean up CU status
  * @See also:
@@ -874,6 +1259,7 @@ void CStore::CStoreScan(_in_ CStoreScanState* state, _out_ VectorBatch* vecBatch
         if (unlikely(m_NumLoadCUDesc == 0)) {
             return;
         }
+        CUWindowPrefetch();
     }
     ADIO_END();
 
@@ -968,6 +1354,8 @@ void CStore::LoadCUDescIfNeed()
     }
 
     m_NumLoadCUDesc = 0;
+    m_prefetchCursor = 0;
+    m_prefetchLastCursor = -1;
 
     Assert(m_perScanMemCnxt);
     // we reset when a batch of CUs have been scanned and handled.
@@ -1120,6 +1508,20 @@ void CStore::SetScanRange()
     m_endCUID = endCUID;
 }
 
+void CStore::SetScanCUIDRange(uint32 startCUID, uint32 endCUID)
+{
+    Assert(startCUID <= endCUID);
+
+    m_startCUID = startCUID;
+    m_endCUID = endCUID;
+    for (int i = 0; i < m_colNum; ++i) {
+        m_CUDescInfo[i]->Reset(m_startCUID);
+    }
+    if (m_virtualCUDescInfo != NULL) {
+        m_virtualCUDescInfo->Reset(m_startCUID);
+    }
+}
+
 void CStore::RefreshCursor(int row, int deadRows)
 {
     int cuRowCount = 0;
@@ -1171,9 +1573,49 @@ bool CStore::RoughCheck(CStoreScanKey scanKey, int nkeys, int cuDescIdx)
         if (!hitCU)
             break;
     }
+
+    // the bloom filters of CU have none of the consts of some equality qual
+    for (int i = 0; hitCU && i < m_cuBloomPredNum; ++i) {
+        if (m_CUDescInfo[m_cuBloomPreds[i].seq]->bloomMiss[cuDescIdx]) {
+            hitCU = false;
+        }
+    }
     return hitCU;
 }
 
+/*
+ * @Description: check whether all the values of the CU pass the scan keys, that's true
+ *     when the CU has min/max and no NULL value in the key columns, and misses the rough
+ *     check of every negated key.
+ * @Param[IN] cuDescIdx: index of cudesc info
+ * @Param[IN] nkeys: keys of scanKey
+ * @Param[IN] scanKey: cstore scan key
+ * @Return: true--all the rows pass, false--some rows may fail
+ * @See also: InitRoughCheckEnv()
+ */
+bool CStore::RoughCheckAllMatch(CStoreScanKey scanKey, int nkeys, int cuDescIdx)
+{
+    if (m_RCNegFuncs == NULL) {
+        return false;
+    }
+
+    for (int j = 0; j < nkeys; j++) {
+        int seq = scanKey[j].cs_attno;
+        CUDesc* cudesc = &(m_CUDescInfo[seq]->cuDescArray[cuDescIdx]);
+        if ((scanKey[j].cs_flags & SK_ISNULL) || cudesc->IsNullCU() || cudesc->CUHasNull() ||
+            cudesc->IsNoMinMaxCU()) {
+            return false;
+        }
+        if (m_RCNegFuncs[2 * j](cudesc, scanKey[j].cs_argument)) {
+            return false;
+        }
+        if (m_RCNegFuncs[2 * j + 1] != NULL && m_RCNegFuncs[2 * j + 1](cudesc, scanKey[j].cs_argument)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 void CStore::RoughCheckIfNeed(_in_ CStoreScanState* state)
 {
     int nkeys = state->csss_NumScanKeys;
@@ -1188,7 +1630,7 @@ void CStore::RoughCheckIfNeed(_in_ CStoreScanState* state)
         return;
     }
 
-    if (likely(nkeys == 0 || scanKey == NULL || m_colNum == 0)) {
+    if (likely(((nkeys == 0 || scanKey == NULL) && m_cuBloomPredNum == 0) || m_colNum == 0)) {
         /* when no where condition, we also need set m_lastNumCUDescIdx and m_NumCUDescIdx for prefetch once */
         ADIO_RUN()
         {
@@ -1280,6 +1722,7 @@ void CStore::InitReScan()
 
     m_delMaskCUId = InValidCUID;
     m_hasDeadRow = false;
+    m_cuPredCUId = InValidCUID;
     m_prefetch_quantity = 0;
 
     m_load_finish = false;
@@ -1301,6 +1744,8 @@ void CStore::InitReScan()
     m_NumCUDescIdx = 0;
     m_lastNumCUDescIdx = 0;
     m_cursor = 0;
+    m_prefetchCursor = 0;
+    m_prefetchLastCursor = -1;
     m_rowCursorInCU = 0;
     m_cuDescIdx = -1;
     m_laterReadCtidColIdx = -1;
@@ -1544,7 +1989,8 @@ HeapTuple CStore::FormVCCUDescTup(
 // nulls[]:  used during forming tuple.
 // pColAttr: attribute data of one column, who matches pCudesc above, for column-store table.
 HeapTuple CStore::FormCudescTuple(_in_ CUDesc* pCudesc, _in_ TupleDesc pCudescTupDesc,
-    _in_ Datum pTupVals[CUDescMaxAttrNum], _in_ bool pTupNulls[CUDescMaxAttrNum], _in_ Form_pg_attribute pColAttr)
+    _in_ Datum pTupVals[CUDescMaxAttrNum], _in_ bool pTupNulls[CUDescMaxAttrNum], _in_ Form_pg_attribute pColAttr,
+    _in_ const text* extra)
 {
     errno_t rc = memset_s(pTupNulls, CUDescMaxAttrNum, false, CUDescMaxAttrNum);
     securec_check(rc, "\0", "\0");
@@ -1589,8 +2035,12 @@ HeapTuple CStore::FormCudescTuple(_in_ CUDesc* pCudesc, _in_ TupleDesc pCudescTu
     pTupVals[CUDescCUMagicAttr - 1] = UInt32GetDatum(pCudesc->magic);
     Assert(pTupVals[CUDescCUMagicAttr - 1] > 0);
 
-    // add attribute extra and set null flag.
-    pTupNulls[CUDescCUExtraAttr - 1] = true;
+    // attribute extra holds the bloom filter of CU, if any.
+    if (extra != NULL) {
+        pTupVals[CUDescCUExtraAttr - 1] = PointerGetDatum(extra);
+    } else {
+        pTupNulls[CUDescCUExtraAttr - 1] = true;
+    }
 
     return heap_form_tuple(pCudescTupDesc, pTupVals, pTupNulls);
 }
@@ -2067,7 +2517,7 @@ CUPointer CStore::GetMaxCUPointer(_in_ int attrno, _in_ Relation rel)
 // rowstore. Note that we use attribute number in order to support
 // 'alter table add/drop table'.
 // attno is physical attribute number
-void CStore::SaveCUDesc(_in_ Relation rel, _in_ CUDesc* cuDescPtr, _in_ int col, int options)
+void CStore::SaveCUDesc(_in_ Relation rel, _in_ CUDesc* cuDescPtr, _in_ int col, int options, _in_ const text* extra)
 {
     Assert(rel != NULL);
     Assert(col >= 0);
@@ -2084,7 +2534,8 @@ void CStore::SaveCUDesc(_in_ Relation rel, _in_ CUDesc* cuDescPtr, _in_ int col,
 
     Datum values[CUDescMaxAttrNum];
     bool nulls[CUDescMaxAttrNum];
-    HeapTuple tup = CStore::FormCudescTuple(cuDescPtr, cudesc_rel->rd_att, values, nulls, rel->rd_att->attrs[col]);
+    HeapTuple tup =
+        CStore::FormCudescTuple(cuDescPtr, cudesc_rel->rd_att, values, nulls, rel->rd_att->attrs[col], extra);
 
     // We always generate xlog for cudesc tuple
     options &= (~HEAP_INSERT_SKIP_WAL);
@@ -2276,6 +2727,12 @@ bool CStore::LoadCUDesc(
         cuDescArray[loadCUDescInfoPtr->curLoadNum].magic = DatumGetUInt32(values[CUDescCUMagicAttr - 1]);
         Assert(!isnull[CUDescCUMagicAttr - 1]);
 
+        /* Check the bloom filter of CU against the equality quals */
+        if (loadCUDescInfoPtr->bloomMiss != NULL) {
+            loadCUDescInfoPtr->bloomMiss[loadCUDescInfoPtr->curLoadNum] =
+                !isnull[CUDescCUExtraAttr - 1] && CUBloomExcludes(col, values[CUDescCUExtraAttr - 1]);
+        }
+
         found = true;
 
         IncLoadCuDescIdx(*(int*)&loadCUDescInfoPtr->curLoadNum);
@@ -2306,6 +2763,195 @@ bool CStore::LoadCUDesc(
     return false;
 }
 
+/*
+ * @Description: evaluate a CU predicate on the given value.
+ * @Return: true if the qual is true, false if it's false or NULL.
+ */
+static bool EvalCUPredicate(CUPredicate* pred, Datum value)
+{
+    FunctionCallInfoData fcinfo;
+    InitFunctionCallInfoData(fcinfo, &pred->func, 2, pred->collation, NULL, NULL);
+    fcinfo.arg[0] = value;
+    fcinfo.argnull[0] = false;
+    fcinfo.argnull[1] = false;
+
+    for (int i = 0; i < pred->nargs; ++i) {
+        fcinfo.arg[1] = pred->args[i];
+        fcinfo.isnull = false;
+        Datum result = FunctionCallInvoke(&fcinfo);
+        bool passed = !fcinfo.isnull && DatumGetBool(result);
+
+        // the first TRUE decides ANY(), and the first FALSE decides the others
+        if (passed == pred->useOr) {
+            return passed;
+        }
+    }
+    return !pred->useOr;
+}
+
+/*
+ * @Description: filter the rows of one CU by a CU predicate, and mark the failed
+ *     rows in the delete mask. the predicate is evaluated once per dictionary item
+ *     for dictionary encoded CUs, and once per run of the same values for RLE
+ *     encoded CUs. the other CUs are left to the executor.
+ * @Param[IN] pred: CU predicate
+ * @Param[IN] cuPtr: the CU of the predicate column
+ * @Param[IN] rowCount: row count of the CU
+ * @Param[IN] attr: the predicate column
+ * @Return: number of the rows filtered out
+ */
+int CStore::ApplyCUPredicate(CUPredicate* pred, CU* cuPtr, int rowCount, Form_pg_attribute attr)
+{
+    bool hasNull = cuPtr->HasNullValue();
+    int filteredRows = 0;
+
+    if (cuPtr->m_dicCodes != NULL && cuPtr->m_dicItemCount <= PG_UINT16_MAX + 1) {
+        // 0: not evaluated, 1: passed, 2: failed
+        uint8* itemState = m_cuPredItemState;
+        errno_t rc = memset_s(itemState, PG_UINT16_MAX + 1, 0, cuPtr->m_dicItemCount);
+        securec_check(rc, "", "");
+
+        for (int row = 0; row < rowCount; ++row) {
+            if ((m_cuDelMask[row >> 3] & (1 << (row % 8))) != 0) {
+                continue;
+            }
+
+            // strict operators never pass NULL values
+            bool passed = false;
+            if (!hasNull || !cuPtr->IsNull(row)) {
+                uint16 code = cuPtr->m_dicCodes[row];
+                Assert(code < cuPtr->m_dicItemCount);
+                if (itemState[code] == 0) {
+                    Datum value = PointerGetDatum(cuPtr->m_srcData + cuPtr->m_offset[row]);
+                    itemState[code] = EvalCUPredicate(pred, value) ? 1 : 2;
+                }
+                passed = (itemState[code] == 1);
+            }
+
+            if (!passed) {
+                m_cuDelMask[row >> 3] |= (1 << (row % 8));
+                ++filteredRows;
+            }
+        }
+    } else if ((cuPtr->m_infoMode & CU_RLECompressed) && attr->attlen > 0) {
+        int attlen = attr->attlen;
+        char* runVal = NULL;
+        bool runPassed = false;
+
+        for (int row = 0; row < rowCount; ++row) {
+            if ((m_cuDelMask[row >> 3] & (1 << (row % 8))) != 0) {
+                continue;
+            }
+
+            bool passed = false;
+            if (!hasNull || !cuPtr->IsNull(row)) {
+                char* val = hasNull ? (cuPtr->m_srcData + cuPtr->m_offset[row]) : (cuPtr->m_srcData + row * attlen);
+                if (runVal == NULL || memcmp(runVal, val, attlen) != 0) {
+                    runPassed = EvalCUPredicate(pred, fetch_att(val, attr->attbyval, attlen));
+                    runVal = val;
+                }
+                passed = runPassed;
+            }
+
+            if (!passed) {
+                m_cuDelMask[row >> 3] |= (1 << (row % 8));
+                ++filteredRows;
+            }
+        }
+    }
+
+    return filteredRows;
+}
+
+/*
+ * @Description: filter the rows of the current CU by the CU predicates once,
+ *     before any column is filled. the failed rows are treated as dead rows,
+ *     so they are never put into a vector nor late read.
+ * @Param[IN] cuDescIdx: index of load cudesc info
+ * @See also: InitCUPredicateEnv()
+ */
+void CStore::ApplyCUPredicatesIfNeed(int cuDescIdx)
+{
+    CUDesc* firstCUDesc = m_CUDescInfo[0]->cuDescArray + cuDescIdx;
+    uint32 cuid = firstCUDesc->cu_id;
+
+    GetCUDeleteMaskIfNeed(cuid, m_snapshot);
+    if (m_cuPredCUId == cuid || m_delMaskCUId != cuid) {
+        return;
+    }
+    m_cuPredCUId = cuid;
+
+    /* show any tuples including deleted tuples just for analyse */
+    if (u_sess->attr.attr_common.XactReadOnly && u_sess->attr.attr_storage.enable_show_any_tuples) {
+        return;
+    }
+
+    int rowCount = firstCUDesc->row_count;
+    if (!m_hasDeadRow) {
+        errno_t rc = memset_s(m_cuDelMask, MaxDelBitmapSize, 0, (rowCount + 7) / 8);
+        securec_check(rc, "", "");
+    }
+
+    // temp spaces of operator functions are freed with this batch of cudesc data
+    AutoContextSwitch newMemCnxt(m_perScanMemCnxt);
+    Form_pg_attribute* attrs = m_relation->rd_att->attrs;
+    int filteredRows = 0;
+
+    for (int i = 0; i < m_cuPredNum; ++i) {
+        CUPredicate* pred = m_cuPreds + i;
+        int colIdx = m_colId[pred->seq];
+        CUDesc* cuDescPtr = m_CUDescInfo[pred->seq]->cuDescArray + cuDescIdx;
+        if (cuDescPtr->IsNullCU() || cuDescPtr->IsSameValCU()) {
+            continue;
+        }
+
+        int slotId = CACHE_BLOCK_INVALID_IDX;
+        CU* cuPtr = GetCUData(cuDescPtr, colIdx, attrs[colIdx]->attlen, slotId);
+        filteredRows += ApplyCUPredicate(pred, cuPtr, rowCount, attrs[colIdx]);
+
+        if (IsValidCacheSlotID(slotId)) {
+            CUCache->UnPinDataBlock(slotId);
+        } else {
+            Assert(false);
+        }
+    }
+
+    if (filteredRows > 0) {
+        m_hasDeadRow = true;
+    }
+}
+
+/*
+ * @Description: check the bloom filter of one CU against the equality quals
+ *     on its column. called while the cudesc is loaded.
+ * @Param[IN] col: the column of CU
+ * @Param[IN] filter: the extra attribute of CUDesc tuple
+ * @Return: true if some qual surely fails on all the rows of CU
+ * @See also: InitCUBloomEnv(), RoughCheck()
+ */
+bool CStore::CUBloomExcludes(int col, Datum filter)
+{
+    text* bloom = (text*)pg_detoast_datum_packed((struct varlena*)DatumGetPointer(filter));
+    bool excluded = false;
+
+    for (int i = 0; !excluded && i < m_cuBloomPredNum; ++i) {
+        CUBloomPredicate* pred = m_cuBloomPreds + i;
+        if (m_colId[pred->seq] != col) {
+            continue;
+        }
+
+        excluded = true;
+        for (int j = 0; excluded && j < pred->nhashes; ++j) {
+            excluded = !CUBloomMayContain(bloom, pred->hashes[j]);
+        }
+    }
+
+    if ((Pointer)bloom != DatumGetPointer(filter)) {
+        pfree(bloom);
+    }
+    return excluded;
+}
+
 int CStore::FillVecBatch(_out_ VectorBatch* vecBatchOut)
 {
     Assert(vecBatchOut);
@@ -2315,6 +2961,11 @@ int CStore::FillVecBatch(_out_ VectorBatch* vecBatchOut)
     this->m_cuDescIdx = idx;
     bool hasCtidForLateRead = false;
 
+    /* Step 0: filter rows by the quals on dictionary or RLE encoded CUs */
+    if (m_cuPredNum > 0) {
+        ApplyCUPredicatesIfNeed(idx);
+    }
+
     /* Step 1: fill normal columns if need */
     for (i = 0; i < m_colNum; ++i) {
         int colIdx = m_colId[i];
@@ -3211,6 +3862,9 @@ void CStore::GetCUDeleteMaskIfNeed(_in_ uint32 cuid, _in_ Snapshot snapShot)
     if (m_delMaskCUId == cuid)
         return;
 
+    // rows of the new mask have not been filtered by CU predicates yet
+    m_cuPredCUId = InValidCUID;
+
     // we will reset m_perScanMemCnxt when switch to the next batch of cudesc data.
     // so the spaces only used for this batch should be managed by m_perScanMemCnxt.
     AutoContextSwitch newMemCnxt(m_perScanMemCnxt);
@@ -3452,7 +4106,7 @@ RETRY_LOAD_CU:
         hasFound = true;
     } else {
         hasFound = false;
-        slotId = CUCache->ReserveDataBlock(&dataSlotTag, cuDescPtr->cu_size, hasFound);
+        slotId = CUCache->ReserveDataBlock(&dataSlotTag, cuDescPtr->cu_size, hasFound, m_cacheStrategy);
     }
 
     // Use the cached CU
@@ -4031,7 +4685,8 @@ void CStore::FillColMinMax(CUDesc* cuDescPtr, ScalarVector* vec, int pos)
 
 /*
  * @Describe: We only read cudesc for getting min/max value if no dead rows
- * Bypass optimization for special SQL case which are like 'select min(col1), max(col2) from t'
+ * Bypass optimization for special SQL case which are like 'select min(col1), max(col2) from t',
+ * or 'select min(col1) from t where col2 >= c1 and col2 < c2' whose quals are all scan keys
  * @in - state  CStore Scan State.
  * @out - vecBatchOut store data struct.
  */
@@ -4069,6 +4724,14 @@ void CStore::CStoreMinMaxScan(_in_ CStoreScanState* state, _out_ VectorBatch* ve
     bool needFixRows = false, onlyFillMinMax = true;
     int deadRows = 0;
 
+    /*
+     * With quals, only the CU whose rows all pass them can be answered by min/max,
+     * for example the CUs inside the range of a partition filter. The other CUs
+     * are filled with data and filtered by the quals as usual.
+     */
+    bool allMatch = (state->ps.qual == NIL) ||
+                    RoughCheckAllMatch(state->csss_ScanKeys, state->csss_NumScanKeys, idx);
+
     CSTORESCAN_TRACE_START(FILL_BATCH);
     for (int i = 0; i < m_colNum; ++i) {
         int colIdx = m_colId[i];
@@ -4078,7 +4741,7 @@ void CStore::CStoreMinMaxScan(_in_ CStoreScanState* state, _out_ VectorBatch* ve
         GetCUDeleteMaskIfNeed(cuDescPtr->cu_id, m_snapshot);
 
         Assert(0 == pos);
-        if (!m_hasDeadRow && !cuDescPtr->IsNoMinMaxCU() && this->m_fillMinMaxFunc[i]) {
+        if (allMatch && !m_hasDeadRow && !cuDescPtr->IsNoMinMaxCU() && this->m_fillMinMaxFunc[i]) {
             (this->*m_fillMinMaxFunc[i])(cuDescPtr, vec, pos);
         } else {
             int funIdx = m_hasDeadRow ? 1 : 0;
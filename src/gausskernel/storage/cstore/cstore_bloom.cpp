@@ -0,0 +1,265 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * cstore_bloom.cpp
+ *      per-CU bloom filters of ColStore
+ *
+ * The filter of a CU is built from its values when the CU is formed, and is
+ * stored in the "extra" attribute of the CUDesc tuple as
+ *     CUBloomHeader + bits
+ * The k probes of a value are derived from two hashes of it by double hashing.
+ *
+ * IDENTIFICATION
+ *        src/gausskernel/storage/cstore/cstore_bloom.cpp
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#include "access/cstore_bloom.h"
+
+#include <math.h>
+
+#include "access/hash.h"
+#include "access/skey.h"
+#include "catalog/pg_am.h"
+#include "catalog/pg_type.h"
+#include "commands/defrem.h"
+#include "fmgr.h"
+#include "utils/builtins.h"
+#include "utils/lsyscache.h"
+
+#define CU_BLOOM_BITS(filter) ((unsigned char *)VARDATA_ANY(filter) + sizeof(CUBloomHeader))
+
+static inline bool CUBloomIsIntegerType(Oid typeOid)
+{
+    return (typeOid == INT2OID || typeOid == INT4OID || typeOid == INT8OID);
+}
+
+CUBloomKind CUBloomGetKind(Oid typeOid)
+{
+    switch (typeOid) {
+        case INT2OID:
+        case INT4OID:
+        case INT8OID:
+        case OIDOID:
+        case DATEOID:
+        case TIMEOID:
+        case TIMESTAMPOID:
+        case TIMESTAMPTZOID:
+            return CU_BLOOM_INTEGER;
+        case TEXTOID:
+        case VARCHAROID:
+            return CU_BLOOM_STRING;
+        case BPCHAROID:
+            return CU_BLOOM_BPCHAR;
+        default:
+            return CU_BLOOM_NONE;
+    }
+}
+
+/*
+ * @Description: check whether the bloom filters of a column of type colType
+ *     can answer "column opno const". opno must be the btree equality of its
+ *     input types, and equal values of the column and of the const must hash
+ *     the same, which holds for the same type, or across int2/int4/int8.
+ * @OUT argType: type of the const
+ */
+bool CUBloomIsUsableOp(Oid opno, Oid colType, Oid *argType)
+{
+    Oid leftType = InvalidOid;
+    Oid rightType = InvalidOid;
+    CUBloomKind kind = CUBloomGetKind(colType);
+
+    if (kind == CU_BLOOM_NONE) {
+        return false;
+    }
+
+    op_input_types(opno, &leftType, &rightType);
+    if (CUBloomGetKind(leftType) != kind || CUBloomGetKind(rightType) != kind) {
+        return false;
+    }
+    if (kind == CU_BLOOM_INTEGER && !(leftType == colType && rightType == colType) &&
+        !(CUBloomIsIntegerType(colType) && CUBloomIsIntegerType(leftType) && CUBloomIsIntegerType(rightType))) {
+        return false;
+    }
+
+    Oid opclass = GetDefaultOpClass(leftType, BTREE_AM_OID);
+    if (!OidIsValid(opclass) ||
+        get_op_opfamily_strategy(opno, get_opclass_family(opclass)) != BTEqualStrategyNumber) {
+        return false;
+    }
+
+    *argType = rightType;
+    return true;
+}
+
+/*
+ * @Description: hash a not-null value of typeOid. integers are widened to
+ *     int64 first, so that the same number of different widths hash the same.
+ */
+uint32 CUBloomHashDatum(Oid typeOid, Datum value)
+{
+    switch (CUBloomGetKind(typeOid)) {
+        case CU_BLOOM_INTEGER: {
+            int64 val = 0;
+            if (typeOid == INT2OID) {
+                val = DatumGetInt16(value);
+            } else if (typeOid == INT4OID || typeOid == DATEOID) {
+                val = DatumGetInt32(value);
+            } else if (typeOid == OIDOID) {
+                val = DatumGetObjectId(value);
+            } else {
+                val = DatumGetInt64(value);
+            }
+            return DatumGetUInt32(hash_any((const unsigned char *)&val, sizeof(int64)));
+        }
+        case CU_BLOOM_STRING:
+        case CU_BLOOM_BPCHAR: {
+            struct varlena *str = pg_detoast_datum_packed((struct varlena *)DatumGetPointer(value));
+            int len = (typeOid == BPCHAROID) ? bcTruelen((BpChar *)str) : (int)VARSIZE_ANY_EXHDR(str);
+            uint32 hash = DatumGetUInt32(hash_any((const unsigned char *)VARDATA_ANY(str), len));
+            if ((Pointer)str != DatumGetPointer(value)) {
+                pfree(str);
+            }
+            return hash;
+        }
+        default:
+            Assert(false);
+            return 0;
+    }
+}
+
+static inline void CUBloomProbe(uint32 hash, uint32 nbits, uint32 i, uint32 *byteIdx, unsigned char *mask)
+{
+    uint32 hash2 = DatumGetUInt32(hash_uint32(hash)) | 1;
+    uint32 pos = (uint32)(((uint64)hash + (uint64)i * hash2) % nbits);
+    *byteIdx = pos / BITS_PER_BYTE;
+    *mask = (unsigned char)(1 << (pos % BITS_PER_BYTE));
+}
+
+static int CUBloomHashCmp(const void *a, const void *b)
+{
+    uint32 ha = *(const uint32 *)a;
+    uint32 hb = *(const uint32 *)b;
+    return (ha > hb) ? 1 : ((ha < hb) ? -1 : 0);
+}
+
+/*
+ * @Description: build the bloom filter of the first rows values of vector.
+ *     the filter is sized for CU_BLOOM_TARGET_FPP by the number of distinct
+ *     values, which is known exactly from the hashes. when the values are too
+ *     many for CU_BLOOM_MAX_BITS, no filter is built if it would pass more than
+ *     CU_BLOOM_MAX_FPP of the absent values.
+ * @Return: the filter, or NULL if all the values are NULL or the filter would
+ *     be too weak.
+ */
+text *CUBloomBuild(bulkload_vector *vector, int rows, Oid typeOid)
+{
+    Assert(CUBloomGetKind(typeOid) != CU_BLOOM_NONE);
+
+    uint32 *hashes = (uint32 *)palloc(sizeof(uint32) * Max(rows, 1));
+    int nhashed = 0;
+    bulkload_vector_iter iter;
+    Datum value = (Datum)0;
+    bool isNull = false;
+    iter.begin(vector, rows);
+    while (iter.not_end()) {
+        iter.next(&value, &isNull);
+        if (!isNull) {
+            hashes[nhashed++] = CUBloomHashDatum(typeOid, value);
+        }
+    }
+    if (nhashed == 0) {
+        pfree(hashes);
+        return NULL;
+    }
+
+    /* keep the distinct hashes only, duplicates set the same bits */
+    qsort(hashes, nhashed, sizeof(uint32), CUBloomHashCmp);
+    int ndistinct = 1;
+    for (int i = 1; i < nhashed; ++i) {
+        if (hashes[i] != hashes[ndistinct - 1]) {
+            hashes[ndistinct++] = hashes[i];
+        }
+    }
+
+    /* m = -n * ln(p) / (ln2)^2 bits and k = ln2 * m / n hashes give the rate p */
+    const double ln2 = log(2.0);
+    double bitsPerValue = -log(CU_BLOOM_TARGET_FPP) / (ln2 * ln2);
+    uint64 wanted = TYPEALIGN(64, (uint64)ceil(ndistinct * bitsPerValue));
+    uint32 nbits = (uint32)Max(Min(wanted, (uint64)CU_BLOOM_MAX_BITS), (uint64)CU_BLOOM_MIN_BITS);
+    int nhashes = (int)rint(ln2 * nbits / ndistinct);
+    nhashes = Max(nhashes, 1);
+    nhashes = Min(nhashes, CU_BLOOM_MAX_HASHES);
+
+    double fpp = pow(1.0 - exp(-(double)nhashes * ndistinct / nbits), nhashes);
+    if (fpp > CU_BLOOM_MAX_FPP) {
+        pfree(hashes);
+        return NULL;
+    }
+
+    Size size = VARHDRSZ + sizeof(CUBloomHeader) + nbits / BITS_PER_BYTE;
+    text *filter = (text *)palloc0(size);
+    SET_VARSIZE(filter, size);
+    CUBloomHeader *header = (CUBloomHeader *)VARDATA(filter);
+    header->nbits = nbits;
+    header->nhashes = (uint8)nhashes;
+    header->version = CU_BLOOM_VERSION;
+    unsigned char *bits = CU_BLOOM_BITS(filter);
+
+    for (int j = 0; j < ndistinct; ++j) {
+        for (int i = 0; i < nhashes; ++i) {
+            uint32 byteIdx = 0;
+            unsigned char mask = 0;
+            CUBloomProbe(hashes[j], nbits, i, &byteIdx, &mask);
+            bits[byteIdx] |= mask;
+        }
+    }
+
+    pfree(hashes);
+    return filter;
+}
+
+/*
+ * @Description: check the hash of a value against a filter.
+ * @Return: false if the value is surely not in the CU. true if it may be, or
+ *     the filter is unknown.
+ */
+bool CUBloomMayContain(const text *filter, uint32 hash)
+{
+    CUBloomHeader header;
+    Size dataLen = VARSIZE_ANY_EXHDR(filter);
+
+    if (dataLen < sizeof(CUBloomHeader)) {
+        return true;
+    }
+    /* the filter data may not be aligned */
+    errno_t rc = memcpy_s(&header, sizeof(CUBloomHeader), VARDATA_ANY(filter), sizeof(CUBloomHeader));
+    securec_check(rc, "\0", "\0");
+    if (header.version != CU_BLOOM_VERSION || header.nbits == 0 || header.nhashes == 0 ||
+        dataLen < sizeof(CUBloomHeader) + header.nbits / BITS_PER_BYTE) {
+        return true;
+    }
+
+    const unsigned char *bits = CU_BLOOM_BITS(filter);
+    for (uint32 i = 0; i < header.nhashes; ++i) {
+        uint32 byteIdx = 0;
+        unsigned char mask = 0;
+        CUBloomProbe(hash, header.nbits, i, &byteIdx, &mask);
+        if ((bits[byteIdx] & mask) == 0) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -37,6 +37,7 @@
 #include "utils/relcache.h"
 #include "catalog/pg_type.h"
 #include "access/cstore_am.h"
+#include "access/cstore_bloom.h"
 #include "storage/custorage.h"
 #include "utils/builtins.h"
 #include "executor/executor.h"
@@ -244,6 +245,7 @@ CStoreInsert::~CStoreInsert()
     m_aio_dispath_cudesc = NULL;
     m_vfdList = NULL;
     m_cuPPtr = NULL;
+    m_cuBloomPPtr = NULL;
     m_idxKeyNum = NULL;
     m_aio_cache_write_threshold = NULL;
     m_formCUFuncArray = NULL;
@@ -407,6 +409,7 @@ void CStoreInsert::Destroy()
     m_cuStorage = NULL;
     m_cuDescPPtr = NULL;
     m_cuPPtr = NULL;
+    m_cuBloomPPtr = NULL;
     m_idxKeyAttr = NULL;
     m_idxKeyNum = NULL;
     m_idxRelation = NULL;
@@ -575,6 +578,7 @@ void CStoreInsert::BeginBatchInsert(const InsertArg& args)
 
     /* Step 6: Initilize CU objects. */
     m_cuPPtr = (CU**)palloc0(sizeof(CU*) * m_relation->rd_att->natts);
+    m_cuBloomPPtr = (text**)palloc0(sizeof(text*) * m_relation->rd_att->natts);
 
     /*
      * Step 7: Lock relfilenode.
@@ -1344,8 +1348,9 @@ void CStoreInsert::SaveAll(int options, _in_ const char* delBitmap)
             totalSize += cuDesc->cu_size;
         }
 
-        /* step 3: Save CUDesc */
-        CStore::SaveCUDesc(m_relation, cuDesc, col, options);
+        /* step 3: Save CUDesc, together with the bloom filter of CU */
+        CStore::SaveCUDesc(m_relation, cuDesc, col, options, m_cuBloomPPtr[col]);
+        pfree_ext(m_cuBloomPPtr[col]);
     }
 
     /* storage space processing before copying column data. */
@@ -1469,6 +1474,12 @@ CU* CStoreInsert::FormCU(int col, bulkload_rows* batchRowPtr, CUDesc* cuDescPtr)
         cuPtr->SetMagic(cuDescPtr->magic);
         cuPtr->Compress(batchRowPtr->m_rows_curnum, m_compress_modes);
         cuDescPtr->cu_size = cuPtr->GetCUSize();
+
+        // min/max already tells all about the CUs of one value
+        if (RelationBloomFilterEnabled(m_relation) && CUBloomGetKind(attrs[col]->atttypid) != CU_BLOOM_NONE) {
+            m_cuBloomPPtr[col] =
+                CUBloomBuild(&batchRowPtr->m_vectors[col], batchRowPtr->m_rows_curnum, attrs[col]->atttypid);
+        }
     }
     cuDescPtr->row_count = batchRowPtr->m_rows_curnum;
 
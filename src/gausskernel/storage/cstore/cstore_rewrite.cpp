@@ -36,6 +36,7 @@
 #include "utils/lsyscache.h"
 #include "catalog/index.h"
 #include "storage/remote_read.h"
+#include "utils/snapmgr.h"
 
 #define IsBitmapSet(_bitmap, _i) (((_bitmap)[(_i) >> 3] & (1 << ((_i) % 8))) != 0)
 
@@ -2147,3 +2148,189 @@ void ATExecCStoreMergePartition(Relation partTableRel, AlterTableCmd* cmd)
 
     partitionClose(partTableRel, destPart, NoLock);
 }
+
+/* a run of neighbouring CUs to compact, see CStoreCompactCUs() */
+typedef struct CStoreCompactRun {
+    uint32 startCUID;
+    uint32 endCUID;
+} CStoreCompactRun;
+
+/*
+ * @Description: count the deleted rows of a CU from its virtual column cudesc tuple.
+ */
+static uint32 CStoreCountDeadRows(HeapTuple vcTup, TupleDesc cudescTupDesc)
+{
+    bool isnull = false;
+    uint32 deadRows = 0;
+    char* delMask = DatumGetPointer(fastgetattr(vcTup, CUDescCUPointerAttr, cudescTupDesc, &isnull));
+
+    /* no row of the CU has been deleted */
+    if (isnull) {
+        return 0;
+    }
+
+    char* detoastPtr = (char*)PG_DETOAST_DATUM(delMask);
+    unsigned char* bits = (unsigned char*)VARDATA_ANY(detoastPtr);
+    int nBytes = (int)VARSIZE_ANY_EXHDR(detoastPtr);
+    for (int i = 0; i < nBytes; ++i) {
+        deadRows += NumberOfBit1Set[bits[i]];
+    }
+    if (detoastPtr != delMask) {
+        pfree_ext(detoastPtr);
+    }
+    return deadRows;
+}
+
+/*
+ * @Description: compact the CUs of a column table whose ratio of deleted rows
+ *     reaches deadRatio. The live rows of each run of such neighbouring CUs are
+ *     inserted again into full CUs, sorted by the partial cluster key if any,
+ *     with fresh min/max, and the cudesc tuples of the old CUs are deleted in the
+ *     same transaction, so the new CUs replace the old ones atomically at commit.
+ *
+ *     No table lock beyond the caller's is taken. A CU is claimed by deleting
+ *     its virtual column cudesc tuple, which is the one DELETE and UPDATE modify,
+ *     so a concurrent delete of its rows either makes us skip the CU, or waits
+ *     for us and fails with a conflict if we commit. The old CU data is left in
+ *     place for the snapshots still reading it, since insertions only append to
+ *     the CU files.
+ *
+ *     The caller must exclude the other vacuums and DDLs, and the table must not
+ *     have indexes, because the rows get new ctids.
+ * @IN rel: the column table or partition
+ * @IN deadRatio: min ratio of deleted rows of a CU to compact it
+ * @Return: number of deleted rows reclaimed
+ */
+int64 CStoreCompactCUs(Relation rel, double deadRatio)
+{
+    TupleDesc tupDesc = RelationGetDescr(rel);
+    List* runs = NIL;
+    ListCell* cell = NULL;
+    CStoreCompactRun* run = NULL;
+    int64 reclaimedRows = 0;
+    HeapTuple tup = NULL;
+    ScanKeyData key[3];
+    bool isnull = false;
+
+    Assert(deadRatio > 0);
+
+    /*
+     * the cudesc tuples deleted by the current command stay visible to a
+     * snapshot taken by it, while the cudesc tuples of the new CUs don't.
+     */
+    Snapshot snapshot = RegisterSnapshot(GetLatestSnapshot());
+    CommandId cid = GetCurrentCommandId(true);
+
+    Relation cudescRel = heap_open(rel->rd_rel->relcudescrelid, RowExclusiveLock);
+    Relation cudescIdx = index_open(cudescRel->rd_rel->relcudescidx, RowExclusiveLock);
+    TupleDesc cudescTupDesc = RelationGetDescr(cudescRel);
+
+    /* step 1: claim the CUs to compact, and group the neighbouring ones into runs */
+    ScanKeyInit(&key[0], (AttrNumber)CUDescColIDAttr, BTEqualStrategyNumber, F_INT4EQ, Int32GetDatum(VitrualDelColID));
+    SysScanDesc cudescScan = systable_beginscan_ordered(cudescRel, cudescIdx, snapshot, 1, key);
+    while ((tup = systable_getnext_ordered(cudescScan, ForwardScanDirection)) != NULL) {
+        uint32 cuid = DatumGetUInt32(fastgetattr(tup, CUDescCUIDAttr, cudescTupDesc, &isnull));
+        uint32 rowCount = DatumGetUInt32(fastgetattr(tup, CUDescRowCountAttr, cudescTupDesc, &isnull));
+        uint32 deadRows = CStoreCountDeadRows(tup, cudescTupDesc);
+        bool claimed = false;
+
+        if (deadRows > 0 && (double)deadRows >= deadRatio * rowCount) {
+            ItemPointerData updateCtid;
+            TransactionId updateXmax;
+            HTSU_Result result =
+                heap_delete(cudescRel, &tup->t_self, &updateCtid, &updateXmax, cid, InvalidSnapshot, true);
+
+            /* skip the CU if its rows are deleted concurrently */
+            claimed = (result == HeapTupleMayBeUpdated);
+        }
+
+        if (!claimed) {
+            run = NULL;
+            continue;
+        }
+
+        if (run == NULL) {
+            run = (CStoreCompactRun*)palloc(sizeof(CStoreCompactRun));
+            run->startCUID = cuid;
+            runs = lappend(runs, run);
+        }
+        run->endCUID = cuid;
+        reclaimedRows += deadRows;
+    }
+    systable_endscan_ordered(cudescScan);
+
+    /* step 2: delete the cudesc tuples of the claimed CUs, dropped columns included */
+    foreach (cell, runs) {
+        run = (CStoreCompactRun*)lfirst(cell);
+        for (int attno = 1; attno <= tupDesc->natts; ++attno) {
+            ScanKeyInit(&key[0], (AttrNumber)CUDescColIDAttr, BTEqualStrategyNumber, F_INT4EQ, Int32GetDatum(attno));
+            ScanKeyInit(&key[1],
+                (AttrNumber)CUDescCUIDAttr,
+                BTGreaterEqualStrategyNumber,
+                F_OIDGE,
+                UInt32GetDatum(run->startCUID));
+            ScanKeyInit(
+                &key[2], (AttrNumber)CUDescCUIDAttr, BTLessEqualStrategyNumber, F_OIDLE, UInt32GetDatum(run->endCUID));
+
+            cudescScan = systable_beginscan_ordered(cudescRel, cudescIdx, snapshot, 3, key);
+            while ((tup = systable_getnext_ordered(cudescScan, ForwardScanDirection)) != NULL) {
+                simple_heap_delete(cudescRel, &tup->t_self);
+            }
+            systable_endscan_ordered(cudescScan);
+        }
+    }
+
+    /* step 3: insert the live rows of the runs again */
+    if (runs != NIL) {
+        InsertArg args;
+        int colNum = 0;
+        int16* colIdx = (int16*)palloc(sizeof(int16) * tupDesc->natts);
+        for (int i = 0; i < tupDesc->natts; ++i) {
+            /* dropped columns have no CU to read, the insertion skips them too */
+            if (!tupDesc->attrs[i]->attisdropped) {
+                colIdx[colNum++] = tupDesc->attrs[i]->attnum;
+            }
+        }
+        Assert(colNum > 0);
+
+        CStoreInsert::InitInsertArg(rel, NULL, true, args);
+        args.sortType = BATCH_SORT;
+        CStoreInsert* cstoreInsert = New(CurrentMemoryContext) CStoreInsert(rel, args, false, NULL, NULL);
+
+        foreach (cell, runs) {
+            run = (CStoreCompactRun*)lfirst(cell);
+            CStoreScanDesc cstoreScan = CStoreBeginScan(rel, colNum, colIdx, snapshot, false);
+            cstoreScan->m_CStore->SetScanCUIDRange(run->startCUID, run->endCUID);
+
+            VectorBatch* batch = NULL;
+            do {
+                vacuum_delay_point();
+
+                batch = CStoreGetNextBatch(cstoreScan);
+                if (!BatchIsNull(batch)) {
+                    cstoreInsert->BatchInsert(batch, 0);
+                }
+            } while (!CStoreIsEndScan(cstoreScan));
+            CStoreEndScan(cstoreScan);
+
+            ereport(DEBUG2,
+                (errmsg("compact CUs %u - %u of relation \"%s\"",
+                    run->startCUID,
+                    run->endCUID,
+                    RelationGetRelationName(rel))));
+        }
+
+        cstoreInsert->SetEndFlag();
+        cstoreInsert->BatchInsert((VectorBatch*)NULL, 0);
+        DELETE_EX(cstoreInsert);
+        CStoreInsert::DeInitInsertArg(args);
+        pfree_ext(colIdx);
+    }
+
+    index_close(cudescIdx, RowExclusiveLock);
+    heap_close(cudescRel, RowExclusiveLock);
+    UnregisterSnapshot(snapshot);
+    list_free_deep(runs);
+
+    return reclaimedRows;
+}
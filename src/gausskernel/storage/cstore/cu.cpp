@@ -171,6 +171,9 @@ void CU::Reset()
     m_bpNullCompressedSize = 0;
     m_offset = NULL;
     m_offsetSize = 0;
+    m_dicCodes = NULL;
+    m_dicCodesSize = 0;
+    m_dicItemCount = 0;
     m_cuSizeExcludePadding = 0;
 
     m_tmpinfo = NULL;
@@ -632,8 +635,9 @@ bool CU::CompressData(_out_ char* outBuf, _in_ int nVals, _in_ int16 compress_mo
                 if (m_tmpinfo->m_valid_minmax) {
                     intCoder.SetMinMaxVal(m_tmpinfo->m_min_value, m_tmpinfo->m_max_value);
                 }
-                /* input a hint about RLE encoding */
+                /* input hints about RLE encoding and bit packing */
                 intCoder.m_adopt_rle = ref_filter->m_adopt_rle;
+                intCoder.m_adopt_bitpack = ref_filter->m_adopt_bitpack;
                 compressOutSize = intCoder.Compress(input, output);
             } else if (ATT_IS_NUMERIC_TYPE(m_atttypid)) {
                 if (compression > COMPRESS_LOW) {
@@ -657,8 +661,9 @@ bool CU::CompressData(_out_ char* outBuf, _in_ int nVals, _in_ int16 compress_mo
             if (m_tmpinfo->m_valid_minmax) {
                 intCoder.SetMinMaxVal(m_tmpinfo->m_min_value, m_tmpinfo->m_max_value);
             }
-            /* input a hint about RLE encoding */
+            /* input hints about RLE encoding and bit packing */
             intCoder.m_adopt_rle = ref_filter->m_adopt_rle;
+            intCoder.m_adopt_bitpack = ref_filter->m_adopt_bitpack;
             compressOutSize = intCoder.Compress(input, output);
         } else {
             // FUTURE CASE: complete global dictionary
@@ -672,6 +677,7 @@ bool CU::CompressData(_out_ char* outBuf, _in_ int nVals, _in_ int16 compress_mo
             // for var-length datatype whose size is -1, dictionary method can be applied
             // to. so try it first.
             input.useDict = (m_eachValSize > 8) ? false : (COMPRESS_LOW != compression);
+            input.useFsst = (m_eachValSize == -1);
 
             // the number of values is excluding the number of NULL values.
             input.numVals = HasNullValue() ? (nVals - CountNullValuesBefore(nVals)) : nVals;
@@ -681,6 +687,7 @@ bool CU::CompressData(_out_ char* outBuf, _in_ int nVals, _in_ int16 compress_mo
             /* input hints about both RLE and DICTIONARY encoding */
             strCoder.m_adopt_rle = ref_filter->m_adopt_rle;
             strCoder.m_adopt_dict = ref_filter->m_adopt_dict;
+            strCoder.m_adopt_fsst = ref_filter->m_adopt_fsst;
             compressOutSize = strCoder.Compress(input, output);
         }
     }
@@ -852,7 +859,7 @@ void CU::UncompressNumeric(char* inBuf, int nNotNulls, int typmode)
         tmpOutBuf = (char*)palloc(tmpOutBufSize + 8);
 
         CompressionArg2 in = {tmpInBuf, tmpInBufSize, (uint16)this->m_infoMode};
-        CompressionArg1 out = {tmpOutBuf, tmpOutBufSize, 0, NULL, 0, false, false, false};
+        CompressionArg1 out = {tmpOutBuf, tmpOutBufSize, 0, NULL, 0, false, false, false, false};
         int err_code = 0;
 
         StringCoder strDecoder;
@@ -994,7 +1001,20 @@ void CU::UnCompressData(char* buf, int rowCount)
             } else {
                 // String Type Decompress
                 StringCoder strDecoder;
+                strDecoder.m_keep_dic_codes =
+                    ((m_infoMode & CU_DicEncode) != 0) && !CU_IS_FSST_COMPRESSED(m_infoMode);
                 err_code = strDecoder.Decompress(in, out);
+
+                // keep the dictionary codes for evaluating predicates per item
+                int codesNum = 0;
+                int itemCount = 0;
+                DicCodeType* codes = strDecoder.DetachDicCodes(codesNum, itemCount);
+                if (codes != NULL) {
+                    if (err_code > 0) {
+                        FormDicCodes(codes, codesNum, itemCount, rowCount);
+                    }
+                    pfree(codes);
+                }
             }
         }
 
@@ -1037,6 +1057,40 @@ void CU::UnCompressData(char* buf, int rowCount)
     return;
 }
 
+/*
+ * @Description: remember the dictionary code of each row. the codes only cover
+ *     the values which are not NULL, so spread them according to the NULL bitmap.
+ * @IN codes: dictionary codes of the values which are not NULL
+ * @IN codesNum: number of codes
+ * @IN itemCount: number of items in the dictionary
+ * @IN rowCount: number of rows in this CU
+ */
+void CU::FormDicCodes(_in_ const uint16* codes, _in_ int codesNum, _in_ int itemCount, _in_ int rowCount)
+{
+    Assert(m_dicCodes == NULL);
+
+    if (unlikely(codesNum != rowCount - CountNullValuesBefore(rowCount))) {
+        // codes don't match the rows, predicates will be evaluated per row
+        return;
+    }
+
+    m_dicCodesSize = sizeof(uint16) * rowCount;
+    m_dicCodes = (uint16*)CStoreMemAlloc::Palloc(m_dicCodesSize, !m_inCUCache);
+    m_dicItemCount = itemCount;
+
+    if (!HasNullValue()) {
+        errno_t rc = memcpy_s(m_dicCodes, m_dicCodesSize, codes, sizeof(uint16) * codesNum);
+        securec_check(rc, "\0", "\0");
+        return;
+    }
+
+    int pos = 0;
+    for (int row = 0; row < rowCount; ++row) {
+        m_dicCodes[row] = IsNull(row) ? 0 : codes[pos++];
+    }
+    Assert(pos == codesNum);
+}
+
 template <bool bpcharType>
 void CU::DeFormNumberStringCU()
 {
@@ -1600,6 +1654,13 @@ void CU::FreeSrcBuf()
     }
     m_offset = NULL;
     m_offsetSize = 0;
+
+    if (m_dicCodes) {
+        CStoreMemAlloc::Pfree(m_dicCodes, !m_inCUCache);
+    }
+    m_dicCodes = NULL;
+    m_dicCodesSize = 0;
+    m_dicItemCount = 0;
 }
 
 FORCE_INLINE
@@ -1625,7 +1686,7 @@ int CU::GetCompressBufSize() const
 FORCE_INLINE
 int CU::GetUncompressBufSize() const
 {
-    return m_srcBufSize + m_offsetSize;
+    return m_srcBufSize + m_offsetSize + m_dicCodesSize;
 }
 
 FORCE_INLINE
@@ -267,16 +267,18 @@ bool DataCacheMgr::ReserveCstoreDataBlockWithSlotId(CacheSlotId_t slotId)
  * @IN dataSlotTag: data slot tag
  * @IN hasFound: whether found or not
  * @IN size: need block size
+ * @IN strategy: ring of a large scan, or NULL
  * @Return: slot id
  * @See also:
  */
-CacheSlotId_t DataCacheMgr::ReserveDataBlock(DataSlotTag* dataSlotTag, int size, bool& hasFound)
+CacheSlotId_t DataCacheMgr::ReserveDataBlock(
+    DataSlotTag* dataSlotTag, int size, bool& hasFound, CacheAccessStrategy strategy)
 {
     CacheSlotId_t slot = CACHE_BLOCK_INVALID_IDX;
     CacheTag cacheTag = {0};
 
     m_cache_mgr->InitCacheBlockTag(&cacheTag, dataSlotTag->slotType, &dataSlotTag->slotTag, sizeof(DataSlotTagKey));
-    slot = m_cache_mgr->ReserveCacheBlock(&cacheTag, size, hasFound);
+    slot = m_cache_mgr->ReserveCacheBlock(&cacheTag, size, hasFound, strategy);
     if (!hasFound) {
         /* remember block slot in process */
         Assert(!IsValidCacheSlotID(t_thrd.storage_cxt.CacheBlockInProgressIO));
@@ -492,6 +494,16 @@ CUUncompressedRetCode DataCacheMgr::StartUncompressCU(
     return CU_OK;
 }
 
+/*
+ * @Description: get the access counters of a data cache type
+ * @IN type: CACHE_COlUMN_DATA, CACHE_ORC_DATA or CACHE_OBS_DATA
+ * @See also: CacheMgr::GetCacheTypeStats
+ */
+void DataCacheMgr::GetCacheTypeStats(int type, uint64* hits, uint64* reads, uint64* evictions, uint64* ring_reuses)
+{
+    m_cache_mgr->GetCacheTypeStats(type, hits, reads, evictions, ring_reuses);
+}
+
 /*
  * @Description: get data cache manage current memory cache used size
  * @Return: cache used size
@@ -477,6 +477,42 @@ void CUStorage::Load(_in_ uint64 offset, _in_ int size, __inout char* outbuf, bo
     Assert(left_size == 0);
 }
 
+/*
+ * @Description: hint the kernel to read [offset, offset + size) ahead with
+ *     posix_fadvise, without waiting. used for buffered reads only.
+ * @Param[IN] offset: cu_pointer
+ * @Param[IN] size: cu size
+ * @See also: CStore::CUWindowPrefetch
+ */
+void CUStorage::Prefetch(_in_ uint64 offset, _in_ int size)
+{
+    int fileId = CU_FILE_ID(offset);
+    uint64 fileOffset = CU_FILE_OFFSET(offset);
+    char tmpFileName[MAXPGPATH];
+    errno_t rc = 0;
+
+    while (size > 0) {
+        int prefetchSize = min(size, (int)(MAX_FILE_SIZE - fileOffset));
+
+        GetFileName(tmpFileName, MAXPGPATH, fileId);
+        if (strcmp(tmpFileName, m_fileName) != 0) {
+            if (m_fd != FILE_INVALID)
+                FileClose(m_fd);
+            m_fd = OpenFile(tmpFileName, fileId, false);
+
+            Assert(m_fd != FILE_INVALID);
+            rc = strcpy_s(m_fileName, MAXPGPATH, tmpFileName);
+            securec_check_c(rc, "\0", "\0");
+        }
+
+        (void)FilePrefetch(m_fd, (off_t)fileOffset, prefetchSize);
+
+        size -= prefetchSize;
+        ++fileId;
+        fileOffset = 0;
+    }
+}
+
 int CUStorage::WSLoad(_in_ uint64 offset, _in_ int size, __inout char* outbuf, bool direct_flag)
 {
     int readFileId = CU_FILE_ID(offset);
@@ -337,6 +337,15 @@ void MetaCacheMgr::UnPinMetaBlock(CacheSlotId_t slot)
     m_cache_mgr->UnPinCacheBlock(slot);
 }
 
+/*
+ * @Description: get the access counters of meta cache
+ * @See also: CacheMgr::GetCacheTypeStats
+ */
+void MetaCacheMgr::GetCacheTypeStats(uint64 *hits, uint64 *reads, uint64 *evictions, uint64 *ring_reuses)
+{
+    m_cache_mgr->GetCacheTypeStats(CACHE_ORC_INDEX, hits, reads, evictions, ring_reuses);
+}
+
 /*
  * @Description: get meta cache manager current memory cache size
  * @Return: cache size
@@ -31,6 +31,7 @@
 #include "txn.h"
 #include "txn_access.h"
 #include "checkpoint_manager.h"
+#include "snapshot_manager.h"
 #include "mm_session_api.h"
 #include "mot_error.h"
 #include <pthread.h>
@@ -47,6 +48,8 @@ OccTransactionManager::OccTransactionManager()
       m_insertSetSize(0),
       m_dynamicSleep(100),
       m_rowsLocked(false),
+      m_rowsPreLocked(false),
+      m_keepVersions(false),
       m_preAbort(true),
       m_validationNoWait(true)
 {}
@@ -227,6 +230,7 @@ RC OccTransactionManager::ValidateOcc(TxnManager* txMan)
 {
     uint32_t numSentinelLock = 0;
     m_rowsLocked = false;
+    m_rowsPreLocked = false;
     TxnAccess* tx = txMan->m_accessMgr.Get();
     RC rc = RC_OK;
     const uint32_t rowCount = tx->m_rowCnt;
@@ -296,10 +300,25 @@ RC OccTransactionManager::ValidateOcc(TxnManager* txMan)
         goto final;
     }
 
+    // Snapshot readers must either see the previous versions or wait for this transaction, so the replaced
+    // versions are allocated now (failing the commit rather than the readers), and the rows are locked before
+    // the commit sequence number is taken
+    m_keepVersions = GetGlobalConfiguration().m_enableSnapshotReads && !MOTEngine::GetInstance()->IsRecovering();
+    if (m_keepVersions && m_writeSetSize > 0) {
+        if (!AllocateVersions(txMan)) {
+            rc = RC_MEMORY_ALLOCATION_ERROR;
+            goto final;
+        }
+        (void)LockRows(txMan, m_rowsSetSize);
+        m_rowsPreLocked = true;
+    }
+
 final:
-    if (__builtin_expect(rc == RC_ABORT, 0)) {
+    if (__builtin_expect(rc != RC_OK, 0)) {
         ReleaseHeaderLocks(txMan, numSentinelLock);
-        m_abortsCounter++;
+        if (rc == RC_ABORT) {
+            m_abortsCounter++;
+        }
     } else {
         MOT_ASSERT(numSentinelLock == m_writeSetSize);
         m_rowsLocked = true;
@@ -318,9 +337,15 @@ bool OccTransactionManager::WriteChanges(TxnManager* txMan)
     if (m_writeSetSize == 0 && m_insertSetSize == 0) {
         return true;
     }
-    LockRows(txMan, m_rowsSetSize);
+    if (!m_rowsPreLocked) {
+        LockRows(txMan, m_rowsSetSize);
+    }
     MOTConfiguration& cfg = GetGlobalConfiguration();
 
+    if (m_keepVersions) {
+        LinkVersions(txMan);
+    }
+
     TxnOrderedSet_t& orderedSet = txMan->m_accessMgr->GetOrderedRowSet();
     // Update CSN with all relevant information on global rows
     // For deletes invalidate sentinels - rows still locked!
@@ -419,6 +444,9 @@ void OccTransactionManager::CleanRowsFromIndexes(TxnManager* txMan)
     TxnAccess* tx = txMan->m_accessMgr.Get();
     TxnOrderedSet_t& orderedSet = tx->GetOrderedRowSet();
     uint32_t numOfDeletes = m_deleteSetSize;
+    uint64_t csn = txMan->GetCommitSequenceNumber();
+    SnapshotManager* snapshotManager = GetSnapshotManager();
+    bool deferRemoval = m_keepVersions && snapshotManager->HasSnapshotBefore(csn);
     // use local counter to optimize
     for (const auto& raPair : orderedSet) {
         const Access* access = raPair.second;
@@ -426,8 +454,13 @@ void OccTransactionManager::CleanRowsFromIndexes(TxnManager* txMan)
             numOfDeletes--;
             access->GetTxnRow()->GetTable()->UpdateRowCount(-1);
             MOT_ASSERT(access->m_params.IsUpgradeInsert() == false);
-            // Use Txn Row as row may change INSERT after DELETE leaves residue
-            txMan->RemoveKeyFromIndex(access->GetTxnRow(), access->m_origSentinel);
+            // Keep the key while an older snapshot may still read the row
+            bool deferred = deferRemoval && access->GetTxnRow()->GetStable() == nullptr &&
+                            snapshotManager->DeferIndexRemoval(access->GetTxnRow(), access->m_origSentinel, csn);
+            if (!deferred) {
+                // Use Txn Row as row may change INSERT after DELETE leaves residue
+                txMan->RemoveKeyFromIndex(access->GetTxnRow(), access->m_origSentinel);
+            }
         }
         if (!numOfDeletes) {
             break;
@@ -489,10 +522,86 @@ void OccTransactionManager::ReleaseRowsLocks(TxnManager* txMan, uint32_t numOfLo
     }
 }
 
+bool OccTransactionManager::AllocateVersions(TxnManager* txMan)
+{
+    TxnOrderedSet_t& orderedSet = txMan->m_accessMgr->GetOrderedRowSet();
+    for (const auto& raPair : orderedSet) {
+        Access* access = raPair.second;
+        if (access->m_type == RD || !access->m_params.IsPrimarySentinel()) {
+            continue;
+        }
+        // a new row has no previous version
+        if (access->m_type == INS && !access->m_params.IsUpgradeInsert()) {
+            continue;
+        }
+        if (access->m_versionRow == nullptr) {
+            access->m_versionRow = access->GetTxnRow()->GetTable()->CreateNewRow();
+            if (access->m_versionRow == nullptr) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void OccTransactionManager::LinkVersions(TxnManager* txMan)
+{
+    TxnOrderedSet_t& orderedSet = txMan->m_accessMgr->GetOrderedRowSet();
+    for (const auto& raPair : orderedSet) {
+        Access* access = raPair.second;
+        if (access->m_type == RD || !access->m_params.IsPrimarySentinel()) {
+            continue;
+        }
+        // rows are locked, so snapshot readers wait for the whole chain to be updated
+        Row* row = access->GetRowFromHeader();
+        if (access->m_versionRow == nullptr) {
+            // new row on a sentinel whose deleted row is still kept for older snapshots
+            Row* deletedRow = access->m_origSentinel->GetData();
+            if (access->m_type == INS && deletedRow != nullptr && deletedRow != row) {
+                row->SetPrevVersion(deletedRow);
+            }
+            continue;
+        }
+        Row* version = access->m_versionRow;
+        access->m_versionRow = nullptr;
+        version->Copy(row);
+        version->CopySurrogateKey(row);
+        version->SetCommitSequenceNumber(row->GetCommitSequenceNumber());
+        version->SetPrevVersion(row->GetPrevVersion());
+        if (access->m_params.IsUpgradeInsert()) {
+            // the new row replaces the old one in the sentinel
+            access->m_auxRow->SetPrevVersion(version);
+        } else {
+            row->SetPrevVersion(version);
+        }
+        // readers that may still need the version started before this transaction committed
+        txMan->GetGcSession()->GcRecordObject(row->GetTable()->GetPrimaryIndex()->GetIndexId(),
+            version,
+            nullptr,
+            version->RowDtor,
+            ROW_SIZE_FROM_POOL(row->GetTable()));
+    }
+}
+
+void OccTransactionManager::ReleasePreLockedRows(TxnManager* txMan)
+{
+    TxnOrderedSet_t& orderedSet = txMan->m_accessMgr->GetOrderedRowSet();
+    for (const auto& raPair : orderedSet) {
+        const Access* access = raPair.second;
+        if (access->m_type == RD || !access->m_params.IsPrimarySentinel()) {
+            continue;
+        }
+        access->GetRowFromHeader()->m_rowHeader.Release();
+    }
+    m_rowsPreLocked = false;
+}
+
 void OccTransactionManager::CleanUp()
 {
     m_writeSetSize = 0;
     m_insertSetSize = 0;
     m_rowsSetSize = 0;
+    m_rowsPreLocked = false;
+    m_keepVersions = false;
 }
 }  // namespace MOT
@@ -108,6 +108,9 @@ public:
     {
         if (m_rowsLocked) {
             ReleaseHeaderLocks(txMan, m_writeSetSize);
+            if (m_rowsPreLocked) {
+                ReleasePreLockedRows(txMan);
+            }
             m_rowsLocked = false;
         }
     }
@@ -163,6 +166,12 @@ private:
     bool QuickHeaderValidation(const Access* access);
 
     void ReleaseHeaderLocks(TxnManager* txMan, uint32_t numOfLocks);
+    /** @brief Release the rows locked during validation when the changes were not written   */
+    void ReleasePreLockedRows(TxnManager* txMan);
+    /** @brief Pre-allocate the rows receiving the versions replaced by the transaction (snapshot reads)   */
+    bool AllocateVersions(TxnManager* txMan);
+    /** @brief Link the replaced versions to the rows before the changes are written (snapshot reads)   */
+    void LinkVersions(TxnManager* txMan);
     /** release all the locked rows    */
     void ReleaseRowsLocks(TxnManager* txMan, uint32_t numOfLocks);
     /** @var validate the read set   */
@@ -194,6 +203,12 @@ private:
     /** @var flag indicating whether we locked the rows   */
     bool m_rowsLocked;
 
+    /** @var flag indicating whether the rows were locked during validation (before the CSN is taken)   */
+    bool m_rowsPreLocked;
+
+    /** @var flag indicating whether replaced versions are kept for snapshot reads   */
+    bool m_keepVersions;
+
     /** @var Pre-abort configuration. */
     bool m_preAbort;
 
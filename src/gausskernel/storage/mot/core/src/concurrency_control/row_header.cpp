@@ -85,6 +85,39 @@ RC RowHeader::GetLocalCopy(
     return RC_OK;
 }
 
+uint64_t RowHeader::GetVersionCopy(uint64_t snapshotCsn, Row* localRow, const Row* origRow, Row*& prevVersion) const
+{
+    uint64_t sleepTime = 1;
+    uint64_t v = 0;
+    uint64_t v2 = 1;
+
+    while (v2 != v) {
+        // wait for a concurrent commit to finish writing the row
+        v = m_csnWord;
+        while (v & LOCK_BIT) {
+            if (sleepTime > LOCK_TIME_OUT) {
+                sleepTime = LOCK_TIME_OUT;
+                struct timespec ts = {0, 5000};
+                (void)nanosleep(&ts, NULL);
+            } else {
+                CpuCyclesLevelTime::Sleep(1);
+                sleepTime = sleepTime << 1;
+            }
+
+            v = m_csnWord;
+        }
+        if ((v & CSN_BITS) <= snapshotCsn) {
+            localRow->Copy(origRow);
+        } else {
+            prevVersion = origRow->GetPrevVersion();
+        }
+        COMPILER_BARRIER
+        v2 = m_csnWord;
+    }
+
+    return v;
+}
+
 bool RowHeader::ValidateWrite(TransactionId tid) const
 {
     return (tid == GetCSN());
@@ -99,6 +99,18 @@ private:
      */
     RC GetLocalCopy(TxnAccess* txn, AccessType type, Row* localRow, const Row* origRow, TransactionId& lastTid) const;
 
+    /**
+     * @brief Gets a consistent copy of a single row version for a snapshot read.
+     * @detail The row contents are copied only if the version is visible to the snapshot, otherwise
+     * the link to the previous version is retrieved.
+     * @param snapshotCsn The snapshot commit sequence number.
+     * @param[out] localRow Receives the row contents if the version is visible.
+     * @param origRow The row version to read.
+     * @param[out] prevVersion Receives the previous version if this version is not visible.
+     * @return The CSN word of the version (without the lock bit).
+     */
+    uint64_t GetVersionCopy(uint64_t snapshotCsn, Row* localRow, const Row* origRow, Row*& prevVersion) const;
+
     /**
      * @brief Validates the row was not changed by a concurrent transaction
      * @param tid The transaction identifier.
@@ -0,0 +1,180 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * snapshot_manager.cpp
+ *    Tracks the snapshots of active read-only transactions and the index removals they still depend on.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/concurrency_control/snapshot_manager.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "snapshot_manager.h"
+#include "mot_engine.h"
+#include "mot_error.h"
+#include "row.h"
+#include "sentinel.h"
+#include "txn.h"
+
+namespace MOT {
+IMPLEMENT_CLASS_LOGGER(SnapshotManager, ConcurrenyControl);
+
+bool SnapshotManager::Initialize(uint16_t maxConnectionCount)
+{
+    m_snapshots = new (std::nothrow) std::atomic<uint64_t>[maxConnectionCount];
+    if (m_snapshots == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM,
+            "Snapshot Manager Initialization",
+            "Failed to allocate %u snapshot slots",
+            (unsigned)maxConnectionCount);
+        return false;
+    }
+    for (uint16_t i = 0; i < maxConnectionCount; ++i) {
+        m_snapshots[i] = 0;
+    }
+    m_maxConnections = maxConnectionCount;
+    return true;
+}
+
+void SnapshotManager::Destroy()
+{
+    for (DeferredRemoval& removal : m_deferred) {
+        removal.m_row->GetTable()->DestroyRow(removal.m_row);
+    }
+    m_deferred.clear();
+    m_deferredCount = 0;
+    if (m_snapshots != nullptr) {
+        delete[] m_snapshots;
+        m_snapshots = nullptr;
+    }
+    m_maxConnections = 0;
+}
+
+uint64_t SnapshotManager::TakeSnapshot(uint64_t connectionId)
+{
+    MOT_ASSERT(connectionId < m_maxConnections);
+    ++m_activeCount;
+    // publish the snapshot and make sure no commit sequence number was issued meanwhile, so that a concurrent
+    // committer either sees the published snapshot or the snapshot already contains the committer
+    uint64_t csn = GetCSNManager().GetCurrentCSN();
+    for (;;) {
+        m_snapshots[connectionId] = csn;
+        uint64_t currentCsn = GetCSNManager().GetCurrentCSN();
+        if (currentCsn == csn) {
+            break;
+        }
+        csn = currentCsn;
+    }
+    return csn;
+}
+
+void SnapshotManager::ReleaseSnapshot(uint64_t connectionId)
+{
+    MOT_ASSERT(connectionId < m_maxConnections);
+    if (m_snapshots[connectionId] != 0) {
+        m_snapshots[connectionId] = 0;
+        --m_activeCount;
+    }
+}
+
+uint64_t SnapshotManager::GetOldestSnapshot() const
+{
+    uint64_t oldest = 0;
+    if (m_activeCount == 0) {
+        return oldest;
+    }
+    for (uint16_t i = 0; i < m_maxConnections; ++i) {
+        uint64_t csn = m_snapshots[i];
+        if (csn != 0 && (oldest == 0 || csn < oldest)) {
+            oldest = csn;
+        }
+    }
+    return oldest;
+}
+
+bool SnapshotManager::HasSnapshotBefore(uint64_t csn) const
+{
+    uint64_t oldest = GetOldestSnapshot();
+    return (oldest != 0 && oldest < csn);
+}
+
+bool SnapshotManager::DeferIndexRemoval(const Row* txnRow, Sentinel* sentinel, uint64_t csn)
+{
+    Table* table = txnRow->GetTable();
+    Row* row = table->CreateNewRow();
+    if (row == nullptr) {
+        MOT_LOG_WARN("Failed to allocate row for deferred index removal, removing key of table %s immediately",
+            table->GetLongTableName().c_str());
+        return false;
+    }
+    row->Copy(txnRow);
+    row->CopySurrogateKey(txnRow);
+
+    m_deferredLock.lock();
+    m_deferred.push_back({row, sentinel, sentinel->GetIndex(), csn});
+    ++m_deferredCount;
+    m_deferredLock.unlock();
+    return true;
+}
+
+void SnapshotManager::ProcessDeferredRemovals(TxnManager* txMan)
+{
+    if (m_deferredCount == 0) {
+        return;
+    }
+
+    // one session at a time is enough, others will get the chance on their next commit
+    if (!m_deferredLock.try_lock()) {
+        return;
+    }
+
+    uint64_t oldest = GetOldestSnapshot();
+    auto itr = m_deferred.begin();
+    while (itr != m_deferred.end()) {
+        // removals are queued in (roughly) commit order, so stop at the first one still required
+        if (oldest != 0 && itr->m_csn > oldest) {
+            break;
+        }
+        Row* row = itr->m_row;
+        row->GetTable()->RemoveKeyFromIndex(row, itr->m_sentinel, txMan->GetThdId(), txMan->GetGcSession());
+        row->GetTable()->DestroyRow(row);
+        itr = m_deferred.erase(itr);
+        --m_deferredCount;
+    }
+    m_deferredLock.unlock();
+}
+
+void SnapshotManager::PurgeDeferredRemovals(const Table* table, const Index* index)
+{
+    if (m_deferredCount == 0) {
+        return;
+    }
+
+    m_deferredLock.lock();
+    auto itr = m_deferred.begin();
+    while (itr != m_deferred.end()) {
+        Row* row = itr->m_row;
+        if ((index != nullptr) ? (itr->m_index == index) : (row->GetTable() == table)) {
+            row->GetTable()->DestroyRow(row);
+            itr = m_deferred.erase(itr);
+            --m_deferredCount;
+        } else {
+            ++itr;
+        }
+    }
+    m_deferredLock.unlock();
+}
+}  // namespace MOT
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * snapshot_manager.h
+ *    Tracks the snapshots of active read-only transactions and the index removals they still depend on.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/concurrency_control/snapshot_manager.h
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef SNAPSHOT_MANAGER_H
+#define SNAPSHOT_MANAGER_H
+
+#include <atomic>
+#include <list>
+#include "global.h"
+#include "spin_lock.h"
+#include "utilities.h"
+
+namespace MOT {
+// forward declarations
+class Row;
+class Sentinel;
+class Index;
+class Table;
+class TxnManager;
+
+/**
+ * @class SnapshotManager
+ * @brief Tracks the snapshots of active read-only transactions (one slot per connection).
+ * @detail Keys of deleted rows must remain in the indexes as long as a snapshot older than the deleting
+ * transaction is active, otherwise that snapshot would miss the row. Such removals are deferred here and
+ * carried out by committing sessions once no older snapshot is active anymore.
+ */
+class SnapshotManager {
+public:
+    SnapshotManager() : m_snapshots(nullptr), m_maxConnections(0), m_activeCount(0), m_deferredCount(0)
+    {}
+
+    ~SnapshotManager()
+    {}
+
+    /** @brief Initializes the snapshot manager with maximum number of connections. */
+    bool Initialize(uint16_t maxConnectionCount);
+
+    /** @brief Destroys the snapshot manager. */
+    void Destroy();
+
+    /**
+     * @brief Takes a snapshot for a connection. The snapshot contains all transactions that committed with a
+     * commit sequence number not greater than the returned one.
+     * @param connectionId The connection taking the snapshot.
+     * @return The snapshot commit sequence number.
+     */
+    uint64_t TakeSnapshot(uint64_t connectionId);
+
+    /**
+     * @brief Releases the snapshot of a connection.
+     * @param connectionId The connection releasing its snapshot.
+     */
+    void ReleaseSnapshot(uint64_t connectionId);
+
+    /**
+     * @brief Queries whether any active snapshot is older than the given commit sequence number.
+     * @param csn The commit sequence number.
+     * @return True if some active snapshot does not contain the transaction.
+     */
+    bool HasSnapshotBefore(uint64_t csn) const;
+
+    /**
+     * @brief Defers the removal of a deleted key from its index until all older snapshots are released.
+     * @param txnRow The deleted row (used for building the key).
+     * @param sentinel The index sentinel of the key.
+     * @param csn The commit sequence number of the deleting transaction.
+     * @return True if the removal was deferred, or false if the caller should remove the key now.
+     */
+    bool DeferIndexRemoval(const Row* txnRow, Sentinel* sentinel, uint64_t csn);
+
+    /**
+     * @brief Carries out all deferred removals that are no longer required by an active snapshot.
+     * @param txMan The transaction under which the keys are removed (provides the GC session).
+     */
+    void ProcessDeferredRemovals(TxnManager* txMan);
+
+    /**
+     * @brief Discards the deferred removals of a table or index that is being dropped or truncated.
+     * @param table The table.
+     * @param index The index, or null to discard the removals of all the table indexes.
+     */
+    void PurgeDeferredRemovals(const Table* table, const Index* index = nullptr);
+
+private:
+    /** @brief Retrieves the oldest active snapshot, or zero if there is none. */
+    uint64_t GetOldestSnapshot() const;
+
+    /** @struct A deferred removal of a deleted key. */
+    struct DeferredRemoval {
+        /** @var Copy of the deleted row used for building the key. */
+        Row* m_row;
+
+        /** @var The sentinel to remove. */
+        Sentinel* m_sentinel;
+
+        /** @var The index of the sentinel. */
+        Index* m_index;
+
+        /** @var Commit sequence number of the deleting transaction. */
+        uint64_t m_csn;
+    };
+
+    /** @var Snapshot slot per connection (zero when the connection has no active snapshot). */
+    std::atomic<uint64_t>* m_snapshots;
+
+    /** @var Number of slots. */
+    uint16_t m_maxConnections;
+
+    /** @var Number of active snapshots. */
+    std::atomic<uint32_t> m_activeCount;
+
+    /** @var Number of pending removals (allows lock-free quick check). */
+    std::atomic<uint32_t> m_deferredCount;
+
+    /** @var Pending removals, in commit order. */
+    std::list<DeferredRemoval> m_deferred;
+
+    /** @var Lock protecting the pending removals. */
+    spin_lock m_deferredLock;
+
+    DECLARE_CLASS_LOGGER()
+};
+}  // namespace MOT
+
+#endif /* SNAPSHOT_MANAGER_H */
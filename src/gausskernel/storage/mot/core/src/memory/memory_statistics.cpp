@@ -35,6 +35,7 @@
 #include "mm_global_api.h"
 #include "mot_error.h"
 #include "mm_api.h"
+#include "mot_engine.h"
 
 namespace MOT {
 DECLARE_LOGGER(MemoryStatistics, Memory)
@@ -324,5 +325,9 @@ void MemoryStatisticsProvider::OnConfigChange()
 void MemoryStatisticsProvider::PrintStatisticsEx()
 {
     MemPrint("Periodic Status", LogLevel::LL_INFO, MEM_REPORT_SUMMARY);
+    ColdRowStore* coldStore = GetColdRowStore();
+    if (coldStore != nullptr) {
+        coldStore->PrintStats(LogLevel::LL_INFO);
+    }
 }
 }  // namespace MOT
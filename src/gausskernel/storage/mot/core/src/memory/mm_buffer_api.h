@@ -66,18 +66,19 @@ extern int MemBufferApiInit();
 extern void MemBufferApiDestroy();
 
 /**
- * @brief Allocates a buffer from the global buffer allocator of the current NUMA node.
+ * @brief Allocates a buffer from the global buffer allocator of the specified NUMA node.
  * @param bufferClass The class of buffer pool from which to allocate a buffer.
+ * @param node The NUMA node identifier.
  * @return The buffer pointer or NULL if allocation failed (i.e. out of memory).
- * @note The global buffer allocator provides buffers from interleaved NUMA pages.
+ * @note The buffer resides on the specified node only if global chunks are allocated with the local chunk
+ * allocation policy. If the global allocator of the node is depleted, the buffer is taken from another node.
  */
-inline void* MemBufferAllocGlobal(MemBufferClass bufferClass)
+inline void* MemBufferAllocGlobalOnNode(MemBufferClass bufferClass, int node)
 {
     void* buffer = nullptr;
-    int node = MOTCurrentNumaNodeId;
-    if (node < 0) {
+    if (node < 0 || node >= (int)g_memGlobalCfg.m_nodeCount) {
         MemBufferIssueError(MOT_ERROR_INVALID_ARG,
-            "Cannot allocate %s global buffer: Invalid NUMA node identifier %u",
+            "Cannot allocate %s global buffer: Invalid NUMA node identifier %d",
             MemBufferClassToString(bufferClass),
             node);
     } else {
@@ -104,6 +105,17 @@ inline void* MemBufferAllocGlobal(MemBufferClass bufferClass)
     return buffer;
 }
 
+/**
+ * @brief Allocates a buffer from the global buffer allocator of the current NUMA node.
+ * @param bufferClass The class of buffer pool from which to allocate a buffer.
+ * @return The buffer pointer or NULL if allocation failed (i.e. out of memory).
+ * @note The global buffer allocator provides buffers from interleaved NUMA pages.
+ */
+inline void* MemBufferAllocGlobal(MemBufferClass bufferClass)
+{
+    return MemBufferAllocGlobalOnNode(bufferClass, MOTCurrentNumaNodeId);
+}
+
 /**
  * @brief Allocates a buffer from the local buffer allocator of the specified NUMA node.
  * @param bufferClass The class of buffer pool from which to allocate a buffer.
@@ -44,13 +44,13 @@ ObjPoolPtr& ObjPoolPtr::operator=(ObjPool* right)
     return *this;
 }
 
-ObjAllocInterface* ObjAllocInterface::GetObjPool(uint16_t size, bool local, uint8_t align)
+ObjAllocInterface* ObjAllocInterface::GetObjPool(uint16_t size, bool local, uint8_t align, int node)
 {
     ObjAllocInterface* result = NULL;
     if (local) {
         result = new (std::nothrow) LocalObjPool(size, align);
     } else {
-        result = new (std::nothrow) GlobalObjPool(size, align);
+        result = new (std::nothrow) GlobalObjPool(size, align, node);
     }
 
     if (result == NULL) {
@@ -313,7 +313,7 @@ public:
     MemBufferClass m_type;
     bool m_global;
 
-    static ObjAllocInterface* GetObjPool(uint16_t size, bool local, uint8_t align = 8);
+    static ObjAllocInterface* GetObjPool(uint16_t size, bool local, uint8_t align = 8, int node = MEM_INVALID_NODE);
     static void FreeObjPool(ObjAllocInterface** pool);
 
     explicit ObjAllocInterface(bool isGlobal) : m_global(isGlobal)
@@ -405,6 +405,19 @@ public:
     ~ObjPool()
     {}
 
+    /**
+     * @brief Retrieves the object pool interface from which an object was allocated.
+     * @param ptr The object.
+     * @param size The size of the object (including the object index).
+     * @return The owning object pool interface.
+     */
+    static inline ObjAllocInterface* GetOwner(void* ptr, uint16_t size)
+    {
+        uint8_t* p = (uint8_t*)ptr;
+        uint8_t oix = p[size - 1];
+        return ((ObjPool*)(p - sizeof(ObjPool) - oix * size))->m_parent;
+    }
+
     inline void AllocNoLock(void** ret, PoolAllocStateT* state)
     {
         uint8_t ix = ++(m_head.m_nextFreeObj);
@@ -456,7 +469,8 @@ public:
         }
     }
 
-    static ObjPool* GetObjPool(uint16_t size, ObjAllocInterface* app, MemBufferClass type, bool global)
+    static ObjPool* GetObjPool(
+        uint16_t size, ObjAllocInterface* app, MemBufferClass type, bool global, int node = MEM_INVALID_NODE)
     {
 #ifdef TEST_STAT_ALLOC
         uint64_t start_time = GetSysClock();
@@ -467,7 +481,7 @@ public:
         void* p;
 
         if (global == true)
-            p = MemBufferAllocGlobal(type);
+            p = (node == MEM_INVALID_NODE) ? MemBufferAllocGlobal(type) : MemBufferAllocGlobalOnNode(type, node);
         else
 #ifdef MEM_SESSION_ACTIVE
         {
@@ -640,7 +654,10 @@ class GlobalObjPool : public ObjAllocInterface {
 public:
     ThreadAOP m_threadAOP[MAX_THR_NUM];
 
-    GlobalObjPool(uint16_t sz, uint8_t align) : ObjAllocInterface(true)
+    /** @var The NUMA node from which sub-pools are allocated (MEM_INVALID_NODE for the current node). */
+    int m_node;
+
+    GlobalObjPool(uint16_t sz, uint8_t align, int node = MEM_INVALID_NODE) : ObjAllocInterface(true), m_node(node)
     {
         m_objList = nullptr;
         m_nextFree = nullptr;
@@ -660,7 +677,7 @@ public:
     {
         bool result = true;
         for (int i = 0; i < INITIAL_NUM_OBJPOOL; i++) {
-            ObjPool* op = ObjPool::GetObjPool(m_size, this, m_type, true);
+            ObjPool* op = ObjPool::GetObjPool(m_size, this, m_type, true, m_node);
             if (op == nullptr) {
                 // memory deallocated when object is destroyed (see ~ObjAllocInterface())
                 result = false;
@@ -688,7 +705,7 @@ public:
             }
         }
 
-        ObjPool* op = ObjPool::GetObjPool(m_size, this, m_type, true);
+        ObjPool* op = ObjPool::GetObjPool(m_size, this, m_type, true, m_node);
 
         if (op != nullptr) {
             ADD_TO_LIST(m_objList, op);
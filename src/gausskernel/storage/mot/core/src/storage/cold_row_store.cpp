@@ -0,0 +1,462 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * cold_row_store.cpp
+ *    File-backed store for rows that were not accessed for a long time.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/storage/cold_row_store.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <list>
+#include <sys/mman.h>
+#include "cold_row_store.h"
+#include "row.h"
+#include "table.h"
+#include "sentinel.h"
+#include "txn.h"
+#include "mot_engine.h"
+#include "checkpoint_manager.h"
+#include "checkpoint_utils.h"
+#include "mm_api.h"
+#include "mm_cfg.h"
+#include "mm_def.h"
+#include "mot_error.h"
+
+namespace MOT {
+IMPLEMENT_CLASS_LOGGER(ColdRowStore, Storage);
+
+constexpr uint64_t ColdRowStore::SEGMENT_SIZE;
+constexpr uint32_t ColdRowStore::INVALID_SEGMENT;
+constexpr uint64_t ColdRowStore::EVICT_SLACK_PERCENT;
+constexpr uint32_t ColdRowStore::EVICT_BATCH_ROWS;
+constexpr uint32_t ColdRowStore::EVICTOR_TICK_USEC;
+
+static const char* const COLD_ROW_STORE_FILE = "mot_cold_rows.dat";
+
+bool ColdRowStore::Initialize(uint64_t maxSizeMB)
+{
+    std::string workingDir;
+    if (!CheckpointUtils::GetWorkingDir(workingDir)) {
+        MOT_LOG_ERROR("Failed to get working directory for cold row store");
+        return false;
+    }
+    m_path = workingDir + COLD_ROW_STORE_FILE;
+
+    m_segmentCount = (uint32_t)((maxSizeMB * MEGA_BYTE) / SEGMENT_SIZE);
+    if (m_segmentCount == 0) {
+        MOT_LOG_ERROR("Invalid cold row store size: %" PRIu64 " MB", maxSizeMB);
+        return false;
+    }
+    m_capacity = m_segmentCount * SEGMENT_SIZE;
+
+    // previous contents are meaningless after restart, since all rows are reloaded by recovery
+    m_fd = open(m_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, S_IRUSR | S_IWUSR);
+    if (m_fd == -1) {
+        MOT_REPORT_SYSTEM_ERROR(open, "Cold Row Store Initialization", "Failed to open file %s", m_path.c_str());
+        return false;
+    }
+
+    // the file is sparse, disk space is allocated when a segment is taken into use
+    if (ftruncate(m_fd, (off_t)m_capacity) != 0) {
+        MOT_REPORT_SYSTEM_ERROR(ftruncate,
+            "Cold Row Store Initialization",
+            "Failed to set size of file %s to %" PRIu64 " bytes",
+            m_path.c_str(),
+            m_capacity);
+        Destroy();
+        return false;
+    }
+
+    void* base = mmap(nullptr, m_capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_NORESERVE, m_fd, 0);
+    if (base == MAP_FAILED) {
+        MOT_REPORT_SYSTEM_ERROR(mmap, "Cold Row Store Initialization", "Failed to map file %s", m_path.c_str());
+        Destroy();
+        return false;
+    }
+    m_base = (uint8_t*)base;
+
+    m_segments = new (std::nothrow) ColdSegment[m_segmentCount];
+    if (m_segments == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM,
+            "Cold Row Store Initialization",
+            "Failed to allocate %u cold row store segment descriptors",
+            m_segmentCount);
+        Destroy();
+        return false;
+    }
+    m_freeSegments.reserve(m_segmentCount);
+    for (uint32_t i = 0; i < m_segmentCount; ++i) {
+        m_segments[i].m_liveBytes = 0;
+        m_segments[i].m_rowCount = 0;
+        m_segments[i].m_usedBytes = 0;
+        m_segments[i].m_tableId = 0;
+        m_segments[i].m_inUse = false;
+        m_segments[i].m_sealed = false;
+        // pop from the back, so segments are used in file order
+        m_freeSegments.push_back(m_segmentCount - i - 1);
+    }
+
+    MOT_LOG_INFO("Cold row store initialized at %s with %" PRIu64 " MB", m_path.c_str(), maxSizeMB);
+    return true;
+}
+
+void ColdRowStore::Destroy()
+{
+    if (m_segments != nullptr) {
+        delete[] m_segments;
+        m_segments = nullptr;
+    }
+    if (m_base != nullptr) {
+        (void)munmap(m_base, m_capacity);
+        m_base = nullptr;
+    }
+    if (m_fd != -1) {
+        (void)close(m_fd);
+        m_fd = -1;
+        (void)unlink(m_path.c_str());
+    }
+    m_freeSegments.clear();
+    m_capacity = 0;
+}
+
+bool ColdRowStore::Start()
+{
+    m_stop = false;
+    m_evictor = std::thread(&ColdRowStore::EvictorFunc, this);
+    return true;
+}
+
+void ColdRowStore::Stop()
+{
+    m_stop = true;
+    if (m_evictor.joinable()) {
+        m_evictor.join();
+    }
+}
+
+void ColdRowStore::Touch(Sentinel* sentinel) const
+{
+    Row* row = sentinel->GetData();
+    if (row != nullptr) {
+        row->Touch(GetClock());
+    }
+}
+
+void ColdRowStore::Release(Row* row, uint32_t size)
+{
+    uint32_t segment = (uint32_t)(((uint8_t*)row - m_base) / SEGMENT_SIZE);
+    MOT_ASSERT(segment < m_segmentCount);
+    ColdSegment& seg = m_segments[segment];
+
+    m_lock.lock();
+    // the segment is already gone if the table was truncated or dropped
+    if (seg.m_inUse) {
+        (void)--m_coldRows;
+        m_coldBytes -= size;
+        (void)--seg.m_rowCount;
+        if ((seg.m_liveBytes -= size) == 0 && seg.m_sealed) {
+            FreeSegment(segment);
+        }
+    }
+    m_lock.unlock();
+}
+
+void ColdRowStore::ReleaseTable(uint32_t tableId)
+{
+    // the eviction thread seals its segment before releasing the table lock, so no segment of this table is current
+    m_lock.lock();
+    for (uint32_t i = 0; i < m_segmentCount; ++i) {
+        ColdSegment& seg = m_segments[i];
+        if (seg.m_inUse && seg.m_tableId == tableId) {
+            MOT_ASSERT(i != m_currSegment);
+            m_coldBytes -= seg.m_liveBytes;
+            m_coldRows -= seg.m_rowCount;
+            seg.m_liveBytes = 0;
+            seg.m_rowCount = 0;
+            FreeSegment(i);
+        }
+    }
+    m_lock.unlock();
+}
+
+void ColdRowStore::PrintStats(LogLevel logLevel) const
+{
+    uint64_t usedSegments = m_segmentCount - m_freeSegments.size();
+    MOT_LOG(logLevel,
+        "Cold row store: %" PRIu64 " rows, %" PRIu64 " MB live, %" PRIu64 " MB on disk, %" PRIu64
+        " rows evicted in total",
+        m_coldRows.load(),
+        m_coldBytes.load() / MEGA_BYTE,
+        (usedSegments * SEGMENT_SIZE) / MEGA_BYTE,
+        m_evictedRows.load());
+}
+
+void ColdRowStore::EvictorFunc()
+{
+    MOT_DECLARE_NON_KERNEL_THREAD();
+    SessionContext* sessionContext = GetSessionManager()->CreateSessionContext();
+    if (sessionContext == nullptr) {
+        MOT_LOG_ERROR("Failed to create session context for cold row eviction, cold rows will not be evicted");
+        MOTEngine::GetInstance()->OnCurrentThreadEnding();
+        return;
+    }
+    TxnManager* txn = sessionContext->GetTxnManager();
+    MOTConfiguration& cfg = GetGlobalConfiguration();
+    time_t startTime = time(nullptr);
+
+    MOT_LOG_INFO("Cold row eviction thread started");
+    while (!m_stop) {
+        (void)usleep(EVICTOR_TICK_USEC);
+        uint32_t clock = (uint32_t)(time(nullptr) - startTime);
+        if (clock == GetClock()) {
+            continue;
+        }
+        m_clock.store(clock, std::memory_order_relaxed);
+        if (MOTEngine::GetInstance()->IsRecovering()) {
+            continue;
+        }
+
+        uint64_t limitBytes = g_memGlobalCfg.m_maxGlobalMemoryMb * MEGA_BYTE;
+        uint64_t thresholdBytes = limitBytes / 100 * cfg.m_coldRowMemoryThreshold;
+        uint64_t usedBytes = MemGetCurrentGlobalMemoryBytes();
+        if (usedBytes > thresholdBytes) {
+            uint64_t targetBytes = (usedBytes - thresholdBytes) + (limitBytes / 100 * EVICT_SLACK_PERCENT);
+            EvictColdRows(txn, targetBytes);
+        }
+    }
+
+    SealCurrentSegment();
+    GetSessionManager()->DestroySessionContext(sessionContext);
+    MOTEngine::GetInstance()->OnCurrentThreadEnding();
+    MOT_LOG_INFO("Cold row eviction thread stopped");
+}
+
+void ColdRowStore::EvictColdRows(TxnManager* txn, uint64_t targetBytes)
+{
+    std::list<Table*> tables;
+    (void)GetTableManager()->AddTablesToList(tables);
+
+    uint64_t evictedBytes = 0;
+    m_allocFailed = false;
+    for (Table* table : tables) {
+        if (evictedBytes < targetBytes && !m_stop && !m_allocFailed) {
+            evictedBytes += EvictTableRows(txn, table, targetBytes - evictedBytes);
+        }
+        table->RdUnlock();
+    }
+
+    if (evictedBytes > 0) {
+        MOT_LOG_DEBUG("Evicted %" PRIu64 " MB of cold rows", evictedBytes / MEGA_BYTE);
+    }
+}
+
+uint64_t ColdRowStore::EvictTableRows(TxnManager* txn, Table* table, uint64_t targetBytes)
+{
+    uint64_t evictedBytes = 0;
+    uint32_t rowSize = table->GetRowSizeFromPool();
+    bool checkpointEnabled = GetGlobalConfiguration().m_enableCheckpoint;
+
+    IndexIterator* it = table->GetPrimaryIndex()->Begin(txn->GetThdId());
+    if (it == nullptr) {
+        return 0;
+    }
+
+    bool done = false;
+    while (!done && it->IsValid()) {
+        // rows may be moved only while no checkpoint is capturing them, so register like a transaction would
+        txn->GcSessionStart();
+        txn->SetCommitSequenceNumber(GetCSNManager().GetCurrentCSN());
+        if (checkpointEnabled) {
+            GetCheckpointManager()->BeginTransaction(txn);
+        }
+
+        if (!checkpointEnabled || txn->m_checkpointPhase == CheckpointPhase::REST) {
+            for (uint32_t i = 0; i < EVICT_BATCH_ROWS && it->IsValid(); ++i) {
+                if (EvictRow(txn, table, it->GetPrimarySentinel())) {
+                    evictedBytes += rowSize;
+                }
+                it->Next();
+            }
+            done = (evictedBytes >= targetBytes) || m_stop || m_allocFailed;
+        } else {
+            // checkpoint in progress, retry in the next round
+            done = true;
+        }
+
+        if (checkpointEnabled) {
+            GetCheckpointManager()->TransactionCompleted(txn);
+        }
+        txn->GcSessionEnd();
+    }
+    delete it;
+
+    // segments are owned by a single table, and a table may be dropped as soon as it is unlocked
+    SealCurrentSegment();
+
+    // rows reclaimed by the GC since the previous round leave empty sub-pools, return them to the global memory
+    table->ClearRowCache();
+    return evictedBytes;
+}
+
+bool ColdRowStore::EvictRow(TxnManager* txn, Table* table, Sentinel* sentinel)
+{
+    if (!sentinel->IsCommited() || sentinel->GetStable() != nullptr) {
+        return false;
+    }
+
+    Row* row = sentinel->GetData();
+    if (row == nullptr || Contains(row) || row->m_prevVersion != nullptr || row->IsAbsentRow()) {
+        return false;
+    }
+
+    uint32_t accessClock = row->GetAccessClock();
+    uint32_t clock = GetClock();
+    if (accessClock > clock || (clock - accessClock) < GetGlobalConfiguration().m_coldRowMinAgeSeconds) {
+        return false;
+    }
+
+    // skip rows being written, the row will be considered again in the next round
+    if (!sentinel->TryLock(txn->GetThdId())) {
+        return false;
+    }
+
+    bool result = false;
+    row = sentinel->GetData();
+    if (row != nullptr && !Contains(row) && row->m_prevVersion == nullptr && !row->IsAbsentRow() &&
+        !row->m_rowHeader.IsLocked()) {
+        uint32_t rowSize = table->GetRowSizeFromPool();
+        void* buf = Allocate(table->GetTableId(), rowSize);
+        if (buf != nullptr) {
+            Row* coldRow = new (buf) Row(*row);
+            sentinel->SetNextPtr(coldRow);
+            ++m_coldRows;
+            ++m_evictedRows;
+            m_coldBytes += rowSize;
+            // concurrent readers may still hold the in-memory row, so it is reclaimed by the GC
+            txn->GetGcSession()->GcRecordObject(
+                table->GetPrimaryIndex()->GetIndexId(), row, nullptr, Row::RowDtor, rowSize);
+            result = true;
+        }
+    }
+    sentinel->Release();
+    return result;
+}
+
+void* ColdRowStore::Allocate(uint32_t tableId, uint32_t size)
+{
+    uint64_t alignedSize = (size + 7) & ~((uint64_t)7);
+    if (m_currSegment != INVALID_SEGMENT) {
+        ColdSegment& seg = m_segments[m_currSegment];
+        if (seg.m_tableId != tableId || (seg.m_usedBytes + alignedSize) > SEGMENT_SIZE) {
+            SealCurrentSegment();
+        }
+    }
+
+    if (m_currSegment == INVALID_SEGMENT) {
+        uint32_t segment = INVALID_SEGMENT;
+        m_lock.lock();
+        if (!m_freeSegments.empty()) {
+            segment = m_freeSegments.back();
+            m_freeSegments.pop_back();
+        }
+        m_lock.unlock();
+        if (segment == INVALID_SEGMENT) {
+            MOT_LOG_WARN("Cold row store is full, cannot evict more rows");
+            m_allocFailed = true;
+            return nullptr;
+        }
+
+        // writing to a page of the mapping without disk space behind it raises SIGBUS, so the whole segment is
+        // allocated before any row is copied into it, and the rows stay in memory if the disk is full
+        int rc = posix_fallocate(m_fd, (off_t)segment * SEGMENT_SIZE, (off_t)SEGMENT_SIZE);
+        if (rc != 0) {
+            MOT_LOG_WARN("Failed to allocate disk space for cold row store segment %u, cannot evict more rows: %s",
+                segment,
+                gs_strerror(rc));
+            m_lock.lock();
+            m_freeSegments.push_back(segment);
+            m_lock.unlock();
+            m_allocFailed = true;
+            return nullptr;
+        }
+
+        m_lock.lock();
+        ColdSegment& seg = m_segments[segment];
+        seg.m_liveBytes = 0;
+        seg.m_rowCount = 0;
+        seg.m_usedBytes = 0;
+        seg.m_tableId = tableId;
+        seg.m_sealed = false;
+        seg.m_inUse = true;
+        m_currSegment = segment;
+        m_lock.unlock();
+    }
+
+    ColdSegment& seg = m_segments[m_currSegment];
+    void* result = m_base + (uint64_t)m_currSegment * SEGMENT_SIZE + seg.m_usedBytes;
+    seg.m_usedBytes += alignedSize;
+    seg.m_liveBytes += size;
+    ++seg.m_rowCount;
+    return result;
+}
+
+void ColdRowStore::SealCurrentSegment()
+{
+    m_lock.lock();
+    uint32_t segment = m_currSegment;
+    m_currSegment = INVALID_SEGMENT;
+    if (segment == INVALID_SEGMENT) {
+        m_lock.unlock();
+        return;
+    }
+
+    ColdSegment& seg = m_segments[segment];
+    seg.m_sealed = true;
+    if (seg.m_liveBytes == 0) {
+        FreeSegment(segment);
+        m_lock.unlock();
+        return;
+    }
+    m_lock.unlock();
+
+    // write the rows back and drop them from memory, they are paged in again on access
+    uint8_t* addr = m_base + (uint64_t)segment * SEGMENT_SIZE;
+    if (msync(addr, SEGMENT_SIZE, MS_SYNC) != 0) {
+        MOT_LOG_SYSTEM_ERROR(msync, "Failed to flush cold row store segment %u", segment);
+        return;
+    }
+    (void)madvise(addr, SEGMENT_SIZE, MADV_DONTNEED);
+    (void)posix_fadvise(m_fd, (off_t)segment * SEGMENT_SIZE, (off_t)SEGMENT_SIZE, POSIX_FADV_DONTNEED);
+}
+
+void ColdRowStore::FreeSegment(uint32_t segment)
+{
+    ColdSegment& seg = m_segments[segment];
+    seg.m_inUse = false;
+    seg.m_sealed = false;
+    seg.m_usedBytes = 0;
+    (void)fallocate(m_fd,
+        FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE,
+        (off_t)segment * SEGMENT_SIZE,
+        (off_t)SEGMENT_SIZE);
+    m_freeSegments.push_back(segment);
+}
+}  // namespace MOT
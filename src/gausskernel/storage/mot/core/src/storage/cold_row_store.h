@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * cold_row_store.h
+ *    File-backed store for rows that were not accessed for a long time.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/storage/cold_row_store.h
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef COLD_ROW_STORE_H
+#define COLD_ROW_STORE_H
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+#include "global.h"
+#include "spin_lock.h"
+#include "utilities.h"
+
+namespace MOT {
+// forward declarations
+class Row;
+class Table;
+class Sentinel;
+class TxnManager;
+
+/**
+ * @class ColdRowStore
+ * @brief Moves cold rows out of MOT memory into a shared file mapping.
+ * @detail When MOT memory usage exceeds the configured threshold, a background thread relocates rows that were not
+ * accessed for a while into a memory-mapped file and hands the original rows over to the GC. Since the relocated row
+ * is still a complete row, the primary sentinel simply points to its new address, and all readers keep working
+ * without change: the operating system pages the row back in on access. The file is split into segments owned by a
+ * single table. A segment is written sequentially, flushed and dropped from the page cache when full, and its disk
+ * space is released once all its rows are gone.
+ */
+class ColdRowStore {
+public:
+    ColdRowStore()
+        : m_fd(-1),
+          m_base(nullptr),
+          m_capacity(0),
+          m_segments(nullptr),
+          m_segmentCount(0),
+          m_currSegment(INVALID_SEGMENT),
+          m_allocFailed(false),
+          m_clock(0),
+          m_stop(false),
+          m_coldRows(0),
+          m_coldBytes(0),
+          m_evictedRows(0)
+    {}
+
+    ~ColdRowStore()
+    {}
+
+    /**
+     * @brief Creates the store file and maps it.
+     * @param maxSizeMB The maximum size of the store file in mega-bytes.
+     * @return True if succeeded.
+     */
+    bool Initialize(uint64_t maxSizeMB);
+
+    /** @brief Unmaps and removes the store file. */
+    void Destroy();
+
+    /** @brief Starts the eviction thread. */
+    bool Start();
+
+    /** @brief Stops the eviction thread. */
+    void Stop();
+
+    /**
+     * @brief Queries whether a row resides in the store.
+     * @param row The row.
+     * @return True if the row was relocated into the store.
+     */
+    inline bool Contains(const Row* row) const
+    {
+        const uint8_t* ptr = reinterpret_cast<const uint8_t*>(row);
+        return (ptr >= m_base) && (ptr < m_base + m_capacity);
+    }
+
+    /**
+     * @brief Records an access to the row referenced by a sentinel.
+     * @param sentinel The primary or secondary sentinel.
+     */
+    void Touch(Sentinel* sentinel) const;
+
+    /**
+     * @brief Retrieves the current access clock (seconds since the store was started).
+     * @return The access clock.
+     */
+    inline uint32_t GetClock() const
+    {
+        return m_clock.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Releases a row residing in the store.
+     * @param row The row.
+     * @param size The size of the row.
+     */
+    void Release(Row* row, uint32_t size);
+
+    /**
+     * @brief Releases all the rows of a table that is being dropped or truncated.
+     * @param tableId The internal table identifier.
+     */
+    void ReleaseTable(uint32_t tableId);
+
+    /** @brief Prints the store usage. */
+    void PrintStats(LogLevel logLevel) const;
+
+private:
+    /** @var Size of a store segment. */
+    static constexpr uint64_t SEGMENT_SIZE = 4 * 1024 * 1024;
+
+    /** @var Marks no segment. */
+    static constexpr uint32_t INVALID_SEGMENT = (uint32_t)-1;
+
+    /** @var Percentage of the memory limit freed beyond the threshold in each eviction round. */
+    static constexpr uint64_t EVICT_SLACK_PERCENT = 5;
+
+    /** @var Number of scanned rows after which the eviction thread re-registers with the checkpoint. */
+    static constexpr uint32_t EVICT_BATCH_ROWS = 4096;
+
+    /** @var Eviction thread wake-up interval in micro-seconds. */
+    static constexpr uint32_t EVICTOR_TICK_USEC = 100000;
+
+    /** @struct A store segment. */
+    struct ColdSegment {
+        /** @var Total size of the rows in the segment that were not released yet. */
+        std::atomic<uint64_t> m_liveBytes;
+
+        /** @var Number of rows in the segment that were not released yet. */
+        std::atomic<uint32_t> m_rowCount;
+
+        /** @var Number of bytes appended so far. */
+        uint64_t m_usedBytes;
+
+        /** @var Internal identifier of the owning table. */
+        uint32_t m_tableId;
+
+        /** @var Specifies whether the segment is in use. */
+        bool m_inUse;
+
+        /** @var Specifies whether the segment is full (no more rows are appended to it). */
+        bool m_sealed;
+    };
+
+    /** @brief Eviction thread function. */
+    void EvictorFunc();
+
+    /**
+     * @brief Moves cold rows out of memory.
+     * @param txn The transaction of the eviction thread.
+     * @param targetBytes The number of bytes to free.
+     */
+    void EvictColdRows(TxnManager* txn, uint64_t targetBytes);
+
+    /**
+     * @brief Moves cold rows of a single table out of memory.
+     * @param txn The transaction of the eviction thread.
+     * @param table The table.
+     * @param targetBytes The number of bytes to free.
+     * @return The number of bytes freed.
+     */
+    uint64_t EvictTableRows(TxnManager* txn, Table* table, uint64_t targetBytes);
+
+    /**
+     * @brief Relocates a single row into the store.
+     * @param txn The transaction of the eviction thread.
+     * @param table The table.
+     * @param sentinel The primary sentinel of the row.
+     * @return True if the row was relocated.
+     */
+    bool EvictRow(TxnManager* txn, Table* table, Sentinel* sentinel);
+
+    /**
+     * @brief Allocates space for a row in the current segment of a table.
+     * @param tableId The internal table identifier.
+     * @param size The size of the row.
+     * @return The allocated space, or null if the store is full or no disk space could be allocated.
+     */
+    void* Allocate(uint32_t tableId, uint32_t size);
+
+    /** @brief Seals the current segment, flushes it and drops it from the page cache. */
+    void SealCurrentSegment();
+
+    /** @brief Returns a segment to the free list and releases its disk space (caller holds the lock). */
+    void FreeSegment(uint32_t segment);
+
+    /** @var The store file descriptor. */
+    int m_fd;
+
+    /** @var The store file path. */
+    std::string m_path;
+
+    /** @var The mapped store file. */
+    uint8_t* m_base;
+
+    /** @var The size of the mapping in bytes. */
+    uint64_t m_capacity;
+
+    /** @var The segment descriptors. */
+    ColdSegment* m_segments;
+
+    /** @var Number of segments. */
+    uint32_t m_segmentCount;
+
+    /** @var The segment being appended to (accessed by the eviction thread only, while holding the table lock). */
+    uint32_t m_currSegment;
+
+    /** @var No segment could be allocated in the current eviction round (accessed by the eviction thread only). */
+    bool m_allocFailed;
+
+    /** @var Free segments. */
+    std::vector<uint32_t> m_freeSegments;
+
+    /** @var Lock protecting the segment states and the free segments. */
+    spin_lock m_lock;
+
+    /** @var The access clock. */
+    std::atomic<uint32_t> m_clock;
+
+    /** @var Stops the eviction thread. */
+    std::atomic<bool> m_stop;
+
+    /** @var The eviction thread. */
+    std::thread m_evictor;
+
+    /** @var Number of rows in the store. */
+    std::atomic<uint64_t> m_coldRows;
+
+    /** @var Total size of the rows in the store. */
+    std::atomic<uint64_t> m_coldBytes;
+
+    /** @var Total number of rows ever moved into the store. */
+    std::atomic<uint64_t> m_evictedRows;
+
+    DECLARE_CLASS_LOGGER()
+};
+}  // namespace MOT
+
+#endif /* COLD_ROW_STORE_H */
@@ -0,0 +1,442 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * hash_index.cpp
+ *    Unique index implementation using a lock-free resizable hash table.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/storage/index/hash_index.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include "hash_index.h"
+#include "mot_engine.h"
+
+namespace MOT {
+IMPLEMENT_CLASS_LOGGER(HashUniqueIndex, Storage);
+
+uint64_t HashUniqueIndex::HashKey(const uint8_t* buf, uint16_t len)
+{
+    // 64-bit multiply-xorshift over whole words, good enough dispersion for binary index keys
+    const uint64_t mul = 0x9E3779B97F4A7C15ULL;
+    uint64_t hash = len * mul;
+    uint16_t i = 0;
+    for (; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t)) {
+        uint64_t word;
+        errno_t erc = memcpy_s(&word, sizeof(word), buf + i, sizeof(word));
+        securec_check(erc, "\0", "\0");
+        hash = (hash ^ word) * mul;
+        hash ^= hash >> 32;
+    }
+    for (; i < len; ++i) {
+        hash = (hash ^ buf[i]) * mul;
+    }
+    hash ^= hash >> 29;
+    hash *= 0xBF58476D1CE4E5B9ULL;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+uint64_t HashUniqueIndex::ReverseBits(uint64_t value)
+{
+    value = ((value >> 1) & 0x5555555555555555ULL) | ((value & 0x5555555555555555ULL) << 1);
+    value = ((value >> 2) & 0x3333333333333333ULL) | ((value & 0x3333333333333333ULL) << 2);
+    value = ((value >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((value & 0x0F0F0F0F0F0F0F0FULL) << 4);
+    return __builtin_bswap64(value);
+}
+
+RC HashUniqueIndex::IndexInitImpl(void** args)
+{
+    m_nodePool = ObjAllocInterface::GetObjPool(sizeof(HashNode) + sizeof(Key) + ALIGN8(m_keyLength), false);
+    if (m_nodePool == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Initialize Index", "Failed to create hash node pool");
+        return RC_MEMORY_ALLOCATION_ERROR;
+    }
+
+    m_segments = new (std::nothrow) std::atomic<BucketSlot*>[MAX_SEGMENTS];
+    if (m_segments == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Initialize Index", "Failed to allocate hash bucket directory");
+        DestroyTable();
+        return RC_MEMORY_ALLOCATION_ERROR;
+    }
+    for (uint64_t i = 0; i < MAX_SEGMENTS; ++i) {
+        m_segments[i].store(nullptr, std::memory_order_relaxed);
+    }
+
+    // bucket 0 is the head of the whole list, every other bucket is initialized on first access
+    BucketSlot* slot = GetBucketSlot(0, true);
+    HashNode* head = (slot != nullptr) ? AllocNode(BucketSoKey(0), nullptr, nullptr) : nullptr;
+    if (head == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Initialize Index", "Failed to allocate hash index head");
+        DestroyTable();
+        return RC_MEMORY_ALLOCATION_ERROR;
+    }
+    slot->store(head, std::memory_order_release);
+
+    m_bucketCount.store(INITIAL_BUCKETS, std::memory_order_relaxed);
+    m_itemCount.store(0, std::memory_order_relaxed);
+    m_initialized = true;
+    return RC_OK;
+}
+
+void HashUniqueIndex::DestroyTable()
+{
+    // nodes are owned by the pool, no need to walk the list
+    if (m_segments != nullptr) {
+        for (uint64_t i = 0; i < MAX_SEGMENTS; ++i) {
+            BucketSlot* segment = m_segments[i].load(std::memory_order_relaxed);
+            if (segment != nullptr) {
+                delete[] segment;
+            }
+        }
+        delete[] m_segments;
+        m_segments = nullptr;
+    }
+    if (m_nodePool != nullptr) {
+        ObjAllocInterface::FreeObjPool(&m_nodePool);
+        m_nodePool = nullptr;
+    }
+}
+
+HashUniqueIndex::HashNode* HashUniqueIndex::AllocNode(uint64_t soKey, const Key* key, Sentinel* sentinel)
+{
+    HashNode* node = reinterpret_cast<HashNode*>(m_nodePool->Alloc());
+    if (node == nullptr) {
+        return nullptr;
+    }
+    node->m_next.store(0, std::memory_order_relaxed);
+    node->m_soKey = soKey;
+    node->m_sentinel = sentinel;
+    if (key != nullptr) {
+        Key* nodeKey = new (node->GetKey())
+            Key(key->GetKeyLength(), (IsPrimaryKey() ? KeyType::PRIMARY_KEY : KeyType::SECONDARY_KEY));
+        (void)nodeKey->CpKey(*key);
+    } else {
+        (void)new (node->GetKey()) Key();  // bucket nodes carry an empty key
+    }
+    return node;
+}
+
+void HashUniqueIndex::RetireNode(HashNode* node)
+{
+    GcManager* gcSession = MOTEngine::GetInstance()->GetCurrentGcSession();
+    if (gcSession != nullptr) {
+        gcSession->GcRecordObject(
+            GetIndexId(), (void*)m_nodePool, (void*)node, DeallocateFromPoolCallBack, m_nodePool->m_size);
+    } else {
+        // no session context (e.g. recovery), no concurrent reader can hold this node
+        m_nodePool->Release(node);
+    }
+}
+
+HashUniqueIndex::BucketSlot* HashUniqueIndex::GetBucketSlot(uint64_t bucket, bool create) const
+{
+    uint64_t segmentId = bucket >> SEGMENT_BITS;
+    BucketSlot* segment = m_segments[segmentId].load(std::memory_order_acquire);
+    if (segment == nullptr) {
+        if (!create) {
+            return nullptr;
+        }
+        BucketSlot* newSegment = new (std::nothrow) BucketSlot[SEGMENT_SIZE];
+        if (newSegment == nullptr) {
+            MOT_REPORT_ERROR(MOT_ERROR_OOM, "Hash Index", "Failed to allocate bucket segment %lu", segmentId);
+            return nullptr;
+        }
+        for (uint64_t i = 0; i < SEGMENT_SIZE; ++i) {
+            newSegment[i].store(nullptr, std::memory_order_relaxed);
+        }
+        if (m_segments[segmentId].compare_exchange_strong(segment, newSegment, std::memory_order_acq_rel)) {
+            segment = newSegment;
+        } else {
+            delete[] newSegment;  // somebody else won, segment now holds the published one
+        }
+    }
+    return &segment[bucket & (SEGMENT_SIZE - 1)];
+}
+
+HashUniqueIndex::HashNode* HashUniqueIndex::FindBucket(uint64_t bucket) const
+{
+    // walk down to the closest initialized parent bucket, which always precedes this bucket's items
+    while (true) {
+        BucketSlot* slot = GetBucketSlot(bucket, false);
+        HashNode* head = (slot != nullptr) ? slot->load(std::memory_order_acquire) : nullptr;
+        if (head != nullptr || bucket == 0) {
+            return head;
+        }
+        bucket &= ~(1ULL << (63 - __builtin_clzll(bucket)));
+    }
+}
+
+HashUniqueIndex::HashNode* HashUniqueIndex::GetBucket(uint64_t bucket)
+{
+    BucketSlot* slot = GetBucketSlot(bucket, true);
+    if (slot == nullptr) {
+        return nullptr;
+    }
+    HashNode* head = slot->load(std::memory_order_acquire);
+    if (head != nullptr) {
+        return head;
+    }
+
+    // initialize the parent first, the new bucket node is linked right after the parent's items
+    uint64_t parentBucket = bucket & ~(1ULL << (63 - __builtin_clzll(bucket)));
+    HashNode* parent = GetBucket(parentBucket);
+    if (parent == nullptr) {
+        return nullptr;
+    }
+
+    uint64_t soKey = BucketSoKey(bucket);
+    HashNode* node = AllocNode(soKey, nullptr, nullptr);
+    if (node == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Hash Index", "Failed to allocate bucket node");
+        return nullptr;
+    }
+
+    std::atomic<uint64_t>* prev = nullptr;
+    HashNode* curr = nullptr;
+    while (true) {
+        if (ListFind(parent, soKey, nullptr, prev, curr)) {
+            // concurrently initialized, our node was never published
+            m_nodePool->Release(node);
+            node = curr;
+            break;
+        }
+        node->m_next.store(reinterpret_cast<uint64_t>(curr), std::memory_order_relaxed);
+        uint64_t expected = reinterpret_cast<uint64_t>(curr);
+        if (prev->compare_exchange_strong(expected, reinterpret_cast<uint64_t>(node), std::memory_order_acq_rel)) {
+            break;
+        }
+    }
+
+    HashNode* expectedHead = nullptr;
+    (void)slot->compare_exchange_strong(expectedHead, node, std::memory_order_acq_rel);
+    return node;
+}
+
+bool HashUniqueIndex::ListFind(
+    HashNode* head, uint64_t soKey, const Key* key, std::atomic<uint64_t>*& prev, HashNode*& curr)
+{
+retry:
+    prev = &head->m_next;
+    curr = GetNodePtr(prev->load(std::memory_order_acquire));
+    while (curr != nullptr) {
+        uint64_t next = curr->m_next.load(std::memory_order_acquire);
+        if (IsMarked(next)) {
+            // help unlinking the logically deleted node, the winner hands it over to the GC
+            uint64_t expected = reinterpret_cast<uint64_t>(curr);
+            if (!prev->compare_exchange_strong(expected, next & ~DELETE_MARK, std::memory_order_acq_rel)) {
+                goto retry;
+            }
+            RetireNode(curr);
+            curr = GetNodePtr(next);
+            continue;
+        }
+
+        int cmp = CompareNode(curr, soKey, key);
+        if (cmp >= 0) {
+            return (cmp == 0);
+        }
+        prev = &curr->m_next;
+        curr = GetNodePtr(next);
+    }
+    return false;
+}
+
+Sentinel* HashUniqueIndex::IndexInsertImpl(const Key* key, Sentinel* sentinel, bool& inserted, uint32_t pid)
+{
+    uint64_t hash = HashKey(key->GetKeyBuf(), key->GetKeyLength());
+    uint64_t soKey = ItemSoKey(hash);
+    inserted = false;
+
+    HashNode* head = GetBucket(hash & (m_bucketCount.load(std::memory_order_acquire) - 1));
+    HashNode* node = (head != nullptr) ? AllocNode(soKey, key, sentinel) : nullptr;
+    if (node == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Hash Index Insert", "Failed to allocate hash node");
+        return nullptr;
+    }
+
+    std::atomic<uint64_t>* prev = nullptr;
+    HashNode* curr = nullptr;
+    while (true) {
+        if (ListFind(head, soKey, key, prev, curr)) {
+            // key mapping already exists in unique index
+            m_nodePool->Release(node);
+            return curr->m_sentinel;
+        }
+        node->m_next.store(reinterpret_cast<uint64_t>(curr), std::memory_order_relaxed);
+        uint64_t expected = reinterpret_cast<uint64_t>(curr);
+        if (prev->compare_exchange_strong(expected, reinterpret_cast<uint64_t>(node), std::memory_order_acq_rel)) {
+            break;
+        }
+    }
+    inserted = true;
+
+    // grow lazily: only the logical bucket count changes, new buckets are split on first access
+    uint64_t count = m_itemCount.fetch_add(1, std::memory_order_relaxed) + 1;
+    uint64_t buckets = m_bucketCount.load(std::memory_order_relaxed);
+    if (count > buckets * MAX_LOAD_FACTOR && buckets < MAX_BUCKETS) {
+        (void)m_bucketCount.compare_exchange_strong(buckets, buckets * 2, std::memory_order_acq_rel);
+    }
+    return nullptr;
+}
+
+Sentinel* HashUniqueIndex::IndexReadImpl(const Key* key, uint32_t pid) const
+{
+    uint64_t hash = HashKey(key->GetKeyBuf(), key->GetKeyLength());
+    uint64_t soKey = ItemSoKey(hash);
+    HashNode* curr = FindBucket(hash & (m_bucketCount.load(std::memory_order_acquire) - 1));
+
+    // read-only traversal, logically deleted nodes are skipped but left for writers to unlink
+    while (curr != nullptr) {
+        uint64_t next = curr->m_next.load(std::memory_order_acquire);
+        int cmp = CompareNode(curr, soKey, key);
+        if (cmp == 0 && !curr->IsBucket()) {
+            return IsMarked(next) ? nullptr : curr->m_sentinel;
+        }
+        if (cmp > 0) {
+            break;
+        }
+        curr = GetNodePtr(next);
+    }
+    return nullptr;
+}
+
+Sentinel* HashUniqueIndex::IndexRemoveImpl(const Key* key, uint32_t pid)
+{
+    uint64_t hash = HashKey(key->GetKeyBuf(), key->GetKeyLength());
+    uint64_t soKey = ItemSoKey(hash);
+    HashNode* head = GetBucket(hash & (m_bucketCount.load(std::memory_order_acquire) - 1));
+    if (head == nullptr) {
+        return nullptr;
+    }
+
+    std::atomic<uint64_t>* prev = nullptr;
+    HashNode* curr = nullptr;
+    while (true) {
+        if (!ListFind(head, soKey, key, prev, curr)) {
+            return nullptr;
+        }
+        uint64_t next = curr->m_next.load(std::memory_order_acquire);
+        if (IsMarked(next)) {
+            continue;
+        }
+        // logical deletion first, then try to unlink; on failure ListFind() finishes the job
+        if (!curr->m_next.compare_exchange_strong(next, next | DELETE_MARK, std::memory_order_acq_rel)) {
+            continue;
+        }
+        Sentinel* sentinel = curr->m_sentinel;
+        uint64_t expected = reinterpret_cast<uint64_t>(curr);
+        if (prev->compare_exchange_strong(expected, next, std::memory_order_acq_rel)) {
+            RetireNode(curr);
+        } else {
+            (void)ListFind(head, soKey, key, prev, curr);
+        }
+        m_itemCount.fetch_sub(1, std::memory_order_relaxed);
+        return sentinel;
+    }
+}
+
+uint64_t HashUniqueIndex::GetIndexSize()
+{
+    PoolStatsSt stats;
+
+    errno_t erc = memset_s(&stats, sizeof(PoolStatsSt), 0, sizeof(PoolStatsSt));
+    securec_check(erc, "\0", "\0");
+    stats.m_type = PoolStatsT::POOL_STATS_ALL;
+    m_keyPool->GetStats(stats);
+    uint64_t res = stats.m_poolCount * stats.m_poolGrossSize;
+    uint64_t netto = (stats.m_totalObjCount - stats.m_freeObjCount) * stats.m_objSize;
+
+    erc = memset_s(&stats, sizeof(PoolStatsSt), 0, sizeof(PoolStatsSt));
+    securec_check(erc, "\0", "\0");
+    stats.m_type = PoolStatsT::POOL_STATS_ALL;
+    m_sentinelPool->GetStats(stats);
+    res += stats.m_poolCount * stats.m_poolGrossSize;
+    netto += (stats.m_totalObjCount - stats.m_freeObjCount) * stats.m_objSize;
+
+    erc = memset_s(&stats, sizeof(PoolStatsSt), 0, sizeof(PoolStatsSt));
+    securec_check(erc, "\0", "\0");
+    stats.m_type = PoolStatsT::POOL_STATS_ALL;
+    m_nodePool->GetStats(stats);
+    res += stats.m_poolCount * stats.m_poolGrossSize;
+    netto += (stats.m_totalObjCount - stats.m_freeObjCount) * stats.m_objSize;
+
+    uint64_t directory = MAX_SEGMENTS * sizeof(std::atomic<BucketSlot*>);
+    res += directory;
+    netto += directory;
+    for (uint64_t i = 0; i < MAX_SEGMENTS; ++i) {
+        if (m_segments[i].load(std::memory_order_relaxed) != nullptr) {
+            res += SEGMENT_SIZE * sizeof(BucketSlot);
+            netto += SEGMENT_SIZE * sizeof(BucketSlot);
+        }
+    }
+
+    MOT_LOG_INFO("Index %s memory size: gross: %lu, netto: %lu", m_name.c_str(), res, netto);
+    return res;
+}
+
+// Iterator API
+IndexIterator* HashUniqueIndex::Begin(uint32_t pid, bool passive) const
+{
+    // full scan in split order, which is not the key order
+    HashNode* head = FindBucket(0);
+    HashNode* first = (head != nullptr) ? GetNodePtr(head->m_next.load(std::memory_order_acquire)) : nullptr;
+    IndexIterator* itr = new (std::nothrow) HashIterator(first, false);
+    if (itr == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Index Begin", "Failed to create hash iterator");
+    }
+    return itr;
+}
+
+IndexIterator* HashUniqueIndex::Search(
+    const Key* key, bool matchKey, bool forward, uint32_t pid, bool& found, bool passive) const
+{
+    HashNode* node = nullptr;
+    found = false;
+
+    if (!matchKey || !forward) {
+        MOT_REPORT_ERROR(MOT_ERROR_INVALID_ARG,
+            "Index Search",
+            "Range search is not supported by hash index %s (exact key lookup only)",
+            m_name.c_str());
+    } else {
+        uint64_t hash = HashKey(key->GetKeyBuf(), key->GetKeyLength());
+        uint64_t soKey = ItemSoKey(hash);
+        HashNode* curr = FindBucket(hash & (m_bucketCount.load(std::memory_order_acquire) - 1));
+        while (curr != nullptr) {
+            uint64_t next = curr->m_next.load(std::memory_order_acquire);
+            int cmp = CompareNode(curr, soKey, key);
+            if (cmp == 0 && !curr->IsBucket()) {
+                if (!IsMarked(next)) {
+                    node = curr;
+                    found = true;
+                }
+                break;
+            }
+            if (cmp > 0) {
+                break;
+            }
+            curr = GetNodePtr(next);
+        }
+    }
+
+    IndexIterator* itr = new (std::nothrow) HashIterator(node, true);
+    if (itr == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Index Search", "Failed to create hash iterator");
+    }
+    return itr;
+}
+}  // namespace MOT
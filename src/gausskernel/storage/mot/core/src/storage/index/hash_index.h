@@ -0,0 +1,389 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * hash_index.h
+ *    Unique index implementation using a lock-free resizable hash table.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/storage/index/hash_index.h
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef HASH_UNIQUE_INDEX_H
+#define HASH_UNIQUE_INDEX_H
+
+#include "index.h"
+#include "utilities.h"
+#include <atomic>
+
+namespace MOT {
+/**
+ * @class HashUniqueIndex.
+ * @brief Unique (primary or secondary) index implementation using a lock-free resizable hash table.
+ * @detail The table is a split-ordered list: all items are kept in a single lock-free linked list
+ * sorted by the bit-reversed hash code, and buckets are lazily initialized shortcuts (dummy nodes)
+ * into that list. Growing the table only doubles the logical bucket count, so no item is ever
+ * moved. Removed nodes are handed over to the GC and released once no transaction can see them.
+ * The index serves exact-key lookups only. A full scan (Begin()) visits items in hash order, and
+ * range searches are rejected.
+ */
+class HashUniqueIndex : public Index {
+private:
+    /**
+     * @struct HashNode
+     * @brief A node in the split-ordered list. The index key is placed right after the node.
+     */
+    struct HashNode {
+        /** @var Next node in the list. The lowest bit marks this node as logically deleted. */
+        std::atomic<uint64_t> m_next;
+
+        /** @var Split-order key (bit-reversed hash code, odd for items, even for bucket nodes). */
+        uint64_t m_soKey;
+
+        /** @var The indexed sentinel, or null for bucket nodes. */
+        Sentinel* m_sentinel;
+
+        inline Key* GetKey() const
+        {
+            return reinterpret_cast<Key*>(const_cast<HashNode*>(this) + 1);
+        }
+
+        inline bool IsBucket() const
+        {
+            return (m_soKey & 1) == 0;
+        }
+    };
+
+    /**
+     * @class HashIterator
+     * @brief An index iterator over a unique hash index. Point iterators stop after the matched
+     * item, full-scan iterators walk the whole list in hash order.
+     */
+    class HashIterator : public IndexIterator {
+    public:
+        /**
+         * @brief Constructor.
+         * @param node The first node to visit (may be null).
+         * @param pointQuery Specifies whether the iterator stops after the first item.
+         */
+        HashIterator(HashNode* node, bool pointQuery)
+            : IndexIterator(IteratorType::ITERATOR_TYPE_FORWARD, false, node != nullptr),
+              m_node(node),
+              m_pointQuery(pointQuery)
+        {
+            if (!m_pointQuery) {
+                SkipInvisible();
+            }
+        }
+
+        virtual ~HashIterator()
+        {
+            m_node = nullptr;
+        }
+
+        /**
+         * @brief Queries whether this iterator still points to a valid index item.
+         * @return True if the iterator is valid.
+         */
+        virtual bool IsValid() const
+        {
+            return m_valid && (m_node != nullptr);
+        }
+
+        /**
+         * @brief Retrieves the key of the currently iterated item.
+         * @return A pointer to the key of the currently iterated item.
+         */
+        virtual const void* GetKey() const
+        {
+            return (m_node != nullptr) ? m_node->GetKey() : nullptr;
+        }
+
+        /**
+         * @brief Retrieves the row of the currently iterated item.
+         * @return A pointer to the row of the currently iterated item.
+         */
+        virtual Row* GetRow() const
+        {
+            return m_node->m_sentinel->GetData();
+        }
+
+        /**
+         * @brief Retrieves the currently iterated primary sentinel.
+         * @return The primary sentinel.
+         */
+        virtual Sentinel* GetPrimarySentinel() const
+        {
+            return m_node->m_sentinel;
+        }
+
+        /**
+         * @brief Moves forwards the iterator to the next item.
+         */
+        virtual void Next()
+        {
+            if (m_pointQuery || m_node == nullptr) {
+                m_node = nullptr;
+                return;
+            }
+            m_node = GetNodePtr(m_node->m_next.load(std::memory_order_acquire));
+            SkipInvisible();
+        }
+
+        /**
+         * @brief Moves backwards the iterator to the previous item.
+         * @detail Not supported by hash iterators.
+         */
+        virtual void Prev()
+        {
+            MOT_ASSERT(false);
+        }
+
+        /**
+         * @brief Queries whether this index iterator equals to another index iterator.
+         * @param rhs The index iterator with which to compare this iterator.
+         * @return True if iterators point to the same index item, otherwise false.
+         */
+        virtual bool Equals(const IndexIterator* rhs) const
+        {
+            return m_node == static_cast<const HashIterator*>(rhs)->m_node;
+        }
+
+        /**
+         * Serializes the iterator into a buffer.
+         * @detail Not implemented
+         */
+        virtual void Serialize(serialize_func_t serializeFunc, unsigned char* buff) const
+        {}
+
+        /**
+         * Deserializes the iterator from a buffer.
+         * @detail Not implemented
+         */
+        virtual void Deserialize(deserialize_func_t deserializeFunc, unsigned char* buff)
+        {}
+
+    private:
+        /** @brief Skips bucket nodes and logically deleted items. */
+        inline void SkipInvisible()
+        {
+            while (m_node != nullptr) {
+                uint64_t next = m_node->m_next.load(std::memory_order_acquire);
+                if (!m_node->IsBucket() && !IsMarked(next)) {
+                    break;
+                }
+                m_node = GetNodePtr(next);
+            }
+        }
+
+        /** @var The currently iterated node. */
+        HashNode* m_node;
+
+        /** @var Specifies whether the iterator stops after the first item. */
+        bool m_pointQuery;
+    };
+
+public:
+    /**
+     * @brief Default constructor.
+     */
+    HashUniqueIndex()
+        : Index(MOT::IndexOrder::INDEX_ORDER_PRIMARY, IndexingMethod::INDEXING_METHOD_HASH),
+          m_nodePool(nullptr),
+          m_segments(nullptr),
+          m_bucketCount(0),
+          m_itemCount(0),
+          m_initialized(false)
+    {}
+
+    /**
+     * @brief Destructor.
+     */
+    virtual ~HashUniqueIndex()
+    {
+        m_initialized = false;
+        DestroyTable();
+    }
+
+    /**
+     * @brief Calculate the Index memory consumption.
+     * @return The amount of memory the Index consumes.
+     */
+    virtual uint64_t GetIndexSize() override;
+
+    /**
+     * @brief Retrieves the number of rows stored in the index.
+     * @return The number of rows stored in the index.
+     */
+    virtual uint64_t GetSize() const
+    {
+        return m_itemCount.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Destroy the hash table and init index again.
+     */
+    virtual RC ReInitIndex()
+    {
+        m_initialized = false;
+        DestroyTable();
+
+        return IndexInitImpl(NULL);
+    }
+
+    // Iterator API
+    virtual IndexIterator* Begin(uint32_t pid, bool passive = false) const;
+
+    virtual IndexIterator* Search(
+        const Key* key, bool matchKey, bool forward, uint32_t pid, bool& found, bool passive = false) const;
+
+    /**
+     * @brief Static callback function for deallocate nodes from the node pool.
+     * @param pool Pool to deallocate from.
+     * @param ptr Pointer to allocated memory.
+     * @param dropIndex Indicates if this callback is part of drop index process.
+     * @return Size of memory that was deallocated.
+     */
+    static uint32_t DeallocateFromPoolCallBack(void* pool, void* ptr, bool dropIndex)
+    {
+        // If dropIndex == true, all index's pools are going to be cleaned, so we skip the release here
+        ObjAllocInterface* localPoolPtr = (ObjAllocInterface*)pool;
+
+        if (dropIndex == false) {
+            localPoolPtr->Release(ptr);
+        }
+        return localPoolPtr->m_size;
+    }
+
+    /**
+     * @brief Hashes a binary index key.
+     * @param buf The key buffer.
+     * @param len The key length.
+     * @return The 64-bit hash value.
+     */
+    static uint64_t HashKey(const uint8_t* buf, uint16_t len);
+
+protected:
+    /**
+     * @brief Implements index initialization.
+     * @param args Null-terminated list of any additional arguments.
+     * @return Return code denoting success or error.
+     */
+    virtual RC IndexInitImpl(void** args);
+
+    virtual Sentinel* IndexInsertImpl(const Key* key, Sentinel* sentinel, bool& inserted, uint32_t pid);
+
+    virtual Sentinel* IndexReadImpl(const Key* key, uint32_t pid) const;
+
+    virtual Sentinel* IndexRemoveImpl(const Key* key, uint32_t pid);
+
+private:
+    /** @var Number of bucket slots in each lazily allocated bucket segment. */
+    static constexpr uint32_t SEGMENT_BITS = 12;
+    static constexpr uint64_t SEGMENT_SIZE = 1ULL << SEGMENT_BITS;
+
+    /** @var Maximum number of bucket segments (caps the table at 16M buckets). */
+    static constexpr uint64_t MAX_SEGMENTS = 1ULL << 12;
+    static constexpr uint64_t MAX_BUCKETS = SEGMENT_SIZE * MAX_SEGMENTS;
+
+    /** @var Initial number of buckets, must be a power of two. */
+    static constexpr uint64_t INITIAL_BUCKETS = 1024;
+
+    /** @var Average chain length that triggers doubling of the bucket count. */
+    static constexpr uint64_t MAX_LOAD_FACTOR = 2;
+
+    /** @var Marks a node as logically deleted in its next pointer. */
+    static constexpr uint64_t DELETE_MARK = 1ULL;
+
+    typedef std::atomic<HashNode*> BucketSlot;
+
+    static inline bool IsMarked(uint64_t next)
+    {
+        return (next & DELETE_MARK) != 0;
+    }
+
+    static inline HashNode* GetNodePtr(uint64_t next)
+    {
+        return reinterpret_cast<HashNode*>(next & ~DELETE_MARK);
+    }
+
+    static uint64_t ReverseBits(uint64_t value);
+
+    static inline uint64_t ItemSoKey(uint64_t hash)
+    {
+        return ReverseBits(hash | (1ULL << 63));
+    }
+
+    static inline uint64_t BucketSoKey(uint64_t bucket)
+    {
+        return ReverseBits(bucket);
+    }
+
+    static inline int CompareNode(const HashNode* node, uint64_t soKey, const Key* key)
+    {
+        if (node->m_soKey != soKey) {
+            return (node->m_soKey < soKey) ? -1 : 1;
+        }
+        if (key == nullptr) {
+            return 0;
+        }
+        const Key* nodeKey = node->GetKey();
+        if (nodeKey->GetKeyLength() != key->GetKeyLength()) {
+            return (nodeKey->GetKeyLength() < key->GetKeyLength()) ? -1 : 1;
+        }
+        return memcmp(nodeKey->GetKeyBuf(), key->GetKeyBuf(), key->GetKeyLength());
+    }
+
+    HashNode* AllocNode(uint64_t soKey, const Key* key, Sentinel* sentinel);
+    void RetireNode(HashNode* node);
+    void DestroyTable();
+
+    BucketSlot* GetBucketSlot(uint64_t bucket, bool create) const;
+    HashNode* GetBucket(uint64_t bucket);
+    HashNode* FindBucket(uint64_t bucket) const;
+
+    /**
+     * @brief Locates the position of a node in the list starting at the given bucket node, unlinking
+     * logically deleted nodes on the way.
+     * @param head The bucket node to start from.
+     * @param soKey The split-order key to look for.
+     * @param key The index key, or null when looking for a bucket node.
+     * @param[out] prev The link pointing to the resulting node.
+     * @param[out] curr The first node not smaller than the searched one (may be null).
+     * @return True if a node with an equal key was found.
+     */
+    bool ListFind(HashNode* head, uint64_t soKey, const Key* key, std::atomic<uint64_t>*& prev, HashNode*& curr);
+
+    /** @var Memory pool for list nodes (items and buckets). */
+    ObjAllocInterface* m_nodePool;
+
+    /** @var Bucket directory of lazily allocated segments. */
+    std::atomic<BucketSlot*>* m_segments;
+
+    /** @var Current logical number of buckets (power of two). */
+    std::atomic<uint64_t> m_bucketCount;
+
+    /** @var Number of items in the index. */
+    std::atomic<uint64_t> m_itemCount;
+
+    /** @var Determine if object is initialized or not. */
+    bool m_initialized;
+
+    DECLARE_CLASS_LOGGER()
+};
+}  // namespace MOT
+
+#endif /* HASH_UNIQUE_INDEX_H */
@@ -33,6 +33,39 @@ IMPLEMENT_CLASS_LOGGER(Index, Storage);
 
 std::atomic<uint32_t> MOT::Index::m_indexCounter(0);
 
+uint32_t IndexIterator::NextBatch(Sentinel** sentinels, uint32_t maxCount, const Key* endKey, uint16_t cmpLen)
+{
+    bool forward = (m_type == IteratorType::ITERATOR_TYPE_FORWARD);
+    uint32_t count = 0;
+    while (count < maxCount && IsValid()) {
+        const Key* key = reinterpret_cast<const Key*>(GetKey());
+        if (endKey != nullptr && key != nullptr) {
+            int cmpRes = memcmp(key->GetKeyBuf(), endKey->GetKeyBuf(), cmpLen);
+            if (forward ? (cmpRes > 0) : (cmpRes < 0)) {
+                Invalidate();
+                break;
+            }
+        }
+        sentinels[count] = GetPrimarySentinel();
+        Prefetch(sentinels[count]);
+        ++count;
+        Next();
+    }
+    PrefetchRows(sentinels, count);
+    return count;
+}
+
+void IndexIterator::PrefetchRows(Sentinel** sentinels, uint32_t count)
+{
+    for (uint32_t i = 0; i < count; i++) {
+        Row* row = sentinels[i]->GetData();
+        if (row != nullptr) {
+            Prefetch(row);
+            Prefetch(row->GetData());
+        }
+    }
+}
+
 uint64_t Index::GetSize() const
 {
     // by default not implemented
@@ -24,6 +24,7 @@
 
 #include "index_factory.h"
 #include "masstree_index.h"
+#include "hash_index.h"
 #include "utilities.h"
 
 namespace MOT {
@@ -72,6 +73,15 @@ Index* IndexFactory::CreatePrimaryIndex(IndexingMethod indexingMethod, IndexTree
             result = CreatePrimaryTreeIndex(flavor);
             break;
 
+        case IndexingMethod::INDEXING_METHOD_HASH:
+            MOT_LOG_DEBUG("Creating hash index.");
+            result = new (std::nothrow) HashUniqueIndex();
+            if (result == nullptr) {
+                MOT_REPORT_ERROR(
+                    MOT_ERROR_OOM, "Create Primary Index", "Failed to allocate primary hash index: out of memory");
+            }
+            break;
+
         default:
             MOT_REPORT_ERROR(MOT_ERROR_INVALID_ARG,
                 "Create Primary Index",
@@ -142,6 +142,28 @@ public:
         return nullptr;
     }
 
+    /**
+     * @brief Retrieves the primary sentinels of the next items in a single call, and moves the iterator past them.
+     * @detail Implementations prefetch upcoming index nodes and the rows of the retrieved sentinels, so that range
+     * scans are not bound by a dependent cache miss per item.
+     * @param sentinels Receives the sentinels.
+     * @param maxCount The maximum number of sentinels to retrieve.
+     * @param endKey The inclusive scan bound, or null if the scan is not bounded. The iterator stops before the
+     * first item beyond the bound and becomes invalid.
+     * @param cmpLen The number of key bytes compared with the bound.
+     * @return The number of sentinels retrieved. Zero means the scan is over.
+     */
+    virtual uint32_t NextBatch(Sentinel** sentinels, uint32_t maxCount, const Key* endKey, uint16_t cmpLen);
+
+    /**
+     * @brief Sets the inclusive bound of a scan, for iterators that read items ahead.
+     * @detail Must be called before the first item is accessed. Ignored by other iterators.
+     * @param endKey The inclusive scan bound, or null if the scan is not bounded.
+     * @param cmpLen The number of key bytes compared with the bound.
+     */
+    virtual void SetScanBound(const Key* endKey, uint16_t cmpLen)
+    {}
+
 protected:
     /**
      * @brief Constructs a builtin end or pre-begin iterator.
@@ -160,6 +182,13 @@ protected:
     IndexIterator(IndexIterator&& other) : m_type(other.m_type), m_bid(other.m_bid), m_valid(other.m_valid)
     {}
 
+    /**
+     * @brief Prefetches the rows of sentinels retrieved by NextBatch().
+     * @param sentinels The sentinels.
+     * @param count The number of sentinels.
+     */
+    static void PrefetchRows(Sentinel** sentinels, uint32_t count);
+
     /** @var The iterator type. */
     IteratorType m_type;
 
@@ -169,6 +198,138 @@ protected:
     /** @var Specifies whether this iterator is valid. */
     bool m_valid;
 };
+
+/**
+ * @class BatchedIndexIterator
+ * @brief An index iterator that reads its items ahead in batches through IndexIterator::NextBatch().
+ * @detail Serves scans that consume one item at a time. Keys are not retained, so GetKey() returns null: the scan
+ * bound given in SetScanBound() is applied while reading ahead instead.
+ */
+class BatchedIndexIterator : public IndexIterator {
+public:
+    /** @var Number of items read ahead in each batch. */
+    static constexpr uint32_t BATCH_SIZE = 16;
+
+    /**
+     * @brief Constructor.
+     * @param itr The underlying index iterator (owned by this iterator).
+     */
+    explicit BatchedIndexIterator(IndexIterator* itr)
+        : IndexIterator(itr->GetType(), false),
+          m_itr(itr),
+          m_endKey(nullptr),
+          m_cmpLen(0),
+          m_count(0),
+          m_pos(0),
+          m_fetched(false)
+    {}
+
+    /** @brief Destructor. */
+    ~BatchedIndexIterator() override
+    {
+        delete m_itr;
+        m_itr = nullptr;
+    }
+
+    void SetScanBound(const Key* endKey, uint16_t cmpLen) override
+    {
+        if (!m_fetched) {
+            m_endKey = endKey;
+            m_cmpLen = cmpLen;
+        }
+    }
+
+    bool IsValid() const override
+    {
+        EnsureFetched();
+        return m_pos < m_count;
+    }
+
+    void Invalidate() override
+    {
+        m_itr->Invalidate();
+        m_fetched = true;
+        m_count = 0;
+        m_pos = 0;
+    }
+
+    void Next() override
+    {
+        EnsureFetched();
+        if (m_pos < m_count && ++m_pos == m_count && m_count == BATCH_SIZE) {
+            Fetch();
+        }
+    }
+
+    void Prev() override
+    {
+        MOT_ASSERT(false);
+    }
+
+    bool Equals(const IndexIterator* rhs) const override
+    {
+        return GetPrimarySentinel() == rhs->GetPrimarySentinel();
+    }
+
+    void Serialize(serialize_func_t serializeFunc, unsigned char* buf) const override
+    {}
+
+    void Deserialize(deserialize_func_t deserializeFunc, unsigned char* buf) override
+    {}
+
+    const void* GetKey() const override
+    {
+        return nullptr;
+    }
+
+    Row* GetRow() const override
+    {
+        Sentinel* sentinel = GetPrimarySentinel();
+        return (sentinel != nullptr) ? sentinel->GetData() : nullptr;
+    }
+
+    Sentinel* GetPrimarySentinel() const override
+    {
+        EnsureFetched();
+        return (m_pos < m_count) ? m_sentinels[m_pos] : nullptr;
+    }
+
+private:
+    inline void EnsureFetched() const
+    {
+        if (!m_fetched) {
+            const_cast<BatchedIndexIterator*>(this)->Fetch();
+        }
+    }
+
+    void Fetch()
+    {
+        m_count = m_itr->IsValid() ? m_itr->NextBatch(m_sentinels, BATCH_SIZE, m_endKey, m_cmpLen) : 0;
+        m_pos = 0;
+        m_fetched = true;
+    }
+
+    /** @var The underlying iterator. */
+    IndexIterator* m_itr;
+
+    /** @var The inclusive scan bound. */
+    const Key* m_endKey;
+
+    /** @var The number of key bytes compared with the bound. */
+    uint16_t m_cmpLen;
+
+    /** @var The number of sentinels in the current batch. */
+    uint32_t m_count;
+
+    /** @var The position of the current item in the batch. */
+    uint32_t m_pos;
+
+    /** @var Specifies whether the first batch was read. */
+    bool m_fetched;
+
+    /** @var The current batch. */
+    Sentinel* m_sentinels[BATCH_SIZE];
+};
 }  // namespace MOT
 
 #endif /* INDEX_ITERATOR_H */
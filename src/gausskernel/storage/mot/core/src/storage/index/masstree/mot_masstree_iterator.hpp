@@ -114,6 +114,31 @@ private:
     /** @var Search key (in MOT's key format) instance. */
     MOT::MaxKey m_motKey;
 
+    /** @var Number of leaf entries ahead of the current one whose values are prefetched. */
+    static constexpr int PREFETCH_DISTANCE = 4;
+
+    /**
+     * @brief Prefetches the value of a leaf entry a few positions ahead of the current one, or the next leaf once
+     * the current leaf is about to be exhausted. The leaf is read without version validation, which is harmless
+     * since the result is only used as a prefetch hint.
+     */
+    inline void PrefetchAhead()
+    {
+        int ki = FORWARD ? (m_stack.ki_ + PREFETCH_DISTANCE) : (m_stack.ki_ - PREFETCH_DISTANCE);
+        if (ki >= 0 && ki < m_stack.perm_.size()) {
+            int p = m_stack.perm_[ki];
+            if (!leaf<P>::keylenx_is_layer(m_stack.n_->keylenx_[p])) {
+                __builtin_prefetch(m_stack.n_->lv_[p].value());
+            }
+        } else if (ki == m_stack.perm_.size() || ki == -1) {
+            const leaf<P>* next = FORWARD ? m_stack.n_->safe_next() : m_stack.n_->prev_;
+            if (next != nullptr) {
+                __builtin_prefetch(next);
+                __builtin_prefetch(reinterpret_cast<const char*>(next) + CACHE_LINE_SIZE);
+            }
+        }
+    }
+
     /**
      * @brief Initialize iterator's members.
      * @param table A Masstree table pointer which the iterator should scan.
@@ -261,6 +286,39 @@ public:
         }
         return this;
     }
+    /**
+     * @brief Retrieves the values of the next entries in a single call, and moves the iterator past them.
+     * @detail Leaf entries ahead of the iterator, and the next leaf, are prefetched while iterating.
+     * @param values Receives the values.
+     * @param maxCount The maximum number of values to retrieve.
+     * @param endKey Inclusive scan bound (in MOT's key format), or null if the scan is not bounded. The iterator
+     * stops before the first key beyond the bound and becomes exhausted.
+     * @param cmpLen The number of key bytes compared with the bound.
+     * @return The number of values retrieved. Zero means the scan is over.
+     */
+    uint32_t NextBatch(void** values, uint32_t maxCount, const uint8_t* endKey, uint16_t cmpLen)
+    {
+        uint32_t count = 0;
+        if (!m_foundInitial && !m_done) {
+            Begin();
+        }
+        while (count < maxCount && !m_done) {
+            if (endKey != nullptr) {
+                int cmpRes = memcmp(m_searchKey->GetKeyBuf(), endKey, cmpLen);
+                if (FORWARD ? (cmpRes > 0) : (cmpRes < 0)) {
+                    m_done = true;
+                    break;
+                }
+            }
+            values[count++] = reinterpret_cast<void*>(m_entry.value());
+            PrefetchAhead();
+            m_stack.ki_ = m_helper.next(m_stack.ki_);
+            m_state = m_stack.find_next(m_helper, m_key, m_entry);
+            Next();
+        }
+        return count;
+    }
+
     /** @brief Dereference operator
      *  @return The current value the iterator is currently points at.
      */
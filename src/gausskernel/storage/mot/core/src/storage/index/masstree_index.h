@@ -157,6 +157,25 @@ private:
             ++(*m_itr);
         }
 
+        /**
+         * @brief Retrieves the primary sentinels of the next items in a single call, and moves the iterator past
+         * them. Upcoming leaf entries and the rows of the retrieved sentinels are prefetched.
+         * @param sentinels Receives the sentinels.
+         * @param maxCount The maximum number of sentinels to retrieve.
+         * @param endKey The inclusive scan bound, or null if the scan is not bounded.
+         * @param cmpLen The number of key bytes compared with the bound.
+         * @return The number of sentinels retrieved. Zero means the scan is over.
+         */
+        virtual uint32_t NextBatch(Sentinel** sentinels, uint32_t maxCount, const Key* endKey, uint16_t cmpLen)
+        {
+            uint32_t count = m_itr->NextBatch(reinterpret_cast<void**>(sentinels),
+                maxCount,
+                (endKey != nullptr) ? endKey->GetKeyBuf() : nullptr,
+                cmpLen);
+            PrefetchRows(sentinels, count);
+            return count;
+        }
+
         /**
          * @brief Moves backwards the iterator to the previous item.
          * @detail Does not supported yet.
@@ -39,9 +39,11 @@ Row::Row(const Row& src)
       m_table(src.m_table),
       m_surrogateKey(src.m_surrogateKey),
       m_pSentinel(src.m_pSentinel),
+      m_prevVersion(nullptr),
       m_rowId(src.m_rowId),
       m_keyType(src.m_keyType),
-      m_twoPhaseRecoverMode(src.m_twoPhaseRecoverMode)
+      m_twoPhaseRecoverMode(src.m_twoPhaseRecoverMode),
+      m_accessClock(src.m_accessClock)
 {
     errno_t erc = memcpy_s(this->m_data, this->GetTupleSize(), src.m_data, src.GetTupleSize());
     securec_check(erc, "\0", "\0");
@@ -67,6 +69,29 @@ RC Row::GetRow(AccessType type, TxnAccess* txn, Row* row, TransactionId& lastTid
     return this->m_rowHeader.GetLocalCopy(txn, type, row, this, lastTid);
 }
 
+RC Row::GetSnapshotRow(uint64_t snapshotCsn, Row* row, bool& isLatest) const
+{
+    const Row* version = this;
+    isLatest = true;
+    row->m_table = GetTable();
+    while (version != nullptr) {
+        Row* prevVersion = nullptr;
+        uint64_t csnWord = version->m_rowHeader.GetVersionCopy(snapshotCsn, row, version, prevVersion);
+        if ((csnWord & CSN_BITS) <= snapshotCsn) {
+            // a deleted row, or a new row that is not committed yet
+            if (csnWord & ABSENT_BIT) {
+                return RC_LOCAL_ROW_NOT_VISIBLE;
+            }
+            row->CopySurrogateKey(version);
+            return RC_OK;
+        }
+        version = prevVersion;
+        isLatest = false;
+    }
+    // the row was inserted after the snapshot was taken
+    return RC_LOCAL_ROW_NOT_VISIBLE;
+}
+
 Row* Row::CreateCopy()
 {
     Row* row = m_table->CreateNewRow();
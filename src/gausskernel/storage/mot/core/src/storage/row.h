@@ -42,6 +42,7 @@ namespace MOT {
 class OccTransactionManager;
 class CheckpointWorkerPool;
 class RecoveryManager;
+class ColdRowStore;
 
 /**
  * @class Row
@@ -255,6 +256,34 @@ public:
      */
     RC GetRow(AccessType type, TxnAccess* txn, Row* row, TransactionId& lastTid) const;
 
+    /**
+     * @brief Reads the version of the row that was committed as of a snapshot, without taking part in
+     * concurrency control validation.
+     * @param snapshotCsn The snapshot commit sequence number.
+     * @param[out] row Receives a copy of the visible version.
+     * @param[out] isLatest Receives whether the visible version is the latest one.
+     * @return RC_OK if a version is visible, otherwise RC_LOCAL_ROW_NOT_VISIBLE.
+     */
+    RC GetSnapshotRow(uint64_t snapshotCsn, Row* row, bool& isLatest) const;
+
+    /**
+     * @brief Retrieves the previous committed version of the row (snapshot reads).
+     * @return The previous version, or null if there is none.
+     */
+    inline Row* GetPrevVersion() const
+    {
+        return m_prevVersion;
+    }
+
+    /**
+     * @brief Sets the previous committed version of the row (snapshot reads).
+     * @param version The previous version.
+     */
+    inline void SetPrevVersion(Row* version)
+    {
+        m_prevVersion = version;
+    }
+
     /**
      * @brief Class specific in-place new operator.
      * @param size Object size in bytes.
@@ -450,6 +479,26 @@ public:
         m_rowId = id;
     }
 
+    /**
+     * @brief Records an access to the row.
+     * @param clock The current access clock of the cold row store.
+     */
+    inline void Touch(uint32_t clock)
+    {
+        if (m_accessClock != clock) {
+            m_accessClock = clock;
+        }
+    }
+
+    /**
+     * @brief Retrieves the access clock of the last recorded access to the row.
+     * @return The access clock.
+     */
+    inline uint32_t GetAccessClock() const
+    {
+        return m_accessClock;
+    }
+
     /**
      * @brief Copy surrogate key from a source row.
      * @param r A source row.
@@ -560,6 +609,9 @@ protected:
     /** @var The reference to the sentinel that points to this row. */
     Sentinel* m_pSentinel = nullptr;
 
+    /** @var The previous committed version of the row, kept for snapshot reads. */
+    Row* m_prevVersion = nullptr;
+
     /** @var the row id. */
     uint64_t m_rowId;
 
@@ -569,6 +621,9 @@ protected:
     /** @var A flag to identify if row is in recover mode state. */
     bool m_twoPhaseRecoverMode = false;
 
+    /** @var Access clock of the last recorded access (used for detecting cold rows). */
+    uint32_t m_accessClock = 0;
+
     /** @var The raw buffer holding the row data. Starts at the end of the class
      * Must be last member */
     uint8_t m_data[0];
@@ -593,6 +648,7 @@ protected:
     friend Index;
     friend RecoveryManager;
     friend Table;
+    friend ColdRowStore;
 
     DECLARE_CLASS_LOGGER()
 };
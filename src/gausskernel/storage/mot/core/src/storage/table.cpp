@@ -25,6 +25,9 @@
 #include <malloc.h>
 #include <string.h>
 #include <algorithm>
+#include <system_error>
+#include <thread>
+#include <vector>
 #include "table.h"
 #include "mot_engine.h"
 #include "utilities.h"
@@ -33,11 +36,131 @@
 #include "txn_insert_action.h"
 #include "redo_log_writer.h"
 #include "recovery_manager.h"
+#include "spin_lock.h"
+#include "cold_row_store.h"
+#include "hash_index.h"
 
 namespace MOT {
 IMPLEMENT_CLASS_LOGGER(Table, Storage);
 
 std::atomic<uint32_t> Table::tableCounter(0);
+constexpr uint64_t Table::INDEX_BUILD_MIN_ROWS_PER_WORKER;
+
+/** @var Number of keys built, sorted and inserted together by a parallel index build worker. */
+static constexpr uint32_t INDEX_BUILD_CHUNK_ROWS = 1024;
+
+/** @struct State shared by the threads of a parallel index build. */
+struct IndexBuildState {
+    /** @var The indexed table. */
+    Table* m_table;
+
+    /** @var The index being built. */
+    Index* m_index;
+
+    /** @var Set by the first failing thread, so that the others stop early. */
+    std::atomic<bool> m_failed;
+
+    /** @var The error of the first failing thread. */
+    RC m_rc;
+
+    /** @var The row that failed to be inserted (used for the error message). */
+    Row* m_errRow;
+
+    /** @var Lock protecting the error details. */
+    spin_lock m_lock;
+};
+
+/** @struct A share of the rows indexed by a single thread of a parallel index build. */
+struct IndexBuildRange {
+    /** @var The primary sentinels of the rows. */
+    Sentinel** m_sentinels;
+
+    /** @var Number of rows. */
+    uint64_t m_count;
+
+    /** @var Specifies whether the range was processed (a worker might fail to start). */
+    bool m_done;
+};
+
+static void IndexBuildSetError(IndexBuildState* state, RC rc, Row* row)
+{
+    state->m_lock.lock();
+    if (!state->m_failed) {
+        state->m_rc = rc;
+        state->m_errRow = row;
+        state->m_failed = true;
+    }
+    state->m_lock.unlock();
+}
+
+static void IndexBuildProcessRange(IndexBuildState* state, IndexBuildRange* range, uint32_t pid)
+{
+    // keys are inserted in sorted chunks, so that consecutive inserts land on the same tree nodes
+    MaxKey* keys = new (std::nothrow) MaxKey[INDEX_BUILD_CHUNK_ROWS];
+    Row** rows = new (std::nothrow) Row*[INDEX_BUILD_CHUNK_ROWS];
+    uint32_t* order = new (std::nothrow) uint32_t[INDEX_BUILD_CHUNK_ROWS];
+    if (keys == nullptr || rows == nullptr || order == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Create Secondary Index", "Failed to allocate index build buffers");
+        IndexBuildSetError(state, RC_MEMORY_ALLOCATION_ERROR, nullptr);
+    } else {
+        Index* index = state->m_index;
+        uint16_t keyLength = index->GetKeyLength();
+        uint64_t pos = 0;
+        while (pos < range->m_count && !state->m_failed) {
+            uint32_t count = 0;
+            while (count < INDEX_BUILD_CHUNK_ROWS && pos < range->m_count) {
+                Row* row = range->m_sentinels[pos++]->GetData();
+                if (row == nullptr) {
+                    continue;
+                }
+                keys[count].InitKey(keyLength);
+                index->BuildKey(state->m_table, row, &keys[count]);
+                rows[count] = row;
+                order[count] = count;
+                ++count;
+            }
+            std::sort(order, order + count, [keys, keyLength](uint32_t lhs, uint32_t rhs) {
+                return memcmp(keys[lhs].GetKeyBuf(), keys[rhs].GetKeyBuf(), keyLength) < 0;
+            });
+            for (uint32_t i = 0; i < count; ++i) {
+                if (index->IndexInsert(&keys[order[i]], rows[order[i]], pid) == nullptr) {
+                    IndexBuildSetError(
+                        state, MOT_IS_OOM() ? RC_MEMORY_ALLOCATION_ERROR : RC_UNIQUE_VIOLATION, rows[order[i]]);
+                    break;
+                }
+            }
+        }
+        range->m_done = true;
+    }
+
+    if (keys != nullptr) {
+        delete[] keys;
+    }
+    if (rows != nullptr) {
+        delete[] rows;
+    }
+    if (order != nullptr) {
+        delete[] order;
+    }
+}
+
+static void IndexBuildWorkerFunc(IndexBuildState* state, IndexBuildRange* range)
+{
+    // since this is a non-kernel thread we must set-up our own u_sess struct for the current thread
+    MOT_DECLARE_NON_KERNEL_THREAD();
+
+    SessionContext* sessionContext = GetSessionManager()->CreateSessionContext();
+    if (sessionContext == nullptr) {
+        // the range is left for the session thread
+        MOT_LOG_WARN("Failed to create session context for index build worker");
+        return;
+    }
+
+    IndexBuildProcessRange(state, range, MOTCurrThreadId);
+
+    GetSessionManager()->DestroySessionContext(sessionContext);
+    MOTEngine::GetInstance()->OnCurrentThreadEnding();
+}
 
 Table::~Table()
 {
@@ -69,6 +192,16 @@ Table::~Table()
         ObjAllocInterface::FreeObjPool(&m_rowPool);
     }
 
+    if (m_numaRowPools != nullptr) {
+        DestroyNumaRowPools(m_numaRowPools, m_numaNodeCount);
+        m_numaRowPools = nullptr;
+    }
+
+    ColdRowStore* coldStore = GetColdRowStore();
+    if (coldStore != nullptr) {
+        coldStore->ReleaseTable(m_tableId);
+    }
+
     int destroyRc = pthread_rwlock_destroy(&m_rwLock);
     if (destroyRc != 0) {
         MOT_LOG_ERROR("~Table: rwlock destroy failed (%d)", destroyRc);
@@ -135,6 +268,102 @@ void Table::ClearThreadMemoryCache()
     if (m_rowPool != nullptr) {
         m_rowPool->ClearThreadCache();
     }
+
+    if (m_numaRowPools != nullptr) {
+        for (uint32_t i = 0; i < m_numaNodeCount; i++) {
+            m_numaRowPools[i]->ClearThreadCache();
+        }
+    }
+}
+
+ObjAllocInterface** Table::CreateNumaRowPools() const
+{
+    uint32_t nodeCount = g_memGlobalCfg.m_nodeCount;
+    ObjAllocInterface** pools = new (std::nothrow) ObjAllocInterface*[nodeCount];
+    if (pools == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM,
+            "Partition Table",
+            "Failed to allocate NUMA row pool array for table %s",
+            m_longTableName.c_str());
+        return nullptr;
+    }
+
+    for (uint32_t i = 0; i < nodeCount; i++) {
+        pools[i] = ObjAllocInterface::GetObjPool(sizeof(Row) + m_tupleSize, false, 8, (int)i);
+        if (pools[i] == nullptr) {
+            MOT_REPORT_ERROR(MOT_ERROR_OOM,
+                "Partition Table",
+                "Failed to allocate row pool on NUMA node %u for table %s",
+                i,
+                m_longTableName.c_str());
+            DestroyNumaRowPools(pools, i);
+            return nullptr;
+        }
+    }
+    return pools;
+}
+
+void Table::DestroyNumaRowPools(ObjAllocInterface** pools, uint32_t nodeCount)
+{
+    for (uint32_t i = 0; i < nodeCount; i++) {
+        ObjAllocInterface::FreeObjPool(&pools[i]);
+    }
+    delete[] pools;
+}
+
+bool Table::SetNumaPartitioned()
+{
+    if (m_numaRowPools != nullptr) {
+        return true;
+    }
+
+    if (g_memGlobalCfg.m_chunkAllocPolicy != MEM_ALLOC_POLICY_LOCAL) {
+        MOT_LOG_WARN("Table %s is NUMA-partitioned, but global memory is not allocated with the local chunk allocation "
+                     "policy: rows are not guaranteed to reside on their home node",
+            m_longTableName.c_str());
+    }
+
+    ObjAllocInterface** pools = CreateNumaRowPools();
+    if (pools == nullptr) {
+        return false;
+    }
+
+    // the table may be partitioned concurrently by several sessions
+    m_numaNodeCount = g_memGlobalCfg.m_nodeCount;
+    if (!__sync_bool_compare_and_swap(&m_numaRowPools, nullptr, pools)) {
+        DestroyNumaRowPools(pools, g_memGlobalCfg.m_nodeCount);
+    } else {
+        MOT_LOG_INFO(
+            "Table %s rows are partitioned between %u NUMA nodes", m_longTableName.c_str(), m_numaNodeCount);
+    }
+    return true;
+}
+
+int Table::GetKeyNumaNode(const Key* key) const
+{
+    if (m_numaRowPools == nullptr) {
+        return -1;
+    }
+    // the high bits are used, since the low bits also drive the hash index bucket selection
+    uint64_t hash = HashUniqueIndex::HashKey(key->GetKeyBuf(), key->GetKeyLength());
+    return (int)((hash >> 32) % m_numaNodeCount);
+}
+
+Row* Table::MoveRowToNumaNode(Row* row, int node)
+{
+    ObjAllocInterface* pool = m_numaRowPools[node];
+    if (ObjPool::GetOwner(row, pool->m_size) == pool) {
+        return row;
+    }
+
+    Row* movedRow = pool->Alloc<Row>(*row);
+    if (movedRow == nullptr) {
+        // not fatal, the row just stays on the current node
+        MOT_LOG_DEBUG("Failed to move new row of table %s to NUMA node %d", m_longTableName.c_str(), node);
+        return row;
+    }
+    DestroyRow(row);
+    return movedRow;
 }
 
 void Table::IncIndexColumnUsage(MOT::Index* index)
@@ -286,12 +515,149 @@ bool Table::CreateSecondaryIndexDataNonTransactional(MOT::Index* index, uint32_t
     }
     return ret;
 }
+
+bool Table::CreateSecondaryIndexDataParallel(MOT::Index* index, TxnManager* txn, uint32_t workerCount)
+{
+    // collect the committed rows first (the table is locked against concurrent writers during index creation), rows
+    // changed by the transaction itself are left for the catch-up phase below
+    bool hasLocalChanges = (txn->m_accessMgr->m_rowCnt != 0);
+    std::vector<Sentinel*> sentinels;
+    std::vector<Row*> localRows;
+    IndexIterator* it = m_indexes[0]->Begin(txn->GetThdId());
+    if (it == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Create Secondary Index", "Failed to begin iterating over primary index");
+        return false;
+    }
+    if (hasLocalChanges) {
+        // make rows inserted by previous statements of the transaction visible
+        txn->IncStmtCount();
+    }
+    while (it->IsValid()) {
+        Sentinel* sentinel = it->GetPrimarySentinel();
+        RC status = RC_LOCAL_ROW_NOT_FOUND;
+        Row* localRow = nullptr;
+        if (hasLocalChanges) {
+            status = txn->AccessLookup(RD, sentinel, localRow);
+        }
+        if (status == RC_LOCAL_ROW_FOUND) {
+            Row* row = it->GetRow();
+            localRows.push_back((row != nullptr) ? row : localRow);
+        } else if (status == RC_MEMORY_ALLOCATION_ERROR) {
+            delete it;
+            GcManager::ClearIndexElements(index->GetIndexId());
+            txn->m_err = RC_MEMORY_ALLOCATION_ERROR;
+            txn->m_errIx = nullptr;
+            return false;
+        } else if (status == RC_LOCAL_ROW_NOT_FOUND && sentinel->IsCommited() && sentinel->GetData() != nullptr) {
+            sentinels.push_back(sentinel);
+        }
+        it->Next();
+    }
+    delete it;
+
+    uint64_t rowCount = sentinels.size();
+    uint64_t rangeCount = rowCount / INDEX_BUILD_MIN_ROWS_PER_WORKER;
+    if (rangeCount > workerCount) {
+        rangeCount = workerCount;
+    } else if (rangeCount == 0) {
+        rangeCount = 1;
+    }
+
+    IndexBuildState state;
+    state.m_table = this;
+    state.m_index = index;
+    state.m_failed = false;
+    state.m_rc = RC_OK;
+    state.m_errRow = nullptr;
+
+    std::vector<IndexBuildRange> ranges(rangeCount);
+    uint64_t rangeSize = rowCount / rangeCount;
+    for (uint64_t i = 0; i < rangeCount; ++i) {
+        ranges[i].m_sentinels = sentinels.data() + i * rangeSize;
+        ranges[i].m_count = (i == rangeCount - 1) ? (rowCount - i * rangeSize) : rangeSize;
+        ranges[i].m_done = false;
+    }
+
+    MOT_LOG_DEBUG("Building index %s of table %s: %" PRIu64 " rows, %" PRIu64 " threads",
+        index->GetName().c_str(),
+        m_longTableName.c_str(),
+        rowCount,
+        rangeCount);
+
+    // the session thread handles the first range, ranges left without a worker are built below
+    std::vector<std::thread> workers;
+    workers.reserve(rangeCount - 1);
+    for (uint64_t i = 1; i < rangeCount; ++i) {
+        try {
+            workers.push_back(std::thread(IndexBuildWorkerFunc, &state, &ranges[i]));
+        } catch (const std::system_error& e) {
+            MOT_LOG_WARN("Failed to start index build worker (%s), building %" PRIu64 " ranges serially",
+                e.what(),
+                rangeCount - i);
+            break;
+        }
+    }
+    IndexBuildProcessRange(&state, &ranges[0], txn->GetThdId());
+    for (auto& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+
+    // process the ranges of workers that failed to start
+    for (uint64_t i = 1; i < rangeCount && !state.m_failed; ++i) {
+        if (!ranges[i].m_done) {
+            IndexBuildProcessRange(&state, &ranges[i], txn->GetThdId());
+        }
+    }
+
+    if (state.m_failed) {
+        GcManager::ClearIndexElements(index->GetIndexId());
+        txn->m_err = state.m_rc;
+        // index is not part of table yet, so we cannot save it in error info of transaction
+        txn->m_errIx = nullptr;
+        if (state.m_errRow != nullptr) {
+            index->BuildErrorMsg(this, state.m_errRow, txn->m_errMsgBuf, sizeof(txn->m_errMsgBuf));
+        }
+        return false;
+    }
+
+    // catch up with the rows changed by the transaction through its access set, as the serial build does
+    for (Row* row : localRows) {
+        Key* key = txn->GetTxnKey(index);
+        index->BuildKey(this, row, key);
+        txn->GetNextInsertItem()->SetItem(row, index, key);
+        RC status = txn->InsertRow(row);
+        if (status != RC_OK) {
+            txn->RollbackSecondaryIndexInsert(index);
+            GcManager::ClearIndexElements(index->GetIndexId());
+            txn->m_err = (status == RC_MEMORY_ALLOCATION_ERROR) ? RC_MEMORY_ALLOCATION_ERROR : RC_UNIQUE_VIOLATION;
+            txn->m_errIx = nullptr;
+            index->BuildErrorMsg(this, row, txn->m_errMsgBuf, sizeof(txn->m_errMsgBuf));
+            return false;
+        }
+    }
+    MOT_LOG_DEBUG("Index %s of table %s caught up with %zu rows changed by the transaction",
+        index->GetName().c_str(),
+        m_longTableName.c_str(),
+        localRows.size());
+    return true;
+}
+
 bool Table::CreateSecondaryIndexData(MOT::Index* index, TxnManager* txn)
 {
     RC status = RC_OK;
     bool error = false;
     Key* key = nullptr;
     bool ret = true;
+
+    // keys of committed rows can be inserted directly by several threads, since the new index is removed as a whole
+    // if the transaction aborts
+    uint32_t workerCount = GetGlobalConfiguration().m_indexBuildWorkers;
+    if (workerCount > 1 && !txn->m_isLightSession) {
+        return CreateSecondaryIndexDataParallel(index, txn, workerCount);
+    }
+
     IndexIterator* it = m_indexes[0]->Begin(txn->GetThdId());
 
     // report error if failed to allocate
@@ -476,6 +842,13 @@ RC Table::InsertRow(Row* row, TxnManager* txn)
         ix->BuildKey(this, row, key);
     }
 
+    // place the row on its home node before any index refers to it
+    if (m_numaRowPools != nullptr) {
+        int node = GetKeyNumaNode(key);
+        txn->RecordNumaAccess(node);
+        row = MoveRowToNumaNode(row, node);
+    }
+
     txn->GetNextInsertItem()->SetItem(row, ix, key);
 
     // add secondary indexes
@@ -594,15 +967,39 @@ Row* Table::RemoveKeyFromIndex(Row* row, Sentinel* sentinel, uint64_t tid, GcMan
 
 Row* Table::CreateNewRow()
 {
-    Row* row = m_rowPool->Alloc<Row>(this);
+    // rows of a NUMA-partitioned table are allocated on the current node, and moved to their home node on insert
+    ObjAllocInterface* pool = m_rowPool;
+    if (m_numaRowPools != nullptr) {
+        int node = MOTCurrentNumaNodeId;
+        if (node >= 0 && (uint32_t)node < m_numaNodeCount) {
+            pool = m_numaRowPools[node];
+        }
+    }
+
+    Row* row = pool->Alloc<Row>(this);
     if (row == nullptr) {
         MOT_REPORT_ERROR(MOT_ERROR_OOM, "Create Row", "Failed to create new row in table %s", m_longTableName.c_str());
+    } else {
+        ColdRowStore* coldStore = GetColdRowStore();
+        if (coldStore != nullptr) {
+            row->Touch(coldStore->GetClock());
+        }
     }
     return row;
 }
 
 void Table::DestroyRow(Row* row)
 {
+    ColdRowStore* coldStore = GetColdRowStore();
+    if (coldStore != nullptr && coldStore->Contains(row)) {
+        coldStore->Release(row, GetRowSizeFromPool());
+        return;
+    }
+    if (m_numaRowPools != nullptr) {
+        // the row may come from any of the node pools, or from the row pool if inserted before partitioning
+        ObjPool::GetOwner(row, m_rowPool->m_size)->Release<Row>(row);
+        return;
+    }
     m_rowPool->Release<Row>(row);
 }
 
@@ -765,6 +1162,10 @@ void Table::Truncate(TxnManager* txn)
     GcManager::ClearIndexElements(m_indexes[0]->GetIndexId());
     m_indexes[0]->Truncate(false);
     ObjAllocInterface::FreeObjPool(&m_rowPool);
+    ColdRowStore* coldStore = GetColdRowStore();
+    if (coldStore != nullptr) {
+        coldStore->ReleaseTable(m_tableId);
+    }
     m_rowPool = ObjAllocInterface::GetObjPool(sizeof(Row) + m_tupleSize, false);
     if (!m_rowPool) {
         MOT_REPORT_ERROR(MOT_ERROR_OOM,
@@ -772,6 +1173,13 @@ void Table::Truncate(TxnManager* txn)
             "Failed to allocate row pool after truncate in table %s",
             m_longTableName.c_str());
     }
+    if (m_numaRowPools != nullptr) {
+        DestroyNumaRowPools(m_numaRowPools, m_numaNodeCount);
+        m_numaRowPools = CreateNumaRowPools();
+        if (m_numaRowPools == nullptr) {
+            MOT_LOG_WARN("Table %s is no longer NUMA-partitioned after truncate", m_longTableName.c_str());
+        }
+    }
 
     (void)pthread_rwlock_unlock(&m_rwLock);
 }
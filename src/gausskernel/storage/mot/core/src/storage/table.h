@@ -130,6 +130,29 @@ public:
      */
     void ClearThreadMemoryCache();
 
+    /**
+     * @brief Partitions the table rows between the NUMA nodes by primary key hash. From now on, each inserted row
+     * is placed on its home node. Rows that were inserted before are left in place.
+     * @return True if succeeded (or the table is already partitioned), otherwise false.
+     */
+    bool SetNumaPartitioned();
+
+    /**
+     * @brief Queries whether the table rows are partitioned between the NUMA nodes.
+     * @return True if the table is NUMA-partitioned.
+     */
+    inline bool IsNumaPartitioned() const
+    {
+        return m_numaRowPools != nullptr;
+    }
+
+    /**
+     * @brief Retrieves the home NUMA node of a row in a NUMA-partitioned table.
+     * @param key The primary key of the row.
+     * @return The home NUMA node, or -1 if the table is not NUMA-partitioned.
+     */
+    int GetKeyNumaNode(const Key* key) const;
+
     /**
      * @brief Retrieves the name of the table.
      * @return The name of the table.
@@ -292,6 +315,11 @@ public:
     void ClearRowCache()
     {
         m_rowPool->ClearFreeCache();
+        if (m_numaRowPools != nullptr) {
+            for (uint32_t i = 0; i < m_numaNodeCount; i++) {
+                m_numaRowPools[i]->ClearFreeCache();
+            }
+        }
         for (int i = 0; i < m_numIndexes; i++) {
             if (m_indexes[i] != nullptr) {
                 m_indexes[i]->ClearFreeCache();
@@ -825,6 +853,20 @@ public:
     Row* RemoveKeyFromIndex(Row* row, Sentinel* sentinel, uint64_t tid, GcManager* gc);
 
 private:
+    /** @var Minimal number of rows a parallel index build worker handles. */
+    static constexpr uint64_t INDEX_BUILD_MIN_ROWS_PER_WORKER = 65536;
+
+    /**
+     * @brief Indexes a table using a secondary index, splitting the rows between several threads that insert the
+     * keys of committed rows directly into the new index, which is removed as a whole if the transaction aborts.
+     * Rows changed by the transaction itself are then inserted through the transaction access set.
+     * @param index The index to use.
+     * @param txn The txn manager object.
+     * @param workerCount The maximal number of threads to use (including the calling thread).
+     * @return Boolean value denoting success or failure.
+     */
+    bool CreateSecondaryIndexDataParallel(Index* index, TxnManager* txn, uint32_t workerCount);
+
     /** @var Global atomic table identifier. */
     static std::atomic<uint32_t> tableCounter;
 
@@ -889,6 +931,34 @@ private:
 
     uint32_t m_rowCount = 0;
 
+    /** @var Number of NUMA nodes the rows are partitioned between (zero if the table is not NUMA-partitioned). */
+    uint32_t m_numaNodeCount = 0;
+
+    /** @var Row pools of a NUMA-partitioned table, one per node (null if the table is not NUMA-partitioned). */
+    ObjAllocInterface** m_numaRowPools = nullptr;
+
+    /**
+     * @brief Allocates a row pool for each NUMA node.
+     * @return The row pool array, or null if failed.
+     */
+    ObjAllocInterface** CreateNumaRowPools() const;
+
+    /**
+     * @brief Releases the row pools of all NUMA nodes.
+     * @param pools The row pool array.
+     * @param nodeCount The number of NUMA nodes.
+     */
+    static void DestroyNumaRowPools(ObjAllocInterface** pools, uint32_t nodeCount);
+
+    /**
+     * @brief Moves a new row that was not inserted into any index yet to its home NUMA node.
+     * @param row The row.
+     * @param node The home NUMA node of the row.
+     * @return The relocated row, or the original row if it already resides on its home node or if the relocation
+     * failed.
+     */
+    Row* MoveRowToNumaNode(Row* row, int node);
+
     DECLARE_CLASS_LOGGER();
 
 public:
@@ -34,11 +34,15 @@
 #include "table.h"
 #include "index.h"
 #include <list>
+#include <set>
 #include <algorithm>
 
 namespace MOT {
 DECLARE_LOGGER(CheckpointManager, Checkpoint);
 
+// Low CSN watermark value when no transaction has committed since the last snapshot
+static constexpr uint64_t DELTA_NO_CSN = (uint64_t)(-1);
+
 CheckpointManager::CheckpointManager()
     : m_lock(),
       m_redoLogHandler(MOTEngine::GetInstance()->GetRedoLogHandler()),
@@ -57,7 +61,17 @@ CheckpointManager::CheckpointManager()
       m_id(0),
       m_inProgressId(0),
       m_lastReplayLsn(0),
-      m_emptyCheckpoint(false)
+      m_emptyCheckpoint(false),
+      m_deltaInterval(GetGlobalConfiguration().m_checkpointDeltaInterval),
+      m_deltaCheckpoint(false),
+      m_fullCheckpointRequested(false),
+      m_deltaLowCsn(DELTA_NO_CSN),
+      m_deltaMinCsn(0),
+      m_recordTombstones(false),
+      m_tombstoneBufSize(GetGlobalConfiguration().m_checkpointDeltaBufferSize),
+      m_tombstoneBufs{nullptr, nullptr},
+      m_tombstoneBufIx(0),
+      m_tombstoneBufUsed(0)
 {}
 
 bool CheckpointManager::Initialize()
@@ -85,6 +99,13 @@ CheckpointManager::~CheckpointManager()
         delete m_checkpointers;
         m_checkpointers = nullptr;
     }
+    FinishDeltaCheckpoint(false);
+    for (uint32_t i = 0; i < 2; i++) {
+        if (m_tombstoneBufs[i] != nullptr) {
+            free(m_tombstoneBufs[i]);
+            m_tombstoneBufs[i] = nullptr;
+        }
+    }
     (void)pthread_rwlock_destroy(&m_fetchLock);
 }
 
@@ -121,6 +142,10 @@ bool CheckpointManager::CreateSnapShot()
     // Ensure that all the transactions that started commit in PREPARE phase are completed.
     WaitPrevPhaseCommittedTxnComplete();
 
+    // No transaction is committing now, so the changes tracked since the previous snapshot
+    // belong exactly to this checkpoint.
+    PrepareDeltaCheckpoint();
+
     // Now in RESOLVE phase, no transaction is allowed to start the commit.
     // It is safe now to obtain a list of all tables to included in this checkpoint.
     // The tables are read locked in order to avoid drop/truncate during checkpoint.
@@ -176,6 +201,7 @@ bool CheckpointManager::BeginCheckpoint()
     if (!m_errorSet) {
         CompleteCheckpoint();
     }
+    FinishDeltaCheckpoint(!m_errorSet);
 
     // No locking required here, as the checkpoint workers have already exited.
     UnlockAndClearTables(m_tasksList);
@@ -218,6 +244,7 @@ bool CheckpointManager::Abort()
         UnlockAndClearTables(m_tasksList);
         UnlockAndClearTables(m_finishedTasks);
         m_numCpTasks = 0;
+        FinishDeltaCheckpoint(false);
 
         // Move to rest
         m_lock.WrLock();
@@ -246,6 +273,14 @@ void CheckpointManager::BeginTransaction(TxnManager* txn)
     txn->m_checkpointPhase = m_phase;
     txn->m_checkpointNABit = !m_availableBit;
     m_counters[m_cntBit].fetch_add(1);
+    if (m_deltaInterval > 0) {
+        // Track the lowest CSN committed after the last snapshot. The CSN is taken before the
+        // transaction gets here, so it may be lower than CSNs already included in the snapshot.
+        uint64_t csn = txn->GetCommitSequenceNumber();
+        uint64_t lowCsn = m_deltaLowCsn.load();
+        while (csn < lowCsn && !m_deltaLowCsn.compare_exchange_weak(lowCsn, csn)) {
+        }
+    }
     m_lock.RdUnlock();
 }
 
@@ -398,6 +433,10 @@ bool CheckpointManager::ApplyWrite(TxnManager* txnMan, Row* origRow, AccessType
         return false;
     }
 
+    if (type == DEL && m_recordTombstones) {
+        RecordTombstone(origRow);
+    }
+
     bool statusBit = s->GetStableStatus();
     switch (startPhase) {
         case REST:
@@ -493,9 +532,13 @@ void CheckpointManager::TaskDone(Table* table, uint32_t numSegs, bool success)
 
 void CheckpointManager::CompleteCheckpoint()
 {
-    if (m_emptyCheckpoint == true && CreateEmptyCheckpoint() == false) {
-        OnError(CheckpointWorkerPool::ErrCodes::FILE_IO, "Failed to create empty checkpoint");
-        return;
+    if (m_emptyCheckpoint == true) {
+        // nothing to chain to, an empty checkpoint is a full one
+        m_deltaCheckpoint = false;
+        if (CreateEmptyCheckpoint() == false) {
+            OnError(CheckpointWorkerPool::ErrCodes::FILE_IO, "Failed to create empty checkpoint");
+            return;
+        }
     }
 
     CheckpointControlFile* ctrlFile = CheckpointControlFile::GetCtrlFile();
@@ -514,6 +557,11 @@ void CheckpointManager::CompleteCheckpoint()
         return;
     }
 
+    if (m_deltaCheckpoint && (!LinkDeltaChain() || !CreateChainFile())) {
+        OnError(CheckpointWorkerPool::ErrCodes::FILE_IO, "Failed to link the delta checkpoint chain");
+        return;
+    }
+
     if (!ctrlFile->IsValid()) {
         OnError(CheckpointWorkerPool::ErrCodes::FILE_IO, "Invalid control file");
         return;
@@ -533,6 +581,10 @@ void CheckpointManager::CompleteCheckpoint()
         }
 
         // Update checkpoint Id
+        if (!m_deltaCheckpoint) {
+            m_deltaChain.clear();
+        }
+        m_deltaChain.push_back(m_inProgressId);
         SetId(m_inProgressId);
         GetRecoveryManager()->SetCheckpointId(m_id);
         finishedUpdatingFiles = true;
@@ -544,7 +596,11 @@ void CheckpointManager::CompleteCheckpoint()
     }
 
     RemoveOldCheckpoints(m_inProgressId);
-    MOT_LOG_INFO("Checkpoint [%lu] completed", m_inProgressId);
+    if (m_deltaCheckpoint) {
+        MOT_LOG_INFO("Delta checkpoint [%lu] completed (%u in chain)", m_inProgressId, (uint32_t)m_deltaChain.size());
+    } else {
+        MOT_LOG_INFO("Checkpoint [%lu] completed", m_inProgressId);
+    }
 }
 
 void CheckpointManager::DestroyCheckpointers()
@@ -557,8 +613,14 @@ void CheckpointManager::DestroyCheckpointers()
 
 void CheckpointManager::CreateCheckpointers()
 {
-    m_checkpointers = new (std::nothrow)
-        CheckpointWorkerPool(m_numThreads, !m_availableBit, m_tasksList, m_cpSegThreshold, m_inProgressId, *this);
+    m_checkpointers = new (std::nothrow) CheckpointWorkerPool(m_numThreads,
+        !m_availableBit,
+        m_tasksList,
+        m_cpSegThreshold,
+        m_inProgressId,
+        *this,
+        m_deltaCheckpoint ? &m_cpTombstones : nullptr,
+        m_deltaMinCsn);
 }
 
 void CheckpointManager::Capture()
@@ -897,4 +959,236 @@ bool CheckpointManager::CreateEndFile()
 
     return ret;
 }
+
+void CheckpointManager::RecordTombstone(Row* row)
+{
+    Table* table = row->GetTable();
+    Index* index = table->GetPrimaryIndex();
+    MaxKey key;
+    key.InitKey(index->GetKeyLength());
+    index->BuildKey(table, row, &key);
+
+    // No checkpoint reads the collecting buffer before the RESOLVE phase, which waits for all the
+    // committing transactions, so reserving the space is the only synchronization needed here.
+    uint64_t size = ALIGN8(sizeof(DeltaTombstone) + key.GetKeyLength());
+    uint64_t offset = m_tombstoneBufUsed.fetch_add(size);
+    if (offset + size > m_tombstoneBufSize) {
+        // the deleted key is lost, so the next checkpoint can not be a delta checkpoint
+        if (m_recordTombstones.exchange(false)) {
+            MOT_LOG_WARN("Deleted keys buffer is full (%lu bytes), next checkpoint will be a full checkpoint",
+                m_tombstoneBufSize);
+        }
+        RequestFullCheckpoint();
+        return;
+    }
+
+    DeltaTombstone* tombstone = (DeltaTombstone*)(m_tombstoneBufs[m_tombstoneBufIx] + offset);
+    tombstone->m_tableId = table->GetTableId();
+    tombstone->m_keyLen = key.GetKeyLength();
+    errno_t erc = memcpy_s(tombstone->GetKeyBuf(), tombstone->m_keyLen, key.GetKeyBuf(), key.GetKeyLength());
+    securec_check(erc, "\0", "\0");
+}
+
+bool CheckpointManager::AllocTombstoneBuffers()
+{
+    for (uint32_t i = 0; i < 2; i++) {
+        if (m_tombstoneBufs[i] == nullptr) {
+            m_tombstoneBufs[i] = (char*)malloc(m_tombstoneBufSize);
+            if (m_tombstoneBufs[i] == nullptr) {
+                MOT_LOG_WARN("Failed to allocate %lu bytes for deleted keys, delta checkpoints are suspended",
+                    m_tombstoneBufSize);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void CheckpointManager::PrepareDeltaCheckpoint()
+{
+    m_deltaCheckpoint = false;
+    if (m_deltaInterval == 0) {
+        return;
+    }
+
+    // No transaction is committing, the keys deleted from now on go to the other buffer
+    char* tombstoneBuf = m_tombstoneBufs[m_tombstoneBufIx];
+    uint64_t tombstoneBytes = m_tombstoneBufUsed.exchange(0);
+    m_tombstoneBufIx = 1 - m_tombstoneBufIx;
+    uint64_t lowCsn = m_deltaLowCsn.exchange(DELTA_NO_CSN);
+    bool fullRequested = m_fullCheckpointRequested;
+    m_fullCheckpointRequested = false;
+
+    // m_deltaChain holds the full checkpoint and the deltas taken after it. Deleted keys were
+    // collected since the previous snapshot only if this checkpoint qualifies, an overflow of the
+    // buffer requested a full checkpoint.
+    if (!fullRequested && !m_deltaChain.empty() && m_deltaChain.size() <= m_deltaInterval) {
+        MOT_ASSERT(tombstoneBytes <= m_tombstoneBufSize);
+        m_deltaCheckpoint = true;
+        m_deltaMinCsn = lowCsn;
+        uint64_t numTombstones = 0;
+        uint64_t offset = 0;
+        while (offset < tombstoneBytes) {
+            DeltaTombstone* tombstone = (DeltaTombstone*)(tombstoneBuf + offset);
+            m_cpTombstones[tombstone->m_tableId].push_back(tombstone);
+            offset += ALIGN8(sizeof(DeltaTombstone) + tombstone->m_keyLen);
+            numTombstones++;
+        }
+        MOT_LOG_DEBUG("Checkpoint %lu is a delta checkpoint: min CSN %lu, %lu deleted keys",
+            m_inProgressId,
+            m_deltaMinCsn,
+            numTombstones);
+    }
+
+    // Keys deleted from now on are needed only if the checkpoint after this one can be a delta
+    size_t nextChainSize = m_deltaCheckpoint ? m_deltaChain.size() + 1 : 1;
+    bool record = (nextChainSize <= m_deltaInterval);
+    if (record && !AllocTombstoneBuffers()) {
+        m_fullCheckpointRequested = true;
+        record = false;
+    }
+    m_recordTombstones = record;
+}
+
+void CheckpointManager::FinishDeltaCheckpoint(bool success)
+{
+    // the deleted keys live in the buffer that is reused at the next snapshot
+    m_cpTombstones.clear();
+
+    // the changes collected for this checkpoint are gone, only a full checkpoint can follow a failure
+    if (!success && m_deltaInterval > 0) {
+        RequestFullCheckpoint();
+    }
+    m_deltaCheckpoint = false;
+}
+
+bool CheckpointManager::LinkDeltaChain()
+{
+    std::string prevDir;
+    std::string workingDir;
+    if (!CheckpointUtils::SetWorkingDir(prevDir, m_id) || !CheckpointUtils::SetWorkingDir(workingDir, m_inProgressId)) {
+        MOT_LOG_ERROR("LinkDeltaChain: failed to set working directory");
+        return false;
+    }
+
+    DIR* dir = opendir(prevDir.c_str());
+    if (dir == nullptr) {
+        MOT_LOG_ERROR(
+            "LinkDeltaChain: failed to open dir: %s, error %d - %s", prevDir.c_str(), errno, gs_strerror(errno));
+        return false;
+    }
+
+    // Recovery reads the map file of every level of the chain and the data files of the tables that
+    // the in-progress checkpoint holds, the files of tables dropped since then are not linked.
+    std::set<uint64_t> levelIds(m_deltaChain.begin(), m_deltaChain.end());
+    std::set<uint32_t> tableIds;
+    for (Table* table : m_tasksList) {
+        (void)tableIds.insert(table->GetTableId());
+    }
+
+    bool ret = true;
+    struct dirent* p;
+    while ((p = readdir(dir))) {
+        std::string name(p->d_name);
+        const char* suffix = strrchr(p->d_name, '.');
+        if (suffix == nullptr) {
+            continue;
+        }
+
+        // data files written by the previous checkpoint itself get its id as prefix, files it
+        // linked from older checkpoints and the map files already carry their checkpoint id
+        std::string target = workingDir + "/";
+        if (strcmp(suffix, CheckpointUtils::mapFileSuffix) == 0) {
+            if (levelIds.find(strtoull(p->d_name, nullptr, 10)) == levelIds.end()) {
+                continue;
+            }
+        } else if (strcmp(suffix, CheckpointUtils::cpFileSuffix) == 0 ||
+                   strcmp(suffix, CheckpointUtils::delFileSuffix) == 0) {
+            const char* tabName = strstr(p->d_name, CheckpointUtils::tabFilePrefix);
+            if (tabName == nullptr) {
+                continue;
+            }
+            uint64_t levelId = (tabName == p->d_name) ? m_id : strtoull(p->d_name, nullptr, 10);
+            uint32_t tableId = (uint32_t)strtoul(tabName + strlen(CheckpointUtils::tabFilePrefix), nullptr, 10);
+            if (levelIds.find(levelId) == levelIds.end() || tableIds.find(tableId) == tableIds.end()) {
+                continue;
+            }
+            if (tabName == p->d_name) {
+                CheckpointUtils::AppendLevelPrefix(target, m_id);
+            }
+        } else {
+            continue;
+        }
+        target.append(name);
+        std::string source = prevDir + "/" + name;
+        if (link(source.c_str(), target.c_str()) != 0) {
+            MOT_LOG_ERROR("LinkDeltaChain: failed to link %s to %s, error %d - %s",
+                source.c_str(),
+                target.c_str(),
+                errno,
+                gs_strerror(errno));
+            ret = false;
+            break;
+        }
+    }
+    closedir(dir);
+    return ret;
+}
+
+bool CheckpointManager::CreateChainFile()
+{
+    int fd = -1;
+    std::string fileName;
+    std::string workingDir;
+    bool ret = false;
+
+    do {
+        if (!CheckpointUtils::SetWorkingDir(workingDir, m_inProgressId)) {
+            break;
+        }
+
+        CheckpointUtils::MakeChainFilename(fileName, workingDir, m_inProgressId);
+        if (!CheckpointUtils::OpenFileWrite(fileName, fd)) {
+            MOT_LOG_ERROR(
+                "CreateChainFile: failed to create file '%s' - %d - %s", fileName.c_str(), errno, gs_strerror(errno));
+            break;
+        }
+
+        CheckpointUtils::ChainFileHeader chainFileHeader{CP_MGR_MAGIC, m_deltaChain.size() + 1};
+        if (CheckpointUtils::WriteFile(fd, (char*)&chainFileHeader, sizeof(CheckpointUtils::ChainFileHeader)) !=
+            sizeof(CheckpointUtils::ChainFileHeader)) {
+            MOT_LOG_ERROR("CreateChainFile: failed to write chain file's header");
+            (void)CheckpointUtils::CloseFile(fd);
+            break;
+        }
+
+        bool writeFailed = false;
+        for (uint64_t levelId : m_deltaChain) {
+            if (CheckpointUtils::WriteFile(fd, (char*)&levelId, sizeof(uint64_t)) != sizeof(uint64_t)) {
+                writeFailed = true;
+                break;
+            }
+        }
+        if (writeFailed ||
+            CheckpointUtils::WriteFile(fd, (char*)&m_inProgressId, sizeof(uint64_t)) != sizeof(uint64_t)) {
+            MOT_LOG_ERROR("CreateChainFile: failed to write chain file entry");
+            (void)CheckpointUtils::CloseFile(fd);
+            break;
+        }
+
+        if (CheckpointUtils::FlushFile(fd)) {
+            MOT_LOG_ERROR("CreateChainFile: failed to flush chain file");
+            (void)CheckpointUtils::CloseFile(fd);
+            break;
+        }
+
+        if (CheckpointUtils::CloseFile(fd)) {
+            MOT_LOG_ERROR("CreateChainFile: failed to close chain file");
+            break;
+        }
+        ret = true;
+    } while (0);
+
+    return ret;
+}
 }  // namespace MOT
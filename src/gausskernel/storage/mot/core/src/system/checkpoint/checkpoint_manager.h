@@ -33,6 +33,7 @@
 #include "txn.h"
 #include "txn_access.h"
 #include <queue>
+#include <vector>
 #include "checkpoint_worker.h"
 #include "checkpoint_ctrlfile.h"
 #include "spin_lock.h"
@@ -107,6 +108,16 @@ public:
      */
     bool ApplyWrite(TxnManager* txnMan, Row* origRow, AccessType type);
 
+    /**
+     * @brief Forces the next checkpoint to be a full checkpoint. Used when rows are removed
+     * without being recorded as deleted keys (e.g. truncate table).
+     */
+    void RequestFullCheckpoint()
+    {
+        m_fullCheckpointRequested = true;
+        m_recordTombstones = false;
+    }
+
     /**
      * @brief Checkpoint task completion callback
      * @param checkpointId The checkpoint's id.
@@ -266,6 +277,43 @@ private:
     // this lock guards gs_ctl checkpoint fetching
     pthread_rwlock_t m_fetchLock;
 
+    // Number of delta checkpoints allowed between two full checkpoints
+    uint32_t m_deltaInterval;
+
+    // Indicates the in-progress checkpoint is a delta checkpoint
+    bool m_deltaCheckpoint;
+
+    // Forces the next checkpoint to be a full checkpoint
+    volatile bool m_fullCheckpointRequested;
+
+    // Checkpoint ids of the last completed checkpoint chain, the full checkpoint first
+    std::vector<uint64_t> m_deltaChain;
+
+    // Lowest commit CSN of the transactions that started committing since the last snapshot
+    std::atomic<uint64_t> m_deltaLowCsn;
+
+    // Rows committed with a lower CSN are not written by the in-progress delta checkpoint
+    uint64_t m_deltaMinCsn;
+
+    // Deleted keys are recorded only while the next checkpoint can be a delta checkpoint
+    std::atomic<bool> m_recordTombstones;
+
+    // Size of each deleted keys buffer
+    uint64_t m_tombstoneBufSize;
+
+    // Deleted keys buffers, allocated once: one collects the keys deleted since the last
+    // snapshot while the other holds the keys of the in-progress checkpoint
+    char* m_tombstoneBufs[2];
+
+    // Index of the buffer collecting deleted keys, switched in the RESOLVE phase
+    uint32_t m_tombstoneBufIx;
+
+    // Bytes reserved in the collecting buffer
+    std::atomic<uint64_t> m_tombstoneBufUsed;
+
+    // Keys deleted between the previous snapshot and the in-progress one
+    DeltaTombstoneMap m_cpTombstones;
+
     void SetId(uint64_t id)
     {
         m_id = id;
@@ -390,6 +438,44 @@ private:
      * @param checkpointId The checkpoint id to be deleted.
      */
     void RemoveCheckpointDir(uint64_t checkpointId);
+
+    /**
+     * @brief Records the primary key of a deleted row for the next delta checkpoint. Forces the next
+     * checkpoint to be a full checkpoint if the deleted keys buffer is full.
+     * @param row The deleted row.
+     */
+    void RecordTombstone(Row* row);
+
+    /**
+     * @brief Allocates the deleted keys buffers if not allocated yet.
+     * @return Boolean value denoting success or failure.
+     */
+    bool AllocTombstoneBuffers();
+
+    /**
+     * @brief Decides whether the checkpoint that is being snapshotted is a delta checkpoint, and
+     * collects the changes tracked since the previous snapshot. Called in the RESOLVE phase.
+     */
+    void PrepareDeltaCheckpoint();
+
+    /**
+     * @brief Releases the deleted keys of the in-progress checkpoint.
+     * @param success Indicates whether the checkpoint has completed successfully.
+     */
+    void FinishDeltaCheckpoint(bool success);
+
+    /**
+     * @brief Links the files of the previous checkpoint chain that the recovery of the in-progress
+     * checkpoint reads into its directory, so that each checkpoint directory is self contained.
+     * @return Boolean value denoting success or failure.
+     */
+    bool LinkDeltaChain();
+
+    /**
+     * @brief Creates the delta chain file that lists the checkpoints to load, the full checkpoint first.
+     * @return Boolean value denoting success or failure.
+     */
+    bool CreateChainFile();
 };
 }  // namespace MOT
 
@@ -172,6 +172,15 @@ static const char* tpcFileSuffix = ".tpc";
 // End file suffix
 static const char* validFileSuffix = ".end";
 
+// Delta checkpoint chain file suffix
+static const char* chainFileSuffix = ".chain";
+
+// Delta checkpoint deleted keys file suffix
+static const char* delFileSuffix = ".del";
+
+// Prefix of the per-table data files
+static const char* tabFilePrefix = "tab_";
+
 // Max path len
 static const size_t maxPath = 1024;
 
@@ -236,23 +245,55 @@ inline void MakeMapFilename(std::string& fileName, std::string& workingDir, uint
     fileName.append(mapFileSuffix);
 }
 
+/**
+ * @brief Appends the prefix of files that were linked from a previous checkpoint of a delta chain
+ * @param fileName The filename string to append to.
+ * @param levelId The checkpoint id that wrote the file, or 0 for files of the current checkpoint.
+ */
+inline void AppendLevelPrefix(std::string& fileName, uint64_t levelId)
+{
+    if (levelId != 0) {
+        fileName.append(std::to_string(levelId));
+        fileName.append("_");
+    }
+}
+
 /**
  * @brief Creates a checkpoint seg filename
  * @param tableId The tabled id that this file contains.
  * @param fileName The returned filename string.
  * @param workingDir The directory in which the file should be located.
  * @param seg The segment number.
+ * @param levelId The checkpoint id that wrote the file, or 0 for files of the current checkpoint.
  */
-inline void MakeCpFilename(uint64_t tableId, std::string& fileName, std::string& workingDir, int seg = 0)
+inline void MakeCpFilename(
+    uint64_t tableId, std::string& fileName, std::string& workingDir, int seg = 0, uint64_t levelId = 0)
 {
     MakeFilename(fileName, workingDir);
-    fileName.append("tab_");
+    AppendLevelPrefix(fileName, levelId);
+    fileName.append(tabFilePrefix);
     fileName.append(std::to_string(tableId));
     fileName.append("_");
     fileName.append(std::to_string(seg));
     fileName.append(cpFileSuffix);
 }
 
+/**
+ * @brief Creates a delta checkpoint deleted keys filename
+ * @param tableId The tabled id that this file contains.
+ * @param fileName The returned filename string.
+ * @param workingDir The directory in which the file should be located.
+ * @param levelId The checkpoint id that wrote the file, or 0 for files of the current checkpoint.
+ */
+inline void MakeDelFilename(uint64_t tableId, std::string& fileName, std::string& workingDir, uint64_t levelId = 0)
+{
+    MakeFilename(fileName, workingDir);
+    AppendLevelPrefix(fileName, levelId);
+    fileName.append(tabFilePrefix);
+    fileName.append(std::to_string(tableId));
+    fileName.append(delFileSuffix);
+}
+
 /**
  * @brief Creates a checkpoint table metadata filename
  * @param tableId The tabled id that this file contains.
@@ -292,6 +333,19 @@ inline void MakeEndFilename(std::string& fileName, std::string& workingDir, uint
     fileName.append(validFileSuffix);
 }
 
+/**
+ * @brief Creates a delta checkpoint chain filename
+ * @param fileName The returned filename string.
+ * @param workingDir The directory in which the file should be located.
+ * @param cpId The checkpoint id.
+ */
+inline void MakeChainFilename(std::string& fileName, std::string& workingDir, uint64_t cpId)
+{
+    MakeFilename(fileName, workingDir);
+    fileName.append(std::to_string(cpId));
+    fileName.append(chainFileSuffix);
+}
+
 /**
  * @brief Sets the cpu affinity for a given thread
  * @param cpu The cpu that the thread should run on.
@@ -330,6 +384,11 @@ struct MapFileHeader {
     uint64_t m_numEntries;
 };
 
+struct ChainFileHeader {
+    uint64_t m_magic;
+    uint64_t m_numLevels;
+};
+
 struct TpcFileHeader {
     uint64_t m_magic;
     uint64_t m_numEntries;
@@ -149,13 +149,16 @@ int CheckpointWorkerPool::Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd,
             if (stableRow == nullptr) {
                 break;
             } else {
-                if (!Write(buffer, stableRow, fd)) {
+                if (!IsDeltaChange(stableRow)) {
+                    wrote = 0;
+                } else if (!Write(buffer, stableRow, fd)) {
                     wrote = -1;
+                    break;
                 } else {
-                    CheckpointUtils::DestroyStableRow(stableRow);
-                    sentinel->SetStable(nullptr);
                     wrote = 1;
                 }
+                CheckpointUtils::DestroyStableRow(stableRow);
+                sentinel->SetStable(nullptr);
                 break;
             }
         } else { /* no stable version */
@@ -170,7 +173,9 @@ int CheckpointWorkerPool::Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd,
                     break;
                 }
                 sentinel->SetStableStatus(!m_na);
-                if (!Write(buffer, mainRow, fd)) {
+                if (!IsDeltaChange(mainRow)) {
+                    wrote = 0;
+                } else if (!Write(buffer, mainRow, fd)) {
                     wrote = -1;  // we failed to write, set error
                 } else {
                     wrote = 1;
@@ -409,6 +414,12 @@ void CheckpointWorkerPool::WorkerFunc()
                     break;
                 }
 
+                if (m_tombstones != nullptr && !WriteTombstones(&buffer, tableId, exId)) {
+                    m_cpManager.OnError(
+                        ErrCodes::FILE_IO, "Failed to write deleted keys for table - ", std::to_string(tableId).c_str());
+                    break;
+                }
+
                 taskSucceeded = true;
                 clock_gettime(CLOCK_MONOTONIC, &end);
                 /*
@@ -445,6 +456,78 @@ void CheckpointWorkerPool::WorkerFunc()
     MOT_LOG_DEBUG("thread exiting");
 }
 
+bool CheckpointWorkerPool::WriteTombstones(Buffer* buffer, uint32_t tableId, uint64_t exId)
+{
+    int fd = -1;
+    uint64_t numOps = 0;
+    std::string fileName;
+    CheckpointUtils::MakeDelFilename(tableId, fileName, m_workingDir);
+    if (!CheckpointUtils::OpenFileWrite(fileName, fd)) {
+        MOT_LOG_ERROR("CheckpointWorkerPool::WriteTombstones: failed to create file: %s", fileName.c_str());
+        return false;
+    }
+
+    bool ret = false;
+    do {
+        DeltaTombstoneMap::const_iterator it = m_tombstones->find(tableId);
+        if (it != m_tombstones->end()) {
+            numOps = it->second.size();
+        }
+
+        CheckpointUtils::FileHeader fileHeader{CP_MGR_MAGIC, tableId, exId, numOps};
+        if (CheckpointUtils::WriteFile(fd, (char*)&fileHeader, sizeof(CheckpointUtils::FileHeader)) !=
+            sizeof(CheckpointUtils::FileHeader)) {
+            MOT_LOG_ERROR("CheckpointWorkerPool::WriteTombstones: failed to write file header: %s", fileName.c_str());
+            break;
+        }
+
+        bool writeFailed = false;
+        if (numOps > 0) {
+            for (DeltaTombstone* tombstone : it->second) {
+                if (buffer->Size() + tombstone->m_keyLen + sizeof(CheckpointUtils::EntryHeader) > buffer->MaxSize()) {
+                    if (CheckpointUtils::WriteFile(fd, (char*)buffer->Data(), buffer->Size()) != buffer->Size()) {
+                        writeFailed = true;
+                        break;
+                    }
+                    buffer->Reset();
+                }
+                CheckpointUtils::EntryHeader entryHeader;
+                entryHeader.m_keyLen = tombstone->m_keyLen;
+                entryHeader.m_dataLen = 0;
+                entryHeader.m_csn = 0;
+                entryHeader.m_rowId = 0;
+                if (!buffer->Append(&entryHeader, sizeof(CheckpointUtils::EntryHeader)) ||
+                    !buffer->Append(tombstone->GetKeyBuf(), tombstone->m_keyLen)) {
+                    writeFailed = true;
+                    break;
+                }
+            }
+        }
+
+        if (!writeFailed && buffer->Size() > 0 &&
+            CheckpointUtils::WriteFile(fd, (char*)buffer->Data(), buffer->Size()) != buffer->Size()) {
+            writeFailed = true;
+        }
+        buffer->Reset();
+        if (writeFailed) {
+            MOT_LOG_ERROR("CheckpointWorkerPool::WriteTombstones: failed to write to file: %s", fileName.c_str());
+            break;
+        }
+
+        if (CheckpointUtils::FlushFile(fd)) {
+            MOT_LOG_ERROR("CheckpointWorkerPool::WriteTombstones: failed to flush file: %s", fileName.c_str());
+            break;
+        }
+        ret = true;
+    } while (0);
+
+    if (CheckpointUtils::CloseFile(fd)) {
+        MOT_LOG_ERROR("CheckpointWorkerPool::WriteTombstones: failed to close file: %s", fileName.c_str());
+        ret = false;
+    }
+    return ret;
+}
+
 bool CheckpointWorkerPool::BeginFile(int& fd, uint32_t tableId, int seg, uint64_t exId)
 {
     std::string fileName;
@@ -31,12 +31,30 @@
 #include <vector>
 #include <pthread.h>
 #include <list>
+#include <unordered_map>
 #include "global.h"
 #include "buffer.h"
 
 namespace MOT {
 const int CHECKPOINT_BUFFER_SIZE = 4096 * 1000;
 
+/**
+ * @struct DeltaTombstone
+ * @brief A primary key that was deleted since the previous checkpoint. The key bytes follow the structure.
+ */
+struct DeltaTombstone {
+    uint32_t m_tableId;
+    uint16_t m_keyLen;
+
+    inline char* GetKeyBuf()
+    {
+        return reinterpret_cast<char*>(this + 1);
+    }
+};
+
+/** @typedef Deleted keys of a delta checkpoint, grouped by table id. */
+typedef std::unordered_map<uint32_t, std::list<DeltaTombstone*>> DeltaTombstoneMap;
+
 /**
  * @class CheckpointManagerCallbacks
  * @brief This class describes the interface for callback methods
@@ -77,8 +95,16 @@ public:
  */
 class CheckpointWorkerPool {
 public:
-    CheckpointWorkerPool(int n, bool b, std::list<Table*>& l, uint32_t s, uint64_t id, CheckpointManagerCallbacks& m)
-        : m_numWorkers(n), m_tasksList(l), m_checkpointId(id), m_na(b), m_cpManager(m), m_checkpointSegsize(s)
+    CheckpointWorkerPool(int n, bool b, std::list<Table*>& l, uint32_t s, uint64_t id, CheckpointManagerCallbacks& m,
+        const DeltaTombstoneMap* tombstones = nullptr, uint64_t deltaMinCsn = 0)
+        : m_numWorkers(n),
+          m_tasksList(l),
+          m_checkpointId(id),
+          m_na(b),
+          m_cpManager(m),
+          m_checkpointSegsize(s),
+          m_tombstones(tombstones),
+          m_deltaMinCsn(deltaMinCsn)
     {
         Start();
     }
@@ -116,6 +142,26 @@ private:
      */
     int Checkpoint(Buffer* buffer, Sentinel* sentinel, int fd, int tid);
 
+    /**
+     * @brief Checks whether a row version belongs to the checkpoint. A full checkpoint writes
+     * all rows, a delta checkpoint writes only the rows committed since the previous checkpoint.
+     * @param row The row version to check.
+     * @return True if the row should be written.
+     */
+    inline bool IsDeltaChange(Row* row) const
+    {
+        return (m_tombstones == nullptr) || (row->GetCommitSequenceNumber() >= m_deltaMinCsn);
+    }
+
+    /**
+     * @brief Writes the keys deleted from a table since the previous checkpoint (delta checkpoint only).
+     * @param buffer The buffer to use.
+     * @param tableId The table id that is checkpointed.
+     * @param exId The table's external table id
+     * @return Boolean value denoting success or failure.
+     */
+    bool WriteTombstones(Buffer* buffer, uint32_t tableId, uint64_t exId);
+
     /**
      * @brief Pops a task (table pointer) from the tasks queue.
      * @return the address of the pop'd table, or nullptr if the queue was empty.
@@ -173,6 +219,12 @@ private:
 
     // Size threshold
     uint32_t m_checkpointSegsize;
+
+    // Deleted keys of a delta checkpoint, null for a full checkpoint
+    const DeltaTombstoneMap* m_tombstones;
+
+    // Rows committed with a lower CSN are not written by a delta checkpoint
+    uint64_t m_deltaMinCsn;
 };
 }  // namespace MOT
 
@@ -69,11 +69,23 @@ constexpr uint64_t MOTConfiguration::MAX_CHECKPOINT_SEGSIZE_BYTES;
 constexpr uint32_t MOTConfiguration::DEFAULT_CHECKPOINT_WORKERS;
 constexpr uint32_t MOTConfiguration::MIN_CHECKPOINT_WORKERS;
 constexpr uint32_t MOTConfiguration::MAX_CHECKPOINT_WORKERS;
+constexpr uint32_t MOTConfiguration::DEFAULT_CHECKPOINT_DELTA_INTERVAL;
+constexpr uint32_t MOTConfiguration::MIN_CHECKPOINT_DELTA_INTERVAL;
+constexpr uint32_t MOTConfiguration::MAX_CHECKPOINT_DELTA_INTERVAL;
+constexpr const char* MOTConfiguration::DEFAULT_CHECKPOINT_DELTA_BUFFER_SIZE;
+constexpr uint64_t MOTConfiguration::DEFAULT_CHECKPOINT_DELTA_BUFFER_SIZE_BYTES;
+constexpr uint64_t MOTConfiguration::MIN_CHECKPOINT_DELTA_BUFFER_SIZE_BYTES;
+constexpr uint64_t MOTConfiguration::MAX_CHECKPOINT_DELTA_BUFFER_SIZE_BYTES;
 // recovery configuration members
 constexpr uint32_t MOTConfiguration::DEFAULT_CHECKPOINT_RECOVERY_WORKERS;
 constexpr uint32_t MOTConfiguration::MIN_CHECKPOINT_RECOVERY_WORKERS;
 constexpr uint32_t MOTConfiguration::MAX_CHECKPOINT_RECOVERY_WORKERS;
+constexpr uint32_t MOTConfiguration::DEFAULT_REDO_RECOVERY_WORKERS;
+constexpr uint32_t MOTConfiguration::MIN_REDO_RECOVERY_WORKERS;
+constexpr uint32_t MOTConfiguration::MAX_REDO_RECOVERY_WORKERS;
 constexpr bool MOTConfiguration::DEFAULT_ENABLE_LOG_RECOVERY_STATS;
+// transaction configuration members
+constexpr bool MOTConfiguration::DEFAULT_ENABLE_SNAPSHOT_READS;
 // machine configuration members
 constexpr uint16_t MOTConfiguration::DEFAULT_NUMA_NODES;
 constexpr uint16_t MOTConfiguration::DEFAULT_CORES_PER_CPU;
@@ -178,6 +190,20 @@ constexpr uint32_t MOTConfiguration::MAX_MOT_CODEGEN_LIMIT;
 // storage configuration
 constexpr bool MOTConfiguration::DEFAULT_ALLOW_INDEX_ON_NULLABLE_COLUMN;
 constexpr IndexTreeFlavor MOTConfiguration::DEFAULT_INDEX_TREE_FLAVOR;
+constexpr uint32_t MOTConfiguration::DEFAULT_INDEX_BUILD_WORKERS;
+constexpr uint32_t MOTConfiguration::MIN_INDEX_BUILD_WORKERS;
+constexpr uint32_t MOTConfiguration::MAX_INDEX_BUILD_WORKERS;
+constexpr bool MOTConfiguration::DEFAULT_ENABLE_COLD_ROW_TIERING;
+constexpr const char* MOTConfiguration::DEFAULT_COLD_ROW_STORE_MAX_SIZE;
+constexpr uint64_t MOTConfiguration::DEFAULT_COLD_ROW_STORE_MAX_SIZE_MB;
+constexpr uint64_t MOTConfiguration::MIN_COLD_ROW_STORE_MAX_SIZE_MB;
+constexpr uint64_t MOTConfiguration::MAX_COLD_ROW_STORE_MAX_SIZE_MB;
+constexpr uint32_t MOTConfiguration::DEFAULT_COLD_ROW_MEMORY_THRESHOLD;
+constexpr uint32_t MOTConfiguration::MIN_COLD_ROW_MEMORY_THRESHOLD;
+constexpr uint32_t MOTConfiguration::MAX_COLD_ROW_MEMORY_THRESHOLD;
+constexpr uint32_t MOTConfiguration::DEFAULT_COLD_ROW_MIN_AGE_SECONDS;
+constexpr uint32_t MOTConfiguration::MIN_COLD_ROW_MIN_AGE_SECONDS;
+constexpr uint32_t MOTConfiguration::MAX_COLD_ROW_MIN_AGE_SECONDS;
 // general configuration members
 constexpr const char* MOTConfiguration::DEFAULT_CFG_MONITOR_PERIOD;
 constexpr uint64_t MOTConfiguration::DEFAULT_CFG_MONITOR_PERIOD_SECONDS;
@@ -450,7 +476,11 @@ MOTConfiguration::MOTConfiguration()
       m_checkpointDir(DEFAULT_CHECKPOINT_DIR),
       m_checkpointSegThreshold(DEFAULT_CHECKPOINT_SEGSIZE_BYTES),
       m_checkpointWorkers(DEFAULT_CHECKPOINT_WORKERS),
+      m_checkpointDeltaInterval(DEFAULT_CHECKPOINT_DELTA_INTERVAL),
+      m_checkpointDeltaBufferSize(DEFAULT_CHECKPOINT_DELTA_BUFFER_SIZE_BYTES),
       m_checkpointRecoveryWorkers(DEFAULT_CHECKPOINT_RECOVERY_WORKERS),
+      m_redoRecoveryWorkers(DEFAULT_REDO_RECOVERY_WORKERS),
+      m_enableSnapshotReads(DEFAULT_ENABLE_SNAPSHOT_READS),
       m_abortBufferEnable(true),
       m_preAbort(true),
       m_validationLock(TxnValidation::TXN_VALIDATION_NO_WAIT),
@@ -504,6 +534,11 @@ MOTConfiguration::MOTConfiguration()
       m_codegenLimit(DEFAULT_MOT_CODEGEN_LIMIT),
       m_allowIndexOnNullableColumn(DEFAULT_ALLOW_INDEX_ON_NULLABLE_COLUMN),
       m_indexTreeFlavor(DEFAULT_INDEX_TREE_FLAVOR),
+      m_indexBuildWorkers(DEFAULT_INDEX_BUILD_WORKERS),
+      m_enableColdRowTiering(DEFAULT_ENABLE_COLD_ROW_TIERING),
+      m_coldRowStoreMaxSizeMB(DEFAULT_COLD_ROW_STORE_MAX_SIZE_MB),
+      m_coldRowMemoryThreshold(DEFAULT_COLD_ROW_MEMORY_THRESHOLD),
+      m_coldRowMinAgeSeconds(DEFAULT_COLD_ROW_MIN_AGE_SECONDS),
       m_configMonitorPeriodSeconds(DEFAULT_CFG_MONITOR_PERIOD_SECONDS),
       m_runInternalConsistencyValidation(DEFAULT_RUN_INTERNAL_CONSISTENCY_VALIDATION),
       m_totalMemoryMb(DEFAULT_TOTAL_MEMORY_MB),
@@ -554,7 +589,11 @@ bool MOTConfiguration::SetFlag(const std::string& name, const std::string& value
     } else if (ParseString(name, "checkpoint_dir", value, &m_checkpointDir)) {
     } else if (ParseUint64(name, "checkpoint_segsize", value, &m_checkpointSegThreshold)) {
     } else if (ParseUint32(name, "checkpoint_workers", value, &m_checkpointWorkers)) {
+    } else if (ParseUint32(name, "checkpoint_delta_interval", value, &m_checkpointDeltaInterval)) {
+    } else if (ParseUint64(name, "checkpoint_delta_buffer_size", value, &m_checkpointDeltaBufferSize)) {
     } else if (ParseUint32(name, "checkpoint_recovery_workers", value, &m_checkpointRecoveryWorkers)) {
+    } else if (ParseUint32(name, "redo_recovery_workers", value, &m_redoRecoveryWorkers)) {
+    } else if (ParseBool(name, "enable_snapshot_reads", value, &m_enableSnapshotReads)) {
     } else if (ParseBool(name, "abort_buffer_enable", value, &m_abortBufferEnable)) {
     } else if (ParseBool(name, "pre_abort", value, &m_preAbort)) {
     } else if (ParseValidation(name, "validation_lock", value, &m_validationLock)) {
@@ -602,6 +641,11 @@ bool MOTConfiguration::SetFlag(const std::string& name, const std::string& value
     } else if (ParseUint32(name, "mot_codegen_limit", value, &m_codegenLimit)) {
     } else if (ParseBool(name, "allow_index_on_nullable_column", value, &m_allowIndexOnNullableColumn)) {
     } else if (ParseIndexTreeFlavor(name, "index_tree_flavor", value, &m_indexTreeFlavor)) {
+    } else if (ParseUint32(name, "index_build_workers", value, &m_indexBuildWorkers)) {
+    } else if (ParseBool(name, "enable_cold_row_tiering", value, &m_enableColdRowTiering)) {
+    } else if (ParseUint64(name, "cold_row_store_max_size_mb", value, &m_coldRowStoreMaxSizeMB)) {
+    } else if (ParseUint32(name, "cold_row_memory_threshold", value, &m_coldRowMemoryThreshold)) {
+    } else if (ParseUint32(name, "cold_row_min_age_seconds", value, &m_coldRowMinAgeSeconds)) {
     } else if (ParseUint64(name, "config_monitor_period_seconds", value, &m_configMonitorPeriodSeconds)) {
     } else if (ParseBool(name, "run_internal_consistency_validation", value, &m_runInternalConsistencyValidation)) {
     } else {
@@ -727,6 +771,17 @@ void MOTConfiguration::LoadConfig()
         DEFAULT_CHECKPOINT_WORKERS,
         MIN_CHECKPOINT_WORKERS,
         MAX_CHECKPOINT_WORKERS);
+    UPDATE_INT_CFG(m_checkpointDeltaInterval,
+        "checkpoint_delta_interval",
+        DEFAULT_CHECKPOINT_DELTA_INTERVAL,
+        MIN_CHECKPOINT_DELTA_INTERVAL,
+        MAX_CHECKPOINT_DELTA_INTERVAL);
+    UPDATE_ABS_MEM_CFG(m_checkpointDeltaBufferSize,
+        "checkpoint_delta_buffer_size",
+        DEFAULT_CHECKPOINT_DELTA_BUFFER_SIZE,
+        SCALE_BYTES,
+        MIN_CHECKPOINT_DELTA_BUFFER_SIZE_BYTES,
+        MAX_CHECKPOINT_DELTA_BUFFER_SIZE_BYTES);
 
     // Recovery configuration
     UPDATE_INT_CFG(m_checkpointRecoveryWorkers,
@@ -734,6 +789,14 @@ void MOTConfiguration::LoadConfig()
         DEFAULT_CHECKPOINT_RECOVERY_WORKERS,
         MIN_CHECKPOINT_RECOVERY_WORKERS,
         MAX_CHECKPOINT_RECOVERY_WORKERS);
+    UPDATE_INT_CFG(m_redoRecoveryWorkers,
+        "redo_recovery_workers",
+        DEFAULT_REDO_RECOVERY_WORKERS,
+        MIN_REDO_RECOVERY_WORKERS,
+        MAX_REDO_RECOVERY_WORKERS);
+
+    // Transaction configuration
+    UPDATE_BOOL_CFG(m_enableSnapshotReads, "enable_snapshot_reads", DEFAULT_ENABLE_SNAPSHOT_READS);
 
     // Tx configuration - not configurable yet
     UPDATE_BOOL_CFG(m_abortBufferEnable, "tx_abort_buffers_enable", true);
@@ -981,6 +1044,28 @@ void MOTConfiguration::LoadConfig()
     UPDATE_BOOL_CFG(
         m_allowIndexOnNullableColumn, "allow_index_on_nullable_column", DEFAULT_ALLOW_INDEX_ON_NULLABLE_COLUMN);
     UPDATE_USER_CFG(m_indexTreeFlavor, "index_tree_flavor", DEFAULT_INDEX_TREE_FLAVOR);
+    UPDATE_INT_CFG(m_indexBuildWorkers,
+        "index_build_workers",
+        DEFAULT_INDEX_BUILD_WORKERS,
+        MIN_INDEX_BUILD_WORKERS,
+        MAX_INDEX_BUILD_WORKERS);
+    UPDATE_BOOL_CFG(m_enableColdRowTiering, "enable_cold_row_tiering", DEFAULT_ENABLE_COLD_ROW_TIERING);
+    UPDATE_ABS_MEM_CFG(m_coldRowStoreMaxSizeMB,
+        "cold_row_store_max_size",
+        DEFAULT_COLD_ROW_STORE_MAX_SIZE,
+        SCALE_MEGA_BYTES,
+        MIN_COLD_ROW_STORE_MAX_SIZE_MB,
+        MAX_COLD_ROW_STORE_MAX_SIZE_MB);
+    UPDATE_INT_CFG(m_coldRowMemoryThreshold,
+        "cold_row_memory_threshold",
+        DEFAULT_COLD_ROW_MEMORY_THRESHOLD,
+        MIN_COLD_ROW_MEMORY_THRESHOLD,
+        MAX_COLD_ROW_MEMORY_THRESHOLD);
+    UPDATE_INT_CFG(m_coldRowMinAgeSeconds,
+        "cold_row_min_age_seconds",
+        DEFAULT_COLD_ROW_MIN_AGE_SECONDS,
+        MIN_COLD_ROW_MIN_AGE_SECONDS,
+        MAX_COLD_ROW_MIN_AGE_SECONDS);
 
     // general configuration
     UPDATE_TIME_CFG(m_configMonitorPeriodSeconds,
@@ -172,6 +172,12 @@ public:
     /** @var number of worker threads to spawn to perform checkpoint. */
     uint32_t m_checkpointWorkers;
 
+    /** @var Number of delta checkpoints taken between two full checkpoints (zero disables delta checkpoints). */
+    uint32_t m_checkpointDeltaInterval;
+
+    /** @var Size in bytes of each of the two buffers holding the keys deleted between delta checkpoints. */
+    uint64_t m_checkpointDeltaBufferSize;
+
     /**********************************************************************/
     // Recovery configuration
     /**********************************************************************/
@@ -179,6 +185,15 @@ public:
     /** @var Specifies the number of workers used to recover from checkpoint. */
     uint32_t m_checkpointRecoveryWorkers;
 
+    /** @var Specifies the number of workers used to replay committed redo transactions. */
+    uint32_t m_redoRecoveryWorkers;
+
+    /**********************************************************************/
+    // Transaction configuration
+    /**********************************************************************/
+    /** @var Enable multi-version snapshot reads for read-only transactions. */
+    bool m_enableSnapshotReads;
+
     /**********************************************************************/
     // Transaction management variables (not configurable)
     /**********************************************************************/
@@ -358,6 +373,21 @@ public:
     /** @var Specifies the tree flavor for tree indexes. */
     IndexTreeFlavor m_indexTreeFlavor;
 
+    /** @var Number of threads used to build a secondary index on a populated table. */
+    uint32_t m_indexBuildWorkers;
+
+    /** @var Specifies whether cold rows are moved out of MOT memory to the cold row store. */
+    bool m_enableColdRowTiering;
+
+    /** @var Maximum size of the cold row store file in mega-bytes. */
+    uint64_t m_coldRowStoreMaxSizeMB;
+
+    /** @var Percentage of the global memory limit above which cold rows are moved out. */
+    uint32_t m_coldRowMemoryThreshold;
+
+    /** @var Time in seconds a row must not be accessed before it is considered cold. */
+    uint32_t m_coldRowMinAgeSeconds;
+
     /**********************************************************************/
     // General configuration
     /**********************************************************************/
@@ -476,11 +506,30 @@ private:
     static constexpr uint32_t MIN_CHECKPOINT_WORKERS = 1;
     static constexpr uint32_t MAX_CHECKPOINT_WORKERS = 1024;
 
+    /** @var Default number of delta checkpoints between full checkpoints (every checkpoint is full). */
+    static constexpr uint32_t DEFAULT_CHECKPOINT_DELTA_INTERVAL = 0;
+    static constexpr uint32_t MIN_CHECKPOINT_DELTA_INTERVAL = 0;
+    static constexpr uint32_t MAX_CHECKPOINT_DELTA_INTERVAL = 64;
+
+    /** @var Default size of each deleted keys buffer of delta checkpoints. */
+    static constexpr const char* DEFAULT_CHECKPOINT_DELTA_BUFFER_SIZE = "16 MB";
+    static constexpr uint64_t DEFAULT_CHECKPOINT_DELTA_BUFFER_SIZE_BYTES = 16 * MEGA_BYTE;
+    static constexpr uint64_t MIN_CHECKPOINT_DELTA_BUFFER_SIZE_BYTES = 1 * MEGA_BYTE;
+    static constexpr uint64_t MAX_CHECKPOINT_DELTA_BUFFER_SIZE_BYTES = 1024 * MEGA_BYTE;
+
     /** ------------------ Default Recovery Configuration ------------ */
     /** @var Default number of workers used in recovery from checkpoint. */
     static constexpr uint32_t DEFAULT_CHECKPOINT_RECOVERY_WORKERS = 3;
     static constexpr uint32_t MIN_CHECKPOINT_RECOVERY_WORKERS = 1;
     static constexpr uint32_t MAX_CHECKPOINT_RECOVERY_WORKERS = 1024;
+    /** @var Default number of workers used to replay redo (replayed by the recovery thread if less than two). */
+    static constexpr uint32_t DEFAULT_REDO_RECOVERY_WORKERS = 1;
+    static constexpr uint32_t MIN_REDO_RECOVERY_WORKERS = 1;
+    static constexpr uint32_t MAX_REDO_RECOVERY_WORKERS = 256;
+
+    /** ------------------ Default Transaction Configuration ------------ */
+    /** @var Default enable snapshot reads. */
+    static constexpr bool DEFAULT_ENABLE_SNAPSHOT_READS = false;
 
     /** @var Default enable log recovery statistics. */
     static constexpr bool DEFAULT_ENABLE_LOG_RECOVERY_STATS = false;
@@ -686,6 +735,30 @@ private:
     /** @var The default tree flavor for tree indexes. */
     static constexpr IndexTreeFlavor DEFAULT_INDEX_TREE_FLAVOR = IndexTreeFlavor::INDEX_TREE_FLAVOR_MASSTREE;
 
+    /** @var Default number of index build workers. */
+    static constexpr uint32_t DEFAULT_INDEX_BUILD_WORKERS = 4;
+    static constexpr uint32_t MIN_INDEX_BUILD_WORKERS = 1;
+    static constexpr uint32_t MAX_INDEX_BUILD_WORKERS = 64;
+
+    /** @var Default enable cold row tiering. */
+    static constexpr bool DEFAULT_ENABLE_COLD_ROW_TIERING = false;
+
+    /** @var Default maximum size of the cold row store. */
+    static constexpr const char* DEFAULT_COLD_ROW_STORE_MAX_SIZE = "64 GB";
+    static constexpr uint64_t DEFAULT_COLD_ROW_STORE_MAX_SIZE_MB = 64 * KILO_BYTE;
+    static constexpr uint64_t MIN_COLD_ROW_STORE_MAX_SIZE_MB = 64;
+    static constexpr uint64_t MAX_COLD_ROW_STORE_MAX_SIZE_MB = 16 * MEGA_BYTE;  // 16 TB
+
+    /** @var Default memory usage percentage that triggers moving out cold rows. */
+    static constexpr uint32_t DEFAULT_COLD_ROW_MEMORY_THRESHOLD = 80;
+    static constexpr uint32_t MIN_COLD_ROW_MEMORY_THRESHOLD = 20;
+    static constexpr uint32_t MAX_COLD_ROW_MEMORY_THRESHOLD = 95;
+
+    /** @var Default time in seconds after which an unused row is considered cold. */
+    static constexpr uint32_t DEFAULT_COLD_ROW_MIN_AGE_SECONDS = 300;
+    static constexpr uint32_t MIN_COLD_ROW_MIN_AGE_SECONDS = 1;
+    static constexpr uint32_t MAX_COLD_ROW_MIN_AGE_SECONDS = 86400;
+
     /** ------------------ Default General Configuration ------------ */
     /** @var Default configuration monitor period in seconds. */
     static constexpr const char* DEFAULT_CFG_MONITOR_PERIOD = "5 seconds";
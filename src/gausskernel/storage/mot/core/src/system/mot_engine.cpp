@@ -81,6 +81,8 @@ MOTEngine::MOTEngine()
       m_sessionManager(nullptr),
       m_tableManager(nullptr),
       m_surrogateKeyManager(nullptr),
+      m_snapshotManager(nullptr),
+      m_coldRowStore(nullptr),
       m_recoveryManager(nullptr),
       m_redoLogHandler(nullptr),
       m_checkpointManager(nullptr)
@@ -365,6 +367,16 @@ bool MOTEngine::InitializeCoreServices()
         CHECK_INIT_STATUS(result, "Failed to Initialize surrogate key manager");
         m_initCoreStack.push(INIT_SURROGATE_KEY_MANAGER_PHASE);
 
+        result = InitializeSnapshotManager();
+        CHECK_INIT_STATUS(result, "Failed to Initialize snapshot manager");
+        m_initCoreStack.push(INIT_SNAPSHOT_MANAGER_PHASE);
+
+        if (GetGlobalConfiguration().m_enableColdRowTiering) {
+            result = InitializeColdRowStore();
+            CHECK_INIT_STATUS(result, "Failed to Initialize cold row store");
+            m_initCoreStack.push(INIT_COLD_ROW_STORE_PHASE);
+        }
+
         result = m_gcContext.Init();
         CHECK_INIT_STATUS(result, "Failed to Initialize garbage collection sub-system");
         m_initCoreStack.push(INIT_GC_PHASE);
@@ -427,6 +439,13 @@ bool MOTEngine::StartBackgroundTasks()
             MOT_LOG_INFO("Startup: Statistics reporter started");
             m_startBgStack.push(START_STAT_PRINT_PHASE);
         }
+
+        if (m_coldRowStore != nullptr) {
+            result = m_coldRowStore->Start();
+            CHECK_INIT_STATUS(result, "Failed to start the cold row eviction task");
+            MOT_LOG_INFO("Startup: Cold row eviction started");
+            m_startBgStack.push(START_COLD_ROW_EVICTOR_PHASE);
+        }
     } while (0);
 
     if (result) {
@@ -454,6 +473,14 @@ void MOTEngine::DestroyCoreServices()
             case INIT_GC_PHASE:
                 break;
 
+            case INIT_COLD_ROW_STORE_PHASE:
+                DestroyColdRowStore();
+                break;
+
+            case INIT_SNAPSHOT_MANAGER_PHASE:
+                DestroySnapshotManager();
+                break;
+
             case INIT_SURROGATE_KEY_MANAGER_PHASE:
                 DestroySurrogateKeyManager();
                 break;
@@ -536,6 +563,12 @@ void MOTEngine::StopBackgroundTasks()
 
     while (!m_startBgStack.empty()) {
         switch (m_startBgStack.top()) {
+            case START_COLD_ROW_EVICTOR_PHASE:
+                if (m_coldRowStore != nullptr) {
+                    m_coldRowStore->Stop();
+                }
+                break;
+
             case START_STAT_PRINT_PHASE:
                 if (GetGlobalConfiguration().m_enableStats) {
                     StatisticsManager::GetInstance().Stop();
@@ -730,6 +763,58 @@ bool MOTEngine::InitializeSurrogateKeyManager()
     return true;
 }
 
+bool MOTEngine::InitializeSnapshotManager()
+{
+    MOT_LOG_TRACE("Startup: Initializing snapshot manager");
+
+    if (m_snapshotManager != nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_INVALID_STATE, "MOT Engine Startup", "Double attempt to initialize snapshot manager");
+        return false;
+    }
+
+    m_snapshotManager = new (std::nothrow) SnapshotManager();
+    if (m_snapshotManager == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "MOT Engine Startup", "Failed to allocate memory for snapshot manager object");
+        return false;
+    }
+
+    if (!m_snapshotManager->Initialize(GetGlobalConfiguration().m_maxConnections)) {
+        MOT_REPORT_ERROR(MOT_ERROR_INTERNAL, "MOT Engine Startup", "Failed to Initialize the snapshot manager");
+        delete m_snapshotManager;
+        m_snapshotManager = nullptr;
+        return false;
+    }
+
+    MOT_LOG_TRACE("Startup: Snapshot manager initialized successfully");
+    return true;
+}
+
+bool MOTEngine::InitializeColdRowStore()
+{
+    MOT_LOG_TRACE("Startup: Initializing cold row store");
+
+    if (m_coldRowStore != nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_INVALID_STATE, "MOT Engine Startup", "Double attempt to initialize cold row store");
+        return false;
+    }
+
+    m_coldRowStore = new (std::nothrow) ColdRowStore();
+    if (m_coldRowStore == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "MOT Engine Startup", "Failed to allocate memory for cold row store object");
+        return false;
+    }
+
+    if (!m_coldRowStore->Initialize(GetGlobalConfiguration().m_coldRowStoreMaxSizeMB)) {
+        MOT_REPORT_ERROR(MOT_ERROR_INTERNAL, "MOT Engine Startup", "Failed to Initialize the cold row store");
+        delete m_coldRowStore;
+        m_coldRowStore = nullptr;
+        return false;
+    }
+
+    MOT_LOG_TRACE("Startup: Cold row store initialized successfully");
+    return true;
+}
+
 bool MOTEngine::InitializeRecoveryManager()
 {
     MOT_LOG_TRACE("Initializing the Recovery Manager");
@@ -881,6 +966,32 @@ void MOTEngine::DestroySurrogateKeyManager()
     MOT_LOG_INFO("Shutdown: Key surrogate manager destroyed");
 }
 
+void MOTEngine::DestroySnapshotManager()
+{
+    MOT_LOG_TRACE("Shutdown: Destroying snapshot manager");
+
+    if (m_snapshotManager != nullptr) {
+        m_snapshotManager->Destroy();
+        delete m_snapshotManager;
+        m_snapshotManager = nullptr;
+    }
+
+    MOT_LOG_INFO("Shutdown: Snapshot manager destroyed");
+}
+
+void MOTEngine::DestroyColdRowStore()
+{
+    MOT_LOG_TRACE("Shutdown: Destroying cold row store");
+
+    if (m_coldRowStore != nullptr) {
+        m_coldRowStore->Destroy();
+        delete m_coldRowStore;
+        m_coldRowStore = nullptr;
+    }
+
+    MOT_LOG_INFO("Shutdown: Cold row store destroyed");
+}
+
 void MOTEngine::DestroyRecoveryManager()
 {
     MOT_LOG_INFO("Destroying the Recovery Manager");
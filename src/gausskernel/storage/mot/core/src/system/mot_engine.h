@@ -41,6 +41,8 @@
 #include "table_manager.h"
 #include "session_manager.h"
 #include "surrogate_key_manager.h"
+#include "snapshot_manager.h"
+#include "cold_row_store.h"
 #include "gc_context.h"
 #include "mot_atomic_ops.h"
 
@@ -170,6 +172,18 @@ public:
         return m_surrogateKeyManager;
     }
 
+    /** @brief Retrieves the snapshot manager. */
+    inline SnapshotManager* GetSnapshotManager()
+    {
+        return m_snapshotManager;
+    }
+
+    /** @brief Retrieves the cold row store (null if cold row tiering is disabled). */
+    inline ColdRowStore* GetColdRowStore()
+    {
+        return m_coldRowStore;
+    }
+
     /**
      * @brief Retrieves the affinity configuration for user sessions.
      * @return The affinity configuration for user sessions.
@@ -468,6 +482,12 @@ private:
     /** @brief Initializes the surrogate key manager. */
     bool InitializeSurrogateKeyManager();
 
+    /** @brief Initializes the snapshot manager. */
+    bool InitializeSnapshotManager();
+
+    /** @brief Initializes the cold row store. */
+    bool InitializeColdRowStore();
+
     /** @brief Initializes the recovery manager. */
     bool InitializeRecoveryManager();
 
@@ -492,6 +512,12 @@ private:
     /** @brief Destroys the surrogate key manager. */
     void DestroySurrogateKeyManager();
 
+    /** @brief Destroys the snapshot manager. */
+    void DestroySnapshotManager();
+
+    /** @brief Destroys the cold row store. */
+    void DestroyColdRowStore();
+
     /** @brief Destroys the recovery manager. */
     void DestroyRecoveryManager();
 
@@ -534,6 +560,12 @@ private:
     /** @var The surrogate key manager. */
     SurrogateKeyManager* m_surrogateKeyManager;
 
+    /** @var The snapshot manager. */
+    SnapshotManager* m_snapshotManager;
+
+    /** @var The cold row store. */
+    ColdRowStore* m_coldRowStore;
+
     /** @var The recovery manager. */
     RecoveryManager* m_recoveryManager;
 
@@ -563,6 +595,8 @@ private:
         INIT_SESSION_MANAGER_PHASE,
         INIT_TABLE_MANAGER_PHASE,
         INIT_SURROGATE_KEY_MANAGER_PHASE,
+        INIT_SNAPSHOT_MANAGER_PHASE,
+        INIT_COLD_ROW_STORE_PHASE,
         INIT_GC_PHASE,
         INIT_DEBUG_UTILS,
         INIT_CORE_DONE
@@ -578,7 +612,7 @@ private:
     };
     stack<InitAppPhase> m_initAppStack;
 
-    enum StartBgTaskPhase { START_STAT_PRINT_PHASE, START_BG_TASK_DONE };
+    enum StartBgTaskPhase { START_STAT_PRINT_PHASE, START_COLD_ROW_EVICTOR_PHASE, START_BG_TASK_DONE };
     stack<StartBgTaskPhase> m_startBgStack;
 
     /**
@@ -629,6 +663,18 @@ inline SurrogateKeyManager* GetSurrogateKeyManager()
     return MOTEngine::GetInstance()->GetSurrogateKeyManager();
 }
 
+/** @brief Retrieves the snapshot manager. */
+inline SnapshotManager* GetSnapshotManager()
+{
+    return MOTEngine::GetInstance()->GetSnapshotManager();
+}
+
+/** @brief Retrieves the cold row store. */
+inline ColdRowStore* GetColdRowStore()
+{
+    return MOTEngine::GetInstance()->GetColdRowStore();
+}
+
 /** @brief Retrieves the recovery manager. */
 inline RecoveryManager* GetRecoveryManager()
 {
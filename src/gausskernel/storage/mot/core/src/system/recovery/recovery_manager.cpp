@@ -83,19 +83,19 @@ void RecoveryManager::OnError(int errCode, const char* errMsg, const char* optio
     m_errorLock.unlock();
 }
 
-int RecoveryManager::FillTasksFromMapFile()
+int RecoveryManager::ReadMapFile(uint64_t checkpointId, std::map<uint32_t, uint32_t>& tables)
 {
-    if (m_checkpointId == CheckpointControlFile::invalidId) {
+    if (checkpointId == CheckpointControlFile::invalidId) {
         return 0;  // fresh install probably. no error
     }
 
     std::string mapFile;
-    CheckpointUtils::MakeMapFilename(mapFile, m_workingDir, m_checkpointId);
+    CheckpointUtils::MakeMapFilename(mapFile, m_workingDir, checkpointId);
     int fd = -1;
     if (!CheckpointUtils::OpenFileRead(mapFile, fd)) {
-        MOT_LOG_ERROR("RecoveryManager::fillTasksFromMapFile: failed to open map file '%s'", mapFile.c_str());
+        MOT_LOG_ERROR("RecoveryManager::ReadMapFile: failed to open map file '%s'", mapFile.c_str());
         OnError(RecoveryManager::ErrCodes::CP_SETUP,
-            "RecoveryManager::fillTasksFromMapFile: failed to open map file: ",
+            "RecoveryManager::ReadMapFile: failed to open map file: ",
             mapFile.c_str());
         return -1;
     }
@@ -103,19 +103,19 @@ int RecoveryManager::FillTasksFromMapFile()
     CheckpointUtils::MapFileHeader mapFileHeader;
     if (CheckpointUtils::ReadFile(fd, (char*)&mapFileHeader, sizeof(CheckpointUtils::MapFileHeader)) !=
         sizeof(CheckpointUtils::MapFileHeader)) {
-        MOT_LOG_ERROR("RecoveryManager::fillTasksFromMapFile: failed to read map file '%s' header", mapFile.c_str());
+        MOT_LOG_ERROR("RecoveryManager::ReadMapFile: failed to read map file '%s' header", mapFile.c_str());
         CheckpointUtils::CloseFile(fd);
         OnError(RecoveryManager::ErrCodes::CP_SETUP,
-            "RecoveryManager::fillTasksFromMapFile: failed to read map file: ",
+            "RecoveryManager::ReadMapFile: failed to read map file: ",
             mapFile.c_str());
         return -1;
     }
 
     if (mapFileHeader.m_magic != CP_MGR_MAGIC) {
-        MOT_LOG_ERROR("RecoveryManager::fillTasksFromMapFile: failed to verify map file'%s'", mapFile.c_str());
+        MOT_LOG_ERROR("RecoveryManager::ReadMapFile: failed to verify map file'%s'", mapFile.c_str());
         CheckpointUtils::CloseFile(fd);
         OnError(RecoveryManager::ErrCodes::CP_SETUP,
-            "RecoveryManager::fillTasksFromMapFile: failed to verify map file: ",
+            "RecoveryManager::ReadMapFile: failed to verify map file: ",
             mapFile.c_str());
         return -1;
     }
@@ -125,51 +125,130 @@ int RecoveryManager::FillTasksFromMapFile()
         if (CheckpointUtils::ReadFile(fd, (char*)&entry, sizeof(CheckpointManager::MapFileEntry)) !=
             sizeof(CheckpointManager::MapFileEntry)) {
             MOT_LOG_ERROR(
-                "RecoveryManager::fillTasksFromMapFile: failed to read map file '%s' entry: %lu", mapFile.c_str(), i);
+                "RecoveryManager::ReadMapFile: failed to read map file '%s' entry: %lu", mapFile.c_str(), i);
             CheckpointUtils::CloseFile(fd);
             OnError(RecoveryManager::ErrCodes::CP_SETUP,
-                "RecoveryManager::fillTasksFromMapFile: failed to read map file entry ",
+                "RecoveryManager::ReadMapFile: failed to read map file entry ",
                 mapFile.c_str());
             return -1;
         }
 
-        if (m_tableIds.find(entry.m_id) == m_tableIds.end()) {
-            m_tableIds.insert(entry.m_id);
+        tables[entry.m_id] = entry.m_numSegs;
+    }
+
+    CheckpointUtils::CloseFile(fd);
+    MOT_LOG_DEBUG("RecoveryManager::ReadMapFile: read %lu tables from map file %lu", tables.size(), checkpointId);
+    return 1;
+}
+
+bool RecoveryManager::FillTasks(const std::map<uint32_t, uint32_t>& tables, uint64_t levelId, bool remove)
+{
+    for (auto it = tables.begin(); it != tables.end(); ++it) {
+        // tables that were dropped after this level was written are not recovered
+        if (m_tableIds.find(it->first) == m_tableIds.end()) {
+            continue;
         }
 
-        for (uint32_t i = 0; i <= entry.m_numSegs; i++) {
+        // a removal task handles all the segments of its table, so that keys deleted and
+        // re-inserted after the previous level are never removed concurrently
+        uint32_t numTasks = remove ? 0 : it->second;
+        for (uint32_t i = 0; i <= numTasks; i++) {
             RecoveryTask* recoveryTask = new (std::nothrow) RecoveryTask();
             if (recoveryTask == nullptr) {
-                CheckpointUtils::CloseFile(fd);
                 OnError(RecoveryManager::ErrCodes::CP_SETUP,
-                    "RecoveryManager::fillTasksFromMapFile: failed to allocate task object");
-                return -1;
+                    "RecoveryManager::FillTasks: failed to allocate task object");
+                return false;
             }
-            recoveryTask->m_id = entry.m_id;
-            recoveryTask->m_seg = i;
+            recoveryTask->m_id = it->first;
+            recoveryTask->m_seg = remove ? it->second : i;
+            recoveryTask->m_levelId = levelId;
+            recoveryTask->m_remove = remove;
             m_tasksList.push_back(recoveryTask);
         }
     }
 
+    MOT_LOG_DEBUG("RecoveryManager::FillTasks: filled %lu tasks (level %lu, %s)",
+        m_tasksList.size(),
+        levelId,
+        remove ? "remove" : "insert");
+    return true;
+}
+
+bool RecoveryManager::ReadCheckpointChain()
+{
+    m_checkpointChain.clear();
+    std::string chainFile;
+    CheckpointUtils::MakeChainFilename(chainFile, m_workingDir, m_checkpointId);
+    if (!CheckpointUtils::FileExists(chainFile)) {
+        // a full checkpoint
+        m_checkpointChain.push_back(m_checkpointId);
+        return true;
+    }
+
+    int fd = -1;
+    if (!CheckpointUtils::OpenFileRead(chainFile, fd)) {
+        MOT_LOG_ERROR("RecoveryManager::ReadCheckpointChain: failed to open chain file '%s'", chainFile.c_str());
+        OnError(RecoveryManager::ErrCodes::CP_SETUP,
+            "RecoveryManager::ReadCheckpointChain: failed to open chain file: ",
+            chainFile.c_str());
+        return false;
+    }
+
+    bool ret = false;
+    do {
+        CheckpointUtils::ChainFileHeader chainFileHeader;
+        if (CheckpointUtils::ReadFile(fd, (char*)&chainFileHeader, sizeof(CheckpointUtils::ChainFileHeader)) !=
+            sizeof(CheckpointUtils::ChainFileHeader)) {
+            MOT_LOG_ERROR("RecoveryManager::ReadCheckpointChain: failed to read chain file '%s' header",
+                chainFile.c_str());
+            break;
+        }
+
+        if (chainFileHeader.m_magic != CP_MGR_MAGIC || chainFileHeader.m_numLevels == 0) {
+            MOT_LOG_ERROR("RecoveryManager::ReadCheckpointChain: failed to verify chain file '%s'", chainFile.c_str());
+            break;
+        }
+
+        uint64_t levelId = 0;
+        bool readFailed = false;
+        for (uint64_t i = 0; i < chainFileHeader.m_numLevels; i++) {
+            if (CheckpointUtils::ReadFile(fd, (char*)&levelId, sizeof(uint64_t)) != sizeof(uint64_t)) {
+                readFailed = true;
+                break;
+            }
+            m_checkpointChain.push_back(levelId);
+        }
+
+        if (readFailed || m_checkpointChain.back() != m_checkpointId) {
+            MOT_LOG_ERROR("RecoveryManager::ReadCheckpointChain: invalid chain file '%s'", chainFile.c_str());
+            break;
+        }
+        ret = true;
+    } while (0);
+
     CheckpointUtils::CloseFile(fd);
-    MOT_LOG_DEBUG("RecoveryManager::fillTasksFromMapFile: filled %lu tasks", m_tasksList.size());
-    return 1;
+    if (!ret) {
+        OnError(RecoveryManager::ErrCodes::CP_SETUP,
+            "RecoveryManager::ReadCheckpointChain: failed to read chain file: ",
+            chainFile.c_str());
+    }
+    return ret;
 }
 
-bool RecoveryManager::GetTask(uint32_t& tableId, uint32_t& seg)
+
+bool RecoveryManager::GetTask(RecoveryTask& task)
 {
     bool ret = false;
-    RecoveryTask* task = nullptr;
+    RecoveryTask* front = nullptr;
     do {
         m_tasksLock.lock();
         if (m_tasksList.empty()) {
             break;
         }
-        task = m_tasksList.front();
-        tableId = task->m_id;
-        seg = task->m_seg;
+        front = m_tasksList.front();
+        task = *front;
         m_tasksList.pop_front();
-        delete task;
+        delete front;
         ret = true;
     } while (0);
     m_tasksLock.unlock();
@@ -235,20 +314,44 @@ bool RecoveryManager::RecoverTableMetadata(uint32_t tableId)
     return (status == RC_OK);
 }
 
-bool RecoveryManager::RecoverTableRows(uint32_t tableId, uint32_t seg, uint32_t tid, char* keyData, char* entryData,
+bool RecoveryManager::RecoverTableRows(const RecoveryTask& task, uint32_t tid, char* keyData, char* entryData,
     uint64_t& maxCsn, SurrogateState& sState)
 {
-    RC status = RC_OK;
-    int fd = -1;
     Table* table = nullptr;
-
-    if (!GetRecoveryManager()->FetchTable(tableId, table)) {
-        MOT_REPORT_ERROR(MOT_ERROR_INTERNAL, "RecoveryManager::recoverTableRows", "Table %llu does not exist", tableId);
+    if (!GetRecoveryManager()->FetchTable(task.m_id, table)) {
+        MOT_REPORT_ERROR(MOT_ERROR_INTERNAL, "RecoveryManager::recoverTableRows", "Table %u does not exist", task.m_id);
         return false;
     }
 
+    // files of older levels were linked into the recovered checkpoint with their checkpoint id as prefix
+    uint64_t prefix = (task.m_levelId == m_checkpointId) ? 0 : task.m_levelId;
     std::string fileName;
-    CheckpointUtils::MakeCpFilename(tableId, fileName, m_workingDir, seg);
+    if (!task.m_remove) {
+        CheckpointUtils::MakeCpFilename(task.m_id, fileName, m_workingDir, task.m_seg, prefix);
+        return RecoverTableFile(table, fileName, false, tid, keyData, entryData, maxCsn, sState);
+    }
+
+    // remove the keys deleted since the previous level and the keys that this level re-writes
+    CheckpointUtils::MakeDelFilename(task.m_id, fileName, m_workingDir, prefix);
+    if (!RecoverTableFile(table, fileName, true, tid, keyData, entryData, maxCsn, sState)) {
+        return false;
+    }
+    for (uint32_t seg = 0; seg <= task.m_seg; seg++) {
+        CheckpointUtils::MakeCpFilename(task.m_id, fileName, m_workingDir, seg, prefix);
+        if (!RecoverTableFile(table, fileName, true, tid, keyData, entryData, maxCsn, sState)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool RecoveryManager::RecoverTableFile(Table* table, const std::string& fileName, bool remove, uint32_t tid,
+    char* keyData, char* entryData, uint64_t& maxCsn, SurrogateState& sState)
+{
+    RC status = RC_OK;
+    int fd = -1;
+    uint32_t tableId = table->GetTableId();
+
     if (!CheckpointUtils::OpenFileRead(fileName, fd)) {
         MOT_LOG_ERROR("RecoveryManager::recoverTableRows: failed to open file: %s", fileName.c_str());
         return false;
@@ -323,6 +426,17 @@ bool RecoveryManager::RecoverTableRows(uint32_t tableId, uint32_t seg, uint32_t
             break;
         }
 
+        if (remove) {
+            RemoveRowFromCheckpoint(table, keyData, entry.m_keyLen, tid, status);
+            if (status != RC_OK) {
+                MOT_LOG_ERROR("Failed to remove row during delta checkpoint recovery: %s (error code: %d)",
+                    RcToString(status),
+                    (int)status);
+                break;
+            }
+            continue;
+        }
+
         InsertRowFromCheckpoint(table,
             keyData,
             entry.m_keyLen,
@@ -344,11 +458,12 @@ bool RecoveryManager::RecoverTableRows(uint32_t tableId, uint32_t seg, uint32_t
     }
     CheckpointUtils::CloseFile(fd);
 
-    MOT_LOG_DEBUG("[%u] RecoveryManager::recoverTableRows table %u:%u, %lu rows recovered (%s)",
+    MOT_LOG_DEBUG("[%u] RecoveryManager::recoverTableRows table %u: %s, %lu rows %s (%s)",
         tid,
         tableId,
-        seg,
+        fileName.c_str(),
         fileHeader.m_numOps,
+        remove ? "removed" : "recovered",
         status == RC_OK ? "OK" : "Error");
 
     return (status == RC_OK);
@@ -394,14 +509,13 @@ void RecoveryManager::CpWorkerFunc()
 
     uint64_t maxCsn = 0;
     while (GetRecoveryManager()->GetCheckpointWorkerStop() == false) {
-        uint32_t tableId = 0;
-        uint32_t seg = 0;
-        if (GetTask(tableId, seg)) {
-            if (!RecoverTableRows(tableId, seg, MOTCurrThreadId, keyData, entryData, maxCsn, sState)) {
-                MOT_LOG_ERROR("RecoveryManager::workerFunc recovery of table %lu's data failed", tableId);
+        RecoveryTask task;
+        if (GetTask(task)) {
+            if (!RecoverTableRows(task, MOTCurrThreadId, keyData, entryData, maxCsn, sState)) {
+                MOT_LOG_ERROR("RecoveryManager::workerFunc recovery of table %u's data failed", task.m_id);
                 GetRecoveryManager()->OnError(MOT::RecoveryManager::ErrCodes::CP_RECOVERY,
                     "RecoveryManager::workerFunc failed to recover table: ",
-                    std::to_string(tableId).c_str());
+                    std::to_string(task.m_id).c_str());
                 break;
             }
         } else {
@@ -462,7 +576,8 @@ bool RecoveryManager::RecoverFromCheckpoint()
         }
     }
 
-    int taskFillStat = FillTasksFromMapFile();
+    std::map<uint32_t, uint32_t> tables;
+    int taskFillStat = ReadMapFile(m_checkpointId, tables);
     if (taskFillStat < 0) {
         MOT_LOG_INFO("RecoveryManager:: failed to read map file");
         return false;                // error was already set
@@ -470,6 +585,15 @@ bool RecoveryManager::RecoverFromCheckpoint()
         return true;
     }
 
+    // the recovered checkpoint holds the metadata of all the tables, even in a delta chain
+    for (auto it = tables.begin(); it != tables.end(); ++it) {
+        m_tableIds.insert(it->first);
+    }
+
+    if (!ReadCheckpointChain()) {
+        return false;  // error was already set
+    }
+
     if (m_tableIds.size() > 0 && GetGlobalConfiguration().m_enableIncrementalCheckpoint) {
         MOT_LOG_ERROR("RecoveryManager::recoverFromCheckpoint: recovery of MOT "
                       "tables failed. MOT does not support incremental checkpoint");
@@ -504,6 +628,52 @@ bool RecoveryManager::RecoverFromCheckpoint()
         return false;
     }
 
+    // Load the full checkpoint and then each delta level in order. Every delta level first removes
+    // the keys it deletes or re-writes and then inserts its rows, the tables of a level are loaded in
+    // parallel.
+    std::map<uint32_t, uint32_t> levelTables;
+    for (size_t level = 0; level < m_checkpointChain.size(); ++level) {
+        uint64_t levelId = m_checkpointChain[level];
+        if (levelId != m_checkpointId) {
+            levelTables.clear();
+            if (ReadMapFile(levelId, levelTables) <= 0) {
+                MOT_LOG_ERROR("RecoveryManager:: failed to read map file of checkpoint %lu", levelId);
+                return false;  // error was already set
+            }
+        }
+        const std::map<uint32_t, uint32_t>& levelMap = (levelId == m_checkpointId) ? tables : levelTables;
+
+        if (level > 0) {
+            MOT_LOG_INFO("RecoverFromCheckpoint: applying delta checkpoint %lu (%u/%u)",
+                levelId,
+                (uint32_t)level,
+                (uint32_t)(m_checkpointChain.size() - 1));
+            if (!FillTasks(levelMap, levelId, true) || !RunCheckpointTasks()) {
+                return false;
+            }
+        }
+
+        if (!FillTasks(levelMap, levelId, false) || !RunCheckpointTasks()) {
+            return false;
+        }
+    }
+
+    if (!RecoverTpcFromCheckpoint()) {
+        MOT_LOG_ERROR("RecoveryManager:: failed to recover in-process transactions from checkpoint");
+        return false;
+    }
+
+    MOT_LOG_INFO("RecoverFromCheckpoint: finished recovering %lu tables from checkpoint id: %lu",
+        m_tableIds.size(),
+        m_checkpointId);
+
+    m_tableIds.clear();
+    MOTEngine::GetInstance()->GetCheckpointManager()->RemoveOldCheckpoints(m_checkpointId);
+    return true;
+}
+
+bool RecoveryManager::RunCheckpointTasks()
+{
     std::vector<std::thread> recoveryThreadPool;
     for (uint32_t i = 0; i < m_numWorkers; ++i) {
         recoveryThreadPool.push_back(std::thread(&RecoveryManager::CpWorkerFunc, this));
@@ -525,18 +695,6 @@ bool RecoveryManager::RecoverFromCheckpoint()
         MOT_LOG_ERROR("RecoveryManager:: failed to recover from checkpoint, tasks finished with error");
         return false;
     }
-
-    if (!RecoverTpcFromCheckpoint()) {
-        MOT_LOG_ERROR("RecoveryManager:: failed to recover in-process transactions from checkpoint");
-        return false;
-    }
-
-    MOT_LOG_INFO("RecoverFromCheckpoint: finished recovering %lu tables from checkpoint id: %lu",
-        m_tableIds.size(),
-        m_checkpointId);
-
-    m_tableIds.clear();
-    MOTEngine::GetInstance()->GetCheckpointManager()->RemoveOldCheckpoints(m_checkpointId);
     return true;
 }
 
@@ -544,20 +702,25 @@ bool RecoveryManager::RecoverDbStart()
 {
     MOT_LOG_INFO("Starting MOT recovery");
 
-    if (m_recoverFromCkptDone) {
-        return true;
+    if (!m_recoverFromCkptDone) {
+        if (!RecoverFromCheckpoint()) {
+            return false;
+        }
+        m_recoverFromCkptDone = true;
     }
 
-    if (!RecoverFromCheckpoint()) {
+    if (!m_replayDispatcher.IsActive() && !m_replayDispatcher.Start(GetGlobalConfiguration().m_redoRecoveryWorkers)) {
+        MOT_LOG_ERROR("Failed to start redo replay workers");
         return false;
     }
-
-    m_recoverFromCkptDone = true;
     return true;
 }
 
 bool RecoveryManager::RecoverDbEnd()
 {
+    // all the committed transactions must be replayed before the in-process ones are resolved
+    m_replayDispatcher.Stop();
+
     if (ApplyInProcessTransactions() != RC_OK) {
         MOT_LOG_ERROR("applyInProcessTransactions failed!");
         return false;
@@ -728,13 +891,29 @@ bool RecoveryManager::OperateOnRecoveredTransaction(
         if (rState != RecoveryOpState::ABORT) {
             LogSegment* segment = segments->GetSegment(segments->GetCount() - 1);
             uint64_t csn = segment->m_controlBlock.m_csn;
-            for (uint32_t i = 0; i < segments->GetCount(); i++) {
-                segment = segments->GetSegment(i);
-                status = RedoSegment(segment, csn, internalTransactionId, rState);
-                if (status != RC_OK) {
-                    OnError(RecoveryManager::ErrCodes::XLOG_RECOVERY,
-                        "RecoveryManager::commitRecoveredTransaction: wal recovery failed");
-                    return false;
+            RedoReplayDispatcher::Task* task = nullptr;
+            if (rState == RecoveryOpState::COMMIT && m_replayDispatcher.IsActive()) {
+                task = m_replayDispatcher.CreateTask(
+                    segments->GetSegments(), segments->GetCount(), csn, internalTransactionId);
+            }
+            if (task != nullptr) {
+                // the workers release the segments once the transaction is replayed
+                (void)segments->Detach();
+                m_replayDispatcher.Submit(task);
+            } else {
+                // DDL and other non-partitioned transactions must observe all the preceding ones
+                m_replayDispatcher.Drain();
+                for (uint32_t i = 0; i < segments->GetCount(); i++) {
+                    segment = segments->GetSegment(i);
+                    status = RedoSegment(segment, csn, internalTransactionId, rState);
+                    if (status != RC_OK) {
+                        OnError(RecoveryManager::ErrCodes::XLOG_RECOVERY,
+                            "RecoveryManager::commitRecoveredTransaction: wal recovery failed");
+                        return false;
+                    }
+                }
+                if (m_replayDispatcher.IsActive()) {
+                    m_replayDispatcher.OnSerialReplay();
                 }
             }
         }
@@ -25,6 +25,7 @@
 #ifndef RECOVERY_MANAGER_H
 #define RECOVERY_MANAGER_H
 
+#include <map>
 #include <set>
 #include <vector>
 #include "checkpoint_ctrlfile.h"
@@ -33,6 +34,7 @@
 #include "txn.h"
 #include "global.h"
 #include "mot_configuration.h"
+#include "redo_replay_dispatcher.h"
 
 namespace MOT {
 typedef TxnCommitStatus (*commitLogStatusCallback)(uint64_t);
@@ -43,6 +45,8 @@ typedef TxnCommitStatus (*commitLogStatusCallback)(uint64_t);
  * a checkpoint, xlog and 2 pc operations
  */
 class RecoveryManager {
+    friend class RedoReplayDispatcher;
+
 public:
     class SurrogateState;
 
@@ -156,6 +160,25 @@ private:
             return m_segments[index];
         }
 
+        LogSegment** GetSegments() const
+        {
+            return m_segments;
+        }
+
+        /**
+         * @brief Hands the segment array over to the caller, which becomes responsible for releasing it.
+         * @return The malloc-ed segment array.
+         */
+        LogSegment** Detach()
+        {
+            LogSegment** segments = m_segments;
+            m_segments = nullptr;
+            m_count = 0;
+            m_size = 0;
+            m_maxSegments = 0;
+            return segments;
+        }
+
     private:
         static constexpr uint32_t DEFAULT_SEGMENT_NUM = 1024;
 
@@ -194,6 +217,25 @@ public:
     {}
 
 private:
+    /**
+     * @struct RecoveryTask
+     * @brief Describes a recovery task by its table id and
+     * segment file number.
+     */
+    struct RecoveryTask {
+        uint32_t m_id;
+        uint32_t m_seg;
+
+        /** @var The checkpoint of the delta chain that wrote the files. */
+        uint64_t m_levelId;
+
+        /**
+         * @var Removes the keys found in the deleted keys file and in segments 0..m_seg
+         * instead of inserting rows (delta checkpoint levels only).
+         */
+        bool m_remove;
+    };
+
     /**
      * @brief Recovers the database state from the last valid
      * checkpoint
@@ -207,9 +249,9 @@ private:
     void CpWorkerFunc();
 
     /**
-     * @brief Reads and inserts rows from a checkpoint file
-     * @param tableId The table id to recover.
-     * @param seg Segment file number to recover from.
+     * @brief Performs a recovery task: inserts the rows of a checkpoint segment file, or
+     * removes the keys that a delta checkpoint level replaces or deletes.
+     * @param task The task to perform.
      * @param tid The current thread id
      * @param keyData The key buffer to use.
      * @param entryData The row buffer to use.
@@ -218,8 +260,24 @@ private:
      * during the recovery
      * @return Boolean value denoting success or failure.
      */
-    bool RecoverTableRows(uint32_t tableId, uint32_t seg, uint32_t tid, char* keyData, char* entryData,
-        uint64_t& maxCsn, SurrogateState& sState);
+    bool RecoverTableRows(const RecoveryTask& task, uint32_t tid, char* keyData, char* entryData, uint64_t& maxCsn,
+        SurrogateState& sState);
+
+    /**
+     * @brief Reads a checkpoint data file and inserts (or removes) its rows
+     * @param table The table to recover.
+     * @param fileName The file to read.
+     * @param remove Removes the rows with the keys found in the file instead of inserting them.
+     * @param tid The current thread id
+     * @param keyData The key buffer to use.
+     * @param entryData The row buffer to use.
+     * @param maxCsn The returned maxCsn encountered during the recovery.
+     * @param sState Surrogate key state structure that will be filled
+     * during the recovery
+     * @return Boolean value denoting success or failure.
+     */
+    bool RecoverTableFile(Table* table, const std::string& fileName, bool remove, uint32_t tid, char* keyData,
+        char* entryData, uint64_t& maxCsn, SurrogateState& sState);
 
     /**
      * @brief Reads and creates a table's defenition from a checkpoint
@@ -232,19 +290,40 @@ private:
     /**
      * @brief Pops a taske (table id and seg number) from the
      * tasks queue.
-     * @param tableId The returned table id to recover.
-     * @param seg the returned segment number.
+     * @param task The returned task.
      * @return Boolean value denoting if a task were retrieved or not
      */
-    bool GetTask(uint32_t& tableId, uint32_t& seg);
+    bool GetTask(RecoveryTask& task);
 
     /**
-     * @brief Reads the checkpoint map file and fills the tasks queue
-     * with the relevant information.
+     * @brief Reads a checkpoint map file.
+     * @param checkpointId The checkpoint whose map file is read.
+     * @param tables The returned tables (table id to the number of its last segment).
      * @return Int value where 0 indicates no tasks (empty checkpoint),
      * -1 denotes an error has occured and 1 means a sucess.
      */
-    int FillTasksFromMapFile();
+    int ReadMapFile(uint64_t checkpointId, std::map<uint32_t, uint32_t>& tables);
+
+    /**
+     * @brief Fills the tasks queue with one checkpoint level of the recovered tables.
+     * @param tables The tables of the level, as read from its map file.
+     * @param levelId The checkpoint id of the level.
+     * @param remove Creates one key removal task per table instead of row insertion tasks.
+     * @return Boolean value denoting success or failure.
+     */
+    bool FillTasks(const std::map<uint32_t, uint32_t>& tables, uint64_t levelId, bool remove);
+
+    /**
+     * @brief Reads the delta chain file of the recovered checkpoint, if any.
+     * @return Boolean value denoting success or failure.
+     */
+    bool ReadCheckpointChain();
+
+    /**
+     * @brief Runs the recovery workers until the tasks queue is drained.
+     * @return Boolean value denoting success or failure.
+     */
+    bool RunCheckpointTasks();
 
     /**
      * @brief Checks if there are any more tasks left in the queue
@@ -266,16 +345,6 @@ private:
      */
     bool DeserializeInProcessTxns(int fd, uint64_t numEntries);
 
-    /**
-     * @struct RecoveryTask
-     * @brief Describes a recovery task by its table id and
-     * segment file number.
-     */
-    struct RecoveryTask {
-        uint32_t m_id;
-        uint32_t m_seg;
-    };
-
 public:
     /**
      * @struct TableInfo
@@ -616,6 +685,11 @@ public:
 
     inline void SetLastReplayLsn(uint64_t lastReplayLsn)
     {
+        if (m_replayDispatcher.IsActive()) {
+            // transactions are replayed out of order, report only what is below all of the queued ones
+            m_replayDispatcher.OnTransactionReplayed(lastReplayLsn, m_lastReplayLsn);
+            return;
+        }
         if (m_lastReplayLsn < lastReplayLsn) {
             m_lastReplayLsn = lastReplayLsn;
         }
@@ -626,6 +700,21 @@ public:
         return m_lastReplayLsn;
     }
 
+    /**
+     * @brief Retrieves the redo replay progress.
+     * @param stats The returned replay counters.
+     */
+    inline void GetRedoReplayStats(RedoReplayStats& stats) const
+    {
+        m_replayDispatcher.GetStats(stats);
+    }
+
+    /** @brief Retrieves the highest commit sequence number recovered so far. */
+    inline uint64_t GetMaxRecoveredCsn() const
+    {
+        return m_maxRecoveredCsn;
+    }
+
     LogStats* m_logStats;
 
     std::map<uint64_t, TableInfo*> m_preCommitedTables;
@@ -849,6 +938,16 @@ private:
     static void InsertRowFromCheckpoint(Table* table, char* keyData, uint16_t keyLen, char* rowData, uint64_t rowLen,
         uint64_t csn, uint32_t tid, SurrogateState& sState, RC& status, uint64_t rowId);
 
+    /**
+     * @brief performs non transactional row removal (for delta checkpoint recovery).
+     * @param table the table's pointer.
+     * @param keyData key's data buffer.
+     * @param keyLen key's data buffer len.
+     * @param tid the thread id of the recovering thread.
+     * @param status the returned status of the operation
+     */
+    static void RemoveRowFromCheckpoint(Table* table, char* keyData, uint16_t keyLen, uint32_t tid, RC& status);
+
     /**
      * @brief performs the actual row update in the storage.
      * @param tableId the table's id.
@@ -1063,6 +1162,9 @@ private:
 
     std::set<uint32_t> m_tableIds;
 
+    // Checkpoints to load, the full checkpoint first and the recovered checkpoint last
+    std::vector<uint64_t> m_checkpointChain;
+
     std::list<RecoveryTask*> m_tasksList;
 
     std::mutex m_tasksLock;
@@ -1104,6 +1206,9 @@ private:
     SurrogateState m_sState;
 
     uint16_t m_maxConnections;
+
+    /** @var Replays committed redo transactions on several threads. */
+    RedoReplayDispatcher m_replayDispatcher;
 };
 }  // namespace MOT
 
@@ -562,6 +562,25 @@ void RecoveryManager::InsertRowFromCheckpoint(Table* table, char* keyData, uint1
     }
 }
 
+void RecoveryManager::RemoveRowFromCheckpoint(Table* table, char* keyData, uint16_t keyLen, uint32_t tid, RC& status)
+{
+    MaxKey key;
+    key.CpKey((const uint8_t*)keyData, keyLen);
+    Row* row = table->GetPrimaryIndex()->IndexRead(&key, tid);
+    if (row == nullptr) {
+        // the row was inserted and deleted after the previous level was written
+        status = RC_OK;
+        return;
+    }
+
+    if (table->RemoveRow(row, tid) == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_INTERNAL, "Recovery Manager Remove Row", "failed to remove row");
+        status = RC_ERROR;
+        return;
+    }
+    status = RC_OK;
+}
+
 void RecoveryManager::DeleteRow(
     uint64_t tableId, uint64_t exId, char* keyData, uint16_t keyLen, uint64_t csn, uint32_t tid, RC& status)
 {
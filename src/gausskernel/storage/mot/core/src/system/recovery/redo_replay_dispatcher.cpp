@@ -0,0 +1,439 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * redo_replay_dispatcher.cpp
+ *    Replays committed redo transactions on several threads, partitioned by table and key.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/system/recovery/redo_replay_dispatcher.cpp
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#include <system_error>
+#include "redo_replay_dispatcher.h"
+#include "mot_engine.h"
+#include "recovery_manager.h"
+#include "table.h"
+#include "hash_index.h"
+#include "bitmapset.h"
+
+namespace MOT {
+IMPLEMENT_CLASS_LOGGER(RedoReplayDispatcher, Recovery);
+
+bool RedoReplayDispatcher::Start(uint32_t numWorkers)
+{
+    if (numWorkers < 2) {
+        MOT_LOG_INFO("Redo is replayed by the recovery thread");
+        return true;
+    }
+
+    m_queues = new (std::nothrow) WorkerQueue[numWorkers];
+    if (m_queues == nullptr) {
+        MOT_REPORT_ERROR(MOT_ERROR_OOM, "Redo Replay", "Failed to allocate %u redo replay queues", numWorkers);
+        return false;
+    }
+    for (uint32_t i = 0; i < numWorkers; ++i) {
+        m_queues[i].m_busy = false;
+    }
+
+    m_numWorkers = numWorkers;
+    m_stop = false;
+    m_workers.reserve(numWorkers);
+    for (uint32_t i = 0; i < numWorkers; ++i) {
+        try {
+            m_workers.push_back(std::thread(&RedoReplayDispatcher::WorkerFunc, this, i));
+        } catch (const std::system_error& e) {
+            // operations are partitioned over all the workers, so replay serially rather than with fewer workers
+            MOT_LOG_WARN("Failed to start redo replay worker %u (%s), redo is replayed by the recovery thread",
+                i,
+                e.what());
+            StopWorkers();
+            m_numWorkers = 0;
+            return true;
+        }
+    }
+    m_active = true;
+    MOT_LOG_INFO("Redo is replayed by %u workers", numWorkers);
+    return true;
+}
+
+void RedoReplayDispatcher::Stop()
+{
+    if (!m_active) {
+        return;
+    }
+
+    Drain();
+    StopWorkers();
+    m_active = false;
+
+    MOT_LOG_INFO("Redo replay workers stopped: %lu transactions (%lu row operations) replayed by the workers, %lu "
+                 "by the recovery thread",
+        m_replayedTxns.load(),
+        m_replayedOps.load(),
+        m_serialTxns.load());
+}
+
+void RedoReplayDispatcher::StopWorkers()
+{
+    m_stop = true;
+    for (uint32_t i = 0; i < m_numWorkers; ++i) {
+        std::lock_guard<std::mutex> lock(m_queues[i].m_lock);
+        m_queues[i].m_ready.notify_all();
+    }
+    for (auto& worker : m_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    m_workers.clear();
+    delete[] m_queues;
+    m_queues = nullptr;
+}
+
+void RedoReplayDispatcher::Drain()
+{
+    if (!m_active) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < m_numWorkers; ++i) {
+        WorkerQueue& queue = m_queues[i];
+        std::unique_lock<std::mutex> lock(queue.m_lock);
+        queue.m_space.wait(lock, [&queue] { return queue.m_tasks.empty() && !queue.m_busy; });
+    }
+}
+
+RedoReplayDispatcher::Task* RedoReplayDispatcher::CreateTask(
+    LogSegment** segments, uint32_t count, uint64_t csn, uint64_t transactionId)
+{
+    if (!m_active || count == 0) {
+        return nullptr;
+    }
+
+    Task* task = new (std::nothrow) Task();
+    if (task == nullptr) {
+        // not an error, the transaction is replayed by the recovery thread
+        return nullptr;
+    }
+    task->m_segments = segments;
+    task->m_segmentCount = count;
+    task->m_csn = csn;
+    task->m_transactionId = transactionId;
+    task->m_replayLsn = segments[count - 1]->m_replayLsn;
+    task->m_pendingParts = 0;
+
+    for (uint32_t i = 0; i < count; ++i) {
+        uint8_t* data = (uint8_t*)segments[i]->m_data;
+        uint8_t* end = data + segments[i]->m_len;
+        while (data < end) {
+            OperationCode opCode = *static_cast<OperationCode*>((void*)data);
+            uint32_t worker = 0;
+            uint32_t length = 0;
+            switch (opCode) {
+                case CREATE_ROW:
+                case UPDATE_ROW:
+                case OVERWRITE_ROW:
+                case REMOVE_ROW:
+                    if (!ClassifyRowOperation(data, worker, length)) {
+                        DestroyTask(task);
+                        return nullptr;
+                    }
+                    task->m_ops.push_back(std::make_pair(data, worker));
+                    break;
+                case PARTIAL_REDO_TX:
+                case PREPARE_TX:
+                    length = sizeof(EndSegmentBlock);
+                    break;
+                case COMMIT_TX:
+                case COMMIT_PREPARED_TX:
+                    // the workers commit their parts, so the commit must end the transaction
+                    length = sizeof(EndSegmentBlock);
+                    if (i != count - 1 || data + length != end) {
+                        DestroyTask(task);
+                        return nullptr;
+                    }
+                    break;
+                default:
+                    // DDL and rollback records are replayed by the recovery thread
+                    DestroyTask(task);
+                    return nullptr;
+            }
+            data += length;
+        }
+    }
+
+    if (task->m_ops.empty()) {
+        DestroyTask(task);
+        return nullptr;
+    }
+    return task;
+}
+
+void RedoReplayDispatcher::Submit(Task* task)
+{
+    // count the workers taking part before the task becomes visible to any of them
+    std::vector<bool> targets(m_numWorkers, false);
+    uint32_t parts = 0;
+    for (const auto& op : task->m_ops) {
+        if (!targets[op.second]) {
+            targets[op.second] = true;
+            ++parts;
+        }
+    }
+    task->m_pendingParts = parts;
+
+    m_lsnLock.lock();
+    m_inFlightLsns[task->m_replayLsn] += parts;
+    if (task->m_replayLsn > m_maxLsn) {
+        m_maxLsn = task->m_replayLsn;
+    }
+    m_lsnLock.unlock();
+
+    GetRecoveryManager()->SetCsnIfGreater(task->m_csn);
+    if (GetRecoveryManager()->m_logStats != nullptr) {
+        GetRecoveryManager()->m_logStats->m_tcls++;
+    }
+    ++m_dispatchedTxns;
+
+    for (uint32_t i = 0; i < m_numWorkers; ++i) {
+        if (!targets[i]) {
+            continue;
+        }
+        WorkerQueue& queue = m_queues[i];
+        std::unique_lock<std::mutex> lock(queue.m_lock);
+        queue.m_space.wait(lock, [&queue] { return queue.m_tasks.size() < MAX_QUEUED_TASKS; });
+        queue.m_tasks.push_back(task);
+        queue.m_ready.notify_one();
+    }
+}
+
+void RedoReplayDispatcher::DestroyTask(Task* task)
+{
+    delete task;
+}
+
+void RedoReplayDispatcher::CompleteTaskPart(Task* task)
+{
+    if (--task->m_pendingParts == 0) {
+        for (uint32_t i = 0; i < task->m_segmentCount; ++i) {
+            RecoveryManager::FreeRedoSegment(task->m_segments[i]);
+        }
+        free(task->m_segments);
+        delete task;
+        ++m_replayedTxns;
+    }
+}
+
+void RedoReplayDispatcher::OnTransactionReplayed(uint64_t replayLsn, uint64_t& lastReplayLsn)
+{
+    m_lsnLock.lock();
+    std::map<uint64_t, uint32_t>::iterator it = m_inFlightLsns.find(replayLsn);
+    if (it != m_inFlightLsns.end()) {
+        if (--it->second == 0) {
+            (void)m_inFlightLsns.erase(it);
+        }
+    } else if (replayLsn > m_maxLsn) {
+        // replayed by the recovery thread
+        m_maxLsn = replayLsn;
+    }
+
+    // everything below the oldest in-flight transaction was replayed
+    uint64_t safeLsn = m_inFlightLsns.empty() ? m_maxLsn : (m_inFlightLsns.begin()->first - 1);
+    if (safeLsn > lastReplayLsn) {
+        lastReplayLsn = safeLsn;
+    }
+    m_lsnLock.unlock();
+}
+
+void RedoReplayDispatcher::GetStats(RedoReplayStats& stats) const
+{
+    stats.m_workers = m_active ? m_numWorkers : 0;
+    stats.m_replayedTxns = m_replayedTxns.load();
+    stats.m_serialTxns = m_serialTxns.load();
+    uint64_t dispatched = m_dispatchedTxns.load();
+    stats.m_pendingTxns = (dispatched > stats.m_replayedTxns) ? (dispatched - stats.m_replayedTxns) : 0;
+    stats.m_replayedOps = m_replayedOps.load();
+}
+
+bool RedoReplayDispatcher::ClassifyRowOperation(uint8_t* op, uint32_t& worker, uint32_t& length) const
+{
+    uint8_t* data = op + sizeof(OperationCode);
+    uint64_t tableId = 0;
+    uint64_t exId = 0;
+    uint64_t rowId = 0;
+    uint64_t rowLength = 0;
+    uint16_t keyLength = 0;
+    OperationCode opCode = *static_cast<OperationCode*>((void*)op);
+
+    RecoveryManager::Extract(data, tableId);
+    RecoveryManager::Extract(data, exId);
+    if (opCode == CREATE_ROW) {
+        RecoveryManager::Extract(data, rowId);
+    }
+    RecoveryManager::Extract(data, keyLength);
+    uint8_t* keyData = RecoveryManager::ExtractPtr(data, keyLength);
+
+    Table* table = GetTableManager()->GetTableByExternal(exId);
+    if (table == nullptr) {
+        // the table may be created by an earlier transaction still queued, let the recovery thread report it
+        return false;
+    }
+
+    switch (opCode) {
+        case CREATE_ROW:
+        case OVERWRITE_ROW:
+            RecoveryManager::Extract(data, rowLength);
+            data += rowLength;
+            break;
+        case UPDATE_ROW:
+            data += GetUpdateDataLength(table, data);
+            break;
+        default:
+            break;
+    }
+    length = (uint32_t)(data - op);
+
+    // a unique secondary index key may move between primary keys, so such tables are replayed by a single worker
+    bool byTable = false;
+    for (uint16_t i = 1; i < table->GetNumIndexes(); ++i) {
+        if (table->GetSecondaryIndex(i)->GetUnique()) {
+            byTable = true;
+            break;
+        }
+    }
+
+    uint64_t hash = tableId * 0x9E3779B97F4A7C15ULL;
+    if (!byTable) {
+        hash ^= HashUniqueIndex::HashKey(keyData, keyLength);
+    }
+    worker = (uint32_t)((hash ^ (hash >> 32)) % m_numWorkers);
+    return true;
+}
+
+uint32_t RedoReplayDispatcher::GetUpdateDataLength(Table* table, uint8_t* data)
+{
+    uint16_t numColumns = table->GetFieldCount() - 1;
+    uint16_t bitmapLength = BitmapSet::GetLength(numColumns);
+    BitmapSet updatedColumns(data, numColumns);
+    BitmapSet validColumns(data + bitmapLength, numColumns);
+    BitmapSet::BitmapSetIterator updatedColumnsIt(updatedColumns);
+    BitmapSet::BitmapSetIterator validColumnsIt(validColumns);
+    uint32_t size = 0;
+    while (!updatedColumnsIt.End()) {
+        if (updatedColumnsIt.IsSet() && validColumnsIt.IsSet()) {
+            size += table->GetField(updatedColumnsIt.GetPosition() + 1)->m_size;
+        }
+        validColumnsIt.Next();
+        updatedColumnsIt.Next();
+    }
+    return 2 * bitmapLength + size;
+}
+
+void RedoReplayDispatcher::WorkerFunc(uint32_t workerId)
+{
+    // since this is a non-kernel thread we must set-up our own u_sess struct for the current thread
+    MOT_DECLARE_NON_KERNEL_THREAD();
+
+    MOTEngine* engine = MOTEngine::GetInstance();
+    RecoveryManager* recoveryManager = GetRecoveryManager();
+    SessionContext* sessionContext = GetSessionManager()->CreateSessionContext();
+    RecoveryManager::SurrogateState sState;
+    bool canReplay = true;
+    if (sessionContext == nullptr || !sState.IsValid()) {
+        recoveryManager->OnError(
+            RecoveryManager::ErrCodes::XLOG_RECOVERY, "RedoReplayDispatcher::WorkerFunc: failed to initialize worker");
+        canReplay = false;
+    }
+    MOT_LOG_DEBUG("RedoReplayDispatcher::WorkerFunc start [%u] on cpu %lu", (unsigned)MOTCurrThreadId, sched_getcpu());
+
+    // keep consuming tasks after an error, so the recovery thread never blocks on a full queue
+    WorkerQueue& queue = m_queues[workerId];
+    while (true) {
+        Task* task = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(queue.m_lock);
+            queue.m_ready.wait(lock, [this, &queue] { return !queue.m_tasks.empty() || m_stop; });
+            if (queue.m_tasks.empty()) {
+                break;
+            }
+            task = queue.m_tasks.front();
+            queue.m_tasks.pop_front();
+            queue.m_busy = true;
+        }
+        queue.m_space.notify_all();
+
+        if (canReplay && !recoveryManager->IsErrorSet()) {
+            RC status = RC_OK;
+            uint64_t ops = 0;
+            if (!recoveryManager->BeginTransaction(task->m_replayLsn)) {
+                status = RC_ERROR;
+            } else {
+                for (const auto& op : task->m_ops) {
+                    if (op.second != workerId) {
+                        continue;
+                    }
+                    if (recoveryManager->IsRecoveryMemoryLimitReached(m_numWorkers)) {
+                        MOT_LOG_ERROR("Memory hard limit reached. Cannot recover datanode");
+                        status = RC_ERROR;
+                        break;
+                    }
+                    bool wasCommit = false;
+                    (void)RecoveryManager::RecoverLogOperation(
+                        op.first, task->m_csn, task->m_transactionId, MOTCurrThreadId, sState, status, wasCommit);
+                    if (status != RC_OK) {
+                        break;
+                    }
+                    ++ops;
+                }
+                if (status == RC_OK) {
+                    status = recoveryManager->CommitTransaction(task->m_csn);
+                } else {
+                    (void)recoveryManager->RollbackTransaction();
+                }
+            }
+
+            if (status != RC_OK) {
+                MOT_LOG_ERROR("RedoReplayDispatcher::WorkerFunc: got error %d on tid %lu", status, task->m_transactionId);
+                recoveryManager->OnError(
+                    RecoveryManager::ErrCodes::XLOG_RECOVERY, "RedoReplayDispatcher::WorkerFunc: wal recovery failed");
+            } else {
+                m_replayedOps += ops;
+                if (!GetGlobalConfiguration().m_enableCheckpoint) {
+                    // otherwise reported by the checkpoint manager when the transaction completes
+                    OnTransactionReplayed(task->m_replayLsn, recoveryManager->m_lastReplayLsn);
+                }
+            }
+        }
+        CompleteTaskPart(task);
+
+        {
+            std::lock_guard<std::mutex> lock(queue.m_lock);
+            queue.m_busy = false;
+        }
+        queue.m_space.notify_all();
+    }
+
+    if (canReplay && !sState.IsEmpty()) {
+        recoveryManager->AddSurrogateArrayToList(sState);
+    }
+    if (sessionContext != nullptr) {
+        GetSessionManager()->DestroySessionContext(sessionContext);
+    }
+    engine->OnCurrentThreadEnding();
+    MOT_LOG_DEBUG("RedoReplayDispatcher::WorkerFunc end [%u] on cpu %lu", (unsigned)MOTCurrThreadId, sched_getcpu());
+}
+}  // namespace MOT
@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * -------------------------------------------------------------------------
+ *
+ * redo_replay_dispatcher.h
+ *    Replays committed redo transactions on several threads, partitioned by table and key.
+ *
+ * IDENTIFICATION
+ *    src/gausskernel/storage/mot/core/src/system/recovery/redo_replay_dispatcher.h
+ *
+ * -------------------------------------------------------------------------
+ */
+
+#ifndef REDO_REPLAY_DISPATCHER_H
+#define REDO_REPLAY_DISPATCHER_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "global.h"
+#include "spin_lock.h"
+#include "transaction_buffer_iterator.h"
+
+namespace MOT {
+// forward declarations
+class RecoveryManager;
+class Table;
+
+/**
+ * @struct RedoReplayStats
+ * @brief Redo replay progress counters.
+ */
+struct RedoReplayStats {
+    /** @var Number of replay workers (zero if redo is replayed by the recovery thread only). */
+    uint32_t m_workers;
+
+    /** @var Number of transactions replayed by the workers. */
+    uint64_t m_replayedTxns;
+
+    /** @var Number of transactions replayed by the recovery thread, after all the workers were drained. */
+    uint64_t m_serialTxns;
+
+    /** @var Number of transactions handed to the workers and not replayed yet. */
+    uint64_t m_pendingTxns;
+
+    /** @var Number of row operations replayed by the workers. */
+    uint64_t m_replayedOps;
+};
+
+/**
+ * @class RedoReplayDispatcher
+ * @brief Replays committed redo transactions on several worker threads.
+ * @detail Each row operation of a committed transaction is assigned to a worker by hashing its table and primary
+ * key (or by its table only, if the table has a unique secondary index), so that all the operations on a key are
+ * replayed by the same worker in commit order, while operations on unrelated keys are replayed concurrently. Every
+ * worker applies its share of a transaction in a recovery transaction of its own, with the original CSN.
+ * Transactions that cannot be partitioned (DDL, rollback records or unknown tables) are replayed by the recovery
+ * thread after all the workers were drained. The replay LSN reported to the checkpoint is held back to the oldest
+ * transaction not fully replayed yet, so a checkpoint taken during redo never skips a queued transaction.
+ * A transaction is handed to the workers only once its commit record was read, so all its redo segments are
+ * buffered until then (a multi-segment transaction may still abort). The progress counters are reported by the
+ * mot_redo_replay_progress() function, like the other MOT statistics.
+ */
+class RedoReplayDispatcher {
+public:
+    /**
+     * @struct Task
+     * @brief A committed transaction handed to the workers.
+     */
+    struct Task {
+        /** @var The redo segments of the transaction (the array and the segments are owned by the task). */
+        LogSegment** m_segments;
+
+        /** @var Number of redo segments. */
+        uint32_t m_segmentCount;
+
+        /** @var The transaction commit sequence number. */
+        uint64_t m_csn;
+
+        /** @var The internal transaction id. */
+        uint64_t m_transactionId;
+
+        /** @var The LSN of the redo record that committed the transaction. */
+        uint64_t m_replayLsn;
+
+        /** @var The row operations of the transaction, with the worker replaying each of them. */
+        std::vector<std::pair<uint8_t*, uint32_t>> m_ops;
+
+        /** @var Number of workers that did not finish their part yet. */
+        std::atomic<uint32_t> m_pendingParts;
+    };
+
+    RedoReplayDispatcher()
+        : m_numWorkers(0),
+          m_active(false),
+          m_stop(false),
+          m_queues(nullptr),
+          m_dispatchedTxns(0),
+          m_replayedTxns(0),
+          m_serialTxns(0),
+          m_replayedOps(0),
+          m_maxLsn(0)
+    {}
+
+    ~RedoReplayDispatcher()
+    {}
+
+    /**
+     * @brief Starts the replay workers.
+     * @param numWorkers The number of workers. Redo is replayed by the recovery thread if less than two, or if
+     * not all the workers could be started.
+     * @return True if succeeded.
+     */
+    bool Start(uint32_t numWorkers);
+
+    /** @brief Waits until all the dispatched transactions were replayed and stops the workers. */
+    void Stop();
+
+    /** @brief Waits until all the dispatched transactions were replayed. */
+    void Drain();
+
+    /** @brief Queries whether transactions are replayed by the workers. */
+    inline bool IsActive() const
+    {
+        return m_active;
+    }
+
+    /**
+     * @brief Prepares a committed transaction for replay by the workers.
+     * @param segments The malloc-ed array of the redo segments of the transaction. Owned by the task once it is
+     * submitted.
+     * @param count The number of segments.
+     * @param csn The transaction commit sequence number.
+     * @param transactionId The internal transaction id.
+     * @return The task, or null if the transaction must be replayed by the recovery thread.
+     */
+    Task* CreateTask(LogSegment** segments, uint32_t count, uint64_t csn, uint64_t transactionId);
+
+    /**
+     * @brief Hands a task to the workers. Blocks while the queue of one of the target workers is full.
+     * @param task The task (the task and its segments are released by the workers).
+     */
+    void Submit(Task* task);
+
+    /**
+     * @brief Destroys a task that was not submitted, without releasing its segments.
+     * @param task The task.
+     */
+    static void DestroyTask(Task* task);
+
+    /** @brief Counts a transaction replayed by the recovery thread. */
+    inline void OnSerialReplay()
+    {
+        ++m_serialTxns;
+    }
+
+    /**
+     * @brief Records that a recovery transaction committed, and advances the reported replay LSN up to the LSN
+     * below which all the redo was replayed.
+     * @param replayLsn The replay LSN of the transaction.
+     * @param[in,out] lastReplayLsn The reported replay LSN.
+     */
+    void OnTransactionReplayed(uint64_t replayLsn, uint64_t& lastReplayLsn);
+
+    /**
+     * @brief Retrieves the replay progress counters.
+     * @param stats The returned counters.
+     */
+    void GetStats(RedoReplayStats& stats) const;
+
+private:
+    /** @var Maximum number of tasks queued to a single worker. */
+    static constexpr size_t MAX_QUEUED_TASKS = 1024;
+
+    /** @struct A worker task queue. */
+    struct WorkerQueue {
+        std::deque<Task*> m_tasks;
+
+        std::mutex m_lock;
+
+        std::condition_variable m_ready;
+
+        std::condition_variable m_space;
+
+        /** @var Specifies whether the worker is replaying a task. */
+        bool m_busy;
+    };
+
+    /**
+     * @brief Computes the worker of a row operation and its length.
+     * @param op The operation.
+     * @param[out] worker The worker that replays the operation.
+     * @param[out] length The length of the operation.
+     * @return False if the operation cannot be replayed by a worker.
+     */
+    bool ClassifyRowOperation(uint8_t* op, uint32_t& worker, uint32_t& length) const;
+
+    /**
+     * @brief Computes the length of a fixed-size column update operation.
+     * @param table The table.
+     * @param data The operation data following the key.
+     * @return The length of the data.
+     */
+    static uint32_t GetUpdateDataLength(Table* table, uint8_t* data);
+
+    /** @brief Stops the started workers and releases the queues. */
+    void StopWorkers();
+
+    /** @brief Worker thread function. */
+    void WorkerFunc(uint32_t workerId);
+
+    /**
+     * @brief Completes the part of a task assigned to a worker, and releases the task after its last part.
+     * @param task The task.
+     */
+    void CompleteTaskPart(Task* task);
+
+    /** @var Number of workers. */
+    uint32_t m_numWorkers;
+
+    /** @var Specifies whether transactions are replayed by the workers. */
+    bool m_active;
+
+    /** @var Stops the workers. */
+    std::atomic<bool> m_stop;
+
+    /** @var The workers. */
+    std::vector<std::thread> m_workers;
+
+    /** @var The worker task queues. */
+    WorkerQueue* m_queues;
+
+    /** @var Number of transactions handed to the workers. */
+    std::atomic<uint64_t> m_dispatchedTxns;
+
+    /** @var Number of transactions replayed by the workers. */
+    std::atomic<uint64_t> m_replayedTxns;
+
+    /** @var Number of transactions replayed by the recovery thread. */
+    std::atomic<uint64_t> m_serialTxns;
+
+    /** @var Number of row operations replayed by the workers. */
+    std::atomic<uint64_t> m_replayedOps;
+
+    /** @var Lock protecting the in-flight LSN map and the LSN members. */
+    spin_lock m_lsnLock;
+
+    /** @var Number of recovery transactions still to commit for each in-flight replay LSN. */
+    std::map<uint64_t, uint32_t> m_inFlightLsns;
+
+    /** @var The highest replay LSN seen so far. */
+    uint64_t m_maxLsn;
+
+    DECLARE_CLASS_LOGGER()
+};
+}  // namespace MOT
+
+#endif /* REDO_REPLAY_DISPATCHER_H */
@@ -83,6 +83,9 @@ public:
     /** @var The original row header */
     Sentinel* m_origSentinel = nullptr;
 
+    /** @var Pre-allocated row receiving the version replaced by this access (snapshot reads). */
+    Row* m_versionRow = nullptr;
+
     /** @var The bitmap set represents the updated columns. */
     BitmapSet m_modifiedColumns;
 
@@ -36,6 +36,7 @@
 #include "db_session_statistics.h"
 #include "utilities.h"
 #include "mm_api.h"
+#include "cold_row_store.h"
 
 namespace MOT {
 DECLARE_LOGGER(TxnManager, System);
@@ -95,6 +96,15 @@ Row* TxnManager::RowLookup(const AccessType type, Sentinel* const& originalSenti
     // if txn not started, tag as started and take global epoch
     GcSessionStart();
 
+    ColdRowStore* coldStore = GetColdRowStore();
+    if (coldStore != nullptr) {
+        coldStore->Touch(originalSentinel);
+    }
+
+    if (m_snapshotCsn != 0 && type == AccessType::RD) {
+        return m_accessMgr->GetSnapshotRow(originalSentinel, m_snapshotCsn);
+    }
+
     RC res = AccessLookup(type, originalSentinel, local_row);
 
     switch (res) {
@@ -149,10 +159,43 @@ RC TxnManager::StartTransaction(uint64_t transactionId, int isolationLevel)
     m_transactionId = transactionId;
     m_isolationLevel = isolationLevel;
     m_state = TxnState::TXN_START;
+    if (m_hasNumaAccess) {
+        errno_t erc = memset_s(m_numaAccessCount, sizeof(m_numaAccessCount), 0, sizeof(m_numaAccessCount));
+        securec_check(erc, "\0", "\0");
+        m_hasNumaAccess = false;
+    }
     GcSessionStart();
     return RC_OK;
 }
 
+int TxnManager::GetPreferredNumaNode() const
+{
+    if (!m_hasNumaAccess) {
+        return -1;
+    }
+    int node = 0;
+    for (int i = 1; i < MEM_MAX_NUMA_NODES; i++) {
+        if (m_numaAccessCount[i] > m_numaAccessCount[node]) {
+            node = i;
+        }
+    }
+    return node;
+}
+
+void TxnManager::StartSnapshotRead()
+{
+    if (m_snapshotCsn != 0 || m_isLightSession || !GetGlobalConfiguration().m_enableSnapshotReads) {
+        return;
+    }
+    // rows already read from the latest versions would make the view inconsistent
+    if (m_accessMgr->m_rowCnt > 0) {
+        return;
+    }
+    // old versions are reclaimed by the GC, so the epoch must be taken before the snapshot
+    GcSessionStart();
+    m_snapshotCsn = GetSnapshotManager()->TakeSnapshot(m_connectionId);
+}
+
 RC TxnManager::LiteRollback(TransactionId transactionId)
 {
     if (m_txnDdlAccess->Size() > 0) {
@@ -401,6 +444,13 @@ void TxnManager::Cleanup()
     m_internalStmtCount = 0;
     m_redoLog.Reset();
     SetFailedCommitPrepared(false);
+    if (m_snapshotCsn != 0) {
+        GetSnapshotManager()->ReleaseSnapshot(m_connectionId);
+        m_snapshotCsn = 0;
+    }
+    if (!m_isLightSession && GetGlobalConfiguration().m_enableSnapshotReads) {
+        GetSnapshotManager()->ProcessDeferredRemovals(this);
+    }
     GcSessionEnd();
     ClearErrorStack();
     m_accessMgr->ClearTableCache();
@@ -591,6 +641,7 @@ void TxnManager::CleanDDLChanges()
                 GetTableManager()->AddTable((Table*)ddl_access->GetEntry());
                 break;
             case DDL_ACCESS_DROP_TABLE:
+                GetSnapshotManager()->PurgeDeferredRemovals((Table*)ddl_access->GetEntry());
                 GetTableManager()->DropTable((Table*)ddl_access->GetEntry(), m_sessionContext);
                 break;
             case DDL_ACCESS_TRUNCATE_TABLE:
@@ -600,10 +651,15 @@ void TxnManager::CleanDDLChanges()
                     table->m_rowCount = 0;
                     for (int i = 0; i < indexArr->GetNumIndexes(); i++) {
                         index = indexArr->GetIndex(i);
+                        GetSnapshotManager()->PurgeDeferredRemovals(table, index);
                         table->DeleteIndex(index);
                     }
                 }
                 delete indexArr;
+                if (GetGlobalConfiguration().m_enableCheckpoint) {
+                    // truncated rows are not recorded as deleted keys, so a delta checkpoint can not follow
+                    GetCheckpointManager()->RequestFullCheckpoint();
+                }
                 break;
             case DDL_ACCESS_CREATE_INDEX:
                 index = (Index*)ddl_access->GetEntry();
@@ -613,6 +669,7 @@ void TxnManager::CleanDDLChanges()
             case DDL_ACCESS_DROP_INDEX:
                 index = (Index*)ddl_access->GetEntry();
                 table = index->GetTable();
+                GetSnapshotManager()->PurgeDeferredRemovals(table, index);
                 table->DeleteIndex(index);
                 break;
             default:
@@ -682,6 +739,7 @@ TxnManager::TxnManager(SessionContext* session_context)
       m_checkpointPhase(CheckpointPhase::NONE),
       m_checkpointNABit(false),
       m_csn(0),
+      m_snapshotCsn(0),
       m_transactionId(INVALID_TRANSACTIOIN_ID),
       m_replayLsn(0),
       m_surrogateGen(0),
@@ -690,12 +748,15 @@ TxnManager::TxnManager(SessionContext* session_context)
       m_internalStmtCount(0),
       m_isolationLevel(READ_COMMITED),
       m_failedCommitPrepared(false),
+      m_hasNumaAccess(false),
       m_isLightSession(false),
       m_errIx(nullptr),
       m_err(RC_OK)
 {
     m_key = nullptr;
     m_state = TxnState::TXN_START;
+    errno_t erc = memset_s(m_numaAccessCount, sizeof(m_numaAccessCount), 0, sizeof(m_numaAccessCount));
+    securec_check(erc, "\0", "\0");
 }
 
 TxnManager::~TxnManager()
@@ -41,6 +41,7 @@
 #include "bitmapset.h"
 #include "txn_ddl_access.h"
 #include "mm_session_api.h"
+#include "mm_def.h"
 #include "commit_sequence_number.h"
 
 namespace MOT {
@@ -393,6 +394,31 @@ public:
      */
     void SetTxnIsoLevel(int envelopeIsoLevel);
 
+    /**
+     * @brief Makes a read-only transaction read all rows as of a consistent snapshot (if snapshot reads are
+     * enabled). Snapshot reads are not validated during commit. Must be called before the first row access.
+     */
+    void StartSnapshotRead();
+
+    /**
+     * @brief Records an access to a row of a NUMA-partitioned table.
+     * @param node The home NUMA node of the row (see Table::GetKeyNumaNode()).
+     */
+    inline void RecordNumaAccess(int node)
+    {
+        if (node >= 0 && node < MEM_MAX_NUMA_NODES) {
+            ++m_numaAccessCount[node];
+            m_hasNumaAccess = true;
+        }
+    }
+
+    /**
+     * @brief Retrieves the NUMA node holding most of the NUMA-partitioned rows accessed by the current (or last)
+     * transaction.
+     * @return The NUMA node, or -1 if the transaction did not access any NUMA-partitioned table by key.
+     */
+    int GetPreferredNumaNode() const;
+
     inline void IncStmtCount()
     {
         m_internalStmtCount++;
@@ -522,6 +548,7 @@ private:
     friend class RedoLog;
     friend class OccTransactionManager;
     friend class SessionContext;
+    friend class ColdRowStore;
 
 public:
     Table* GetTableByExternalId(uint64_t id);
@@ -562,6 +589,9 @@ private:
     /** @var CSN taken at the commit stage. */
     uint64_t m_csn;
 
+    /** @var Snapshot CSN of a read-only transaction (zero when reading the latest row versions). */
+    uint64_t m_snapshotCsn;
+
     /** @var transaction_id Provided by envelop on start transaction. */
     uint64_t m_transactionId;
 
@@ -589,6 +619,12 @@ private:
 
     bool m_failedCommitPrepared;
 
+    /** @var Specifies whether the transaction accessed any NUMA-partitioned row. */
+    bool m_hasNumaAccess;
+
+    /** @var Number of NUMA-partitioned row accesses per home node. */
+    uint32_t m_numaAccessCount[MEM_MAX_NUMA_NODES];
+
 public:
     /** @var Transaction cache (OCC optimization). */
     MemSessionPtr<TxnAccess> m_accessMgr;
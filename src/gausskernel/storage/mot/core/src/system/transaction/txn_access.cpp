@@ -203,6 +203,11 @@ void TxnAccess::DestroyAccess(Access* access)
         m_dummyTable.DestroyRow(row, access);
         access->m_localRow = nullptr;
     }
+    if (access->m_versionRow != nullptr) {
+        // version was not consumed by the commit
+        access->m_versionRow->GetTable()->DestroyRow(access->m_versionRow);
+        access->m_versionRow = nullptr;
+    }
     if (access->m_modifiedColumns.IsInitialized()) {
         m_dummyTable.DestroyBitMapBuffer(access->m_modifiedColumns.GetData(), access->m_modifiedColumns.GetSize());
         access->m_modifiedColumns.Reset();
@@ -674,6 +679,31 @@ Row* TxnAccess::GetReadCommitedRow(Sentinel* sentinel)
     } else
         return nullptr;
 }
+
+Row* TxnAccess::GetSnapshotRow(Sentinel* sentinel, uint64_t snapshotCsn)
+{
+    // deleted rows stay reachable (dirty sentinel) while an older snapshot is active
+    Row* row = sentinel->GetData();
+    if (row == nullptr) {
+        return nullptr;
+    }
+    bool isLatest = true;
+    if (row->GetSnapshotRow(snapshotCsn, m_rowZero, isLatest) != RC::RC_OK) {
+        return nullptr;
+    }
+    if (!sentinel->IsPrimaryIndex() && (sentinel->IsDirty() || !isLatest)) {
+        // the primary sentinel may meanwhile hold another row, verify the version still maps to this key
+        MaxKey key;
+        Index* ix = sentinel->GetIndex();
+        key.InitKey(ix->GetKeyLength());
+        ix->BuildKey(m_rowZero->GetTable(), m_rowZero, &key);
+        if (ix->IndexReadSentinel(&key, m_txnManager->GetThdId()) != sentinel) {
+            return nullptr;
+        }
+    }
+    return m_rowZero;
+}
+
 RC TxnAccess::GenerateDeletes(Access* element)
 {
     RC rc = RC_OK;
@@ -187,6 +187,14 @@ public:
      */
     Row* GetReadCommitedRow(Sentinel* sentinel);
 
+    /**
+     * @brief For snapshot reads we return a copy of the row version visible to the snapshot
+     * @param sentinel The row-header
+     * @param snapshotCsn The snapshot commit sequence number
+     * @return row zero with the visible version, or null if no version is visible
+     */
+    Row* GetSnapshotRow(Sentinel* sentinel, uint64_t snapshotCsn);
+
     /**
      * @brief Undo insert operation if possible after delete
      * @param element Current row to be deleted
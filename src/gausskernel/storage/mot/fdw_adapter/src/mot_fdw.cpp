@@ -49,6 +49,8 @@
 #include "optimizer/restrictinfo.h"
 #include "utils/memutils.h"
 #include "utils/rel.h"
+#include "vecexecutor/vecnodes.h"
+#include "vecexecutor/vectorbatch.h"
 
 #include "utils/syscache.h"
 #include "utils/partitionkey.h"
@@ -80,6 +82,7 @@
 #include "checkpoint_manager.h"
 #include <queue>
 #include "recovery_manager.h"
+#include "storage/mot/mot_fdw.h"
 #include "redo_log_handler_type.h"
 #include "ext_config_loader.h"
 #include "utilities.h"
@@ -108,6 +111,7 @@ static const struct MOTFdwOption valid_options[] = {
 
     {"null", ForeignTableRelationId},
     {"encoding", ForeignTableRelationId},
+    {"numa_partitioned", ForeignTableRelationId},
     {"force_not_null", AttributeRelationId},
 
     /* Sentinel */
@@ -132,6 +136,7 @@ static ForeignScan* MOTGetForeignPlan(PlannerInfo* root, RelOptInfo* baserel, Oi
 static void MOTExplainForeignScan(ForeignScanState* node, ExplainState* es);
 static void MOTBeginForeignScan(ForeignScanState* node, int eflags);
 static TupleTableSlot* MOTIterateForeignScan(ForeignScanState* node);
+static VectorBatch* MOTVecIterateForeignScan(VecForeignScanState* node);
 static void MOTReScanForeignScan(ForeignScanState* node);
 static void MOTEndForeignScan(ForeignScanState* node);
 static void MOTAddForeignUpdateTargets(Query* parsetree, RangeTblEntry* targetRte, Relation targetRelation);
@@ -364,6 +369,7 @@ Datum mot_fdw_handler(PG_FUNCTION_ARGS)
     fdwroutine->ExplainForeignScan = MOTExplainForeignScan;
     fdwroutine->BeginForeignScan = MOTBeginForeignScan;
     fdwroutine->IterateForeignScan = MOTIterateForeignScan;
+    fdwroutine->VecIterateForeignScan = MOTVecIterateForeignScan;
     fdwroutine->ReScanForeignScan = MOTReScanForeignScan;
     fdwroutine->EndForeignScan = MOTEndForeignScan;
     fdwroutine->AnalyzeForeignTable = MOTAnalyzeForeignTable;
@@ -496,6 +502,10 @@ static void MOTGetForeignRelSize(PlannerInfo* root, RelOptInfo* baserel, Oid for
             ERRCODE_UNDEFINED_TABLE, MOT_TABLE_NOTFOUND, (char*)RelationGetRelationName(rel));
         return;
     }
+    // the NUMA partitioning table option is not persisted by the engine, re-apply it after restart
+    if (!planstate->m_table->IsNumaPartitioned() && MOTAdaptor::IsNumaPartitionRequested(ftable->options)) {
+        (void)planstate->m_table->SetNumaPartitioned();
+    }
     baserel->fdw_private = planstate;
     planstate->m_hasForUpdate = root->parse->hasForUpdate;
     planstate->m_cmdOper = root->parse->commandType;
@@ -547,6 +557,10 @@ static bool IsOrderingApplicable(PathKey* pathKey, RelOptInfo* rel, MOT::Index*
 {
     bool res = false;
 
+    // hash index keeps no key order
+    if (ix->GetIndexingMethod() == MOT::IndexingMethod::INDEXING_METHOD_HASH)
+        return res;
+
     if (ord->m_order == SORTDIR_ENUM::SORTDIR_NONE)
         ord->m_order = SORT_STRATEGY(pathKey->pk_strategy);
     else if (ord->m_order != SORT_STRATEGY(pathKey->pk_strategy))
@@ -842,7 +856,16 @@ static ForeignScan* MOTGetForeignPlan(
         list_free(tmpLocal);
 
     List* quals = planstate->m_localConds;
-    return make_foreignscan(tlist,
+
+    // produce vector batches for aggregating scans, point lookups are not worth the batch overhead
+    bool vecOutput = u_sess->attr.attr_sql.enable_vector_engine && root->parse->commandType == CMD_SELECT &&
+                     root->parse->rowMarks == NIL && (root->parse->hasAggs || root->parse->groupClause != NIL);
+    if (vecOutput && planstate->m_bestIx != nullptr && planstate->m_bestIx->m_ixOpers[0] == READ_KEY_EXACT &&
+        planstate->m_bestIx->m_ix->GetUnique()) {
+        vecOutput = false;
+    }
+
+    ForeignScan* scan = make_foreignscan(tlist,
         quals,
         scanRelid,
         remote, /* no expressions to evaluate */
@@ -854,6 +877,8 @@ static ForeignScan* MOTGetForeignPlan(
         nullptr
 #endif
     );
+    scan->scan.plan.vec_output = vecOutput;
+    return scan;
 }
 
 /*
@@ -935,6 +960,9 @@ static void MOTBeginForeignScan(ForeignScanState* node, int eflags)
             RelationGetRelid(node->ss.ss_currentRelation))
         node->ss.ps.state->es_result_relation_info->ri_FdwState = festate;
     festate->m_currTxn->SetTxnIsoLevel(u_sess->utils_cxt.XactIsoLevel);
+    if (u_sess->attr.attr_common.XactReadOnly) {
+        festate->m_currTxn->StartSnapshotRead();
+    }
 
     foreach (t, node->ss.ps.plan->targetlist) {
         TargetEntry* tle = (TargetEntry*)lfirst(t);
@@ -1067,6 +1095,7 @@ static TupleTableSlot* MOTIterateForeignScan(ForeignScanState* node)
         festate->m_econtext = node->ss.ps.ps_ExprContext;
         CleanCursors(festate);
         MOTAdaptor::OpenCursor(node->ss.ss_currentRelation, festate);
+        MOTAdaptor::EnableCursorReadAhead(festate);
 
         festate->m_cursorOpened = true;
     }
@@ -1143,6 +1172,89 @@ static TupleTableSlot* MOTIterateForeignScan(ForeignScanState* node)
     }
 }
 
+/*
+ * Fills a batch straight from the MOT rows, saving the per-row slot and the row-to-vector conversion.
+ * Sentinels are collected a few at a time, so their rows can be prefetched before they are read.
+ */
+static VectorBatch* MOTVecIterateForeignScan(VecForeignScanState* node)
+{
+    MOT::RC rc = MOT::RC_OK;
+    MOTFdwStateSt* festate = (MOTFdwStateSt*)node->fdw_state;
+    VectorBatch* batch = node->m_pScanBatch;
+    TupleDesc tupdesc = node->ss.ss_currentRelation->rd_att;
+    MOT::Sentinel* sentinels[MOT_VEC_PREFETCH_ROWS];
+
+    batch->Reset(true);
+    if (node->ss.is_scan_end) {
+        return batch;
+    }
+
+    if (!festate->m_cursorOpened) {
+        ForeignScan* fscan = (ForeignScan*)node->ss.ps.plan;
+        festate->m_execExprs = (List*)ExecInitExpr((Expr*)fscan->fdw_exprs, (PlanState*)node);
+        festate->m_econtext = node->ss.ps.ps_ExprContext;
+        CleanCursors(festate);
+        MOTAdaptor::OpenCursor(node->ss.ss_currentRelation, festate);
+
+        festate->m_cursorOpened = true;
+    }
+
+    // festate->cursor[1] might be NULL (in case it is not in use)
+    if (festate->m_cursor[0] == nullptr || !festate->m_cursor[0]->IsValid() ||
+        (festate->m_cursor[1] != nullptr && !festate->m_cursor[1]->IsValid())) {
+        node->ss.is_scan_end = true;
+        return batch;
+    }
+
+    MemoryContextReset(node->m_scanCxt);
+    MemoryContext oldContext = MemoryContextSwitchTo(node->m_scanCxt);
+    const MOT::Key* endKey = nullptr;
+    uint16_t cmpLen = 0;
+    MOTAdaptor::GetScanBound(festate, endKey, cmpLen);
+    while (batch->m_rows < BatchMaxSize) {
+        // the cursor applies the scan bound and prefetches the rows of the retrieved sentinels
+        int maxCount = Min(MOT_VEC_PREFETCH_ROWS, BatchMaxSize - batch->m_rows);
+        int count = (int)festate->m_cursor[0]->NextBatch(sentinels, (uint32_t)maxCount, endKey, cmpLen);
+        if (count == 0) {
+            node->ss.is_scan_end = true;
+            break;
+        }
+
+        for (int i = 0; i < count; i++) {
+            MOT::Row* currRow = festate->m_currTxn->RowLookup(festate->m_internalCmdOper, sentinels[i], rc);
+            if (currRow == nullptr) {
+                if (rc != MOT::RC_OK) {
+                    if (MOT_IS_SEVERE()) {
+                        MOT_REPORT_ERROR(MOT_ERROR_INTERNAL, "MOTVecIterateForeignScan", "Failed to lookup row");
+                        MOT_LOG_ERROR_STACK("Failed to lookup row");
+                    }
+
+                    (void)MemoryContextSwitchTo(oldContext);
+                    CleanQueryStatesOnError(festate->m_currTxn);
+                    report_pg_error(rc,
+                        festate->m_currTxn,
+                        (void*)(festate->m_currTxn->m_errIx != NULL ? festate->m_currTxn->m_errIx->GetName().c_str()
+                                                                    : "unknown"),
+                        (void*)festate->m_currTxn->m_errMsgBuf);
+                    return nullptr;
+                }
+                continue;
+            }
+            MOTAdaptor::UnpackRow(batch,
+                batch->m_rows,
+                tupdesc,
+                festate->m_table,
+                festate->m_attrsUsed,
+                const_cast<uint8_t*>(currRow->GetData()));
+            batch->m_rows++;
+            festate->m_rowsFound++;
+        }
+    }
+    (void)MemoryContextSwitchTo(oldContext);
+
+    return batch;
+}
+
 /*
  *
  */
@@ -1163,6 +1275,10 @@ static void MOTReScanForeignScan(ForeignScanState* node)
             festate->m_econtext = node->ss.ps.ps_ExprContext;
         }
         MOTAdaptor::OpenCursor(node->ss.ss_currentRelation, festate);
+        if (!IsA(node, VecForeignScanState)) {
+            // vectorized scans retrieve whole batches from the cursor by themselves
+            MOTAdaptor::EnableCursorReadAhead(festate);
+        }
         festate->m_cursorOpened = true;
     }
 }
@@ -1628,6 +1744,7 @@ static void MOTXactCallback(XactEvent event, void* arg)
         } else {
             rc = MOTAdaptor::Commit(tid);
         }
+        u_sess->mot_cxt.preferred_numa_node = mgr->GetPreferredNumaNode();
 
         if (rc == MOT::RC_PANIC) {
             report_pg_error(MOT::RC_PANIC, mgr, (char*)"Checkpoint Memory Allocation Failure (commit)");
@@ -1681,6 +1798,7 @@ static void MOTXactCallback(XactEvent event, void* arg)
         } else {
             elog(DEBUG2, "XACT_EVENT_ABORT tid %lu", tid);
             MOTAdaptor::Rollback(tid);
+            u_sess->mot_cxt.preferred_numa_node = mgr->GetPreferredNumaNode();
         }
 
         mgr->SetTxnState(MOT::TxnState::TXN_ROLLBACK);
@@ -2126,6 +2244,28 @@ uint64_t MOTCheckpointGetId()
     return 0;
 }
 
+void MOTGetRedoReplayProgress(MotRedoReplayProgress* progress)
+{
+    errno_t erc = memset_s(progress, sizeof(MotRedoReplayProgress), 0, sizeof(MotRedoReplayProgress));
+    securec_check(erc, "\0", "\0");
+
+    MOT::MOTEngine* engine = MOT::MOTEngine::GetInstance();
+    if (engine == nullptr || engine->GetRecoveryManager() == nullptr) {
+        return;
+    }
+
+    MOT::RecoveryManager* recoveryManager = engine->GetRecoveryManager();
+    MOT::RedoReplayStats stats;
+    recoveryManager->GetRedoReplayStats(stats);
+    progress->workers = stats.m_workers;
+    progress->replayedTxns = stats.m_replayedTxns;
+    progress->serialTxns = stats.m_serialTxns;
+    progress->pendingTxns = stats.m_pendingTxns;
+    progress->replayedOps = stats.m_replayedOps;
+    progress->lastReplayLsn = recoveryManager->GetLastReplayLsn();
+    progress->maxRecoveredCsn = recoveryManager->GetMaxRecoveredCsn();
+}
+
 inline bool IsNotEqualOper(OpExpr* op)
 {
     switch (op->opno) {
@@ -41,8 +41,10 @@
 #include "parser/parse_type.h"
 #include "utils/syscache.h"
 #include "executor/executor.h"
+#include "vecexecutor/vectorbatch.h"
 #include "storage/ipc.h"
 #include "commands/dbcommands.h"
+#include "commands/defrem.h"
 #include "knl/knl_session.h"
 
 #include "log_statistics.h"
@@ -1326,6 +1328,13 @@ void MOTAdaptor::OpenCursor(Relation rel, MOTFdwStateSt* festate)
 
             festate->m_cursor[fIx] = festate->m_table->Begin(festate->m_currTxn->GetThdId());
 
+            // hash unique index has no key order to bound the scan with, rows inserted by the current
+            // statement are filtered out by the access set anyway
+            if (ix->GetIndexingMethod() == MOT::IndexingMethod::INDEXING_METHOD_HASH) {
+                festate->m_cursor[bIx] = nullptr;
+                break;
+            }
+
             festate->m_stateKey[bIx].InitKey(keyLength);
             buf = festate->m_stateKey[bIx].GetKeyBuf();
             FILL_KEY_MAX(INT8OID, buf, keyLength);
@@ -1336,7 +1345,10 @@ void MOTAdaptor::OpenCursor(Relation rel, MOTFdwStateSt* festate)
 
         for (int i = 0; i < 2; i++) {
             if (i == 1 && festate->m_bestIx->m_end < 0) {
-                if (festate->m_forwardDirectionScan) {
+                if (festate->m_bestIx->m_ix->GetIndexingMethod() == MOT::IndexingMethod::INDEXING_METHOD_HASH) {
+                    // point iterator of a hash index stops after the matched key
+                    festate->m_cursor[1] = nullptr;
+                } else if (festate->m_forwardDirectionScan) {
                     uint8_t* buf = nullptr;
                     MOT::Index* ix = festate->m_bestIx->m_ix;
                     uint16_t keyLength = ix->GetKeyLength();
@@ -1358,6 +1370,12 @@ void MOTAdaptor::OpenCursor(Relation rel, MOTFdwStateSt* festate)
 
             CreateKeyBuffer(rel, festate, i);
 
+            // point lookups by primary key steer the session towards the home node of the row
+            if (i == 0 && oper == KEY_OPER::READ_KEY_EXACT && festate->m_table->IsNumaPartitioned() &&
+                festate->m_bestIx->m_ix->GetIndexOrder() == MOT::IndexOrder::INDEX_ORDER_PRIMARY) {
+                festate->m_currTxn->RecordNumaAccess(festate->m_table->GetKeyNumaNode(&festate->m_stateKey[0]));
+            }
+
             if (i == 0) {
                 festate->m_forwardDirectionScan = forwardDirection;
             }
@@ -1524,6 +1542,30 @@ static MOT::RC TableFieldType(const ColumnDef* colDef, MOT::MOT_CATALOG_FIELD_TY
     return res;
 }
 
+static bool IsHashIndexRequested(List* options)
+{
+    ListCell* lc = nullptr;
+    foreach (lc, options) {
+        DefElem* def = (DefElem*)lfirst(lc);
+        if (pg_strcasecmp(def->defname, "hash_index") == 0) {
+            return defGetBoolean(def);
+        }
+    }
+    return false;
+}
+
+bool MOTAdaptor::IsNumaPartitionRequested(List* options)
+{
+    ListCell* lc = nullptr;
+    foreach (lc, options) {
+        DefElem* def = (DefElem*)lfirst(lc);
+        if (pg_strcasecmp(def->defname, "numa_partitioned") == 0) {
+            return defGetBoolean(def);
+        }
+    }
+    return false;
+}
+
 MOT::RC MOTAdaptor::CreateIndex(IndexStmt* index, ::TransactionId tid)
 {
     MOT::RC res;
@@ -1573,6 +1615,19 @@ MOT::RC MOTAdaptor::CreateIndex(IndexStmt* index, ::TransactionId tid)
         // Use the default index tree flavor from configuration file
         indexing_method = MOT::IndexingMethod::INDEXING_METHOD_TREE;
         flavor = MOT::GetGlobalConfiguration().m_indexTreeFlavor;
+
+        // WITH (hash_index = on) asks for the lock-free hash index, which serves exact-key lookups only
+        if (IsHashIndexRequested(index->options)) {
+            if (!index->unique) {
+                ereport(ERROR,
+                    (errmodule(MOD_MOT),
+                        errcode(ERRCODE_FEATURE_NOT_SUPPORTED),
+                        errmsg("Can't create index"),
+                        errdetail("MOT hash index must be unique")));
+                return MOT::RC_ERROR;
+            }
+            indexing_method = MOT::IndexingMethod::INDEXING_METHOD_HASH;
+        }
     } else {
         ereport(ERROR, (errmodule(MOD_MOT), errmsg("MOT supports indexes of type BTREE only (btree or btree_art)")));
         return MOT::RC_ERROR;
@@ -1854,6 +1909,13 @@ MOT::RC MOTAdaptor::CreateTable(CreateForeignTableStmt* table, ::TransactionId t
             break;
         }
 
+        if (IsNumaPartitionRequested(table->options) && !currentTable->SetNumaPartitioned()) {
+            delete currentTable;
+            currentTable = nullptr;
+            report_pg_error(MOT::RC_MEMORY_ALLOCATION_ERROR, txn);
+            break;
+        }
+
         elog(LOG,
             "creating table %s (OID: %u), num columns: %u, tuple: %u",
             currentTable->GetLongTableName().c_str(),
@@ -2230,6 +2292,36 @@ void MOTAdaptor::CreateKeyBuffer(Relation rel, MOTFdwStateSt* festate, int start
     festate->m_bestIx->m_ix->AdjustKey(&festate->m_stateKey[start], pattern);
 }
 
+void MOTAdaptor::GetScanBound(MOTFdwStateSt* festate, const MOT::Key*& endKey, uint16_t& cmpLen)
+{
+    MOT::Index* ix = (festate->m_bestIx != nullptr ? festate->m_bestIx->m_ix : festate->m_table->GetPrimaryIndex());
+    endKey = nullptr;
+    if (festate->m_cursor[1] != nullptr && festate->m_cursor[1]->IsValid()) {
+        endKey = reinterpret_cast<const MOT::Key*>(festate->m_cursor[1]->GetKey());
+    }
+    cmpLen = ix->GetKeySizeNoSuffix();
+}
+
+void MOTAdaptor::EnableCursorReadAhead(MOTFdwStateSt* festate)
+{
+    // nothing to read ahead if the scan is already over
+    if (festate->m_cursor[0] == nullptr || (festate->m_cursor[1] != nullptr && !festate->m_cursor[1]->IsValid())) {
+        return;
+    }
+
+    MOT::IndexIterator* cursor = new (std::nothrow) MOT::BatchedIndexIterator(festate->m_cursor[0]);
+    if (cursor == nullptr) {
+        // not fatal, the scan proceeds one item at a time
+        return;
+    }
+
+    const MOT::Key* endKey = nullptr;
+    uint16_t cmpLen = 0;
+    GetScanBound(festate, endKey, cmpLen);
+    cursor->SetScanBound(endKey, cmpLen);
+    festate->m_cursor[0] = cursor;
+}
+
 bool MOTAdaptor::IsScanEnd(MOTFdwStateSt* festate)
 {
     bool res = false;
@@ -2346,6 +2438,34 @@ void MOTAdaptor::UnpackRow(TupleTableSlot* slot, MOT::Table* table, const uint8_
     }
 }
 
+void MOTAdaptor::UnpackRow(
+    VectorBatch* batch, int rowIdx, TupleDesc tupdesc, MOT::Table* table, const uint8_t* attrs_used, uint8_t* srcRow)
+{
+    EnsureSafeThreadAccessInline();
+    uint64_t i = 0;
+
+    // column count includes null bits field
+    uint64_t cols = table->GetFieldCount() - 1;
+
+    for (; i < cols; i++) {
+        ScalarVector* vec = &(batch->m_arr[i]);
+        if (BITMAP_GET(attrs_used, i)) {
+            Datum value;
+            bool isNull = false;
+            MOTToDatum(table, tupdesc->attrs[i], srcRow, &value, &isNull);
+            if (isNull) {
+                vec->SetNull(rowIdx);
+            } else {
+                // fixed-length by-reference types get a varlena header, numeric the fast format
+                vec->m_vals[rowIdx] = ScalarVector::DatumToScalar(value, tupdesc->attrs[i]->atttypid, false);
+            }
+        } else {
+            vec->SetNull(rowIdx);
+        }
+        vec->m_rows++;
+    }
+}
+
 // useful functions for data conversion: utils/fmgr/gmgr.cpp
 void MOTAdaptor::MOTToDatum(MOT::Table* table, const Form_pg_attribute attr, uint8_t* data, Datum* value, bool* is_null)
 {
@@ -2655,6 +2775,24 @@ bool MatchIndex::SetIndexColumn(
     return res;
 }
 
+inline bool MatchIndex::IsUsable() const
+{
+    if (m_ix->GetIndexingMethod() != MOT::IndexingMethod::INDEXING_METHOD_HASH) {
+        return (m_colMatch[0][0] != nullptr);
+    }
+
+    // hash index serves only equality on every key column, without any additional bound
+    for (int i = 0; i < m_ix->GetNumFields(); i++) {
+        if (m_colMatch[0][i] == nullptr || m_opers[0][i] != KEY_OPER::READ_KEY_EXACT) {
+            return false;
+        }
+        if (m_colMatch[1][i] != nullptr && m_opers[1][i] != KEY_OPER::READ_KEY_EXACT) {
+            return false;
+        }
+    }
+    return true;
+}
+
 inline bool MatchIndex::IsFullMatch() const
 {
     return (m_numMatches[0] == m_ix->GetNumFields() || m_numMatches[1] == m_ix->GetNumFields());
@@ -2841,6 +2979,10 @@ bool MatchIndex::CanApplyOrdering(const int* orderCols) const
 {
     int16_t numKeyCols = m_ix->GetNumFields();
 
+    if (m_ix->GetIndexingMethod() == MOT::IndexingMethod::INDEXING_METHOD_HASH) {
+        return false;
+    }
+
     // check if order columns are overlap index matched columns or are suffix for it
     for (int16_t i = 0; i < numKeyCols; i++) {
         // overlap: we can use index ordering
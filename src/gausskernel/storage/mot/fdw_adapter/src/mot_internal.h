@@ -82,6 +82,7 @@ using std::string;
 
 // forward declaration
 struct CreateStmt;
+class VectorBatch;
 
 namespace MOT {
 class Table;
@@ -106,6 +107,9 @@ void report_pg_error(MOT::RC rc, MOT::TxnManager* txn, void* arg1 = nullptr, voi
 #define KEY_OPER_PREFIX_BITMASK 0x10
 #define MAX_VARCHAR_LEN 1024
 
+// number of rows whose sentinels and data are prefetched together by the vectorized scan
+#define MOT_VEC_PREFETCH_ROWS 16
+
 typedef enum : uint8_t {
     READ_KEY_EXACT = 0,    // equal
     READ_KEY_LIKE = 1,     // like
@@ -203,10 +207,7 @@ public:
     void ClearPreviousMatch(MOTFdwStateSt* state, bool set_local, int i, int j);
     bool SetIndexColumn(MOTFdwStateSt* state, int16_t colNum, KEY_OPER op, Expr* expr, Expr* parent, bool set_local);
 
-    inline bool IsUsable() const
-    {
-        return (m_colMatch[0][0] != nullptr);
-    }
+    inline bool IsUsable() const;
     inline bool IsFullMatch() const;
 
     inline int32_t GetNumMatchedCols() const
@@ -321,6 +322,7 @@ public:
     static void DeleteTablePtr(MOT::Table* t);
 
     static MOT::RC CreateTable(CreateForeignTableStmt* table, TransactionId tid);
+    static bool IsNumaPartitionRequested(List* options);
     static MOT::RC CreateIndex(IndexStmt* index, TransactionId tid);
     static MOT::RC DropIndex(DropForeignStmt* stmt, TransactionId tid);
     static MOT::RC DropTable(DropForeignStmt* stmt, TransactionId tid);
@@ -388,10 +390,14 @@ public:
     static void PackRow(TupleTableSlot* slot, MOT::Table* table, uint8_t* attrs_used, uint8_t* destRow);
     static void PackUpdateRow(TupleTableSlot* slot, MOT::Table* table, const uint8_t* attrs_used, uint8_t* destRow);
     static void UnpackRow(TupleTableSlot* slot, MOT::Table* table, const uint8_t* attrs_used, uint8_t* srcRow);
+    static void UnpackRow(VectorBatch* batch, int rowIdx, TupleDesc tupdesc, MOT::Table* table,
+        const uint8_t* attrs_used, uint8_t* srcRow);
 
     // scan helpers
     static void OpenCursor(Relation rel, MOTFdwStateSt* festate);
     static bool IsScanEnd(MOTFdwStateSt* festate);
+    static void GetScanBound(MOTFdwStateSt* festate, const MOT::Key*& endKey, uint16_t& cmpLen);
+    static void EnableCursorReadAhead(MOTFdwStateSt* festate);
     static void CreateKeyBuffer(Relation rel, MOTFdwStateSt* festate, int start);
 
     // planning helpers
@@ -90,6 +90,8 @@ extern const char* CommandToString(JitCommandType commandType)
             return "Aggregate-Range-Join";
         case JIT_COMMAND_COMPOUND_SELECT:
             return "Compound-Select";
+        case JIT_COMMAND_GROUP_BY_RANGE_SELECT:
+            return "Group-By-Range-Select";
 
         case JIT_COMMAND_INVALID:
         default:
@@ -105,6 +107,7 @@ extern bool IsRangeCommand(JitCommandType commandType)
         case JIT_COMMAND_RANGE_UPDATE:
         case JIT_COMMAND_RANGE_SELECT:
         case JIT_COMMAND_AGGREGATE_RANGE_SELECT:
+        case JIT_COMMAND_GROUP_BY_RANGE_SELECT:
         case JIT_COMMAND_POINT_JOIN:
         case JIT_COMMAND_RANGE_JOIN:
         case JIT_COMMAND_AGGREGATE_JOIN:
@@ -315,6 +315,17 @@ extern bool PrepareJitContext(JitContext* jitContext)
         }
     }
 
+    // allocate group keys for GROUP BY range select command
+    if ((jitContext->m_groupByKey == NULL) && (jitContext->m_commandType == JIT_COMMAND_GROUP_BY_RANGE_SELECT)) {
+        MOT_LOG_TRACE("Preparing group keys for GROUP BY command from index %s", jitContext->m_index->GetName().c_str());
+        jitContext->m_groupByKey = PrepareJitSearchKey(jitContext, jitContext->m_index);
+        jitContext->m_nextGroupByKey = PrepareJitSearchKey(jitContext, jitContext->m_index);
+        if ((jitContext->m_groupByKey == NULL) || (jitContext->m_nextGroupByKey == NULL)) {
+            MOT_LOG_TRACE("Failed to allocate reusable group keys for JIT context, aborting jitted code execution");
+            return false;  // safe cleanup during destroy
+        }
+    }
+
     // allocate inner loop search key for JOIN commands
     if ((jitContext->m_innerSearchKey == NULL) && IsJoinCommand(jitContext->m_commandType)) {
         MOT_LOG_TRACE(
@@ -536,6 +547,16 @@ static void CleanupJitContextPrimary(JitContext* jitContext)
                 jitContext->m_index->DestroyKey(jitContext->m_endIteratorKey);
                 jitContext->m_endIteratorKey = NULL;
             }
+
+            if (jitContext->m_groupByKey != nullptr) {
+                jitContext->m_index->DestroyKey(jitContext->m_groupByKey);
+                jitContext->m_groupByKey = NULL;
+            }
+
+            if (jitContext->m_nextGroupByKey != nullptr) {
+                jitContext->m_index->DestroyKey(jitContext->m_nextGroupByKey);
+                jitContext->m_nextGroupByKey = NULL;
+            }
         }
 
         // cleanup JOIN outer row copy
@@ -203,10 +203,17 @@ struct JitContext {
     /** @var The number of full query executions. */
     uint64_t m_queryCount;  // L1 offset 24
 
+    /*---------------------- GROUP BY execution state -------------------*/
+    /** @var The index key of the first row in the current group. */
+    MOT::Key* m_groupByKey;  // L1 offset 32 (reusable)
+
+    /** @var The index key of the currently scanned row, compared with the key of the current group. */
+    MOT::Key* m_nextGroupByKey;  // L1 offset 40 (reusable)
+
     /*---------------------- Debug execution state -------------------*/
     /** @var The number of times this context was invoked for execution. */
 #ifdef MOT_JIT_DEBUG
-    uint64_t m_execCount;  // L1 offset 32
+    uint64_t m_execCount;  // L1 offset 48
 #endif
 };
 
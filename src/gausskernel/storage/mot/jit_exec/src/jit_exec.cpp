@@ -65,6 +65,20 @@ DECLARE_LOGGER(LiteExecutor, JitExec);
 
 static pthread_spinlock_t jitConfigLock;
 
+static bool IsMultiJoinQuery(const Query* query)
+{
+    // JIT joins are built around one outer and one inner index scan, so joining more tables is not supported
+    int relationCount = 0;
+    ListCell* lc = nullptr;
+    foreach (lc, query->rtable) {
+        RangeTblEntry* rte = (RangeTblEntry*)lfirst(lc);
+        if (rte->rtekind == RTE_RELATION) {
+            ++relationCount;
+        }
+    }
+    return (relationCount > 2);
+}
+
 extern JitPlan* IsJittable(Query* query, const char* queryString)
 {
     JitPlan* jitPlan = NULL;
@@ -127,6 +141,9 @@ extern JitPlan* IsJittable(Query* query, const char* queryString)
         JitStatisticsProvider::GetInstance().AddUnjittableLimitQuery();
     } else if (jitPlan == nullptr) {
         JitStatisticsProvider::GetInstance().AddUnjittableDisqualifiedQuery();
+        if ((query->commandType == CMD_SELECT) && IsMultiJoinQuery(query)) {
+            JitStatisticsProvider::GetInstance().AddUnjittableMultiJoinQuery();
+        }
     } else {
         // whether generating or cloning code, this is a jittable query
         JitStatisticsProvider::GetInstance().AddJittableQuery();
@@ -135,6 +152,34 @@ extern JitPlan* IsJittable(Query* query, const char* queryString)
     return jitPlan;
 }
 
+static void AddCodeGenQueryKind(JitStatisticsProvider& instance, JitCommandType commandType)
+{
+    // track coverage of jitted query shapes beyond simple point and range queries
+    switch (commandType) {
+        case JIT_COMMAND_AGGREGATE_RANGE_SELECT:
+            instance.AddCodeGenAggregateQuery();
+            break;
+
+        case JIT_COMMAND_GROUP_BY_RANGE_SELECT:
+            instance.AddCodeGenAggregateQuery();
+            instance.AddCodeGenGroupByQuery();
+            break;
+
+        case JIT_COMMAND_AGGREGATE_JOIN:
+            instance.AddCodeGenAggregateQuery();
+            instance.AddCodeGenJoinQuery();
+            break;
+
+        case JIT_COMMAND_POINT_JOIN:
+        case JIT_COMMAND_RANGE_JOIN:
+            instance.AddCodeGenJoinQuery();
+            break;
+
+        default:
+            break;
+    }
+}
+
 static void ProcessJitResult(MOT::RC result, JitContext* jitContext)
 {
     // NOTE: errors might be reported in a better way, so this part can be reviewed sometime
@@ -142,7 +187,8 @@ static void ProcessJitResult(MOT::RC result, JitContext* jitContext)
     if (result == MOT::RC_LOCAL_ROW_NOT_FOUND) {
         if ((jitContext->m_commandType == JIT_COMMAND_DELETE) || (jitContext->m_commandType == JIT_COMMAND_SELECT) ||
             (jitContext->m_commandType == JIT_COMMAND_RANGE_SELECT) ||
-            (jitContext->m_commandType == JIT_COMMAND_COMPOUND_SELECT)) {
+            (jitContext->m_commandType == JIT_COMMAND_COMPOUND_SELECT) ||
+            (jitContext->m_commandType == JIT_COMMAND_GROUP_BY_RANGE_SELECT)) {
             // this is considered as successful execution
             JitStatisticsProvider::GetInstance().AddExecQuery();
             return;
@@ -212,6 +258,7 @@ static JitContext* GenerateJitContext(Query* query, const char* queryString, Jit
                 JitStatisticsProvider& instance = JitStatisticsProvider::GetInstance();
                 instance.AddCodeGenTime(MOT::CpuCyclesLevelTime::CyclesToMicroseconds(endTime - startTime));
                 instance.AddCodeGenQuery();
+                AddCodeGenQueryKind(instance, sourceJitContext->m_commandType);
                 instance.AddCodeCloneQuery();
             } else {
                 // this is illegal state transition error in JIT source (internal bug)
@@ -363,6 +410,9 @@ extern int JitExecQuery(
         JitStatisticsProvider::GetInstance().AddFailExecQuery();
         report_pg_error(MOT::RC_MEMORY_ALLOCATION_ERROR, NULL);  // execution control ends, calls ereport(error,...)
     }
+    if (u_sess->attr.attr_common.XactReadOnly) {
+        u_sess->mot_cxt.jit_txn->StartSnapshotRead();
+    }
 
     // during the very first invocation of the query we need to setup the reusable search key
     // since during prepare we still don't have an MOT SessionContext for the calling thread
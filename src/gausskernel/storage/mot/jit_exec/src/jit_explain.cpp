@@ -658,7 +658,15 @@ static void ExplainRangeSelectPlan(Query* query, JitRangeSelectPlan* plan, bool
             MOT_LOG_TRACE("%*sLIMIT %d", indent, "", plan->_limit_count);
         }
     }
-    if (plan->_aggregate._aggreaget_op == JIT_AGGREGATE_NONE) {
+    if (plan->_group_by._prefix_column_count > 0) {
+        indent += 2;
+        MOT_LOG_TRACE("%*sGROUP BY %d index columns (%d key bytes)",
+            indent,
+            "",
+            plan->_group_by._prefix_column_count,
+            plan->_group_by._prefix_key_length);
+    }
+    if ((plan->_aggregate._aggreaget_op == JIT_AGGREGATE_NONE) || (plan->_group_by._prefix_column_count > 0)) {
         if (isSubQuery) {
             MOT_LOG_APPEND(MOT::LogLevel::LL_TRACE, " SELECT");
             ExplainSelectExprArray(query, (JitPlan*)plan, &plan->_select_exprs);
@@ -747,6 +747,16 @@ MOT::IndexIterator* searchIterator(MOT::Index* index, MOT::Key* key, int forward
         MOT_LOG_DEBUG("searchIterator: Exact match found with iterator %p", itr);
     }
 
+    // scan loops consume one row at a time, so let the iterator read ahead in batches (the scan bound is bound
+    // lazily on first access, since the end iterator is created only after the begin iterator)
+    if (itr != nullptr) {
+        MOT::IndexIterator* batchedItr = new (std::nothrow) MOT::BatchedIndexIterator(itr);
+        if (batchedItr != nullptr) {
+            MOT_LOG_DEBUG("searchIterator: Wrapped iterator %p with read-ahead iterator %p", itr, batchedItr);
+            itr = batchedItr;
+        }
+    }
+
     return itr;
 }
 
@@ -778,11 +788,23 @@ MOT::IndexIterator* createEndIterator(MOT::Index* index, MOT::Key* key, int forw
     return itr;
 }
 
+static inline void setScanBound(MOT::Index* index, MOT::IndexIterator* itr, MOT::IndexIterator* end_itr)
+{
+    if (itr != nullptr) {
+        const MOT::Key* endKey = nullptr;
+        if (end_itr != nullptr && end_itr->IsValid()) {
+            endKey = reinterpret_cast<const MOT::Key*>(end_itr->GetKey());
+        }
+        itr->SetScanBound(endKey, index->GetKeySizeNoSuffix());
+    }
+}
+
 int isScanEnd(MOT::Index* index, MOT::IndexIterator* itr, MOT::IndexIterator* end_itr, int forward_scan)
 {
     MOT_LOG_DEBUG("Checking if scan ended");
 
     int res = 0;
+    setScanBound(index, itr, end_itr);
 
     if (itr != nullptr && !itr->IsValid()) {
         MOT_LOG_DEBUG("isScanEnd(): begin iterator is not valid");
@@ -796,11 +818,15 @@ int isScanEnd(MOT::Index* index, MOT::IndexIterator* itr, MOT::IndexIterator* en
 
         if (itr != nullptr) {
             startKey = reinterpret_cast<const MOT::Key*>(const_cast<void*>(itr->GetKey()));
-            MOT_LOG_DEBUG("Start key: %s", MOT::HexStr(startKey->GetKeyBuf(), startKey->GetKeyLength()).c_str());
+            if (startKey != nullptr) {
+                MOT_LOG_DEBUG("Start key: %s", MOT::HexStr(startKey->GetKeyBuf(), startKey->GetKeyLength()).c_str());
+            }
         }
         if (end_itr != nullptr) {
             endKey = reinterpret_cast<const MOT::Key*>(const_cast<void*>(end_itr->GetKey()));
-            MOT_LOG_DEBUG("End key:   %s", MOT::HexStr(endKey->GetKeyBuf(), endKey->GetKeyLength()).c_str());
+            if (endKey != nullptr) {
+                MOT_LOG_DEBUG("End key:   %s", MOT::HexStr(endKey->GetKeyBuf(), endKey->GetKeyLength()).c_str());
+            }
         }
 
         if (startKey != nullptr && endKey != nullptr) {
@@ -833,6 +859,7 @@ MOT::Row* getRowFromIterator(
 
     MOT_LOG_DEBUG("getRowFromIterator(): Retrieving row from iterator %p", itr);
     MOT::TxnManager* curr_txn = u_sess->mot_cxt.jit_txn;
+    setScanBound(index, itr, end_itr);
     do {
         // get row from iterator using primary sentinel
         MOT::Sentinel* sentinel = itr->GetPrimarySentinel();
@@ -1099,6 +1126,26 @@ int getStateLimitCounter()
     MOT_LOG_DEBUG("Retrieved state limit counter with value %d", u_sess->mot_cxt.jit_context->m_limitCounter);
 }
 
+void setGroupByKey(MOT::Row* row)
+{
+    JitContext* jitContext = u_sess->mot_cxt.jit_context;
+    jitContext->m_index->BuildKey(jitContext->m_table, row, jitContext->m_groupByKey);
+    MOT_LOG_DEBUG("Set group key from row %p", row);
+}
+
+int isSameGroupByKey(MOT::Row* row, int prefix_length)
+{
+    JitContext* jitContext = u_sess->mot_cxt.jit_context;
+    jitContext->m_index->BuildKey(jitContext->m_table, row, jitContext->m_nextGroupByKey);
+    int result = (memcmp(jitContext->m_groupByKey->GetKeyBuf(),
+                      jitContext->m_nextGroupByKey->GetKeyBuf(),
+                      (size_t)prefix_length) == 0)
+                     ? 1
+                     : 0;
+    MOT_LOG_DEBUG("Checked if row %p is in current group (prefix_length=%d): result=%d", row, prefix_length, result);
+    return result;
+}
+
 void prepareAvgArray(int element_type, int element_count)
 {
     MOT_LOG_DEBUG("Preparing AVG() array with %d elements of type %d", element_count, element_type);
@@ -450,6 +450,21 @@ void incrementStateLimitCounter();
 /** @brief Retrieves the limit counter for stateful scan with LIMIT clause. */
 int getStateLimitCounter();
 
+/*---------------------------  GROUP BY Helpers ---------------------------*/
+/**
+ * @brief Saves the index key of the first row in a new group.
+ * @param row The first row in the group.
+ */
+void setGroupByKey(MOT::Row* row);
+
+/**
+ * @brief Queries whether a row belongs to the current group.
+ * @param row The row to check.
+ * @param prefix_length The length in bytes of the grouping index key prefix.
+ * @return Non-zero value if the row has the same grouping key prefix as the current group.
+ */
+int isSameGroupByKey(MOT::Row* row, int prefix_length);
+
 /*---------------------------  Aggregation Helpers ---------------------------*/
 /*---------------------------  Average Helpers ---------------------------*/
 /**
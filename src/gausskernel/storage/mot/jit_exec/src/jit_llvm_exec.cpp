@@ -178,6 +178,9 @@ struct JitLlvmCodeGenContext {
     llvm::Constant* incrementStateLimitCounterFunc;
     llvm::Constant* getStateLimitCounterFunc;
 
+    llvm::Constant* setGroupByKeyFunc;
+    llvm::Constant* isSameGroupByKeyFunc;
+
     llvm::Constant* prepareAvgArrayFunc;
     llvm::Constant* loadAvgArrayFunc;
     llvm::Constant* saveAvgArrayFunc;
@@ -716,6 +719,18 @@ static void defineGetStateLimitCounter(JitLlvmCodeGenContext* ctx, llvm::Module*
     ctx->getStateLimitCounterFunc = defineFunction(module, ctx->INT32_T, "getStateLimitCounter", nullptr);
 }
 
+static void defineSetGroupByKey(JitLlvmCodeGenContext* ctx, llvm::Module* module)
+{
+    ctx->setGroupByKeyFunc =
+        defineFunction(module, ctx->VOID_T, "setGroupByKey", ctx->RowType->getPointerTo(), nullptr);
+}
+
+static void defineIsSameGroupByKey(JitLlvmCodeGenContext* ctx, llvm::Module* module)
+{
+    ctx->isSameGroupByKeyFunc = defineFunction(
+        module, ctx->INT32_T, "isSameGroupByKey", ctx->RowType->getPointerTo(), ctx->INT32_T, nullptr);
+}
+
 static void definePrepareAvgArray(JitLlvmCodeGenContext* ctx, llvm::Module* module)
 {
     ctx->prepareAvgArrayFunc =
@@ -922,6 +937,9 @@ static void InitCodeGenContextFuncs(JitLlvmCodeGenContext* ctx)
     defineIncrementStateLimitCounter(ctx, module);
     defineGetStateLimitCounter(ctx, module);
 
+    defineSetGroupByKey(ctx, module);
+    defineIsSameGroupByKey(ctx, module);
+
     definePrepareAvgArray(ctx, module);
     defineLoadAvgArray(ctx, module);
     defineSaveAvgArray(ctx, module);
@@ -1722,6 +1740,19 @@ static llvm::Value* AddGetStateLimitCounter(JitLlvmCodeGenContext* ctx)
     return AddFunctionCall(ctx, ctx->getStateLimitCounterFunc, nullptr);
 }
 
+/** @brief Adds a call to setGroupByKey(row). */
+static void AddSetGroupByKey(JitLlvmCodeGenContext* ctx, llvm::Value* row)
+{
+    AddFunctionCall(ctx, ctx->setGroupByKeyFunc, row, nullptr);
+}
+
+/** @brief Adds a call to isSameGroupByKey(row, prefix_length). */
+static llvm::Value* AddIsSameGroupByKey(JitLlvmCodeGenContext* ctx, llvm::Value* row, int prefix_length)
+{
+    llvm::ConstantInt* prefix_length_value = llvm::ConstantInt::get(ctx->INT32_T, prefix_length, true);
+    return AddFunctionCall(ctx, ctx->isSameGroupByKeyFunc, row, prefix_length_value, nullptr);
+}
+
 static void AddPrepareAvgArray(JitLlvmCodeGenContext* ctx, int element_type, int element_count)
 {
     llvm::ConstantInt* element_type_value = llvm::ConstantInt::get(ctx->INT32_T, element_type, true);
@@ -4080,10 +4111,10 @@ static void buildAggregateResult(JitLlvmCodeGenContext* ctx, const JitAggregate*
     if (aggregate->_aggreaget_op == JIT_AGGREGATE_AVG) {
         llvm::Value* avg_value = AddComputeAvgFromArray(
             ctx, aggregate->_avg_element_type);  // we infer this during agg op analysis, but don't save it...
-        AddWriteTupleDatum(ctx, 0, avg_value);   // we alway aggregate to slot tuple 0
+        AddWriteTupleDatum(ctx, aggregate->_tuple_column_id, avg_value);
     } else {
         llvm::Value* count_value = AddGetAggValue(ctx);
-        AddWriteTupleDatum(ctx, 0, count_value);  // we alway aggregate to slot tuple 0
+        AddWriteTupleDatum(ctx, aggregate->_tuple_column_id, count_value);
     }
 
     // we take the opportunity to cleanup as well
@@ -4707,6 +4738,137 @@ static JitContext* JitAggregateRangeSelectCodegen(
     return jit_context;
 }
 
+/**
+ * @brief Generates code for range SELECT query with aggregator and GROUP BY clause. The grouping columns make up a
+ * prefix of the scanned index, so rows of each group are adjacent in the scan. Each call produces a single group, and
+ * the first row of the next group is kept in the state row for the next call.
+ */
+static JitContext* JitGroupByRangeSelectCodegen(
+    const Query* query, const char* query_string, JitRangeSelectPlan* plan)
+{
+    MOT_LOG_DEBUG("Generating code for MOT GROUP BY range select at thread %p", (void*)pthread_self());
+
+    GsCodeGen* code_gen = SetupCodegenEnv();
+    if (code_gen == nullptr) {
+        return nullptr;
+    }
+    GsCodeGen::LlvmBuilder builder(code_gen->context());
+
+    JitLlvmCodeGenContext cg_ctx = {0};
+    MOT::Table* table = plan->_index_scan._table;
+    int index_id = plan->_index_scan._index_id;
+    if (!InitCodeGenContext(&cg_ctx, code_gen, &builder, table, table->GetIndex(index_id))) {
+        return nullptr;
+    }
+    JitLlvmCodeGenContext* ctx = &cg_ctx;
+
+    // prepare the jitted function (declare, get arguments into context and define locals)
+    CreateJittedFunction(ctx, "MotJittedGroupByRangeSelect");
+    IssueDebugLog("Starting execution of jitted GROUP BY range SELECT");
+
+    // initialize rows_processed local variable
+    buildResetRowsProcessed(ctx);
+
+    // clear tuple even if row is not found later
+    AddExecClearTuple(ctx);
+
+    // emit code to cleanup previous scan in case this is a new scan (including first row of pending group)
+    AddCleanupOldScan(ctx);
+    JIT_IF_BEGIN(reset_pending_group)
+    JIT_IF_EVAL(ctx->isNewScanValue)
+    AddResetStateRow(ctx, JIT_RANGE_SCAN_MAIN);
+    JIT_IF_END()
+
+    // prepare stateful scan if not done so already, if no row exists then emit code to return from function
+    int max_arg = 0;
+    MOT::AccessType access_mode = query->hasForUpdate ? MOT::AccessType::RD_FOR_UPDATE : MOT::AccessType::RD;
+    llvm::Value* row = buildPrepareStateScanRow(
+        ctx, &plan->_index_scan, JIT_RANGE_SCAN_MAIN, access_mode, &max_arg, nullptr, nullptr, nullptr);
+    if (row == nullptr) {
+        MOT_LOG_TRACE("Failed to generate jitted code for GROUP BY range select query: unsupported WHERE clause type");
+        DestroyCodeGenContext(ctx);
+        return nullptr;
+    }
+
+    // the first row of the group provides the grouping columns and the group key
+    prepareAggregate(ctx, &plan->_aggregate);
+    if (!selectRowColumns(ctx, row, &plan->_select_exprs, &max_arg, JIT_RANGE_SCAN_MAIN)) {
+        MOT_LOG_TRACE("Failed to generate jitted code for GROUP BY range SELECT query: failed to select row "
+                      "expressions");
+        DestroyCodeGenContext(ctx);
+        return nullptr;
+    }
+    AddSetGroupByKey(ctx, row);
+    buildAggregateRow(ctx, &plan->_aggregate, row, nullptr);
+    AddResetStateRow(ctx, JIT_RANGE_SCAN_MAIN);
+
+    // aggregate following rows until the group key changes
+    JitIndexScanDirection index_scan_direction = plan->_index_scan._scan_direction;
+    JIT_WHILE_BEGIN(group_by_aggregate_loop)
+    llvm::Value* res = AddIsStateScanEnd(ctx, index_scan_direction, JIT_RANGE_SCAN_MAIN);
+    JIT_WHILE_EVAL_NOT(res)
+    llvm::Value* next_row = AddGetRowFromStateIterator(ctx, access_mode, index_scan_direction, JIT_RANGE_SCAN_MAIN);
+    JIT_IF_BEGIN(test_next_row_found)
+    JIT_IF_EVAL_NOT(next_row)
+    IssueDebugLog("Could not retrieve row from state iterator, group is complete");
+    JIT_WHILE_BREAK()
+    JIT_IF_END()
+
+    // check for additional filters, if not try to fetch next row
+    if (!buildFilterRow(ctx, next_row, &plan->_index_scan._filters, &max_arg, JIT_WHILE_COND_BLOCK())) {
+        MOT_LOG_TRACE("Failed to generate jitted code for GROUP BY range SELECT query: unsupported filter");
+        DestroyCodeGenContext(ctx);
+        return nullptr;
+    }
+
+    // a row with a different key starts the next group, so keep it for the next call
+    JIT_IF_BEGIN(test_same_group)
+    llvm::Value* same_group = AddIsSameGroupByKey(ctx, next_row, plan->_group_by._prefix_key_length);
+    JIT_IF_EVAL_NOT(same_group)
+    IssueDebugLog("Found first row of next group");
+    AddSetStateRow(ctx, next_row, JIT_RANGE_SCAN_MAIN);
+    JIT_WHILE_BREAK()
+    JIT_IF_END()
+
+    buildAggregateRow(ctx, &plan->_aggregate, next_row, nullptr);
+    JIT_WHILE_END()
+
+    // wrap up aggregation and write group to result tuple
+    IssueDebugLog("Reached end of group");
+    buildAggregateResult(ctx, &plan->_aggregate);
+    AddExecStoreVirtualTuple(ctx);
+
+    // if there is no pending group then this was the last group
+    JIT_IF_BEGIN(test_last_group)
+    llvm::Value* last_group = AddIsStateRowNull(ctx, JIT_RANGE_SCAN_MAIN);
+    JIT_IF_EVAL(last_group)
+    IssueDebugLog("No more groups, cleaning up iterators");
+    AddDestroyStateIterators(ctx, JIT_RANGE_SCAN_MAIN);
+    AddSetScanEnded(ctx, 1);
+    JIT_IF_END()
+
+    // one result row for the group (rows processed during aggregation are not reported)
+    buildResetRowsProcessed(ctx);
+    buildIncrementRowsProcessed(ctx);
+
+    // if a limit clause exists, then increment limit counter and check if reached limit
+    buildCheckLimit(ctx, plan->_limit_count);
+
+    // execute *tp_processed = rows_processed
+    AddSetTpProcessed(ctx);
+
+    // return success from calling function
+    builder.CreateRet(llvm::ConstantInt::get(ctx->INT32_T, (int)MOT::RC_OK, true));
+
+    // wrap up
+    JitContext* jit_context = FinalizeCodegen(ctx, max_arg, JIT_COMMAND_GROUP_BY_RANGE_SELECT);
+
+    // cleanup
+    DestroyCodeGenContext(ctx);
+
+    return jit_context;
+}
+
 static JitContext* JitPointJoinCodegen(const Query* query, const char* query_string, JitJoinPlan* plan)
 {
     MOT_LOG_DEBUG("Generating code for MOT Point JOIN query at thread %p", (void*)pthread_self());
@@ -5575,6 +5737,8 @@ static JitContext* JitRangeScanCodegen(Query* query, const char* query_string, J
             JitRangeSelectPlan* range_select_plan = (JitRangeSelectPlan*)plan;
             if (range_select_plan->_aggregate._aggreaget_op == JIT_AGGREGATE_NONE) {
                 jit_context = JitRangeSelectCodegen(query, query_string, range_select_plan);
+            } else if (range_select_plan->_group_by._prefix_column_count > 0) {
+                jit_context = JitGroupByRangeSelectCodegen(query, query_string, range_select_plan);
             } else {
                 jit_context = JitAggregateRangeSelectCodegen(query, query_string, range_select_plan);
             }
@@ -1545,7 +1545,8 @@ static bool countWhereClauseEqualsLeaves(Query* query, MOT::Table* table, MOT::I
         return false;                                                            \
     }
 
-static bool CheckQueryAttributes(const Query* query, bool allowSorting, bool allowAggregate, bool allowSublink)
+static bool CheckQueryAttributes(
+    const Query* query, bool allowSorting, bool allowAggregate, bool allowSublink, bool allowGroupBy = false)
 {
     checkJittableAttribute(query, hasWindowFuncs);
     checkJittableAttribute(query, hasDistinctOn);
@@ -1553,7 +1554,9 @@ static bool CheckQueryAttributes(const Query* query, bool allowSorting, bool all
     checkJittableAttribute(query, hasModifyingCTE);
 
     checkJittableClause(query, returningList);
-    checkJittableClause(query, groupClause);
+    if (!allowGroupBy) {
+        checkJittableClause(query, groupClause);
+    }
     checkJittableClause(query, groupingSets);
     checkJittableClause(query, havingQual);
     checkJittableClause(query, windowClause);
@@ -1979,6 +1982,157 @@ static bool isPlanSortOrderValid(Query* query, JitRangeSelectPlan* plan)
     return result;
 }
 
+static bool isGroupClauseTargetEntry(const Query* query, const TargetEntry* target_entry)
+{
+    if (target_entry->ressortgroupref == 0) {
+        return false;
+    }
+
+    ListCell* lc = nullptr;
+    foreach (lc, query->groupClause) {
+        SortGroupClause* sgc = (SortGroupClause*)lfirst(lc);
+        if (sgc->tleSortGroupRef == target_entry->ressortgroupref) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool prepareGroupBySelectExpressions(Query* query, JitSelectExprArray* expr_array)
+{
+    // with a GROUP BY clause the target list is made of one aggregate and any subset of the grouping columns
+    MOT_LOG_TRACE("Preparing GROUP BY target expressions");
+    int expr_count = 0;
+    ListCell* lc = nullptr;
+    foreach (lc, query->targetList) {
+        TargetEntry* target_entry = (TargetEntry*)lfirst(lc);
+        if (!target_entry->resjunk && (target_entry->expr->type != T_Aggref)) {
+            if (!isGroupClauseTargetEntry(query, target_entry)) {
+                MOT_LOG_TRACE("prepareGroupBySelectExpressions(): Disqualifying query - target entry %d is neither "
+                              "an aggregate nor a grouping column",
+                    (int)target_entry->resno);
+                return false;
+            }
+            ++expr_count;
+        }
+    }
+
+    MOT_LOG_TRACE("Counted %d grouping target expressions", expr_count);
+    if (expr_count == 0) {
+        // grouping columns are not projected
+        expr_array->_exprs = nullptr;
+        expr_array->_count = 0;
+        return true;
+    }
+    if (!allocSelectExprArray(expr_array, expr_count)) {
+        MOT_LOG_TRACE("Failed to allocate select expression array with %d items", expr_count);
+        return false;
+    }
+
+    int i = 0;
+    foreach (lc, query->targetList) {
+        TargetEntry* target_entry = (TargetEntry*)lfirst(lc);
+        if (target_entry->resjunk || (target_entry->expr->type == T_Aggref)) {
+            continue;
+        }
+        JitExpr* sub_expr = parseExpr(query, target_entry->expr, 0, 0);
+        if (sub_expr == nullptr) {
+            MOT_LOG_TRACE("prepareGroupBySelectExpressions(): Failed to parse select expression %d", i);
+            freeSelectExprArray(expr_array);
+            return false;
+        }
+        expr_array->_exprs[i]._column_expr = (JitVarExpr*)sub_expr;
+        expr_array->_exprs[i]._tuple_column_id = target_entry->resno - 1;
+        ++i;
+        if (sub_expr->_expr_type != JIT_EXPR_TYPE_VAR) {
+            MOT_LOG_TRACE("prepareGroupBySelectExpressions(): Unexpected non-var expression");
+            freeSelectExprArray(expr_array);
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool isPlanGroupByValid(Query* query, JitRangeSelectPlan* plan)
+{
+    // grouping is carried out on the fly while scanning, so the grouping columns must make up a prefix of the
+    // scanned index (possibly with holes filled by columns bound with equals operator in the WHERE clause), such
+    // that all rows of a group are adjacent in the scan, and the group boundary is detected by comparing key prefixes
+    MOT::Table* table = plan->_index_scan._table;
+    MOT::Index* index = table->GetIndex(plan->_index_scan._index_id);
+    int key_column_count = index->GetNumFields();
+    bool* grouped_columns = (bool*)calloc(key_column_count, sizeof(bool));
+    if (grouped_columns == nullptr) {
+        MOT_LOG_TRACE("isPlanGroupByValid(): Disqualifying query - memory allocation failed");
+        return false;
+    }
+
+    int prefix_column_count = 0;
+    ListCell* lc = nullptr;
+    foreach (lc, query->groupClause) {
+        SortGroupClause* sgc = (SortGroupClause*)lfirst(lc);
+        if (sgc->groupSet) {
+            MOT_LOG_TRACE("isPlanGroupByValid(): Disqualifying query - grouping sets are not supported");
+            free(grouped_columns);
+            return false;
+        }
+
+        TargetEntry* te = getRefTargetEntry(query->targetList, sgc->tleSortGroupRef);
+        if ((te == nullptr) || (te->expr->type != T_Var)) {
+            MOT_LOG_TRACE("isPlanGroupByValid(): Disqualifying query - GROUP BY clause item is not a column");
+            free(grouped_columns);
+            return false;
+        }
+
+        int table_column_id = ((Var*)te->expr)->varattno;
+        int index_column_id = MapTableColumnToIndex(table, index, table_column_id);
+        if ((index_column_id < 0) || (index_column_id >= key_column_count)) {
+            MOT_LOG_TRACE("isPlanGroupByValid(): Disqualifying plan - GROUP BY column %d is not a column of index %s",
+                table_column_id,
+                index->GetName().c_str());
+            free(grouped_columns);
+            return false;
+        }
+
+        // null values are not distinguishable from zero values in the index key
+        if (!table->GetField(table_column_id)->m_isNotNull) {
+            MOT_LOG_TRACE("isPlanGroupByValid(): Disqualifying query - GROUP BY column %d is nullable", table_column_id);
+            free(grouped_columns);
+            return false;
+        }
+
+        grouped_columns[index_column_id] = true;
+        if (index_column_id + 1 > prefix_column_count) {
+            prefix_column_count = index_column_id + 1;
+        }
+    }
+
+    // any index column in the grouping prefix that is not grouped must be bound with equals operator
+    int equals_column_count = plan->_index_scan._column_count;
+    if ((plan->_index_scan._scan_type == JIT_INDEX_SCAN_OPEN) ||
+        (plan->_index_scan._scan_type == JIT_INDEX_SCAN_SEMI_OPEN)) {
+        --equals_column_count;
+    }
+    const uint16_t* key_lengths = index->GetLengthKeyFields();
+    int prefix_key_length = 0;
+    for (int i = 0; i < prefix_column_count; ++i) {
+        if (!grouped_columns[i] && (i >= equals_column_count)) {
+            MOT_LOG_TRACE("isPlanGroupByValid(): Disqualifying plan - GROUP BY clause does not make up a prefix of "
+                          "index %s (hole found at index column %d)",
+                index->GetName().c_str(),
+                i);
+            free(grouped_columns);
+            return false;
+        }
+        prefix_key_length += key_lengths[i];
+    }
+    free(grouped_columns);
+
+    plan->_group_by._prefix_column_count = prefix_column_count;
+    plan->_group_by._prefix_key_length = prefix_key_length;
+    return true;
+}
+
 static int evalConstExpr(Expr* expr)
 {
     int result = -1;
@@ -2219,6 +2373,7 @@ static bool getTargetEntryAggregateOperator(Query* query, TargetEntry* target_en
                 aggregate->_table_column_id =
                     getRealColumnId(query, var_expr->varno, var_expr->varattno, aggregate->_table);
                 aggregate->_distinct = (agg_ref->aggdistinct != nullptr) ? true : false;
+                aggregate->_tuple_column_id = target_entry->resno - 1;
                 result = true;
             }
         }
@@ -2234,6 +2389,7 @@ static bool getAggregateOperator(Query* query, JitAggregate* aggregate)
     // if an aggregate operator is specified, then only one column can exist
     // so we check all target entries, and if one of them specifies an aggregate operator, then
     // it must be the only target entry in the query
+    // with a GROUP BY clause the other target entries are the grouping columns, but still only one aggregate is allowed
     ListCell* lc = nullptr;
 
     bool aggregate_found = false;
@@ -2243,10 +2399,15 @@ static bool getAggregateOperator(Query* query, JitAggregate* aggregate)
         TargetEntry* target_entry = (TargetEntry*)lfirst(lc);
         if (target_entry->expr->type == T_Aggref) {
             // found an aggregate target entry
+            if (aggregate_found) {
+                MOT_LOG_TRACE("getAggregateOperator(): Disqualifying query - only one aggregate is supported");
+                return false;
+            }
             aggregate_found = true;
-            if (entry_count != 1) {
+            if ((entry_count != 1) && (query->groupClause == nullptr)) {
                 MOT_LOG_TRACE(
                     "getAggregateOperator(): Disqualifying query - aggregate must specify only 1 target entry");
+                return false;
             }
             result = getTargetEntryAggregateOperator(query, target_entry, aggregate);
         }
@@ -2417,6 +2578,10 @@ static JitRangeScanPlan* JitPrepareRangeScanPlan(Query* query, MOT::Table* table
         table->GetTableName().c_str(),
         index_id,
         index->GetName().c_str());
+    if (index->GetIndexingMethod() == MOT::IndexingMethod::INDEXING_METHOD_HASH) {
+        MOT_LOG_TRACE("Disqualifying range scan - index %s is a hash index", index->GetName().c_str());
+        return nullptr;
+    }
     JitRangeScanPlan* plan = (JitRangeScanPlan*)MOT::MemSessionAlloc(alloc_size);
     if (plan == nullptr) {
         MOT_REPORT_ERROR(MOT_ERROR_OOM,
@@ -2480,7 +2645,7 @@ static JitPlan* JitPrepareRangeSelectPlan(Query* query, MOT::Table* table, JoinC
 
     // the limit count and aggregation can be inferred regardless of plan
     int limit_count = 0;
-    JitAggregate aggregate = {JIT_AGGREGATE_NONE, 0, 0, nullptr, 0, 0, 0, false};
+    JitAggregate aggregate = {JIT_AGGREGATE_NONE, 0, 0, nullptr, 0, 0, 0, false, 0};
     if (!getLimitCount(query, &limit_count) || !getAggregateOperator(query, &aggregate)) {
         MOT_LOG_TRACE(
             "JitPrepareRangeSelectPlan(): Disqualifying query - unsupported scan limit count or aggregate operation");
@@ -2489,9 +2654,20 @@ static JitPlan* JitPrepareRangeSelectPlan(Query* query, MOT::Table* table, JoinC
 
     // now we search for the best index/plan
     bool has_aggregate = (aggregate._aggreaget_op != JIT_AGGREGATE_NONE);
+    bool has_group_by = (query->groupClause != nullptr);
+    if (has_group_by && (!has_aggregate || aggregate._distinct)) {
+        MOT_LOG_TRACE("JitPrepareRangeSelectPlan(): Disqualifying query - GROUP BY clause requires a single "
+                      "non-distinct aggregate");
+        return nullptr;
+    }
     size_t alloc_size = sizeof(JitRangeSelectPlan);
 
     for (int index_id = 0; index_id < (int)table->GetNumIndexes(); ++index_id) {
+        // hash indexes serve point queries only (see JitPreparePointQueryPlan())
+        if (table->GetIndexingMethod(index_id) == MOT::IndexingMethod::INDEXING_METHOD_HASH) {
+            MOT_LOG_TRACE("Skipping hash index %d for range scan", index_id);
+            continue;
+        }
         MOT_LOG_TRACE("Attempting to prepare plan with index %d", index_id);
         JitRangeSelectPlan* next_plan = (JitRangeSelectPlan*)JitPrepareRangeScanPlan(
             query, table, index_id, alloc_size, JIT_COMMAND_SELECT, join_clause_type);
@@ -2503,7 +2679,22 @@ static JitPlan* JitPrepareRangeSelectPlan(Query* query, MOT::Table* table, JoinC
             break;
         }
 
-        if (!has_aggregate && !prepareSelectExpressions(query, &next_plan->_select_exprs)) {
+        if (has_group_by) {
+            // grouping depends on the index, so failure only disqualifies this candidate plan
+            if (!isPlanGroupByValid(query, next_plan)) {
+                MOT_LOG_TRACE("Disqualifying plan - Query GROUP BY clause is incompatible with index");
+                JitDestroyPlan((JitPlan*)next_plan);
+                continue;
+            }
+            if (!prepareGroupBySelectExpressions(query, &next_plan->_select_exprs)) {
+                MOT_LOG_TRACE("Failed to prepare range select plan with index %d: failed to prepare GROUP BY select "
+                              "expressions",
+                    index_id);
+                JitDestroyPlan((JitPlan*)next_plan);
+                clean_plan = true;
+                break;
+            }
+        } else if (!has_aggregate && !prepareSelectExpressions(query, &next_plan->_select_exprs)) {
             MOT_LOG_TRACE(
                 "Failed to prepare range select plan with index %d: failed to prepare select expressions", index_id);
             JitDestroyPlan((JitPlan*)next_plan);
@@ -2603,8 +2794,11 @@ static JitPlan* JitPrepareSimplePlan(Query* query)
                     plan = JitPrepareRangeUpdatePlan(query, table);
                 }
             } else if (query->commandType == CMD_SELECT) {
-                if (!CheckQueryAttributes(
-                        query, true, true, false)) {  // range select can specify sort clause or aggregate clause
+                if (!CheckQueryAttributes(query,
+                        true,
+                        true,
+                        false,
+                        true)) {  // range select can specify sort clause, aggregate clause or group clause
                     MOT_LOG_TRACE(
                         "JitPrepareSimplePlan(): Disqualifying range select query - Invalid query attributes");
                 } else {
@@ -2879,7 +3073,9 @@ static JitPlan* JitPrepareJoinPlan(Query* query)
         } else if (table_count == 2) {  // case 2: no explicit JOIN clause
             plan = JitPrepareImplicitJoinPlan(query);
         } else {
-            MOT_LOG_TRACE("Query is not jittable - unsupported JOIN format (more than 3 tables involved)");
+            // N-way joins need a scan state per joined table, while the JIT context, the stateful helpers and both
+            // code generators keep state for one outer and one inner scan only
+            MOT_LOG_TRACE("Query is not jittable - unsupported JOIN format (more than 2 tables joined)");
         }
     }
 
@@ -425,7 +425,7 @@ struct JitAggregate {
     /** @var The aggregate function identifier. */
     int _func_id;
 
-    /** @var The table column id to aggregate (we always aggregate into slot tuple column id 0). */
+    /** @var The table column id to aggregate. */
     int _table_column_id;
 
     /** @var The table to which the aggregated column belongs (required if this is in JOIN). */
@@ -442,6 +442,18 @@ struct JitAggregate {
 
     /** @var Specifies whether this is a distinct aggregation. */
     bool _distinct;
+
+    /** @var The zero-based output tuple column id into which the aggregated value is written. */
+    int _tuple_column_id;
+};
+
+/** @struct Specifies grouping of a range scan by a prefix of the scanned index. */
+struct JitGroupBy {
+    /** @var The number of leading index columns making up the grouping key (zero if there is no GROUP BY clause). */
+    int _prefix_column_count;
+
+    /** @var The length in bytes of the leading index key part made up of the grouping columns. */
+    int _prefix_key_length;
 };
 
 /** @struct Specifies join of an outer column with an inner column. */
@@ -569,8 +581,14 @@ struct JitRangeSelectPlan {
     /** @var Limit on number of rows returned to the user (zero for none). */
     int _limit_count;
 
-    /** @var An aggregate function (if one is specified then only one select expression should exist). */
+    /**
+     * @var An aggregate function (if one is specified then only one select expression should exist, unless a GROUP BY
+     * clause is specified, in which case the select expressions are the grouping columns).
+     */
     JitAggregate _aggregate;
+
+    /** @var Grouping of the scanned rows (rows of each group are adjacent in the index, so each group is a sub-range). */
+    JitGroupBy _group_by;
 };
 
 /** @strut Plan for JOIN queries. */
@@ -47,22 +47,30 @@ JitGlobalStatistics::JitGlobalStatistics(GlobalStatistics::NamingScheme namingSc
       m_jittableQueryCount(MakeName("jittable-queries", namingScheme).c_str(), 1, "queries"),
       m_unjittableLimitQueryCount(MakeName("unjittable-limit-queries", namingScheme).c_str(), 1, "queries"),
       m_unjittableDisqualifiedQueryCount(MakeName("disqualified-queries", namingScheme).c_str(), 1, "queries"),
+      m_unjittableMultiJoinQueryCount(MakeName("unjittable-multi-join-queries", namingScheme).c_str(), 1, "queries"),
       m_codeGenQueryCount(MakeName("code-gen-queries", namingScheme).c_str(), 1, "queries"),
       m_codeGenTime(MakeName("code-gen-time", namingScheme).c_str(), 1000, "millis"),
       m_codeGenErrorQueryCount(MakeName("code-gen-error-queries", namingScheme).c_str(), 1, "queries"),
       m_codeCloneQueryCount(MakeName("code-clone-queries", namingScheme).c_str(), 1, "queries"),
       m_codeCloneErrorQueryCount(MakeName("code-clone-error-queries", namingScheme).c_str(), 1, "queries"),
-      m_codeExpiredQueryCount(MakeName("code-expired-queries", namingScheme).c_str(), 1, "queries")
+      m_codeExpiredQueryCount(MakeName("code-expired-queries", namingScheme).c_str(), 1, "queries"),
+      m_codeGenAggregateQueryCount(MakeName("code-gen-aggregate-queries", namingScheme).c_str(), 1, "queries"),
+      m_codeGenGroupByQueryCount(MakeName("code-gen-group-by-queries", namingScheme).c_str(), 1, "queries"),
+      m_codeGenJoinQueryCount(MakeName("code-gen-join-queries", namingScheme).c_str(), 1, "queries")
 {
     RegisterStatistics(&m_jittableQueryCount);
     RegisterStatistics(&m_unjittableLimitQueryCount);
     RegisterStatistics(&m_unjittableDisqualifiedQueryCount);
+    RegisterStatistics(&m_unjittableMultiJoinQueryCount);
     RegisterStatistics(&m_codeGenQueryCount);
     RegisterStatistics(&m_codeGenTime);
     RegisterStatistics(&m_codeGenErrorQueryCount);
     RegisterStatistics(&m_codeCloneQueryCount);
     RegisterStatistics(&m_codeCloneErrorQueryCount);
     RegisterStatistics(&m_codeExpiredQueryCount);
+    RegisterStatistics(&m_codeGenAggregateQueryCount);
+    RegisterStatistics(&m_codeGenGroupByQueryCount);
+    RegisterStatistics(&m_codeGenJoinQueryCount);
 }
 
 MOT::TypedStatisticsGenerator<JitThreadStatistics, JitGlobalStatistics> JitStatisticsProvider::m_generator;
@@ -103,6 +103,12 @@ public:
         m_unjittableDisqualifiedQueryCount.AddSample(1);
     }
 
+    /** @brief Updates the statistics for total amount of un-jittable queries joining more than two tables. */
+    inline void AddUnjittableMultiJoinQuery()
+    {
+        m_unjittableMultiJoinQueryCount.AddSample(1);
+    }
+
     /** @brief Updates the statistics for total amount of JIT query code generation. */
     inline void AddCodeGenQuery()
     {
@@ -139,16 +145,38 @@ public:
         m_codeExpiredQueryCount.AddSample(1);
     }
 
+    /** @brief Updates the statistics for total amount of JIT query code generation for aggregate queries. */
+    inline void AddCodeGenAggregateQuery()
+    {
+        m_codeGenAggregateQueryCount.AddSample(1);
+    }
+
+    /** @brief Updates the statistics for total amount of JIT query code generation for GROUP BY queries. */
+    inline void AddCodeGenGroupByQuery()
+    {
+        m_codeGenGroupByQueryCount.AddSample(1);
+    }
+
+    /** @brief Updates the statistics for total amount of JIT query code generation for JOIN queries. */
+    inline void AddCodeGenJoinQuery()
+    {
+        m_codeGenJoinQueryCount.AddSample(1);
+    }
+
 private:
     MOT::LevelStatisticVariable m_jittableQueryCount;
     MOT::LevelStatisticVariable m_unjittableLimitQueryCount;
     MOT::LevelStatisticVariable m_unjittableDisqualifiedQueryCount;
+    MOT::LevelStatisticVariable m_unjittableMultiJoinQueryCount;
     MOT::LevelStatisticVariable m_codeGenQueryCount;
     MOT::NumericStatisticVariable m_codeGenTime;
     MOT::LevelStatisticVariable m_codeGenErrorQueryCount;
     MOT::LevelStatisticVariable m_codeCloneQueryCount;
     MOT::LevelStatisticVariable m_codeCloneErrorQueryCount;
     MOT::LevelStatisticVariable m_codeExpiredQueryCount;
+    MOT::LevelStatisticVariable m_codeGenAggregateQueryCount;
+    MOT::LevelStatisticVariable m_codeGenGroupByQueryCount;
+    MOT::LevelStatisticVariable m_codeGenJoinQueryCount;
 };
 
 /**
@@ -200,6 +228,15 @@ public:
         }
     }
 
+    /** @brief Updates the statistics for total amount of un-jittable queries joining more than two tables. */
+    inline void AddUnjittableMultiJoinQuery()
+    {
+        JitGlobalStatistics* jgs = GetGlobalStatistics<JitGlobalStatistics>();
+        if (jgs) {
+            jgs->AddUnjittableMultiJoinQuery();
+        }
+    }
+
     /** @brief Updates the statistics for total amount of un-jittable queries due to disqualification. */
     inline void AddCodeGenQuery()
     {
@@ -254,6 +291,33 @@ public:
         }
     }
 
+    /** @brief Updates the statistics for total amount of JIT query code generation for aggregate queries. */
+    inline void AddCodeGenAggregateQuery()
+    {
+        JitGlobalStatistics* jgs = GetGlobalStatistics<JitGlobalStatistics>();
+        if (jgs) {
+            jgs->AddCodeGenAggregateQuery();
+        }
+    }
+
+    /** @brief Updates the statistics for total amount of JIT query code generation for GROUP BY queries. */
+    inline void AddCodeGenGroupByQuery()
+    {
+        JitGlobalStatistics* jgs = GetGlobalStatistics<JitGlobalStatistics>();
+        if (jgs) {
+            jgs->AddCodeGenGroupByQuery();
+        }
+    }
+
+    /** @brief Updates the statistics for total amount of JIT query code generation for JOIN queries. */
+    inline void AddCodeGenJoinQuery()
+    {
+        JitGlobalStatistics* jgs = GetGlobalStatistics<JitGlobalStatistics>();
+        if (jgs) {
+            jgs->AddCodeGenJoinQuery();
+        }
+    }
+
     /** @brief Records a transaction event. */
     inline void AddExecQuery()
     {
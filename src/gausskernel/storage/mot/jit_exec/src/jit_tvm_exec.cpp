@@ -2414,6 +2414,70 @@ protected:
     }
 };
 
+/** @class SetGroupByKeyInstruction */
+class SetGroupByKeyInstruction : public Instruction {
+public:
+    explicit SetGroupByKeyInstruction(Instruction* row_inst) : Instruction(Instruction::Void), _row_inst(row_inst)
+    {
+        AddSubInstruction(_row_inst);
+    }
+
+    ~SetGroupByKeyInstruction() final
+    {
+        _row_inst = nullptr;
+    }
+
+    uint64_t Exec(ExecContext* exec_context) final
+    {
+        MOT::Row* row = (MOT::Row*)_row_inst->Exec(exec_context);
+        setGroupByKey(row);
+        return (uint64_t)MOT::RC_OK;
+    }
+
+    void Dump() final
+    {
+        (void)fprintf(stderr, "setGroupByKey(row=");
+        _row_inst->Dump();
+        (void)fprintf(stderr, ")");
+    }
+
+private:
+    Instruction* _row_inst;
+};
+
+/** @class IsSameGroupByKeyInstruction */
+class IsSameGroupByKeyInstruction : public Instruction {
+public:
+    IsSameGroupByKeyInstruction(Instruction* row_inst, int prefix_length)
+        : _row_inst(row_inst), _prefix_length(prefix_length)
+    {
+        AddSubInstruction(_row_inst);
+    }
+
+    ~IsSameGroupByKeyInstruction() final
+    {
+        _row_inst = nullptr;
+    }
+
+protected:
+    uint64_t ExecImpl(ExecContext* exec_context) final
+    {
+        MOT::Row* row = (MOT::Row*)_row_inst->Exec(exec_context);
+        return (uint64_t)isSameGroupByKey(row, _prefix_length);
+    }
+
+    void DumpImpl() final
+    {
+        (void)fprintf(stderr, "isSameGroupByKey(row=");
+        _row_inst->Dump();
+        (void)fprintf(stderr, ", prefix_length=%d)", _prefix_length);
+    }
+
+private:
+    Instruction* _row_inst;
+    int _prefix_length;
+};
+
 /** @class PrepareAvgArrayInstruction */
 class PrepareAvgArrayInstruction : public Instruction {
 public:
@@ -3162,6 +3226,16 @@ static Instruction* AddGetStateLimitCounter(JitTvmCodeGenContext* ctx)
     return ctx->_builder->addInstruction(new (std::nothrow) GetStateLimitCounterInstruction());
 }
 
+static void AddSetGroupByKey(JitTvmCodeGenContext* ctx, Instruction* row)
+{
+    (void)ctx->_builder->addInstruction(new (std::nothrow) SetGroupByKeyInstruction(row));
+}
+
+static Instruction* AddIsSameGroupByKey(JitTvmCodeGenContext* ctx, Instruction* row, int prefix_length)
+{
+    return ctx->_builder->addInstruction(new (std::nothrow) IsSameGroupByKeyInstruction(row, prefix_length));
+}
+
 static void AddPrepareAvgArray(JitTvmCodeGenContext* ctx, int element_type, int element_count)
 {
     (void)ctx->_builder->addInstruction(new (std::nothrow) PrepareAvgArrayInstruction(element_type, element_count));
@@ -5298,11 +5372,11 @@ static void buildAggregateResult(JitTvmCodeGenContext* ctx, const JitAggregate*
     if (aggregate->_aggreaget_op == JIT_AGGREGATE_AVG) {
         Instruction* avg_value = AddComputeAvgFromArray(
             ctx, aggregate->_avg_element_type);  // we infer this during agg op analysis, but don't save it...
-        AddWriteTupleDatum(ctx, 0, avg_value);   // we alway aggregate to slot tuple 0
+        AddWriteTupleDatum(ctx, aggregate->_tuple_column_id, avg_value);
     } else {
         Expression* count_expr = AddGetAggValue(ctx);
         Instruction* count_value = buildExpression(ctx, count_expr);
-        AddWriteTupleDatum(ctx, 0, count_value);  // we alway aggregate to slot tuple 0
+        AddWriteTupleDatum(ctx, aggregate->_tuple_column_id, count_value);
     }
 
     // we take the opportunity to cleanup as well
@@ -5900,6 +5974,134 @@ static JitContext* JitAggregateRangeSelectCodegen(
     return jit_context;
 }
 
+/**
+ * @brief Generates code for range SELECT query with aggregator and GROUP BY clause. The grouping columns make up a
+ * prefix of the scanned index, so rows of each group are adjacent in the scan. Each call produces a single group, and
+ * the first row of the next group is kept in the state row for the next call.
+ */
+static JitContext* JitGroupByRangeSelectCodegen(
+    const Query* query, const char* query_string, JitRangeSelectPlan* plan)
+{
+    MOT_LOG_DEBUG("Generating code for MOT GROUP BY range select at thread %p", (void*)pthread_self());
+
+    Builder builder;
+
+    JitTvmCodeGenContext cg_ctx = {0};
+    MOT::Table* table = plan->_index_scan._table;
+    int index_id = plan->_index_scan._index_id;
+    if (!InitCodeGenContext(&cg_ctx, &builder, table, table->GetIndex(index_id))) {
+        return nullptr;
+    }
+    JitTvmCodeGenContext* ctx = &cg_ctx;
+
+    // prepare the jitted function (declare, get arguments into context and define locals)
+    CreateJittedFunction(ctx, "MotJittedGroupByRangeSelect", query_string);
+    IssueDebugLog("Starting execution of jitted GROUP BY range SELECT");
+
+    // initialize rows_processed local variable
+    buildResetRowsProcessed(ctx);
+
+    // clear tuple even if row is not found later
+    AddExecClearTuple(ctx);
+
+    // emit code to cleanup previous scan in case this is a new scan (including first row of pending group)
+    AddCleanupOldScan(ctx);
+    JIT_IF_BEGIN(reset_pending_group)
+    Instruction* isNewScan = AddIsNewScan(ctx);
+    JIT_IF_EVAL(isNewScan)
+    AddResetStateRow(ctx, JIT_RANGE_SCAN_MAIN);
+    JIT_IF_END()
+
+    // prepare stateful scan if not done so already, if no row exists then emit code to return from function
+    int max_arg = 0;
+    MOT::AccessType access_mode = query->hasForUpdate ? MOT::AccessType::RD_FOR_UPDATE : MOT::AccessType::RD;
+    Instruction* row = buildPrepareStateScanRow(
+        ctx, &plan->_index_scan, JIT_RANGE_SCAN_MAIN, access_mode, &max_arg, nullptr, nullptr, nullptr);
+    if (row == nullptr) {
+        MOT_LOG_TRACE("Failed to generate jitted code for GROUP BY range select query: unsupported WHERE clause type");
+        DestroyCodeGenContext(ctx);
+        return nullptr;
+    }
+
+    // the first row of the group provides the grouping columns and the group key
+    prepareAggregate(ctx, &plan->_aggregate);
+    if (!selectRowColumns(ctx, row, &plan->_select_exprs, &max_arg, JIT_RANGE_SCAN_MAIN)) {
+        MOT_LOG_TRACE("Failed to generate jitted code for GROUP BY range SELECT query: failed to select row "
+                      "expressions");
+        DestroyCodeGenContext(ctx);
+        return nullptr;
+    }
+    AddSetGroupByKey(ctx, row);
+    buildAggregateRow(ctx, &plan->_aggregate, row, nullptr);
+    AddResetStateRow(ctx, JIT_RANGE_SCAN_MAIN);
+
+    // aggregate following rows until the group key changes
+    JitIndexScanDirection index_scan_direction = plan->_index_scan._scan_direction;
+    JIT_WHILE_BEGIN(group_by_aggregate_loop)
+    Instruction* res = AddIsStateScanEnd(ctx, index_scan_direction, JIT_RANGE_SCAN_MAIN);
+    JIT_WHILE_EVAL_NOT(res)
+    Instruction* next_row = AddGetRowFromStateIterator(ctx, access_mode, index_scan_direction, JIT_RANGE_SCAN_MAIN);
+    JIT_IF_BEGIN(test_next_row_found)
+    JIT_IF_EVAL_NOT(next_row)
+    IssueDebugLog("Could not retrieve row from state iterator, group is complete");
+    JIT_WHILE_BREAK()
+    JIT_IF_END()
+
+    // check for additional filters, if not try to fetch next row
+    if (!buildFilterRow(ctx, next_row, &plan->_index_scan._filters, &max_arg, JIT_WHILE_COND_BLOCK())) {
+        MOT_LOG_TRACE("Failed to generate jitted code for GROUP BY range SELECT query: unsupported filter");
+        DestroyCodeGenContext(ctx);
+        return nullptr;
+    }
+
+    // a row with a different key starts the next group, so keep it for the next call
+    JIT_IF_BEGIN(test_same_group)
+    Instruction* same_group = AddIsSameGroupByKey(ctx, next_row, plan->_group_by._prefix_key_length);
+    JIT_IF_EVAL_NOT(same_group)
+    IssueDebugLog("Found first row of next group");
+    AddSetStateRow(ctx, next_row, JIT_RANGE_SCAN_MAIN);
+    JIT_WHILE_BREAK()
+    JIT_IF_END()
+
+    buildAggregateRow(ctx, &plan->_aggregate, next_row, nullptr);
+    JIT_WHILE_END()
+
+    // wrap up aggregation and write group to result tuple
+    IssueDebugLog("Reached end of group");
+    buildAggregateResult(ctx, &plan->_aggregate);
+    AddExecStoreVirtualTuple(ctx);
+
+    // if there is no pending group then this was the last group
+    JIT_IF_BEGIN(test_last_group)
+    Instruction* last_group = AddIsStateRowNull(ctx, JIT_RANGE_SCAN_MAIN);
+    JIT_IF_EVAL(last_group)
+    IssueDebugLog("No more groups, cleaning up iterators");
+    AddDestroyStateIterators(ctx, JIT_RANGE_SCAN_MAIN);
+    AddSetScanEnded(ctx, 1);
+    JIT_IF_END()
+
+    // one result row for the group (rows processed during aggregation are not reported)
+    buildResetRowsProcessed(ctx);
+    buildIncrementRowsProcessed(ctx);
+
+    // if a limit clause exists, then increment limit counter and check if reached limit
+    buildCheckLimit(ctx, plan->_limit_count);
+
+    // execute *tp_processed = rows_processed
+    AddSetTpProcessed(ctx);
+
+    // return success from calling function
+    builder.CreateRet(builder.CreateConst((uint64_t)MOT::RC_OK));
+
+    // wrap up
+    JitContext* jit_context = FinalizeCodegen(ctx, max_arg, JIT_COMMAND_GROUP_BY_RANGE_SELECT);
+
+    // cleanup
+    DestroyCodeGenContext(ctx);
+
+    return jit_context;
+}
+
 static JitContext* JitPointJoinCodegen(const Query* query, const char* query_string, JitJoinPlan* plan)
 {
     MOT_LOG_DEBUG("Generating code for MOT Point JOIN query at thread %p", (void*)pthread_self());
@@ -6742,6 +6944,8 @@ static JitContext* JitRangeScanCodegen(const Query* query, const char* query_str
             JitRangeSelectPlan* range_select_plan = (JitRangeSelectPlan*)plan;
             if (range_select_plan->_aggregate._aggreaget_op == JIT_AGGREGATE_NONE) {
                 jit_context = JitRangeSelectCodegen(query, query_string, range_select_plan);
+            } else if (range_select_plan->_group_by._prefix_column_count > 0) {
+                jit_context = JitGroupByRangeSelectCodegen(query, query_string, range_select_plan);
             } else {
                 jit_context = JitAggregateRangeSelectCodegen(query, query_string, range_select_plan);
             }
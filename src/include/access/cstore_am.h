@@ -36,6 +36,10 @@
 
 #define MAX_CU_PREFETCH_REQSIZ (64)
 
+/* CU cache ring size of a sequential scan */
+#define CSTORE_RING_CU_PER_COLUMN (8)
+#define CSTORE_RING_MAX_SLOTS (1024)
+
 #define MaxDelBitmapSize ((int)DefaultFullCUSize / 8 + 1)
 
 class BatchCUData;
@@ -48,11 +52,13 @@ struct LoadCUDescCtl : public BaseObject {
     uint32 lastLoadNum;
     uint32 nextCUID;
     CUDesc *cuDescArray;
+    bool *bloomMiss; /* the CU can't match the bloom filtered quals, see CStore::CUBloomExcludes() */
 
     LoadCUDescCtl(uint32 startCUID)
     {
         Reset(startCUID);
         cuDescArray = (CUDesc *)palloc0(sizeof(CUDesc) * u_sess->attr.attr_storage.max_loaded_cudesc);
+        bloomMiss = NULL;
     }
 
     virtual ~LoadCUDescCtl()
@@ -65,6 +71,10 @@ struct LoadCUDescCtl : public BaseObject {
             pfree(cuDescArray);
             cuDescArray = NULL;
         }
+        if (bloomMiss != NULL) {
+            pfree(bloomMiss);
+            bloomMiss = NULL;
+        }
     }
 
     inline bool HasFreeSlot()
@@ -80,6 +90,32 @@ struct LoadCUDescCtl : public BaseObject {
     }
 };
 
+/*
+ * A qual clause "column op const" or "column op ANY/ALL(const array)", which is
+ * evaluated once per dictionary item of dictionary encoded CUs, or once per run
+ * of RLE encoded CUs, before the batch is filled. Rows failing it are skipped
+ * like deleted rows, so no column of them is ever materialized.
+ */
+typedef struct CUPredicate {
+    int seq;          /* sequence of the column in m_colId[] */
+    FmgrInfo func;    /* strict operator function */
+    Oid collation;    /* collation to use, if needed */
+    Datum *args;      /* the const, or the elements of the const array */
+    int nargs;        /* number of args */
+    bool useOr;       /* true for ANY, false for ALL and the single const */
+} CUPredicate;
+
+/*
+ * "column = const" or "column = ANY(const array)" checked against the per-CU
+ * bloom filters of the column while its cudesc is loaded. a CU whose filter
+ * has none of the consts is skipped by RoughCheck().
+ */
+typedef struct CUBloomPredicate {
+    int seq;          /* sequence of the column in m_colId[] */
+    uint32 *hashes;   /* bloom hashes of the consts */
+    int nhashes;      /* number of hashes */
+} CUBloomPredicate;
+
 struct CStoreScanState;
 typedef CStoreScanState *CStoreScanDesc;
 
@@ -105,13 +141,14 @@ public:
     // form and deform CU Desc tuple
     static HeapTuple FormCudescTuple(_in_ CUDesc *pCudesc, _in_ TupleDesc pCudescTupDesc,
                                      _in_ Datum values[CUDescMaxAttrNum], _in_ bool nulls[CUDescMaxAttrNum],
-                                     _in_ Form_pg_attribute pColAttr);
+                                     _in_ Form_pg_attribute pColAttr, _in_ const text *extra = NULL);
 
     static void DeformCudescTuple(_in_ HeapTuple pCudescTup, _in_ TupleDesc pCudescTupDesc,
                                   _in_ Form_pg_attribute pColAttr, _out_ CUDesc *pCudesc);
 
     // Save CU description information into CUDesc table
-    static void SaveCUDesc(_in_ Relation rel, _in_ CUDesc *cuDescPtr, _in_ int col, _in_ int options);
+    static void SaveCUDesc(_in_ Relation rel, _in_ CUDesc *cuDescPtr, _in_ int col, _in_ int options,
+                           _in_ const text *extra = NULL);
 
     // form and deform VC CU Desc tuple.
     // We add a virtual column for marking deleted rows.
@@ -220,10 +257,14 @@ public:
     /* Set CU range for scan in redistribute. */
     void SetScanRange();
 
+    /* Limit the scan to the CUs in [startCUID, endCUID], before the first batch. */
+    void SetScanCUIDRange(uint32 startCUID, uint32 endCUID);
+
     // Judge whether dead row
     bool IsDeadRow(uint32 cuid, uint32 row) const;
 
     void CUListPrefetch();
+    void CUWindowPrefetch();
     void CUPrefetch(CUDesc *cudesc, int col, AioDispatchCUDesc_t **dList, int &count, File *vfdList);
 
     /* Point to scan function */
@@ -256,6 +297,15 @@ private:  // private methods.
 
     void InitRoughCheckEnv(CStoreScanState *state);
 
+    // Evaluate quals on dictionary or RLE encoded CUs
+    void InitCUPredicateEnv(CStoreScanState *state);
+    // Skip CUs by the bloom filters of their values
+    void InitCUBloomEnv(CStoreScanState *state);
+    void InitCacheStrategy(CStoreScanState *state);
+    void ApplyCUPredicatesIfNeed(int cuDescIdx);
+    int ApplyCUPredicate(CUPredicate *pred, CU *cuPtr, int rowCount, Form_pg_attribute attr);
+    bool CUBloomExcludes(int col, Datum filter);
+
     void BindingFp(CStoreScanState *state);
     void InitFillVecEnv(CStoreScanState *state);
 
@@ -273,6 +323,7 @@ private:  // private methods.
     bool NeedLoadCUDesc(int32 &cudesc_idx);
     void IncLoadCuDescIdx(int &idx) const;
     bool RoughCheck(CStoreScanKey scanKey, int nkeys, int cuDescIdx);
+    bool RoughCheckAllMatch(CStoreScanKey scanKey, int nkeys, int cuDescIdx);
 
     void FillColMinMax(CUDesc *cuDescPtr, ScalarVector *vec, int pos);
 
@@ -322,6 +373,13 @@ private:
     int m_prefetch_threshold;
     bool m_load_finish;
 
+    // read ahead by hints without ADIO, see CUWindowPrefetch()
+    int m_prefetchCursor;
+    int m_prefetchLastCursor;
+
+    // CU cache ring of a large sequential scan, NULL for other scans
+    CacheAccessStrategy m_cacheStrategy;
+
     // Current scan position inside CU
     // 
     int *m_scanPosInCU;
@@ -330,6 +388,19 @@ private:
     // 
     RoughCheckFunc *m_RCFuncs;
 
+    // 1. Quals evaluated on dictionary or RLE encoded CUs
+    // 2. Number of these quals
+    // 3. Result of each dictionary item, see ApplyCUPredicate()
+    // 4. CU id whose rows have been filtered by these quals
+    CUPredicate *m_cuPreds;
+    int m_cuPredNum;
+    uint8 *m_cuPredItemState;
+    uint32 m_cuPredCUId;
+
+    // Equality quals checked against the per-CU bloom filters, and their number
+    CUBloomPredicate *m_cuBloomPreds;
+    int m_cuBloomPredNum;
+
     typedef int (CStore::*m_colFillFun)(int seq, CUDesc *cuDescPtr, ScalarVector *vec);
 
     typedef struct {
@@ -348,6 +419,10 @@ private:
     typedef void (CStore::*fillMinMaxFuncPtr)(CUDesc *cuDescPtr, ScalarVector *vec, int pos);
     fillMinMaxFuncPtr *m_fillMinMaxFunc;
 
+    // Rough check functions of the negated scan keys, two per key, used by
+    // min/max scan to find the CUs whose values all pass the scan keys
+    RoughCheckFunc *m_RCNegFuncs;
+
     ScanFuncPtr m_scanFunc;  // cstore scan function ptr
 
     // node id of this plan
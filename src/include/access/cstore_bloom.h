@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * cstore_bloom.h
+ *         per-CU bloom filters of ColStore
+ *
+ * A bloom filter of the values of one CU is kept in the "extra" attribute of
+ * its CUDesc tuple, so that a scan can skip the CUs which can't hold the
+ * constants of "column = const" and "column IN (...)" quals, even when the
+ * min/max of the CU covers them.
+ *
+ * IDENTIFICATION
+ *        src/include/access/cstore_bloom.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+
+#ifndef CSTORE_BLOOM_H
+#define CSTORE_BLOOM_H
+
+#include "postgres.h"
+#include "knl/knl_variable.h"
+#include "access/cstore_vector.h"
+
+#define CU_BLOOM_VERSION 1
+/* false positive rate a filter is sized for */
+#define CU_BLOOM_TARGET_FPP 0.01
+/* a filter which can't get below this rate is not worth probing, it's not built */
+#define CU_BLOOM_MAX_FPP 0.1
+#define CU_BLOOM_MIN_BITS 512
+/* keep the CUDesc tuple within one page, the cudesc table has no toast table */
+#define CU_BLOOM_MAX_BITS (6144 * 8)
+#define CU_BLOOM_MAX_HASHES 8
+
+/* how the values of a type are hashed, equal values must have equal hash */
+typedef enum CUBloomKind {
+    CU_BLOOM_NONE = 0,
+    CU_BLOOM_INTEGER, /* integer types and the date/time types stored as integers */
+    CU_BLOOM_STRING,  /* text and varchar */
+    CU_BLOOM_BPCHAR   /* bpchar, trailing spaces are insignificant */
+} CUBloomKind;
+
+/* header of the filter data, followed by the bits */
+typedef struct CUBloomHeader {
+    uint32 nbits;
+    uint8 nhashes;
+    uint8 version;
+    uint16 reserved;
+} CUBloomHeader;
+
+extern CUBloomKind CUBloomGetKind(Oid typeOid);
+extern bool CUBloomIsUsableOp(Oid opno, Oid colType, Oid *argType);
+extern uint32 CUBloomHashDatum(Oid typeOid, Datum value);
+extern text *CUBloomBuild(bulkload_vector *vector, int rows, Oid typeOid);
+extern bool CUBloomMayContain(const text *filter, uint32 hash);
+
+#endif /* CSTORE_BLOOM_H */
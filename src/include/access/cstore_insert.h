@@ -192,6 +192,7 @@ private:
 
     CUDesc **m_cuDescPPtr;                 /* The cudesc of all columns of m_relation */
     CU **m_cuPPtr;                         /* The CU of all columns of m_relation; */
+    text **m_cuBloomPPtr;                  /* The bloom filter of each CU, see option bloom_filter */
     CUStorage **m_cuStorage;               /* CU storage */
     compression_options *m_cuCmprsOptions; /* compression filter */
     cu_tmp_compress_info m_cuTempInfo;     /* temp info for CU compression */
@@ -328,5 +328,6 @@ extern void CStoreCopyColumnData(Relation CUReplicationRel, Relation rel, AttrNu
 extern void CStoreCopyColumnDataEnd(Relation colRel, Oid targetTableSpace, Oid newrelfilenode);
 extern Oid CStoreSetTableSpaceForColumnData(Relation colRel, Oid targetTableSpace);
 extern void ATExecCStoreMergePartition(Relation partTableRel, AlterTableCmd *cmd);
+extern int64 CStoreCompactCUs(Relation rel, double deadRatio);
 
 #endif
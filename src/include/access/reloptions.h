@@ -262,6 +262,7 @@ extern void CheckFoldernameOrFilenamesOrCfgPtah(const char* OptStr, char* OptTyp
 extern void CheckWaitCleanGpi(const char* value);
 
 extern void ForbidToSetOptionsForPSort(List* options);
+extern void ForbidToSetOptionsForNotMOTIndex(List* options);
 extern void ForbidOutUsersToSetInnerOptions(List* user_options);
 extern void ForbidToSetOptionsForAttribute(List* options);
 extern void ForbidUserToSetUnsupportedOptions(
@@ -269,6 +270,7 @@ extern void ForbidUserToSetUnsupportedOptions(
 extern void ForbidToSetOptionsForColTbl(List* options);
 extern void ForbidToSetOptionsForRowTbl(List* options);
 extern void ForbidUserToSetDefinedOptions(List* options);
+extern void ForbidUserToAlterIndexOptions(List* options);
 extern bool CheckRelOptionValue(Datum options, const char* opt_name);
 extern void forbid_to_set_options_for_timeseries_tbl(List* options);
 extern List* RemoveRelOption(List* options, const char* optName, bool* removed);
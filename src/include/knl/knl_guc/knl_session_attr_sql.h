@@ -71,6 +71,8 @@ typedef struct knl_session_attr_sql {
     bool enable_mergejoin;
     bool enable_hashjoin;
     bool enable_index_nestloop;
+    bool enable_adaptive_nestloop;
+    bool enable_card_feedback;
     bool enable_nodegroup_debug;
     bool enable_partitionwise;
     bool enable_remotejoin;
@@ -87,6 +89,7 @@ typedef struct knl_session_attr_sql {
     bool enable_random_datanode;
     bool enable_fstream;
     bool enable_geqo;
+    bool enable_dphyp;
     bool restart_after_crash;
     bool enable_early_free;
     bool enable_kill_query;
@@ -131,7 +134,9 @@ typedef struct knl_session_attr_sql {
     bool enable_prevent_job_task_startup;
     int from_collapse_limit;
     int join_collapse_limit;
+    int adaptive_nestloop_threshold;
     int geqo_threshold;
+    int dphyp_mem_limit;
     int Geqo_effort;
     int Geqo_pool_size;
     int Geqo_generations;
@@ -199,6 +204,7 @@ typedef struct knl_session_attr_sql {
     bool enable_beta_opfusion;
     bool enable_beta_nestloop_fusion;
     int opfusion_debug_mode;
+    int opfusion_batch_insert_size;
     int single_shard_stmt;
 } knl_session_attr_sql;
 
@@ -46,6 +46,7 @@ typedef struct knl_session_attr_storage {
     bool wal_compression;
     bool Log_connections;
     bool autovacuum_start_daemon;
+    bool autovacuum_merge_cstore_delta;
 #ifdef LOCK_DEBUG
     bool Trace_locks;
     bool Trace_userlocks;
@@ -151,6 +152,7 @@ typedef struct knl_session_attr_storage {
     double shared_buffers_fraction;
     double autovacuum_vac_scale;
     double autovacuum_anl_scale;
+    double cstore_compaction_dead_ratio;
     double CheckPointCompletionTarget;
     char* XLogArchiveCommand;
     char* default_tablespace;
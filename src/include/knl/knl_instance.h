@@ -104,6 +104,11 @@ typedef struct knl_g_cost_context {
     Cost disable_cost;
 
     Cost disable_cost_enlarge_factor;
+
+    /* cardinality feedback store, see optimizer/util/cardfeedback.cpp */
+    MemoryContext card_feedback_context;
+
+    struct HTAB* card_feedback_hashtbl;
 } knl_g_cost_context;
 
 typedef struct knl_g_pid_context {
@@ -148,6 +148,9 @@ typedef struct knl_u_executor_context {
 
     struct OpFusion* CurrentOpFusionObj;
 
+    /* insert fusion holding rows of consecutive Bind/Execute messages, see opfusion_batch_insert_size */
+    struct OpFusion* PendingBatchOpFusionObj;
+
     bool is_exec_trigger_func;
 } knl_u_executor_context;
 
@@ -2010,6 +2013,9 @@ typedef struct knl_u_mot_context {
     tvm::JitDoWhile* jit_tvm_do_while_stack;
     JitExec::JitContext* jit_context;
     MOT::TxnManager* jit_txn;
+
+    /* NUMA node holding most of the NUMA-partitioned rows accessed by the last transaction, -1 if none */
+    int preferred_numa_node;
 } knl_u_mot_context;
 
 typedef struct knl_u_gtt_context {
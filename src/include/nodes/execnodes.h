@@ -1894,12 +1894,35 @@ typedef struct JoinState {
     List* nulleqqual;
 } JoinState;
 
+/*
+ * Adaptive nestloop modes: a nestloop whose join quals contain hashable
+ * equality clauses watches the number of outer rows and, once
+ * adaptive_nestloop_threshold is crossed, hashes the inner side and probes
+ * it instead of rescanning the inner plan for every outer row.
+ */
+typedef enum NestLoopAdaptiveMode {
+    NL_ADAPTIVE_DISABLED = 0, /* feature off or join not eligible */
+    NL_ADAPTIVE_WATCHING,     /* counting outer rows, still looping */
+    NL_ADAPTIVE_HASHED,       /* switched, probing inner hash table */
+    NL_ADAPTIVE_ABANDONED     /* inner side did not fit in work_mem */
+} NestLoopAdaptiveMode;
+
 /* ----------------
  *	 NestLoopState information
  *
  *		NeedNewOuter	   true if need new outer tuple on next call
  *		MatchedOuter	   true if found a join match for current outer tuple
  *		NullInnerTupleSlot prepared null tuple for left outer joins
+ *
+ *		AdaptiveMode	   current adaptive nestloop state, see above
+ *		NumHashKeys		   number of hashable equality join clauses
+ *		OuterKeyIdx		   outer attribute numbers of the hash keys
+ *		InnerKeyIdx		   inner attribute numbers of the hash keys
+ *		HashTable		   hash table on the inner side, once switched
+ *		HashMatch		   next candidate inner tuple for current outer tuple
+ *		OuterRows		   outer rows fetched so far
+ *		SwitchOuterRows    outer rows fetched when the switch happened
+ *		HashInnerRows	   inner rows loaded into the hash table
  * ----------------
  */
 typedef struct NestLoopState {
@@ -1908,6 +1931,20 @@ typedef struct NestLoopState {
     bool nl_MatchedOuter;
     bool nl_MaterialAll;
     TupleTableSlot* nl_NullInnerTupleSlot;
+    NestLoopAdaptiveMode nl_AdaptiveMode;
+    int nl_NumHashKeys;
+    AttrNumber* nl_OuterKeyIdx;
+    AttrNumber* nl_InnerKeyIdx;
+    FmgrInfo* nl_HashEqFuncs;
+    FmgrInfo* nl_HashFuncs;
+    TupleHashTable nl_HashTable;
+    MemoryContext nl_HashTableContext;
+    TupleTableSlot* nl_HashProbeSlot;
+    TupleTableSlot* nl_HashInnerSlot;
+    ListCell* nl_HashMatch;
+    int64 nl_OuterRows;
+    int64 nl_SwitchOuterRows;
+    int64 nl_HashInnerRows;
 } NestLoopState;
 
 /* ----------------
@@ -102,6 +102,10 @@ public:
 
     static bool isQueryCompleted();
 
+    static void flushPendingBatch();
+
+    static void discardPendingBatch();
+
     void bindClearPosition();
 
 public:
@@ -185,9 +189,19 @@ public:
 
     bool execute(long max_rows, char* completionTag);
 
+    void flushBatch();
+
+    void discardBatch();
+
 private:
     void refreshParameterIfNecessary();
 
+    bool useBatchInsert();
+
+    bool relHasUniqueIndex(Relation rel);
+
+    bool executeBatch(char* completionTag);
+
     EState* m_estate;
 
     /* for func/op expr calculation */
@@ -198,6 +212,20 @@ private:
     int m_targetParamNum;
 
     bool m_is_bucket_rel;
+
+    /* rows of consecutive Bind/Execute messages waiting for one heap_multi_insert */
+    MemoryContext m_batchContext;
+
+    HeapTuple* m_batchTuples;
+
+    int m_batchNum;
+
+    int m_batchSize;
+
+    /* index OIDs relHasUniqueIndex last looked at, and what it found */
+    List* m_checkedIndexOids;
+
+    bool m_hasUniqueIndex;
 };
 
 class UpdateFusion : public OpFusion {
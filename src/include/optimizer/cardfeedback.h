@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2020 Huawei Technologies Co.,Ltd.
+ *
+ * openGauss is licensed under Mulan PSL v2.
+ * You can use this software according to the terms and conditions of the Mulan PSL v2.
+ * You may obtain a copy of Mulan PSL v2 at:
+ *
+ *          http://license.coscl.org.cn/MulanPSL2
+ *
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PSL v2 for more details.
+ * ---------------------------------------------------------------------------------------
+ *
+ * cardfeedback.h
+ *        Shared cardinality feedback store fed by executed scan nodes.
+ *
+ *
+ * IDENTIFICATION
+ *        src/include/optimizer/cardfeedback.h
+ *
+ * ---------------------------------------------------------------------------------------
+ */
+#ifndef CARDFEEDBACK_H
+#define CARDFEEDBACK_H
+
+#include "executor/execdesc.h"
+#include "fmgr.h"
+#include "utils/timestamp.h"
+
+/* upper bound of entries kept in the shared feedback store */
+#define CARD_FEEDBACK_MAX_ENTRIES 4096
+
+/* on-disk copy of the feedback store, rewritten at every checkpoint */
+#define CARD_FEEDBACK_FILENAME "global/pg_card_feedback"
+
+typedef struct CardFeedbackKey {
+    Oid dbid;          /* database of the relation */
+    Oid relid;         /* scanned relation */
+    uint32 predhash;   /* order-insensitive hash of the restriction clauses */
+} CardFeedbackKey;
+
+typedef struct CardFeedbackEntry {
+    CardFeedbackKey key;      /* hash key, must be first */
+    double selectivity;       /* blended observed selectivity */
+    double est_rows;          /* latest planner estimate of the scan */
+    double actual_rows;       /* latest observed rows per loop */
+    int64 nsamples;           /* number of executions folded in */
+    TimestampTz last_update;  /* last time the entry was refreshed */
+} CardFeedbackEntry;
+
+extern void InitCardFeedback(void);
+extern void CheckPointCardFeedback(void);
+
+extern bool CardFeedbackLookup(Oid relid, List* restrictinfo, Selectivity* selec);
+extern void CardFeedbackCollect(QueryDesc* queryDesc);
+
+extern Datum gs_get_card_feedback(PG_FUNCTION_ARGS);
+extern Datum gs_reset_card_feedback(PG_FUNCTION_ARGS);
+
+#endif /* CARDFEEDBACK_H */
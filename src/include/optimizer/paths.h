@@ -88,6 +88,7 @@ extern void create_joinrel_rqpath(PlannerInfo* root, RelOptInfo* joinrel, RelOpt
  *	  routines to determine which relations to join
  */
 extern void join_search_one_level(PlannerInfo* root, int level);
+extern RelOptInfo* dphyp_join_search(PlannerInfo* root, int levels_needed, List* initial_rels);
 extern RelOptInfo* make_join_rel(PlannerInfo* root, RelOptInfo* rel1, RelOptInfo* rel2);
 extern bool have_join_order_restriction(PlannerInfo* root, RelOptInfo* rel1, RelOptInfo* rel2);
 
@@ -55,6 +55,9 @@ const int CACHE_BLOCK_NO_LIST = -2;      // Invalid index -not in any list
 // Max usage count for CLOCK cache strategy
 const uint16 CACHE_BLOCK_MAX_USAGE = 5;
 
+// Number of clock sweep partitions, each with its own clock hand and lock
+const int CACHE_SWEEP_PARTITIONS = 8;
+
 /* common buffer cache function for cu cache and orc cache */
 #define MAX_CACHE_TAG_LEN (32)
 
@@ -71,6 +74,9 @@ typedef enum CacheType {
     CACHE_ORC_INDEX
 } CacheType;
 
+/* number of cache types, including CACHE_TYPE_NONE */
+#define CACHE_TYPE_NUM (CACHE_ORC_INDEX + 1)
+
 typedef enum MgrCacheType {
     /* cache manager type */
     MGR_CACHE_TYPE_DATA,
@@ -126,6 +132,43 @@ typedef struct CacheDesc {
     CacheFlags m_flag;
 } CacheDesc;
 
+/*
+ * Ring of cache blocks reused by a large sequential scan, like BufferAccessStrategy of heap.
+ * Once the scan has read more than ring_threshold bytes into the cache, the blocks it reads
+ * afterwards replace its own older blocks in the ring, instead of sweeping out blocks that
+ * the other sessions are using. A ring block touched by another session is left in the cache.
+ */
+typedef struct CacheAccessStrategyData {
+    int64 read_size;      /* bytes the scan has read into the cache */
+    int64 ring_threshold; /* the ring is used after reading this many bytes */
+    int ring_size;        /* number of slots in the ring */
+    int current;          /* ring position of the latest block */
+    CacheSlotId_t slots[FLEXIBLE_ARRAY_MEMBER];
+} CacheAccessStrategyData;
+
+typedef CacheAccessStrategyData *CacheAccessStrategy;
+
+extern CacheAccessStrategy GetCacheAccessStrategy(int ring_size, int64 ring_threshold);
+extern void FreeCacheAccessStrategy(CacheAccessStrategy strategy);
+
+/* access counters of one cache type */
+typedef struct CacheTypeStats {
+    pg_atomic_uint64 hits;        /* blocks found in the cache at the first access */
+    pg_atomic_uint64 reads;       /* blocks read into the cache, including prefetched ones */
+    pg_atomic_uint64 evictions;   /* blocks evicted by the clock sweep */
+    pg_atomic_uint64 ring_reuses; /* blocks replaced within the ring of a large scan */
+} CacheTypeStats;
+
+/* counters of one clock sweep, only reported when no block can be evicted */
+typedef struct CacheSweepStats {
+    int scanned;
+    int pinned;
+    int unpinned;
+    int invalid;
+    int reserved;
+    int freepinned;
+} CacheSweepStats;
+
 int CacheMgrNumLocks(int64 cache_size, uint32 each_block_size);
 int64 CacheMgrCalcSizeByType(MgrCacheType type);
 
@@ -144,7 +187,8 @@ public:
     CacheSlotId_t FindCacheBlock(CacheTag *cacheTag, bool first_enter_block);
     void InvalidateCacheBlock(CacheTag *cacheTag);
     void DeleteCacheBlock(CacheTag *cacheTag);
-    CacheSlotId_t ReserveCacheBlock(CacheTag *cacheTag, int size, bool &hasFound);
+    CacheSlotId_t ReserveCacheBlock(CacheTag *cacheTag, int size, bool &hasFound,
+                                    CacheAccessStrategy strategy = NULL);
     bool ReserveCacheBlockWithSlotId(CacheSlotId_t slotId);
     bool ReserveCstoreCacheBlockWithSlotId(CacheSlotId_t slotId);
     void *GetCacheBlock(CacheSlotId_t slotId);
@@ -195,6 +239,9 @@ public:
     }
     void CopyCacheBlockTag(CacheSlotId_t slotId, CacheTag *outTag);
 
+    /* access counters of the given cache type */
+    void GetCacheTypeStats(int type, uint64 *hits, uint64 *reads, uint64 *evictions, uint64 *ring_reuses);
+
     char *m_CacheSlots;
 
 #ifndef ENABLE_UT
@@ -205,7 +252,9 @@ private:
 
     /* internal block operate */
     CacheSlotId_t EvictCacheBlock(int size, int retryNum);
-    CacheSlotId_t GetFreeCacheBlock(int size);
+    CacheSlotId_t SweepPartition(int part, CacheSweepStats *stats);
+    CacheSlotId_t GetFreeCacheBlock(int size, CacheAccessStrategy strategy);
+    CacheSlotId_t GetRingCacheBlock(CacheAccessStrategy strategy);
 
     /* memory operate */
     bool ReserveCacheMem(int size);
@@ -228,7 +277,8 @@ private:
     bool CacheBlockIsPinned(CacheSlotId_t slotId) const;
     void PinCacheBlock_Locked(CacheSlotId_t slotId);
 
-    CacheSlotId_t AllocateBlockFromCache(CacheTag *cacheTag, uint32 hashCode, int size, bool &hasFound);
+    CacheSlotId_t AllocateBlockFromCache(CacheTag *cacheTag, uint32 hashCode, int size, bool &hasFound,
+                                         CacheAccessStrategy strategy);
     void AllocateBlockFromCacheWithSlotId(CacheSlotId_t slotId);
     void WaitEvictSlot(CacheSlotId_t slotId);
 
@@ -247,9 +297,17 @@ private:
     int m_freeListTail;
     slock_t m_freeList_lock;
 
-    int m_csweep;
+    /* protect m_CaccheSlotMax */
     LWLock *m_csweep_lock;
 
+    /* clock sweep partitions. partition i sweeps slots i, i + m_sweep_parts, i + 2 * m_sweep_parts ... */
+    int m_sweep_parts;
+    int *m_sweep_hands;
+    LWLock **m_sweep_locks;
+    pg_atomic_uint32 m_sweep_next;
+
+    CacheTypeStats m_stats[CACHE_TYPE_NUM];
+
     int m_partition_lock;
 
     /* protect memory size counter */
@@ -264,6 +264,95 @@ private:
     short m_outValSize;
 };
 
+// Frame-of-reference compression with bit packing.
+// each value is stored as its difference from the frame in the fewest bits. for sorted data
+// the difference from the previous value is stored instead (delta of FOR) if it needs fewer bits.
+// compressed data layout:
+//   format (1 byte) | bit width (1 byte) | frame value (8 bytes) | packed differences
+//
+#define BITPACK_FORMAT_FOR 0
+#define BITPACK_FORMAT_DELTA 1
+#define BITPACK_HEADER_SIZE (2 + sizeof(int64))
+// values are unpacked with 64-bit loads, so a difference must fit in 64 - 7 bits
+#define BITPACK_MAX_BITS 56
+
+class BitpackCoder : public BaseObject {
+public:
+    explicit BitpackCoder(short eachValSize) : m_eachValSize(eachValSize)
+    {}
+    virtual ~BitpackCoder()
+    {}
+
+    // return the compressed size, or 0 if bit packing doesn't make the data smaller than <maxsize>.
+    // <outbuf> must hold at least <maxsize> bytes.
+    //
+    int Compress(char* inbuf, char* outbuf, int insize, int maxsize, int64 mindata, int64 maxdata);
+
+    // <outsize> is the size of decompressed data, or raw data size.
+    //
+    int Decompress(char* inbuf, char* outbuf, int insize, int outsize);
+
+private:
+    template <typename T>
+    void Unpack(const uint8* inbuf, int insize, T* outbuf, int nvals, int bits, uint64 frame);
+
+    short m_eachValSize;
+};
+
+// FSST-style compression with a static symbol table.
+// a table of up to 255 symbols (1 ~ 8 bytes each) is trained on a sample of the values, and then
+// the values are encoded replacing byte sequences with 1-byte symbol codes. a byte that no symbol
+// starts with is written as the escape code followed by the byte itself.
+// compressed data layout:
+//   symbols count (1 byte) | symbol lengths (1 byte each) | symbol bytes |
+//   encoded size (4 bytes) | encoded values
+//
+#define FSST_MAX_SYMBOLS 255
+#define FSST_MAX_SYMBOL_LEN 8
+#define FSST_ESCAPE_CODE 255
+
+class FsstCoder : public BaseObject {
+public:
+    FsstCoder();
+    virtual ~FsstCoder()
+    {}
+
+    // <inbuf> holds <numVals> varlena values one after another.
+    // return the compressed size, or 0 if the compressed data isn't smaller than <maxsize>.
+    // <outbuf> must hold at least <maxsize> bytes.
+    //
+    int Compress(char* inbuf, int insize, int numVals, char* outbuf, int maxsize);
+
+    // read the symbol table of compressed data. it must be called before Decompress().
+    //
+    void Load(char* inbuf, int insize);
+
+    // restore all the values, and return the size of decompressed data or -1 if data corrupts.
+    //
+    int Decompress(char* outbuf, int outsize) const;
+
+private:
+    void BuildSymbolTable(char* inbuf, int insize, int numVals);
+    void BuildLookupIndex(void);
+    int FindLongestSymbol(const uint8* in, int len) const;
+    int EncodeBytes(const uint8* in, int len, uint8* out, const uint8* outEnd) const;
+    int DecodeBytes(const uint8* in, int len, char* out, const char* outEnd) const;
+
+    // symbol bytes, zero padded to 8 bytes
+    uint64 m_symbols[FSST_MAX_SYMBOLS];
+    uint8 m_symbolLens[FSST_MAX_SYMBOLS];
+    int m_symbolsNum;
+
+    // symbols grouped by their first byte, the longest first.
+    // group b is m_byFirstByte[m_firstByteStart[b]] ~ m_byFirstByte[m_firstByteStart[b + 1] - 1].
+    uint8 m_byFirstByte[FSST_MAX_SYMBOLS];
+    uint16 m_firstByteStart[257];
+
+    // compressed values set by Load()
+    int m_encodedSize;
+    const uint8* m_encoded;
+};
+
 typedef uint16 DicCodeType;
 
 /* Dictionary Data In Disk
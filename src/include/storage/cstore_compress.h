@@ -36,12 +36,16 @@
 #define CU_CompressExtend 0x0004    // Used for extended compression
 #define CU_Delta2Compressed 0x0005  // CU_Delta2Compressed equals CU_CompressExtend plus 0x0001
 #define CU_XORCompressed 0x0006     // CU_XORCompressed equals CU_CompressExtend plus 0x0002
+#define CU_FSSTCompressed 0x0007    // CU_FSSTCompressed equals CU_CompressExtend plus 0x0003
 #define CU_RLECompressed 0x0008
 #define CU_LzCompressed 0x0010
 #define CU_ZlibCompressed 0x0020
 #define CU_BitpackCompressed 0x0040
 #define CU_IntLikeCompressed 0x0080
 
+// CU_FSSTCompressed shares its bits with CU_DicEncode and CU_DeltaCompressed, so test it first
+#define CU_IS_FSST_COMPRESSED(_modes) (CU_FSSTCompressed == ((_modes) & CU_FSSTCompressed))
+
 extern bool NeedToRecomputeMinMax(Oid typeOid);
 extern int64 ConvertToInt64Data(_in_ const char* inBuf, _in_ const short eachValSize);
 extern void Int64DataConvertTo(_in_ int64 inVal, _in_ short eachValSize, _out_ char* outBuf);
@@ -64,8 +68,10 @@ struct compression_options {
     bool m_adopt_numeric2int_int64_rle;
 
     /* common flags */
-    bool m_adopt_dict; /* Dictionary encoding */
-    bool m_adopt_rle;  /* RLE encoding */
+    bool m_adopt_dict;    /* Dictionary encoding */
+    bool m_adopt_rle;     /* RLE encoding */
+    bool m_adopt_bitpack; /* Frame-of-reference bit packing */
+    bool m_adopt_fsst;    /* Static symbol table compression */
 
     void reset(void);
     void set_numeric_flags(uint16 modes);
@@ -91,6 +97,8 @@ typedef struct {
     bool useDict;
     bool useGlobalDict;
     bool buildGlobalDict;
+    /* values are varlena, so that they can be encoded one by one */
+    bool useFsst;
 } CompressionArg1;
 
 // output arguments for compression &&
@@ -114,6 +122,7 @@ public:
 
     /* optimizing flags */
     bool m_adopt_rle;
+    bool m_adopt_bitpack;
 
 private:
     void InsertMinMaxVal(char* buf, int* usedSize);
@@ -137,15 +146,27 @@ public:
     virtual ~StringCoder()
     {}
 
-    StringCoder() : m_adopt_rle(true), m_adopt_dict(true), m_dicCodes(NULL), m_dicCodesNum(0)
+    StringCoder()
+        : m_adopt_rle(true), m_adopt_dict(true), m_adopt_fsst(true), m_keep_dic_codes(false), m_dicCodes(NULL),
+          m_dicCodesNum(0), m_dicItemsNum(0)
     {}
 
     int Compress(_in_ CompressionArg1& in, _in_ CompressionArg2& out);
     int Decompress(_in_ const CompressionArg2& in, _out_ CompressionArg1& out);
 
+    /*
+     * hand the dictionary codes kept by Decompress() over to the caller,
+     * who must pfree them. NULL is returned if no code is kept.
+     */
+    DicCodeType* DetachDicCodes(_out_ int& codesNum, _out_ int& itemsNum);
+
     /* optimizing flags */
     bool m_adopt_rle;
     bool m_adopt_dict;
+    bool m_adopt_fsst;
+
+    /* keep the dictionary codes after decompressing, see DetachDicCodes() */
+    bool m_keep_dic_codes;
 
 private:
     /* inner implement for compress api */
@@ -159,6 +180,10 @@ private:
     int DecompressWithoutDict(
         _in_ char* inBuf, _in_ int inBufSize, _in_ uint16 mode, _out_ char* outBuf, _out_ int outBufSize);
 
+    // compress values with a static symbol table, see FsstCoder.
+    // the result is kept only if it isn't bigger than <cmprSize>, or the raw data if <cmprSize> is 0.
+    int CompressWithFsst(_in_ CompressionArg1& in, _in_ int cmprSize, _out_ CompressionArg2& out);
+
     int CompressNumbers(
         _in_ int max, _in_ int compressing_modes, __inout char* outBuf, _in_ int outBufSize, _out_ uint16& mode);
     void DecompressNumbers(
@@ -167,6 +192,7 @@ private:
 private:
     DicCodeType* m_dicCodes;
     DicCodeType m_dicCodesNum;
+    int m_dicItemsNum;
 };
 
 /// light-weight implementation for Delta-RLE compression.
@@ -231,6 +231,17 @@ public:
     /* the number of m_offset items */
     int32 m_offsetSize;
 
+    /*
+     * dictionary code of each row, kept after loading a dictionary encoded CU,
+     * so that predicates can be evaluated once per dictionary item. the code
+     * of a NULL row is meaningless. NULL if the CU is not dictionary encoded.
+     */
+    uint16* m_dicCodes;
+
+    /* the size of m_dicCodes, and the number of dictionary items */
+    int32 m_dicCodesSize;
+    int32 m_dicItemCount;
+
     /* source buffer size. */
     uint32 m_srcBufSize;
 
@@ -337,6 +348,7 @@ public:
     void UnCompressData(_in_ char* buf, _in_ int rowCount);
     template <bool DscaleFlag>
     void UncompressNumeric(char* inBuf, int nNotNulls, int typmode);
+    void FormDicCodes(_in_ const uint16* codes, _in_ int codesNum, _in_ int itemCount, _in_ int rowCount);
 
     // access datum randomly in CU
     //
@@ -524,6 +536,16 @@ void CU::FreeMem()
         this->m_offset = NULL;
         this->m_offsetSize = 0;
     }
+    if (this->m_dicCodes) {
+        if (!freeByCUCacheMgr) {
+            CStoreMemAlloc::Pfree(this->m_dicCodes, !this->m_inCUCache);
+        } else {
+            free(this->m_dicCodes);
+        }
+        this->m_dicCodes = NULL;
+        this->m_dicCodesSize = 0;
+        this->m_dicItemCount = 0;
+    }
 }
 
 #endif
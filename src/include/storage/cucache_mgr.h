@@ -111,7 +111,7 @@ public:
     DataSlotTag InitOBSSlotTag(uint32 hostNameHash, uint32 bucketNameHash, uint32 fileFirstHalfHash,
         uint32 fileSecondHalfHash, uint64 offset, uint64 length) const;
     CacheSlotId_t FindDataBlock(DataSlotTag* dataSlotTag, bool first_enter_block);
-    int ReserveDataBlock(DataSlotTag* dataSlotTag, int size, bool& hasFound);
+    int ReserveDataBlock(DataSlotTag* dataSlotTag, int size, bool& hasFound, CacheAccessStrategy strategy = NULL);
     bool ReserveDataBlockWithSlotId(int slotId);
     bool ReserveCstoreDataBlockWithSlotId(int slotId);
     CU* GetCUBuf(int cuSlotId);
@@ -121,6 +121,7 @@ public:
     bool DataBlockWaitIO(int cuSlotId);
     void DataBlockCompleteIO(int cuSlotId);
     int64 GetCurrentMemSize();
+    void GetCacheTypeStats(int type, uint64* hits, uint64* reads, uint64* evictions, uint64* ring_reuses);
     void PrintDataCacheSlotLeakWarning(CacheSlotId_t slotId);
 
     void AbortCU(CacheSlotId_t slot);
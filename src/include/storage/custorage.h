@@ -59,6 +59,10 @@ public:
 
     int WSLoad(_in_ uint64 offset, _in_ int size, __inout char* outbuf, bool direct_flag);
 
+    // Hint the kernel to read data ahead
+    //
+    void Prefetch(_in_ uint64 offset, _in_ int size);
+
     void GetFileName(_out_ char* fileName, _in_ int size, _in_ int fileId) const;
     bool IsDataFileExist(int fileId) const;
 
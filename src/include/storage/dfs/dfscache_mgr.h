@@ -100,6 +100,7 @@ public:
     void UnPinMetaBlock(CacheSlotId_t slot);
 
     int64 GetCurrentMemSize();
+    void GetCacheTypeStats(uint64 *hits, uint64 *reads, uint64 *evictions, uint64 *ring_reuses);
     void PrintMetaCacheSlotLeakWarning(CacheSlotId_t slotId) const;
 
     void AbortMetaBlock(CacheSlotId_t slot);
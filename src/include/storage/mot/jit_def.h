@@ -80,7 +80,10 @@ enum JitCommandType : uint8_t {
     JIT_COMMAND_AGGREGATE_JOIN,
 
     /** @var Compound select command (point-select with sub-queries). */
-    JIT_COMMAND_COMPOUND_SELECT
+    JIT_COMMAND_COMPOUND_SELECT,
+
+    /** @var Range select command with aggregation grouped by an index prefix. */
+    JIT_COMMAND_GROUP_BY_RANGE_SELECT
 };
 
 /** @enum JIT context usage constants. */
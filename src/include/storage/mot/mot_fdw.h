@@ -66,4 +66,18 @@ extern char* MOTCheckpointFetchDirName();
 extern char* MOTCheckpointFetchWorkingDir();
 extern uint64_t MOTCheckpointGetId();
 
+/** @brief MOT redo replay progress, reported by mot_redo_replay_progress(). */
+typedef struct MotRedoReplayProgress {
+    uint32_t workers;         /* number of redo replay workers (0 if replayed by the recovery thread) */
+    uint64_t replayedTxns;    /* transactions replayed by the workers */
+    uint64_t serialTxns;      /* transactions replayed by the recovery thread */
+    uint64_t pendingTxns;     /* transactions queued to the workers */
+    uint64_t replayedOps;     /* row operations replayed by the workers */
+    uint64_t lastReplayLsn;   /* all the redo below this LSN was replayed */
+    uint64_t maxRecoveredCsn; /* highest commit sequence number recovered */
+} MotRedoReplayProgress;
+
+/** @brief Retrieves the MOT redo replay progress. */
+extern void MOTGetRedoReplayProgress(MotRedoReplayProgress* progress);
+
 #endif  // MOT_FDW_H
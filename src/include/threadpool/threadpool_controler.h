@@ -84,6 +84,8 @@ public:
         return m_groupNum;
     }
 
+    ThreadPoolGroup* FindThreadGroupOnNumaNode(int numaId);
+
     void BindThreadToAllAvailCpu(ThreadId thread) const;
 
 private:
@@ -43,6 +43,7 @@ public:
     void NotifyReady();
     bool TryFeedWorker(ThreadPoolWorker* worker);
     void AddNewSession(knl_session_context* session);
+    void AddMigratedSession(knl_session_context* session);
     void WaitTask();
     void DelSessionFromEpoll(knl_session_context* session);
     void RemoveWorkerFromList(ThreadPoolWorker* worker);
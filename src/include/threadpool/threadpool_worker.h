@@ -122,6 +122,7 @@ private:
     void CleanThread();
     bool AttachSessionToThread();
     void DetachSessionFromThread();
+    ThreadPoolGroup* GetSessionHomeGroup();
     void WaitNextSession();
     bool InitPort(Port* port);
     void FreePort(Port* port);
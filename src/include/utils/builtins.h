@@ -1518,6 +1518,7 @@ extern Datum check_engine_status(PG_FUNCTION_ARGS);
 /* MOT */
 extern Datum mot_global_memory_detail(PG_FUNCTION_ARGS);
 extern Datum mot_local_memory_detail(PG_FUNCTION_ARGS);
+extern Datum mot_redo_replay_progress(PG_FUNCTION_ARGS);
 extern Datum mot_session_memory_detail(PG_FUNCTION_ARGS);
 
 #endif /* BUILTINS_H */
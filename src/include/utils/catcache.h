@@ -109,6 +109,7 @@ typedef struct catctup {
     bool dead;           /* dead but not yet removed? */
     bool negative;       /* negative cache entry? */
     bool isnailed;       /* indicate if we can reomve this cattup from syscache or not */
+    uint64 lastaccess;   /* ch_clock when last created or found by a search */
     HeapTupleData tuple; /* tuple management header */
 
     /*
@@ -170,6 +171,9 @@ typedef struct catclist {
 typedef struct CatCacheHeader {
     CatCache* ch_caches; /* head of list of CatCache structs */
     int ch_ntup;         /* # of tuples in all caches */
+    int64 ch_size;       /* bytes of tuples in all caches */
+    uint64 ch_clock;     /* # of tuples created or found by searches */
+    uint64 ch_pruned;    /* ch_clock when the caches were last pruned */
 } CatCacheHeader;
 
 extern void AtEOXact_CatCache(bool isCommit);
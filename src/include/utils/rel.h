@@ -285,6 +285,8 @@ typedef struct StdRdOptions {
     bool ignore_enable_hadoop_env; /* ignore enable_hadoop_env */
     bool user_catalog_table;       /* use as an additional catalog relation */
     bool hashbucket;        /* enable hash bucket for this relation */
+    bool hash_index;        /* MOT index built as a hash index (equality lookups only) */
+    bool bloom_filter;      /* keep a bloom filter of each CU of column relation */
 
     /* info for redistribution */
     Oid rel_cn_oid;
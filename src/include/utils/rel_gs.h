@@ -332,6 +332,12 @@ static inline RedisHtlAction RelationGetAppendMode(Relation rel)
                             RelationGetMaxBatchRows(relation)))                                          \
             : RelDefaultPartialClusterRows)
 
+// RelationBloomFilterEnabled
+//    Return the relation's bloom_filter option
+//
+#define RelationBloomFilterEnabled(relation) \
+    ((relation)->rd_options ? ((StdRdOptions*)(relation)->rd_options)->bloom_filter : false)
+
 /* Relation whether create in current xact */
 static inline bool RelationCreateInCurrXact(Relation rel)
 {
@@ -0,0 +1,5 @@
+START TRANSACTION;
+insert into batch_ins_nokey values (1, 'one');
+insert into batch_ins_nokey values (2, 'two');
+insert into batch_ins_nokey values (3, 'three');
+COMMIT TRANSACTION;
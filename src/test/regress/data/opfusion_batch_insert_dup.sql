@@ -0,0 +1,4 @@
+START TRANSACTION;
+insert into batch_ins_pkey values (2, 'two');
+insert into batch_ins_pkey values (1, 'one');
+COMMIT TRANSACTION;
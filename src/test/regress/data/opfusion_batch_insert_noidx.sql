@@ -0,0 +1,7 @@
+START TRANSACTION;
+insert into batch_ins_noidx values (1, 'one');
+insert into batch_ins_noidx values (2, 'two');
+insert into batch_ins_noidx values (3, 'three');
+insert into batch_ins_noidx values (4, 'four');
+insert into batch_ins_noidx values (5, 'five');
+COMMIT TRANSACTION;
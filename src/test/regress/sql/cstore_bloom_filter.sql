@@ -0,0 +1,65 @@
+--
+-- per-CU bloom filters of column tables
+--
+CREATE TABLE cstore_bloom_raw (id INT4, a INT4, b INT4, s VARCHAR(16), v TEXT);
+-- a: 5000 distinct values per CU, spread over the whole range so min/max can't skip any CU
+-- b: 20000 distinct values per CU, too many for a filter of useful selectivity
+INSERT INTO cstore_bloom_raw
+SELECT id,
+	CASE WHEN id % 1000 = 0 THEN NULL ELSE ((id - 1) / 4) * 7919 % 100003 END,
+	id * 7919 % 100003,
+	CASE WHEN id % 1000 = 0 THEN NULL ELSE 'k' || ((id - 1) / 4) * 7919 % 100003 END,
+	md5(id::text)
+FROM generate_series(1, 100000) id;
+CREATE TABLE cstore_bloom_col WITH (orientation = column, bloom_filter = on, max_batchrow = 20000)
+	AS SELECT * FROM cstore_bloom_raw;
+CREATE TABLE cstore_bloom_plain WITH (orientation = column, max_batchrow = 20000)
+	AS SELECT * FROM cstore_bloom_raw;
+SELECT 'bloom_filter=on' = ANY(reloptions) AS bloom_filter FROM pg_class WHERE relname = 'cstore_bloom_col';
+-- bloom_filter is an option of column relations only
+CREATE TABLE cstore_bloom_row (a INT4) WITH (bloom_filter = on);
+ALTER TABLE cstore_bloom_raw SET (bloom_filter = on);
+CREATE TABLE cstore_bloom_ts (ts TIMESTAMP TSTIME, tag TEXT TSTAG, val INT4 TSFIELD)
+	WITH (orientation = timeseries, bloom_filter = on);
+-- filters are kept only for the CUs of a and s
+CREATE FUNCTION cstore_bloom_filters(tbl regclass) RETURNS TABLE(col_id INT4, cus INT8, filters INT8) AS $$
+BEGIN
+	RETURN QUERY EXECUTE 'SELECT col_id, count(*), count(extra) FROM ' ||
+		(SELECT relcudescrelid FROM pg_class WHERE oid = tbl)::regclass::text ||
+		' WHERE col_id > 0 GROUP BY col_id ORDER BY col_id';
+END;
+$$ LANGUAGE plpgsql;
+SELECT * FROM cstore_bloom_filters('cstore_bloom_col');
+SELECT * FROM cstore_bloom_filters('cstore_bloom_plain');
+-- the filters skip the CUs which min/max can't
+CREATE TABLE cstore_bloom_stats0 AS
+	SELECT hits + reads AS requests FROM pg_stat_get_cache_hit_stats() WHERE cache_type = 'CU';
+SELECT count(*) FROM cstore_bloom_col WHERE a = 84533;
+CREATE TABLE cstore_bloom_stats1 AS
+	SELECT hits + reads AS requests FROM pg_stat_get_cache_hit_stats() WHERE cache_type = 'CU';
+SELECT count(*) FROM cstore_bloom_plain WHERE a = 84533;
+CREATE TABLE cstore_bloom_stats2 AS
+	SELECT hits + reads AS requests FROM pg_stat_get_cache_hit_stats() WHERE cache_type = 'CU';
+SELECT s1.requests - s0.requests < s2.requests - s1.requests AS skipped
+	FROM cstore_bloom_stats0 s0, cstore_bloom_stats1 s1, cstore_bloom_stats2 s2;
+-- and return the same rows as a plain scan
+SELECT id, b, s FROM cstore_bloom_col WHERE a IN (96909, 72157, 62875) ORDER BY id;
+SELECT count(*) FROM cstore_bloom_col WHERE a = 84533::INT8;
+SELECT count(*) FROM cstore_bloom_col WHERE a = ANY(ARRAY[84533, NULL]);
+SELECT count(*) FROM cstore_bloom_col WHERE a = 62875;
+SELECT count(*) FROM cstore_bloom_col WHERE s = 'k84533';
+SELECT count(*) FROM cstore_bloom_col WHERE s IN ('k96909', 'k62875');
+SELECT count(*) FROM cstore_bloom_col WHERE b = 7919;
+SELECT * FROM cstore_bloom_col WHERE a IN (96909, 72157, 84533) AND s LIKE 'k%'
+MINUS ALL
+SELECT * FROM cstore_bloom_raw WHERE a IN (96909, 72157, 84533) AND s LIKE 'k%';
+SELECT * FROM cstore_bloom_raw WHERE a IN (96909, 72157) AND v IS NOT NULL
+MINUS ALL
+SELECT * FROM cstore_bloom_col WHERE a IN (96909, 72157) AND v IS NOT NULL;
+DROP FUNCTION cstore_bloom_filters(regclass);
+DROP TABLE cstore_bloom_stats0;
+DROP TABLE cstore_bloom_stats1;
+DROP TABLE cstore_bloom_stats2;
+DROP TABLE cstore_bloom_col;
+DROP TABLE cstore_bloom_plain;
+DROP TABLE cstore_bloom_raw;
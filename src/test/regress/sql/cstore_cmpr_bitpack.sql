@@ -0,0 +1,55 @@
+--
+-- bit packing of integer CUs: values of every bit width come back unchanged,
+-- whether they are unpacked by the SIMD loop (int4 and int8) or the scalar one (int2),
+-- and in both the frame of reference and the delta format.
+--
+CREATE TABLE cmpr_bitpack_raw
+(
+	id INT4,
+	w0 INT4,         -- constant after the first CU, packed with 0 bits
+	w1 INT4,         -- 0 and 1, packed with 1 bit
+	w1_8 INT8,
+	w32 INT8,        -- full 32-bit range
+	w56 INT8,        -- widest range that is packed
+	w64 INT8,        -- full 64-bit range, not packed
+	d4 INT4,         -- sorted, packed as steps
+	d8 INT8,
+	s2 INT2,         -- unpacked by the scalar loop
+	d2 INT2
+);
+INSERT INTO cmpr_bitpack_raw
+SELECT id,
+	CASE WHEN id <= 10001 THEN (id * 7919) % 1000 ELSE 42 END,
+	id % 2,
+	((id * 5) % 7) % 2,
+	CASE id % 3 WHEN 0 THEN 0 WHEN 1 THEN 4294967295 ELSE (id::int8 * 2654435761) % 4294967296 END,
+	CASE id % 3 WHEN 0 THEN -36028797018963968 WHEN 1 THEN 36028797018963967 ELSE id::int8 * 2654435761 END,
+	CASE id % 3 WHEN 0 THEN -9223372036854775808 WHEN 1 THEN 9223372036854775807 ELSE id END,
+	id * 3 + id % 2,
+	id::int8 * 1000003 + id % 5,
+	(id * 37) % 1000,
+	id / 3
+FROM generate_series(1, 30005) id;
+
+-- CUs of 10001 values leave one value to the scalar tail, and the last CU holds only 2 values
+CREATE TABLE cmpr_bitpack_low WITH (orientation = column, max_batchrow = 10001, compression = low)
+	AS SELECT * FROM cmpr_bitpack_raw;
+CREATE TABLE cmpr_bitpack_high WITH (orientation = column, max_batchrow = 10001, compression = high)
+	AS SELECT * FROM cmpr_bitpack_raw;
+
+SELECT count(*) FROM cmpr_bitpack_low;
+(SELECT * FROM cmpr_bitpack_raw) MINUS ALL (SELECT * FROM cmpr_bitpack_low);
+(SELECT * FROM cmpr_bitpack_low) MINUS ALL (SELECT * FROM cmpr_bitpack_raw);
+SELECT count(*) FROM cmpr_bitpack_high;
+(SELECT * FROM cmpr_bitpack_raw) MINUS ALL (SELECT * FROM cmpr_bitpack_high);
+(SELECT * FROM cmpr_bitpack_high) MINUS ALL (SELECT * FROM cmpr_bitpack_raw);
+
+-- values at CU boundaries
+SELECT id, w0, w1, w32, w56, w64, d4, d8, s2, d2 FROM cmpr_bitpack_low
+	WHERE id IN (1, 2, 3, 10001, 10002, 30002, 30005) ORDER BY id;
+SELECT sum(w0), sum(w1), sum(w1_8), sum(w32), sum(w56), sum(d4), sum(d8), sum(s2), sum(d2) FROM cmpr_bitpack_high;
+SELECT count(*) FROM cmpr_bitpack_low WHERE w64 = 9223372036854775807 AND w32 = 4294967295;
+
+DROP TABLE cmpr_bitpack_raw;
+DROP TABLE cmpr_bitpack_low;
+DROP TABLE cmpr_bitpack_high;
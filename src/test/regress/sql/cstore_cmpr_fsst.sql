@@ -0,0 +1,39 @@
+--
+-- strings the dictionary can't encode are compressed with a static symbol table:
+-- values of every length, bytes no symbol starts with, empty strings and NULL values come back unchanged.
+--
+CREATE TABLE cmpr_fsst_raw
+(
+	id INT4,
+	email TEXT,
+	url TEXT,
+	note TEXT,
+	big TEXT
+);
+INSERT INTO cmpr_fsst_raw
+SELECT id,
+	'user' || id || '@' || (ARRAY['example.com', 'mail.org', 'corp.net'])[id % 3 + 1],
+	'https://www.site' || (id % 97) || '.com/path/' || md5(id::text),
+	CASE WHEN id % 100 = 0 THEN '' WHEN id % 101 = 0 THEN NULL ELSE repeat('abc', id % 5) || '~' || id || '|' END,
+	CASE WHEN id % 1000 = 1 THEN repeat('lorem ipsum ', 300) || id ELSE 'short ' || id END
+FROM generate_series(1, 20000) id;
+
+CREATE TABLE cmpr_fsst_low WITH (orientation = column, max_batchrow = 10001, compression = low)
+	AS SELECT * FROM cmpr_fsst_raw;
+CREATE TABLE cmpr_fsst_high WITH (orientation = column, max_batchrow = 10001, compression = high)
+	AS SELECT * FROM cmpr_fsst_raw;
+
+SELECT count(*) FROM cmpr_fsst_low;
+(SELECT * FROM cmpr_fsst_raw) MINUS ALL (SELECT * FROM cmpr_fsst_low);
+(SELECT * FROM cmpr_fsst_low) MINUS ALL (SELECT * FROM cmpr_fsst_raw);
+SELECT count(*) FROM cmpr_fsst_high;
+(SELECT * FROM cmpr_fsst_raw) MINUS ALL (SELECT * FROM cmpr_fsst_high);
+(SELECT * FROM cmpr_fsst_high) MINUS ALL (SELECT * FROM cmpr_fsst_raw);
+
+SELECT id, email, note, length(url), length(big) FROM cmpr_fsst_low WHERE id IN (1, 100, 101, 10001, 10002, 20000) ORDER BY id;
+SELECT sum(length(email)), sum(length(url)), sum(length(note)), sum(length(big)) FROM cmpr_fsst_high;
+SELECT count(*) FROM cmpr_fsst_low WHERE email LIKE '%@mail.org' AND note LIKE 'abcabc~%';
+
+DROP TABLE cmpr_fsst_raw;
+DROP TABLE cmpr_fsst_low;
+DROP TABLE cmpr_fsst_high;
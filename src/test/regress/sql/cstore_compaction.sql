@@ -0,0 +1,43 @@
+--
+-- VACUUM compacts the CUs of a column table with many deleted rows
+--
+CREATE TABLE cstore_compact_raw (id INT4, dropped INT4, tag VARCHAR(8), val TEXT);
+INSERT INTO cstore_compact_raw SELECT id, id, lpad(id::text, 6, '0'), md5(id::text) FROM generate_series(1, 30000) id;
+CREATE TABLE cstore_compact_col WITH (orientation = column, max_batchrow = 10000) AS SELECT * FROM cstore_compact_raw;
+-- dropped columns are not read again
+ALTER TABLE cstore_compact_raw DROP COLUMN dropped;
+ALTER TABLE cstore_compact_col DROP COLUMN dropped;
+-- 20% of the first CU and 70% of the second one deleted
+DELETE FROM cstore_compact_raw WHERE id <= 2000 OR id BETWEEN 10001 AND 17000;
+DELETE FROM cstore_compact_col WHERE id <= 2000 OR id BETWEEN 10001 AND 17000;
+CREATE FUNCTION cstore_compact_cus(tbl regclass) RETURNS TABLE(cu INT8, cu_min TEXT, cu_max TEXT, cu_rows INT4) AS $$
+BEGIN
+	RETURN QUERY EXECUTE 'SELECT row_number() OVER (ORDER BY cu_id), min, max, row_count FROM ' ||
+		(SELECT relcudescrelid FROM pg_class WHERE oid = tbl)::regclass::text ||
+		' WHERE col_id = 3 ORDER BY cu_id';
+END;
+$$ LANGUAGE plpgsql;
+-- the compaction is disabled by default
+SHOW cstore_compaction_dead_ratio;
+VACUUM cstore_compact_col;
+SELECT * FROM cstore_compact_cus('cstore_compact_col');
+-- only the second CU reaches the ratio, its live rows are moved into a new CU
+SET cstore_compaction_dead_ratio = 0.5;
+VACUUM cstore_compact_col;
+SELECT * FROM cstore_compact_cus('cstore_compact_col');
+SELECT count(*), sum(id), min(tag), max(tag) FROM cstore_compact_col;
+SELECT count(*), sum(id), min(tag), max(tag) FROM cstore_compact_raw;
+SELECT count(*), min(id), max(id) FROM cstore_compact_col WHERE tag BETWEEN '017001' AND '017010';
+SELECT * FROM cstore_compact_col
+MINUS ALL
+SELECT * FROM cstore_compact_raw;
+SELECT * FROM cstore_compact_raw
+MINUS ALL
+SELECT * FROM cstore_compact_col;
+-- nothing left to compact
+VACUUM cstore_compact_col;
+SELECT * FROM cstore_compact_cus('cstore_compact_col');
+RESET cstore_compaction_dead_ratio;
+DROP FUNCTION cstore_compact_cus(regclass);
+DROP TABLE cstore_compact_col;
+DROP TABLE cstore_compact_raw;
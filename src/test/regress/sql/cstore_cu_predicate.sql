@@ -0,0 +1,57 @@
+--
+-- scan quals evaluated once per dictionary item or RLE run of a CU
+-- must return the same rows as a plain scan of a row table.
+--
+CREATE TABLE cu_pred_raw
+(
+	id INT4,
+	dict TEXT,       -- few distinct values, dictionary encoded
+	run INT4,        -- runs of 1000 equal values, RLE encoded
+	run8 INT8,
+	runnull INT4     -- runs with NULL values in between
+);
+INSERT INTO cu_pred_raw
+SELECT id,
+	CASE WHEN id % 50 = 0 THEN NULL ELSE 'item_' || (id % 7) END,
+	id / 1000,
+	(id / 500) * 1000000000,
+	CASE WHEN id % 3000 < 100 THEN NULL ELSE id / 700 END
+FROM generate_series(1, 30000) id;
+CREATE TABLE cu_pred_col WITH (orientation = column, max_batchrow = 10001) AS SELECT * FROM cu_pred_raw;
+-- deleted rows stay invisible
+DELETE FROM cu_pred_raw WHERE id % 10 = 3;
+DELETE FROM cu_pred_col WHERE id % 10 = 3;
+
+-- dictionary encoded CUs
+SELECT count(*), sum(id) FROM cu_pred_col WHERE dict = 'item_3';
+SELECT count(*), sum(id) FROM cu_pred_raw WHERE dict = 'item_3';
+SELECT count(*), sum(id) FROM cu_pred_col WHERE dict IN ('item_1', 'item_5', 'none');
+SELECT count(*), sum(id) FROM cu_pred_raw WHERE dict IN ('item_1', 'item_5', 'none');
+SELECT count(*), sum(id) FROM cu_pred_col WHERE dict LIKE '%_6';
+SELECT count(*), sum(id) FROM cu_pred_raw WHERE dict LIKE '%_6';
+SELECT count(*), sum(id) FROM cu_pred_col WHERE dict <> ALL (ARRAY['item_0', 'item_2']);
+SELECT count(*), sum(id) FROM cu_pred_raw WHERE dict <> ALL (ARRAY['item_0', 'item_2']);
+SELECT count(*), sum(id) FROM cu_pred_col WHERE dict <> ALL (ARRAY['item_0', NULL]);
+SELECT count(*), sum(id) FROM cu_pred_raw WHERE dict <> ALL (ARRAY['item_0', NULL]);
+
+-- RLE encoded CUs
+SELECT count(*), sum(id) FROM cu_pred_col WHERE run = 7;
+SELECT count(*), sum(id) FROM cu_pred_raw WHERE run = 7;
+SELECT count(*), sum(id) FROM cu_pred_col WHERE run BETWEEN 3 AND 5;
+SELECT count(*), sum(id) FROM cu_pred_raw WHERE run BETWEEN 3 AND 5;
+SELECT count(*), sum(id) FROM cu_pred_col WHERE run8 IN (2000000000, 59000000000);
+SELECT count(*), sum(id) FROM cu_pred_raw WHERE run8 IN (2000000000, 59000000000);
+SELECT count(*), sum(id) FROM cu_pred_col WHERE runnull < 5;
+SELECT count(*), sum(id) FROM cu_pred_raw WHERE runnull < 5;
+SELECT count(*), sum(id) FROM cu_pred_col WHERE run = ANY (ARRAY[]::int[]);
+
+-- several quals on both kinds of CUs
+SELECT count(*), sum(id) FROM cu_pred_col WHERE run = 7 AND dict = 'item_3';
+SELECT count(*), sum(id) FROM cu_pred_raw WHERE run = 7 AND dict = 'item_3';
+(SELECT * FROM cu_pred_raw WHERE run BETWEEN 3 AND 25 AND dict LIKE 'item_%' AND runnull <> 10)
+	MINUS ALL (SELECT * FROM cu_pred_col WHERE run BETWEEN 3 AND 25 AND dict LIKE 'item_%' AND runnull <> 10);
+(SELECT * FROM cu_pred_col WHERE run BETWEEN 3 AND 25 AND dict LIKE 'item_%' AND runnull <> 10)
+	MINUS ALL (SELECT * FROM cu_pred_raw WHERE run BETWEEN 3 AND 25 AND dict LIKE 'item_%' AND runnull <> 10);
+
+DROP TABLE cu_pred_raw;
+DROP TABLE cu_pred_col;
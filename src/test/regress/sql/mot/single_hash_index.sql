@@ -0,0 +1,23 @@
+create foreign table hash_ix_t (id int not null, val int not null);
+create unique index hash_ix_t_id on hash_ix_t(id) with (hash_index = on);
+create index hash_ix_t_val on hash_ix_t(val) with (hash_index = on);
+insert into hash_ix_t values (generate_series(1,1000), generate_series(1,1000));
+
+select val from hash_ix_t where id = 500;
+update hash_ix_t set val = 0 where id = 500;
+select val from hash_ix_t where id = 500;
+delete from hash_ix_t where id = 500;
+select count(*) from hash_ix_t where id = 500;
+
+-- full scan and range predicates do not use the hash index order
+select count(*) from hash_ix_t;
+select id from hash_ix_t where id < 4 order by id;
+
+drop foreign table hash_ix_t;
+
+-- hash_index only applies to MOT indexes and is fixed once the index exists
+create table hash_ix_heap (id int);
+create unique index hash_ix_heap_id on hash_ix_heap(id) with (hash_index = on);
+create unique index hash_ix_heap_id on hash_ix_heap(id);
+alter index hash_ix_heap_id set (hash_index = on);
+drop table hash_ix_heap;
@@ -0,0 +1,30 @@
+-- secondary indexes built by several workers on a populated table
+create foreign table index_build_t (id int not null, val int not null, grp int not null);
+insert into index_build_t select g, 300000 - g, g % 1000 from generate_series(1, 300000) g;
+create unique index index_build_t_id on index_build_t(id);
+-- rows changed by the creating transaction are caught up after the workers are done
+begin;
+insert into index_build_t values (300001, 123, 1);
+create unique index index_build_t_val on index_build_t(val);
+rollback;
+begin;
+delete from index_build_t where id <= 10;
+update index_build_t set grp = grp + 1000 where id between 11 and 20;
+insert into index_build_t values (300001, -1, 7);
+create unique index index_build_t_val on index_build_t(val);
+commit;
+create index index_build_t_grp on index_build_t(grp);
+-- a duplicate found by any worker fails the whole build
+create unique index index_build_t_grp_u on index_build_t(grp);
+
+select count(*) from index_build_t where grp = 7;
+select id from index_build_t where val = 123;
+select id from index_build_t where val = 299995;
+select id, grp from index_build_t where val = 299985;
+select id, grp from index_build_t where val = -1;
+select count(*) from index_build_t where grp = 15;
+select count(*) from index_build_t where grp = 1015;
+select count(*), min(val), max(val) from index_build_t where id between 1000 and 1999;
+select count(*) from index_build_t where id = 300001;
+
+drop foreign table index_build_t;
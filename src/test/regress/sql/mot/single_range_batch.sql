@@ -0,0 +1,49 @@
+--
+-- range scans read ahead in batches of 16 items
+--
+CREATE FOREIGN TABLE range_batch (id int primary key, grp int, v int) SERVER mot_server;
+CREATE INDEX range_batch_grp_idx ON range_batch (grp);
+INSERT INTO range_batch SELECT g, (g - 1) / 20, g * 2 FROM generate_series(1, 200) g;
+-- inclusive and exclusive end keys at and around the batch boundaries
+SELECT count(*), min(id), max(id), sum(v) FROM range_batch WHERE id >= 1 AND id <= 16;
+SELECT count(*), min(id), max(id), sum(v) FROM range_batch WHERE id >= 1 AND id <= 17;
+SELECT count(*), min(id), max(id), sum(v) FROM range_batch WHERE id > 16 AND id <= 48;
+SELECT count(*), min(id), max(id), sum(v) FROM range_batch WHERE id >= 100 AND id < 116;
+SELECT count(*), min(id), max(id), sum(v) FROM range_batch WHERE id >= 100 AND id < 117;
+SELECT count(*), min(id), max(id), sum(v) FROM range_batch WHERE id >= 190;
+SELECT count(*), min(id), max(id), sum(v) FROM range_batch WHERE id <= 33;
+-- empty ranges
+SELECT count(*), min(id), max(id), sum(v) FROM range_batch WHERE id > 200;
+SELECT count(*), min(id), max(id), sum(v) FROM range_batch WHERE id >= 50 AND id <= 49;
+-- backward scans stop at their inclusive end key too
+SELECT id FROM range_batch WHERE id >= 85 AND id <= 101 ORDER BY id DESC;
+SELECT id FROM range_batch WHERE id <= 20 ORDER BY id DESC LIMIT 3;
+-- a secondary index with duplicate keys across batches
+SELECT count(*), min(id), max(id), sum(v) FROM range_batch WHERE grp = 3;
+SELECT count(*), min(id), max(id), sum(v) FROM range_batch WHERE grp >= 2 AND grp <= 3;
+SELECT count(*), min(id), max(id), sum(v) FROM range_batch WHERE grp > 8;
+SELECT grp, count(*) FROM range_batch WHERE grp >= 4 AND grp <= 5 GROUP BY grp ORDER BY grp DESC;
+-- LIMIT stops in the middle of a batch
+SELECT count(*), min(id), max(id) FROM (SELECT id FROM range_batch WHERE id > 10 ORDER BY id LIMIT 17) s;
+SELECT count(*), min(id), max(id) FROM (SELECT id FROM range_batch WHERE id > 10 ORDER BY id DESC LIMIT 17) s;
+-- a cursor consumes the batches one row at a time
+START TRANSACTION;
+DECLARE range_batch_cur CURSOR FOR SELECT id, v FROM range_batch WHERE id >= 40 AND id <= 75 ORDER BY id;
+MOVE 14 FROM range_batch_cur;
+FETCH 4 FROM range_batch_cur;
+MOVE 12 FROM range_batch_cur;
+FETCH 10 FROM range_batch_cur;
+CLOSE range_batch_cur;
+COMMIT;
+-- jitted range scans
+PREPARE range_batch_sum(int, int) AS SELECT count(*), sum(v) FROM range_batch WHERE id >= $1 AND id <= $2;
+EXECUTE range_batch_sum(1, 16);
+EXECUTE range_batch_sum(1, 17);
+EXECUTE range_batch_sum(17, 48);
+EXECUTE range_batch_sum(60, 59);
+DEALLOCATE range_batch_sum;
+PREPARE range_batch_next(int) AS SELECT id, v FROM range_batch WHERE id > $1 ORDER BY id LIMIT 3;
+EXECUTE range_batch_next(15);
+EXECUTE range_batch_next(198);
+DEALLOCATE range_batch_next;
+DROP FOREIGN TABLE range_batch;
@@ -0,0 +1,44 @@
+-- aggregating scans of MOT tables fill vector batches directly, see MOTVecIterateForeignScan
+create foreign table mot_vec_t (id int primary key, grp text, iv interval, tiv tinterval, ttz timetz, txt text, num numeric(12,2));
+insert into mot_vec_t select g, 'g' || g % 3, g * interval '1 minute',
+    case when g % 10 = 0 then null
+         when g % 2 = 0 then '["2020-01-01 00:00:00+00" "2020-01-02 00:00:00+00"]'::tinterval
+         else '["2020-01-01 00:00:00+00" "2020-01-03 00:00:00+00"]'::tinterval end,
+    case when g % 17 = 0 then null else '00:00:00+08'::timetz + g * interval '1 second' end,
+    case when g % 7 = 0 then null else 'txt' || lpad(g::text, 4, '0') end,
+    g * 1.25
+  from generate_series(1, 3000) g;
+create function mot_vec_scan_node(query text) returns setof text
+language plpgsql as
+$$
+declare
+    ln text;
+begin
+    for ln in execute 'explain (costs off) ' || query loop
+        if ln ~ 'Foreign Scan' then
+            return next ltrim(ln);
+        end if;
+    end loop;
+end;
+$$;
+set enable_vector_engine = on;
+select mot_vec_scan_node('select grp, count(*), sum(iv), avg(iv), min(iv), max(iv) from mot_vec_t group by grp order by grp');
+select mot_vec_scan_node('select count(*), sum(num), min(txt), max(iv) from mot_vec_t where id between 100 and 2500');
+-- interval, tinterval and timetz are passed by reference with a fixed length
+select grp, count(*), sum(iv), avg(iv), min(iv), max(iv) from mot_vec_t group by grp order by grp;
+select grp, count(ttz), min(ttz), max(ttz), count(txt), min(txt), max(txt) from mot_vec_t group by grp order by grp;
+select grp, sum(num), avg(num), min(num), max(num) from mot_vec_t group by grp order by grp;
+select count(tiv), count(*) from mot_vec_t group by tiv order by 1, 2;
+-- a range of the primary key
+select count(*), sum(num), min(txt), max(iv) from mot_vec_t where id between 100 and 2500;
+-- the row engine gives the same results
+set enable_vector_engine = off;
+select mot_vec_scan_node('select grp, count(*), sum(iv), avg(iv), min(iv), max(iv) from mot_vec_t group by grp order by grp');
+select grp, count(*), sum(iv), avg(iv), min(iv), max(iv) from mot_vec_t group by grp order by grp;
+select grp, count(ttz), min(ttz), max(ttz), count(txt), min(txt), max(txt) from mot_vec_t group by grp order by grp;
+select grp, sum(num), avg(num), min(num), max(num) from mot_vec_t group by grp order by grp;
+select count(tiv), count(*) from mot_vec_t group by tiv order by 1, 2;
+select count(*), sum(num), min(txt), max(iv) from mot_vec_t where id between 100 and 2500;
+reset enable_vector_engine;
+drop function mot_vec_scan_node(text);
+drop foreign table mot_vec_t;
@@ -0,0 +1,49 @@
+--
+-- Adaptive nested-loop join switching to a hash of the inner side
+--
+CREATE TABLE adaptive_nl_outer (a int, b int);
+CREATE TABLE adaptive_nl_inner (a int, c text);
+INSERT INTO adaptive_nl_outer SELECT g % 10, g FROM generate_series(1, 20) g;
+INSERT INTO adaptive_nl_outer VALUES (NULL, 0);
+INSERT INTO adaptive_nl_inner SELECT g, 'v' || g FROM generate_series(0, 4) g;
+INSERT INTO adaptive_nl_inner VALUES (2, 'dup'), (NULL, 'null');
+SET enable_hashjoin = off;
+SET enable_mergejoin = off;
+SET enable_adaptive_nestloop = on;
+SET adaptive_nestloop_threshold = 3;
+SELECT count(*), sum(o.b) FROM adaptive_nl_outer o JOIN adaptive_nl_inner i ON o.a = i.a;
+SELECT count(*), count(i.c) FROM adaptive_nl_outer o LEFT JOIN adaptive_nl_inner i ON o.a = i.a;
+SELECT count(*) FROM adaptive_nl_outer o WHERE EXISTS (SELECT 1 FROM adaptive_nl_inner i WHERE i.a = o.a);
+SELECT count(*) FROM adaptive_nl_outer o WHERE NOT EXISTS (SELECT 1 FROM adaptive_nl_inner i WHERE i.a = o.a);
+-- extra join quals are still checked after the hash probe
+SELECT count(*) FROM adaptive_nl_outer o JOIN adaptive_nl_inner i ON o.a = i.a AND i.c <> 'dup';
+-- EXPLAIN ANALYZE reports the decision of the node
+CREATE FUNCTION adaptive_nl_explain(query text) RETURNS SETOF text
+LANGUAGE plpgsql AS
+$$
+DECLARE
+    ln text;
+BEGIN
+    FOR ln IN EXECUTE 'EXPLAIN (ANALYZE, COSTS OFF, TIMING OFF) ' || query LOOP
+        IF ln ~ 'Nested Loop|Adaptive Join' THEN
+            RETURN NEXT ltrim(ln);
+        END IF;
+    END LOOP;
+END;
+$$;
+SELECT adaptive_nl_explain('SELECT count(*) FROM adaptive_nl_outer o LEFT JOIN adaptive_nl_inner i ON o.a = i.a');
+-- below the threshold the node keeps looping
+SET adaptive_nestloop_threshold = 100;
+SELECT adaptive_nl_explain('SELECT count(*) FROM adaptive_nl_outer o LEFT JOIN adaptive_nl_inner i ON o.a = i.a');
+SET adaptive_nestloop_threshold = 3;
+-- the result must not depend on whether the switch happened
+SET enable_adaptive_nestloop = off;
+SELECT count(*), sum(o.b) FROM adaptive_nl_outer o JOIN adaptive_nl_inner i ON o.a = i.a;
+SELECT adaptive_nl_explain('SELECT count(*) FROM adaptive_nl_outer o LEFT JOIN adaptive_nl_inner i ON o.a = i.a');
+RESET adaptive_nestloop_threshold;
+RESET enable_adaptive_nestloop;
+RESET enable_mergejoin;
+RESET enable_hashjoin;
+DROP FUNCTION adaptive_nl_explain(text);
+DROP TABLE adaptive_nl_outer;
+DROP TABLE adaptive_nl_inner;
@@ -0,0 +1,25 @@
+--
+-- Cardinality feedback from executed scans
+--
+CREATE TABLE card_fb (a int, b int);
+INSERT INTO card_fb SELECT g % 10, g % 10 FROM generate_series(1, 1000) g;
+ANALYZE card_fb;
+SET enable_card_feedback = on;
+-- a and b are fully correlated, so the estimate is off by a factor of 10
+SELECT count(*) FROM card_fb WHERE a = 1 AND b = 1;
+SELECT samples, round(selectivity::numeric, 2) AS selectivity, est_rows, actual_rows
+  FROM gs_card_feedback WHERE relid = 'card_fb'::regclass;
+-- the next plan picks the observed selectivity up, clause order does not matter
+SELECT count(*) FROM card_fb WHERE b = 1 AND a = 1;
+SELECT samples, round(selectivity::numeric, 2) AS selectivity, est_rows, actual_rows
+  FROM gs_card_feedback WHERE relid = 'card_fb'::regclass;
+-- other constants get their own entry
+SELECT count(*) FROM card_fb WHERE a = 2 AND b = 3;
+SELECT count(*) FROM gs_card_feedback WHERE relid = 'card_fb'::regclass;
+-- scans below a limit are not sampled
+SELECT count(*) FROM (SELECT * FROM card_fb WHERE a = 5 LIMIT 1) s;
+SELECT count(*) FROM gs_card_feedback WHERE relid = 'card_fb'::regclass;
+SELECT gs_reset_card_feedback();
+SELECT count(*) FROM gs_card_feedback WHERE relid = 'card_fb'::regclass;
+RESET enable_card_feedback;
+DROP TABLE card_fb;
@@ -0,0 +1,41 @@
+--
+-- min/max of filtered column table scans, compared with a row table
+--
+CREATE TABLE minmax_col (a int, b int) WITH (orientation = column, max_batchrow = 10000);
+CREATE TABLE minmax_row (a int, b int);
+-- one CU per insert
+INSERT INTO minmax_col SELECT g, (g * 37) % 10007 FROM generate_series(1, 10000) g;
+INSERT INTO minmax_col SELECT 10000 + g, (g * 53) % 10009 + 1000 FROM generate_series(1, 10000) g;
+INSERT INTO minmax_col SELECT CASE WHEN g % 100 = 0 THEN NULL ELSE 20000 + g END, (g * 61) % 9973 + 2000 FROM generate_series(1, 10000) g;
+INSERT INTO minmax_col SELECT 30000 + g, CASE WHEN g % 50 = 0 THEN NULL ELSE (g * 71) % 9967 + 3000 END FROM generate_series(1, 10000) g;
+INSERT INTO minmax_col SELECT 40000 + g, (g * 79) % 9949 + 4000 FROM generate_series(1, 10000) g;
+INSERT INTO minmax_row SELECT g, (g * 37) % 10007 FROM generate_series(1, 10000) g;
+INSERT INTO minmax_row SELECT 10000 + g, (g * 53) % 10009 + 1000 FROM generate_series(1, 10000) g;
+INSERT INTO minmax_row SELECT CASE WHEN g % 100 = 0 THEN NULL ELSE 20000 + g END, (g * 61) % 9973 + 2000 FROM generate_series(1, 10000) g;
+INSERT INTO minmax_row SELECT 30000 + g, CASE WHEN g % 50 = 0 THEN NULL ELSE (g * 71) % 9967 + 3000 END FROM generate_series(1, 10000) g;
+INSERT INTO minmax_row SELECT 40000 + g, (g * 79) % 9949 + 4000 FROM generate_series(1, 10000) g;
+DELETE FROM minmax_col WHERE a > 40000 AND (b < 4050 OR b > 13900);
+DELETE FROM minmax_row WHERE a > 40000 AND (b < 4050 OR b > 13900);
+-- CUs whose rows all match
+SELECT min(b), max(b), min(a), max(a) FROM minmax_col WHERE a >= 1 AND a <= 20000;
+SELECT min(b), max(b), min(a), max(a) FROM minmax_row WHERE a >= 1 AND a <= 20000;
+-- CUs that partially match
+SELECT min(b), max(b), min(a), max(a) FROM minmax_col WHERE a > 5000 AND a < 15000;
+SELECT min(b), max(b), min(a), max(a) FROM minmax_row WHERE a > 5000 AND a < 15000;
+-- an equality key
+SELECT min(b), max(b), min(a), max(a) FROM minmax_col WHERE a = 12345;
+SELECT min(b), max(b), min(a), max(a) FROM minmax_row WHERE a = 12345;
+-- a CU with NULLs in the key column
+SELECT min(b), max(b), min(a), max(a) FROM minmax_col WHERE a >= 20001 AND a <= 30000;
+SELECT min(b), max(b), min(a), max(a) FROM minmax_row WHERE a >= 20001 AND a <= 30000;
+-- a CU with NULLs in the aggregated column
+SELECT min(b), max(b), min(a), max(a) FROM minmax_col WHERE a > 30000 AND a <= 40000;
+SELECT min(b), max(b), min(a), max(a) FROM minmax_row WHERE a > 30000 AND a <= 40000;
+-- a CU with deleted rows
+SELECT min(b), max(b), min(a), max(a) FROM minmax_col WHERE a > 40000;
+SELECT min(b), max(b), min(a), max(a) FROM minmax_row WHERE a > 40000;
+-- matching, partially matching and NULL CUs together
+SELECT min(b), max(b), min(a), max(a) FROM minmax_col WHERE a < 25000;
+SELECT min(b), max(b), min(a), max(a) FROM minmax_row WHERE a < 25000;
+DROP TABLE minmax_col;
+DROP TABLE minmax_row;
@@ -0,0 +1,89 @@
+--
+-- DPhyp join enumeration for join problems above geqo_threshold
+--
+CREATE TABLE dphyp_dim AS SELECT g AS a, g + 1 AS b FROM generate_series(0, 9) g;
+CREATE TABLE dphyp_fact AS SELECT g % 10 AS k1, g % 10 AS k2, g % 10 AS k3, g % 10 AS k4,
+    g % 10 AS k5, g % 10 AS k6, g % 10 AS k7, g % 10 AS k8, g % 10 AS k9, g % 10 AS k10,
+    g % 10 AS k11, g % 10 AS k12 FROM generate_series(1, 100) g;
+ANALYZE dphyp_dim;
+ANALYZE dphyp_fact;
+SET geqo_threshold = 4;
+SET enable_dphyp = on;
+-- chain
+SELECT count(*), min(d1.a) FROM dphyp_dim d1, dphyp_dim d2, dphyp_dim d3, dphyp_dim d4, dphyp_dim d5, dphyp_dim d6
+    WHERE d1.b = d2.a AND d2.b = d3.a AND d3.b = d4.a AND d4.b = d5.a AND d5.b = d6.a;
+-- outer joins restrict the join order
+SELECT count(*), count(d5.a) FROM dphyp_dim d1 LEFT JOIN dphyp_dim d2 ON d1.b = d2.a
+    LEFT JOIN dphyp_dim d3 ON d2.b = d3.a LEFT JOIN dphyp_dim d4 ON d3.b = d4.a
+    LEFT JOIN dphyp_dim d5 ON d4.b = d5.a;
+-- disconnected join graph
+SELECT count(*) FROM dphyp_dim d1, dphyp_dim d2, dphyp_dim d3, dphyp_dim d4
+    WHERE d1.b = d2.a AND d3.b = d4.a;
+-- a selective chain is joined left-deep from its restricted end
+CREATE TABLE dphyp_big AS SELECT g AS a, g + 1 AS b FROM generate_series(0, 999) g;
+CREATE INDEX dphyp_big_a_idx ON dphyp_big(a);
+ANALYZE dphyp_big;
+SET enable_hashjoin = off;
+SET enable_mergejoin = off;
+EXPLAIN (COSTS OFF) SELECT count(*) FROM dphyp_big b1, dphyp_big b2, dphyp_big b3, dphyp_big b4
+    WHERE b1.a = 0 AND b1.b = b2.a AND b2.b = b3.a AND b3.b = b4.a;
+SELECT count(*) FROM dphyp_big b1, dphyp_big b2, dphyp_big b3, dphyp_big b4
+    WHERE b1.a = 0 AND b1.b = b2.a AND b2.b = b3.a AND b3.b = b4.a;
+RESET enable_mergejoin;
+RESET enable_hashjoin;
+DROP TABLE dphyp_big;
+-- a 15-way star fits into the default limit: DPhyp finds the plan of the
+-- exhaustive search, which is cheaper than the greedy order that joins the
+-- most selective dimension first
+CREATE TABLE dphyp_star AS SELECT g % 12 AS k1, g % 13 AS k2, g % 14 AS k3, g % 15 AS k4, g % 16 AS k5,
+    g % 17 AS k6, g % 18 AS k7, g % 19 AS k8, g % 20 AS k9, g % 21 AS k10, g % 22 AS k11, g % 23 AS k12,
+    g % 24 AS k13, g % 100 AS kx FROM generate_series(1, 10000) g;
+CREATE TABLE dphyp_x AS SELECT g AS a, g AS b FROM generate_series(0, 49999) g;
+CREATE INDEX dphyp_x_a_idx ON dphyp_x(a);
+ANALYZE dphyp_star;
+ANALYZE dphyp_x;
+CREATE FUNCTION dphyp_star_cost() RETURNS float8 AS $$
+DECLARE
+    line text;
+BEGIN
+    EXECUTE 'EXPLAIN SELECT count(*) FROM dphyp_star f, dphyp_dim d1, dphyp_dim d2, dphyp_dim d3, dphyp_dim d4,
+        dphyp_dim d5, dphyp_dim d6, dphyp_dim d7, dphyp_dim d8, dphyp_dim d9, dphyp_dim d10, dphyp_dim d11,
+        dphyp_dim d12, dphyp_dim d13, dphyp_x x WHERE f.k1 = d1.a AND f.k2 = d2.a AND f.k3 = d3.a
+        AND f.k4 = d4.a AND f.k5 = d5.a AND f.k6 = d6.a AND f.k7 = d7.a AND f.k8 = d8.a AND f.k9 = d9.a
+        AND f.k10 = d10.a AND f.k11 = d11.a AND f.k12 = d12.a AND f.k13 = d13.a AND f.kx = x.a AND x.b < 20' INTO line;
+    RETURN substring(line from 'cost=[0-9.]+\.\.([0-9.]+)')::float8;
+END;
+$$ LANGUAGE plpgsql;
+CREATE TABLE dphyp_costs(search text, cost float8);
+INSERT INTO dphyp_costs VALUES ('dphyp', dphyp_star_cost());
+SET enable_dphyp = off;
+SET geqo = off;
+INSERT INTO dphyp_costs VALUES ('exhaustive', dphyp_star_cost());
+RESET geqo;
+SET enable_dphyp = on;
+SET dphyp_mem_limit = '1MB';
+INSERT INTO dphyp_costs VALUES ('greedy', dphyp_star_cost());
+RESET dphyp_mem_limit;
+SELECT abs(d.cost - e.cost) <= e.cost * 0.001 AS dphyp_is_exhaustive, d.cost < g.cost AS greedy_is_worse
+    FROM dphyp_costs d, dphyp_costs e, dphyp_costs g
+    WHERE d.search = 'dphyp' AND e.search = 'exhaustive' AND g.search = 'greedy';
+SELECT count(*) FROM dphyp_star f, dphyp_dim d1, dphyp_dim d2, dphyp_dim d3, dphyp_dim d4, dphyp_dim d5,
+    dphyp_dim d6, dphyp_dim d7, dphyp_dim d8, dphyp_dim d9, dphyp_dim d10, dphyp_dim d11, dphyp_dim d12,
+    dphyp_dim d13, dphyp_x x WHERE f.k1 = d1.a AND f.k2 = d2.a AND f.k3 = d3.a AND f.k4 = d4.a AND f.k5 = d5.a
+    AND f.k6 = d6.a AND f.k7 = d7.a AND f.k8 = d8.a AND f.k9 = d9.a AND f.k10 = d10.a AND f.k11 = d11.a AND
+    f.k12 = d12.a AND f.k13 = d13.a AND f.kx = x.a AND x.b < 20;
+DROP TABLE dphyp_costs;
+DROP FUNCTION dphyp_star_cost();
+DROP TABLE dphyp_x;
+DROP TABLE dphyp_star;
+-- a 13-way star does not fit into 1MB and is ordered greedily
+SET dphyp_mem_limit = '1MB';
+SELECT count(*) FROM dphyp_fact f, dphyp_dim d1, dphyp_dim d2, dphyp_dim d3, dphyp_dim d4, dphyp_dim d5,
+    dphyp_dim d6, dphyp_dim d7, dphyp_dim d8, dphyp_dim d9, dphyp_dim d10, dphyp_dim d11, dphyp_dim d12
+    WHERE f.k1 = d1.a AND f.k2 = d2.a AND f.k3 = d3.a AND f.k4 = d4.a AND f.k5 = d5.a AND f.k6 = d6.a
+    AND f.k7 = d7.a AND f.k8 = d8.a AND f.k9 = d9.a AND f.k10 = d10.a AND f.k11 = d11.a AND f.k12 = d12.a;
+RESET dphyp_mem_limit;
+RESET enable_dphyp;
+RESET geqo_threshold;
+DROP TABLE dphyp_fact;
+DROP TABLE dphyp_dim;